@@ -355,21 +355,24 @@ int IRRCALLCONV main(int argc, char* argv[])
 		int fps = driver->getFPS();
 		//if (lastFPS != fps)
 		{
-			io::IAttributes * const attr = smgr->getParameters();
+			const scene::SRenderStatistics * const stats = smgr->getRenderStatistics();
 			core::stringw str = L"Q3 [";
 			str += driver->getName();
 			str += "] FPS:";
 			str += fps;
-			str += " Cull:";
-			str += attr->getAttributeAsInt("calls");
-			str += "/";
-			str += attr->getAttributeAsInt("culled");
-			str += " Draw: ";
-			str += attr->getAttributeAsInt("drawn_solid");
-			str += "/";
-			str += attr->getAttributeAsInt("drawn_transparent");
-			str += "/";
-			str += attr->getAttributeAsInt("drawn_transparent_effect");
+			if (stats)
+			{
+				str += " Cull:";
+				str += stats->RegisteredNodes;
+				str += "/";
+				str += stats->CulledNodes;
+				str += " Draw: ";
+				str += stats->DrawnSolidNodes;
+				str += "/";
+				str += stats->DrawnTransparentNodes;
+				str += "/";
+				str += stats->DrawnTransparentEffectNodes;
+			}
 
 			device->setWindowCaption(str.c_str());
 			lastFPS = fps;
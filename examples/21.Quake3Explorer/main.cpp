@@ -2020,25 +2020,27 @@ void CQuake3EventHandler::Animate()
 
 	checkTimeFire ( player->Anim, 4, now );
 
-	// Query Scene Manager attributes
+	// Query Scene Manager statistics
 	if ( player->Anim[0].flags & FIRED )
 	{
 		ISceneManager *smgr = Game->Device->getSceneManager ();
 		wchar_t msg[128];
 		IVideoDriver * driver = Game->Device->getVideoDriver();
 
-		IAttributes * attr = smgr->getParameters();
+		SRenderStatistics stats;
+		if ( smgr->getRenderStatistics () )
+			stats = *smgr->getRenderStatistics ();
 		swprintf ( msg, 128,
 			L"Q3 %s [%ls], FPS:%03d Tri:%.03fm Cull %d/%d nodes (%d,%d,%d)",
 			Game->CurrentMapName.c_str(),
 			driver->getName(),
 			driver->getFPS (),
 			(f32) driver->getPrimitiveCountDrawn( 0 ) * ( 1.f / 1000000.f ),
-			attr->getAttributeAsInt ( "culled" ),
-			attr->getAttributeAsInt ( "calls" ),
-			attr->getAttributeAsInt ( "drawn_solid" ),
-			attr->getAttributeAsInt ( "drawn_transparent" ),
-			attr->getAttributeAsInt ( "drawn_transparent_effect" )
+			stats.CulledNodes,
+			stats.RegisteredNodes,
+			stats.DrawnSolidNodes,
+			stats.DrawnTransparentNodes,
+			stats.DrawnTransparentEffectNodes
 			);
 		Game->Device->setWindowCaption( msg );
 
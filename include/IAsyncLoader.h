@@ -0,0 +1,134 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __I_ASYNC_LOADER_H_INCLUDED__
+#define __I_ASYNC_LOADER_H_INCLUDED__
+
+#include "IReferenceCounted.h"
+#include "path.h"
+
+namespace irr
+{
+namespace video
+{
+	class ITexture;
+} // end namespace video
+namespace scene
+{
+	class IAnimatedMesh;
+
+	//! State of an asynchronous load
+	enum E_ASYNC_LOAD_STATE
+	{
+		//! The file is waiting or being loaded
+		EALS_LOADING = 0,
+
+		//! The mesh or texture is available
+		EALS_LOADED,
+
+		//! The file could not be loaded
+		EALS_FAILED
+	};
+
+	//! A mesh or texture which is loaded in the background
+	/** Created by IAsyncLoader::loadMesh() and IAsyncLoader::loadTexture().
+	The state only changes in IAsyncLoader::update(), on the main thread. */
+	class IAsyncLoad : public virtual IReferenceCounted
+	{
+	public:
+
+		//! Get the state of the load
+		virtual E_ASYNC_LOAD_STATE getState() const = 0;
+
+		//! Get the name of the loaded file
+		virtual const io::path& getFileName() const = 0;
+
+		//! Get the loaded mesh
+		/** \return The mesh, or 0 if this is no mesh load or it's not
+		loaded yet. The mesh is in the mesh cache, like meshes of
+		ISceneManager::getMesh(). */
+		virtual IAnimatedMesh* getMesh() const = 0;
+
+		//! Get the loaded texture
+		/** \return The texture, or 0 if this is no texture load or
+		it's not loaded yet. The texture is in the texture cache of the
+		driver, like textures of IVideoDriver::getTexture(). */
+		virtual video::ITexture* getTexture() const = 0;
+	};
+
+	//! Callback interface for catching finished loads.
+	/** Implement this interface and use
+	IAsyncLoader::setLoadFinishedCallback to be notified when a load has
+	finished. */
+	class IAsyncLoadFinishedCallBack : public virtual IReferenceCounted
+	{
+	public:
+
+		//! Will be called on the main thread when a load has finished.
+		/** \param load: The load, its state is EALS_LOADED or EALS_FAILED. */
+		virtual void OnLoadFinished(IAsyncLoad* load) = 0;
+	};
+
+	//! Loads meshes and textures without blocking the main thread.
+	/** Files are read and parsed on a background thread, and the images
+	of textures are decoded there, too. Only the textures are created on
+	the main thread, during update(), which the scene manager calls in
+	ISceneManager::drawAll(). Textures which mesh loaders request on the
+	background thread are created the same way, so the loader thread waits
+	for the next update() in this case. Hardware buffers of the meshes are
+	created by the driver when they are drawn first, as usual.
+
+	Mesh loaders which are not known to be thread safe, see
+	IMeshLoader::canLoadInBackground(), are run on the main thread during
+	update(). So are all mesh loads of a scene manager when another scene
+	manager with the same driver is loading meshes already. While loads
+	are pending, mesh loaders, image loaders and file archives must not be
+	added or removed, and files of archives which are used by pending loads
+	should not be read on the main thread. */
+	class IAsyncLoader : public virtual IReferenceCounted
+	{
+	public:
+
+		//! Starts loading a mesh
+		/** The mesh is added to the mesh cache when it's loaded, so
+		ISceneManager::getMesh() finds it afterwards. A mesh which is in
+		the cache already is finished by the next update().
+		\param filename Name of the mesh file.
+		\return The load. Drop it when it's no longer needed. See
+		IReferenceCounted::drop() for more information. */
+		virtual IAsyncLoad* loadMesh(const io::path& filename) = 0;
+
+		//! Starts loading a texture
+		/** The texture is added to the texture cache of the driver when
+		it's loaded. A texture which is in the cache already is finished
+		by the next update().
+		\param filename Name of the texture file.
+		\return The load. Drop it when it's no longer needed. See
+		IReferenceCounted::drop() for more information. */
+		virtual IAsyncLoad* loadTexture(const io::path& filename) = 0;
+
+		//! Finishes the loads which were done in the background
+		/** Creates their textures, adds them to the caches and calls the
+		callback. Must be called regularly on the main thread, this is
+		done by ISceneManager::drawAll(). */
+		virtual void update() = 0;
+
+		//! Blocks until a load has finished
+		/** \param load The load to wait for, or 0 to wait for all
+		pending loads. */
+		virtual void wait(IAsyncLoad* load=0) = 0;
+
+		//! Get the number of loads which have not finished yet
+		virtual u32 getPendingCount() const = 0;
+
+		//! Sets a callback interface which will be called when a load has finished.
+		/** Set this to 0 to disable the callback again. */
+		virtual void setLoadFinishedCallback(IAsyncLoadFinishedCallBack* callback=0) = 0;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -7,6 +7,7 @@
 
 #include "IReadFile.h"
 #include "IFileList.h"
+#include "irrArray.h"
 
 namespace irr
 {
@@ -70,6 +71,19 @@ public:
 	\return Returns a pointer to the created file on success, or 0 on failure. */
 	virtual IReadFile* createAndOpenFile(u32 index) =0;
 
+	//! Opens several files at once, based on their positions in the file list.
+	/** Archives which decompress their files, like zip archives, can
+	decompress them on several threads.
+	\param indices The zero based indices of the files.
+	\param files Receives a pointer to each created file, or 0 if the file
+	could not be opened. Drop them when they are no longer needed. */
+	virtual void createAndOpenFiles(const core::array<u32>& indices, core::array<IReadFile*>& files)
+	{
+		files.set_used(indices.size());
+		for (u32 i=0; i<indices.size(); ++i)
+			files[i] = createAndOpenFile(indices[i]);
+	}
+
 	//! Returns the complete file tree
 	/** \return Returns the complete directory tree for the archive,
 	including all files and folders */
@@ -78,6 +92,26 @@ public:
 	//! get the archive type
 	virtual E_FILE_ARCHIVE_TYPE getType() const { return EFAT_UNKNOWN; }
 
+	//! Check if files are opened by looking them up in the file list
+	/** Return true if createAndOpenFile(const path&) does the same as
+	calling createAndOpenFile(u32) with the index which
+	getFileList()->findFile() returns, and the file list doesn't change
+	anymore. The file system then finds the files of the archive in a hash
+	table instead of asking the archive, which makes opening files fast
+	when many archives are added. This is only done if the file list
+	ignores the case of the names, see IFileList::isIgnoringCase().
+	\return True if the file list is used for opening files. */
+	virtual bool opensFilesByFileList() const { return false; }
+
+	//! Sets the size of the cache for decompressed files
+	/** Archives which decompress their files, like zip archives, keep
+	the decompressed files in the cache, so opening them again only
+	creates a new file for the same memory. The files which were not
+	opened for the longest time are removed when the cache is full.
+	\param bytes Maximum size of the decompressed files in the cache.
+	The default 0 disables the cache. */
+	virtual void setCacheSize(u32 bytes) {}
+
 	//! An optionally used password string
 	/** This variable is publicly accessible from the interface in order to
 	avoid single access patterns to this place, and hence allow some more
@@ -74,6 +74,18 @@ public:
 	//! Returns the base path of the file list
 	virtual const io::path& getPath() const = 0;
 
+	//! Check if the list ignores the paths of the files
+	/** Then the full names of the files are just their names, and
+	findFile() only compares the names.
+	\return True if the paths are ignored, else false. */
+	virtual bool isIgnoringPaths() const { return false; }
+
+	//! Check if the list ignores the case of the names
+	/** Then the names of the files are lower case, and findFile()
+	compares the lower case names.
+	\return True if the case is ignored, else false. */
+	virtual bool isIgnoringCase() const { return false; }
+
 	//! Add as a file or folder to the list
 	/** \param fullPath The file name including path, from the root of the file list.
 	\param isDirectory True if this is a directory rather than a file.
@@ -43,6 +43,14 @@ public:
 	If you no longer need the mesh, you should call IAnimatedMesh::drop().
 	See IReferenceCounted::drop() for more information. */
 	virtual IAnimatedMesh* createMesh(io::IReadFile* file) = 0;
+
+	//! Returns true if createMesh() may be called on a background thread.
+	/** Used by IAsyncLoader. Such loaders must not change the scene,
+	the mesh cache or settings of the video driver. They may get textures
+	from the video driver or add textures from images, these are created
+	on the main thread.
+	\return True if the loader is thread safe, false by default. */
+	virtual bool canLoadInBackground() const { return false; }
 };
 
 
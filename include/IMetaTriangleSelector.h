@@ -16,6 +16,12 @@ namespace scene
 /** This is nothing more than a collection of one or more triangle selectors
 providing together the interface of one triangle selector. In this way,
 collision tests can be done with different triangle soups in one pass.
+Queries with a box or line only ask the selectors whose bounding box
+touches it. The boxes are kept in a hierarchy, which is updated when
+selectors are added, removed or move out of the space reserved for
+them. Only selectors whose node was moved, resized or animated are
+checked, once for each time of the timer, or on each query while the
+timer is stopped.
 */
 class IMetaTriangleSelector : public ITriangleSelector
 {
@@ -0,0 +1,89 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __I_PAGED_TERRAIN_SCENE_NODE_H_INCLUDED__
+#define __I_PAGED_TERRAIN_SCENE_NODE_H_INCLUDED__
+
+#include "ISceneNode.h"
+
+namespace irr
+{
+namespace scene
+{
+	class ITerrainSceneNode;
+
+	//! A terrain which is streamed from a tiled heightmap file.
+	/** The terrain is split into square tiles. Only the tiles around the
+	active camera are kept in memory, each as an ITerrainSceneNode child of
+	this node. The tiles are read from the file on a background thread when
+	the camera comes near, and removed again when it goes away. So the
+	memory use only depends on the tile size and the load radius, not on
+	the size of the terrain.
+
+	The heightmap file contains the tiles one after another, first all
+	tiles with tile X coordinate 0, ordered by their Z coordinate, then
+	those with X coordinate 1 and so on. Each tile is stored like a file of
+	ITerrainSceneNode::loadHeightMapRAW(). Neighbouring tiles share the
+	samples on their common border, so a tile of size 257 covers 256 units
+	of the terrain before scaling.
+
+	Tiles are independent terrains, so cracks may show on tile borders
+	between patches of different LOD. The terrain can't be moved after
+	its creation. The material of this node is used for all tiles. */
+	class IPagedTerrainSceneNode : public ISceneNode
+	{
+	public:
+
+		//! Constructor
+		IPagedTerrainSceneNode(ISceneNode* parent, ISceneManager* mgr, s32 id,
+			const core::vector3df& position = core::vector3df(0.0f, 0.0f, 0.0f),
+			const core::vector3df& scale = core::vector3df(1.0f, 1.0f, 1.0f))
+			: ISceneNode(parent, mgr, id, position, core::vector3df(0.0f, 0.0f, 0.0f), scale) {}
+
+		//! Get the number of tiles along the X axis
+		virtual s32 getTileCountX() const = 0;
+
+		//! Get the number of tiles along the Z axis
+		virtual s32 getTileCountZ() const = 0;
+
+		//! Get a loaded tile
+		/** \param tileX X coordinate of the tile.
+		\param tileZ Z coordinate of the tile.
+		\return The terrain of the tile, or 0 if the tile is not loaded. */
+		virtual ITerrainSceneNode* getTile(s32 tileX, s32 tileZ) const = 0;
+
+		//! Get the number of tiles which are currently loaded
+		virtual u32 getLoadedTileCount() const = 0;
+
+		//! Set how many tiles around the tile of the camera are loaded
+		/** Tiles are removed when they are more than one tile farther
+		away, so at most (2*radius+3)^2 tiles are in memory.
+		\param radius Number of tiles in each direction. Default is 2. */
+		virtual void setLoadRadius(s32 radius) = 0;
+
+		//! Get how many tiles around the tile of the camera are loaded
+		virtual s32 getLoadRadius() const = 0;
+
+		//! Loads all missing tiles around a position at once.
+		/** Blocks until they are loaded, e.g. to have the terrain
+		ready before the first frame.
+		\param position Position in world coordinates. */
+		virtual void loadTilesAround(const core::vector3df& position) = 0;
+
+		//! Get the height of the terrain at a position
+		/** \return The height in world coordinates, or -FLT_MAX if
+		the tile at the position is not loaded. */
+		virtual f32 getHeight(f32 x, f32 z) const = 0;
+
+		//! Scales the texture coordinates of the tiles
+		/** See ITerrainSceneNode::scaleTexture(). The texture
+		coordinates of each tile go from 0 to 1 before scaling. */
+		virtual void scaleTexture(f32 scale = 1.0f, f32 scale2 = 0.0f) = 0;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
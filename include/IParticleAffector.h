@@ -51,6 +51,34 @@ public:
 	\param count Amount of particles in array. */
 	virtual void affect(u32 now, SParticle* particlearray, u32 count) = 0;
 
+	//! Affects particles stored in separate arrays.
+	/** Called instead of affect() by particle systems with the storage
+	EPS_ARRAYS. The built in affectors process 4 particles at once with
+	SIMD instructions where available.
+	\param now Current time. (Same as ITimer::getTime() would return)
+	\param particles The particle arrays. If prepareAffectArrays()
+	returned true, only a part of the particles, and other parts may be
+	affected at the same time on other threads.
+	\return False if not implemented, the particles are then copied to
+	an array of SParticle for affect() and back. */
+	virtual bool affectArrays(u32 now, SParticleArrays& particles)
+	{
+		return false;
+	}
+
+	//! Prepares calls of affectArrays() for parts of the particles.
+	/** Called once per update before affectArrays() by particle systems
+	with the storage EPS_ARRAYS. State which changes once per update, like
+	the time of the last update, has to be changed here.
+	\param now Current time. (Same as ITimer::getTime() would return)
+	\return True if affectArrays() may be called concurrently for parts
+	of the particles, see IParticleSystemSceneNode::setParallelUpdate().
+	Otherwise it is called once with all particles. */
+	virtual bool prepareAffectArrays(u32 now)
+	{
+		return false;
+	}
+
 	//! Sets whether or not the affector is currently enabled.
 	virtual void setEnabled(bool enabled) { Enabled = enabled; }
 
@@ -23,6 +23,20 @@ namespace irr
 namespace scene
 {
 
+//! How a particle system stores its particles
+enum E_PARTICLE_STORAGE
+{
+	//! One SParticle struct for each particle, the default
+	EPS_STRUCTS = 0,
+
+	//! One array for each member of SParticle, see SParticleArrays.
+	/** The built in affectors and the movement of the particles work on 4
+	particles at once with SIMD instructions where available. Affectors
+	which don't implement IParticleAffector::affectArrays() are slower,
+	as the particles are copied for them. */
+	EPS_ARRAYS
+};
+
 //! A particle system scene node for creating snow, fire, exlosions, smoke...
 /** A scene node controlling a particle System. The behavior of the particles
 can be controlled by setting the right particle emitters and affectors.
@@ -67,6 +81,36 @@ public:
 	//! Remove all currently visible particles
 	virtual void clearParticles() = 0;
 
+	//! Sets how the particles are stored.
+	/** The particles which exist are kept. Default is EPS_STRUCTS. */
+	virtual void setParticleStorage(E_PARTICLE_STORAGE storage) = 0;
+
+	//! Gets how the particles are stored.
+	virtual E_PARTICLE_STORAGE getParticleStorage() const = 0;
+
+	//! Sets the maximal number of particles in the system.
+	/** No new particles are emitted while the system has this many.
+	Systems with more than 16250 particles are drawn in several parts.
+	Default is 16250. */
+	virtual void setMaxParticles(u32 maxParticles) = 0;
+
+	//! Gets the maximal number of particles in the system.
+	virtual u32 getMaxParticles() const = 0;
+
+	//! Updates the particles and creates their billboards on several threads.
+	/** The particles are split into blocks which are handled by worker
+	threads shared by all particle systems. Billboards are created in
+	parallel with both storages, the affectors and the movement of the
+	particles only with EPS_ARRAYS and affectors whose
+	IParticleAffector::prepareAffectArrays() returns true. The emitter
+	always runs on the calling thread. Only worth it for systems with
+	thousands of particles. Only available with _IRR_COMPILE_WITH_THREADS_,
+	default is false. */
+	virtual void setParallelUpdate(bool on) = 0;
+
+	//! Gets if the particles are updated on several threads.
+	virtual bool getParallelUpdate() const = 0;
+
 	//! Do manually update the particles.
 	/** This should only be called when you want to render the node outside
 	the scenegraph, as the node will care about this otherwise
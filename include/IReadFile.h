@@ -42,6 +42,15 @@ namespace io
 		//! Get name of file.
 		/** \return File name as zero terminated character string. */
 		virtual const io::path& getFileName() const = 0;
+
+		//! Get the contents of the whole file in memory.
+		/** Available for files read from memory, and for large files on
+		disk which are mapped into memory. Loaders can parse them without
+		copying them into a buffer first. The pointer is valid until the
+		file is dropped, and doesn't depend on the current position.
+		\return Pointer to the getSize() bytes of the file, or 0 if the
+		file can only be accessed with read(). */
+		virtual const void* getBuffer() const { return 0; }
 	};
 
 	//! Internal function, please do not use.
@@ -20,6 +20,24 @@ namespace scene
 	class ICameraSceneNode;
 	class ITriangleSelector;
 
+	//! Result for one ray of ISceneCollisionManager::getCollisionPoints()
+	struct SCollisionHit
+	{
+		SCollisionHit() : Node(0), Hit(false) {}
+
+		//! The nearest collision point to the start of the ray
+		core::vector3df Point;
+
+		//! The triangle with which the ray collided
+		core::triangle3df Triangle;
+
+		//! The scene node associated with the triangle
+		ISceneNode* Node;
+
+		//! True if a collision was detected, the other members are only valid then
+		bool Hit;
+	};
+
 	//! The Scene Collision Manager provides methods for performing collision tests and picking on scene nodes.
 	class ISceneCollisionManager : public virtual IReferenceCounted
 	{
@@ -42,6 +60,28 @@ namespace scene
 				ITriangleSelector* selector, core::vector3df& outCollisionPoint,
 				core::triangle3df& outTriangle, ISceneNode*& outNode) =0;
 
+		//! Finds the nearest collision points of many lines with lots of triangles.
+		/** Works like getCollisionPoint() for each ray, but the
+		selectors are only gone through once for the whole batch.
+		Triangles of selectors without their own collision point query
+		are fetched once for the bounding box of all rays, and tested
+		against packets of four rays, which is fastest when neighbouring
+		rays in the array are close to each other. For large static meshes
+		a selector from ISceneManager::createBVHTriangleSelector() is
+		best, it is searched for each ray without copying triangles.
+		\param rays: Array of lines with which collisions are tested.
+		\param rayCount: Number of lines in rays.
+		\param selector: TriangleSelector containing the triangles.
+		\param outHits: Array of rayCount results, one for each ray.
+		\param parallel: If true, the rays are split across one thread
+		per processor core. The selectors are only read by the threads,
+		so they must not be changed until the call returns. Only
+		available with _IRR_COMPILE_WITH_THREADS_.
+		\return Number of rays for which a collision was detected. */
+		virtual u32 getCollisionPoints(const core::line3d<f32>* rays, u32 rayCount,
+				ITriangleSelector* selector, SCollisionHit* outHits,
+				bool parallel=false) =0;
+
 		//! Collides a moving ellipsoid with a 3d world with gravity and returns the resulting new position of the ellipsoid.
 		/** This can be used for moving a character in a 3d world: The
 		character will slide at walls and is able to walk up stairs.
@@ -17,6 +17,7 @@
 #include "ESceneNodeAnimatorTypes.h"
 #include "EMeshWriterEnums.h"
 #include "SceneParameters.h"
+#include "SRenderStatistics.h"
 #include "IGeometryCreator.h"
 #include "ISkinnedMesh.h"
 
@@ -96,6 +97,7 @@ namespace scene
 
 	class IAnimatedMesh;
 	class IAnimatedMeshSceneNode;
+	class IAsyncLoader;
 	class IBillboardSceneNode;
 	class IBillboardTextSceneNode;
 	class ICameraSceneNode;
@@ -119,6 +121,7 @@ namespace scene
 	class ISceneNodeAnimatorFactory;
 	class ISceneNodeFactory;
 	class ISceneUserDataSerializer;
+	class IPagedTerrainSceneNode;
 	class ITerrainSceneNode;
 	class ITextSceneNode;
 	class ITriangleSelector;
@@ -413,6 +416,13 @@ namespace scene
 		through already loaded meshes. */
 		virtual IMeshCache* getMeshCache() = 0;
 
+		//! Get the loader which loads meshes and textures in the background.
+		/** The loader is created on the first call, its background thread
+		with the first load. Its loads are finished in drawAll().
+		\return Pointer to the loader.
+		This pointer should not be dropped. See IReferenceCounted::drop() for more information. */
+		virtual IAsyncLoader* getAsyncLoader() = 0;
+
 		//! Get the video driver.
 		/** \return Pointer to the video Driver.
 		This pointer should not be dropped. See IReferenceCounted::drop() for more information. */
@@ -876,6 +886,43 @@ namespace scene
 			s32 maxLOD=5, E_TERRAIN_PATCH_SIZE patchSize=ETPS_17, s32 smoothFactor=0,
 			bool addAlsoIfHeightmapEmpty = false) = 0;
 
+		//! Adds a terrain which is streamed from a tiled heightmap file.
+		/** Only the tiles around the active camera are loaded, on a
+		background thread. This allows terrains which don't fit into
+		memory. See IPagedTerrainSceneNode for the layout of the file.
+		\param tiledHeightMapFileName: The name of the file with the tiles.
+		The file is kept open as long as the node exists. It is read
+		with the long positions of IReadFile, so it can't be larger
+		than 2GB where long has 32 bits, like on Windows and 32 bit
+		systems.
+		\param tileSize: Number of samples along each side of a tile,
+		must be 2^N+1, e.g. 129, 257 or 513.
+		\param tileCountX: Number of tiles along the X axis.
+		\param tileCountZ: Number of tiles along the Z axis.
+		\param bitsPerPixel: Size of a sample, 8, 16 or 32 bits.
+		\param signedData: Whether the samples are signed.
+		\param floatVals: Whether the samples are floats, needs 32 bits per pixel.
+		\param parent: Parent of the scene node. Can be 0 if no parent.
+		\param id: Id of the node. This id can be used to identify the scene node.
+		\param position: The absolute position of the first tile.
+		\param scale: The scale factor for the terrain, see addTerrainSceneNode().
+		\param vertexColor: The default color of all the vertices.
+		\param maxLOD: The maximum LOD (level of detail) for the tiles.
+		\param patchSize: patch size of the tiles.
+		\return Pointer to the created scene node. Can be null if the
+		file could not be opened, or is too small or too large. The returned pointer
+		should not be dropped. See IReferenceCounted::drop() for more
+		information. */
+		virtual IPagedTerrainSceneNode* addPagedTerrainSceneNode(
+			const io::path& tiledHeightMapFileName,
+			s32 tileSize, s32 tileCountX, s32 tileCountZ,
+			s32 bitsPerPixel=16, bool signedData=true, bool floatVals=false,
+			ISceneNode* parent=0, s32 id=-1,
+			const core::vector3df& position = core::vector3df(0.0f,0.0f,0.0f),
+			const core::vector3df& scale = core::vector3df(1.0f,1.0f,1.0f),
+			video::SColor vertexColor = video::SColor(255,255,255,255),
+			s32 maxLOD=5, E_TERRAIN_PATCH_SIZE patchSize=ETPS_17) = 0;
+
 		//! Adds a terrain scene node to the scene graph.
 		/** Just like the other addTerrainSceneNode() method, but takes an IReadFile
 		pointer as parameter for the heightmap. For more informations take a look
@@ -1346,6 +1393,46 @@ namespace scene
 			return createOctreeTriangleSelector(mesh, node, minimalPolysPerNode);
 		}
 
+		//! Creates a Triangle Selector, optimized by a bounding volume hierarchy.
+		/** The triangles are sorted into a hierarchy of bounding boxes,
+		built with the surface area heuristic. Like the octree selector it
+		is meant for huge static meshes like levels. It also finds the
+		nearest triangle hit by a ray without returning any triangles,
+		which is used by ISceneCollisionManager::getCollisionPoint().
+		The selector is not attached to the scene node, you will have to
+		call ISceneNode::setTriangleSelector() for this.
+		\param mesh: Mesh of which the triangles are taken.
+		\param node: Scene node of which visibility and transformation is used.
+		\param maximalPolysPerLeaf: Leaves of the hierarchy have at most this
+		many triangles, unless splitting them does not help.
+		\return The selector, or null if not successful.
+		If you no longer need the selector, you should call ITriangleSelector::drop().
+		See IReferenceCounted::drop() for more information. */
+		virtual ITriangleSelector* createBVHTriangleSelector(IMesh* mesh,
+			ISceneNode* node, s32 maximalPolysPerLeaf=4) = 0;
+
+		//! Creates a Triangle Selector with a bounding volume hierarchy over the current frame of an animated mesh scene node.
+		/** The hierarchy is built once from the frame the node shows
+		when the selector is created. When the frame number of the node
+		has changed, the triangles of the new frame are fetched and only
+		the boxes of the hierarchy are fitted around them again, which is
+		much cheaper than building it again. Nothing is done while the
+		frame number stays the same. The hierarchy gets worse when the
+		animation moves triangles far from where they were, so create
+		the selector in a typical pose. The mesh must keep the same
+		triangles in all frames, like skinned and morphed meshes do.
+		The selector is not attached to the scene node, you will have to
+		call ISceneNode::setTriangleSelector() for this.
+		\param node: The animated mesh scene node from which to build
+		the selector. It must have a mesh.
+		\param maximalPolysPerLeaf: Leaves of the hierarchy have at most this
+		many triangles, unless splitting them does not help.
+		\return The selector, or null if not successful.
+		If you no longer need the selector, you should call ITriangleSelector::drop().
+		See IReferenceCounted::drop() for more information. */
+		virtual ITriangleSelector* createBVHTriangleSelector(IAnimatedMeshSceneNode* node,
+			s32 maximalPolysPerLeaf=4) = 0;
+
 		//! Creates a meta triangle selector.
 		/** A meta triangle selector is nothing more than a
 		collection of one or more triangle selectors providing together
@@ -1653,6 +1740,29 @@ namespace scene
 		\return True if node is not visible in the current scene, else
 		false. */
 		virtual bool isCulled(const ISceneNode* node) const =0;
+
+		//! Get statistics about the render queue of the last drawAll() call.
+		/** Shows how many nodes were drawn in the sorted passes and how
+		often the material type and texture changed between the sorted
+		solid nodes. */
+		virtual const SRenderQueueStatistics& getRenderQueueStatistics() const =0;
+
+		//! Get statistics about one of the last frames drawn by drawAll().
+		/** The scene manager keeps the statistics of the last frames in
+		a ring buffer, see setRenderStatisticsHistorySize().
+		\param framesAgo 0 for the last frame, 1 for the frame before
+		and so on.
+		\return Pointer to the statistics, or 0 if the frame is not in
+		the history. The pointer is valid until the next drawAll() call. */
+		virtual const SRenderStatistics* getRenderStatistics(u32 framesAgo=0) const =0;
+
+		//! Set how many frames are kept in the render statistics history.
+		/** Clears the history. The default is 64 frames.
+		\param frames Amount of frames, at least 1. */
+		virtual void setRenderStatisticsHistorySize(u32 frames) =0;
+
+		//! Get how many frames are kept in the render statistics history.
+		virtual u32 getRenderStatisticsHistorySize() const =0;
 	};
 
 
@@ -69,8 +69,38 @@ namespace scene
 		virtual void animateMesh(f32 frame, f32 blend)=0;
 
 		//! Preforms a software skin on this mesh based of joint positions
+		/** The vertex weights are gathered into a table with up to
+		four joint influences per vertex when the mesh is prepared for
+		skinning, later changes of the weights are not used. */
 		virtual void skinMesh() = 0;
 
+		//! Skins the vertices on several threads.
+		/** Software skinning is split into blocks of vertices which are
+		skinned on one thread per processor core. All meshes share the
+		same worker threads. Only worth it for meshes with thousands of
+		vertices. Only available with _IRR_COMPILE_WITH_THREADS_,
+		default is false. */
+		virtual void setParallelSkinning(bool on) = 0;
+
+		//! Keeps the skinned poses of animated frames for reuse.
+		/** Scene nodes sharing this mesh animate and skin it again
+		for each node. With the pose cache, animateMesh with a blend
+		of 1 restores the joints and skinned vertices of a frame which
+		was skinned before, and skinMesh does nothing. Blended frames
+		depend on the previous pose and are not cached. Joints must not
+		be changed by hand between animateMesh and skinMesh while the
+		cache is used. Without hardware skinning only.
+		\param budget Memory for the cached poses in bytes. The least
+		recently used poses are removed when it is exceeded. 0 disables
+		the cache, which is the default.
+		\param frameQuantum If larger than 0, frames are rounded to
+		multiples of it before they are animated. Larger values give
+		more cache hits and less smooth animation. */
+		virtual void setPoseCache(u32 budget, f32 frameQuantum=0.f) = 0;
+
+		//! Removes all poses from the pose cache
+		virtual void clearPoseCache() = 0;
+
 		//! converts the vertex type of all meshbuffers to tangents.
 		/** E.g. used for bump mapping. */
 		virtual void convertMeshToTangents() = 0;
@@ -94,7 +124,6 @@ namespace scene
 		private:
 			//! Internal members used by CSkinnedMesh
 			friend class CSkinnedMesh;
-			bool *Moved;
 			core::vector3df StaticPos;
 			core::vector3df StaticNormal;
 		};
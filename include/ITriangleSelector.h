@@ -98,6 +98,40 @@ public:
 		s32& outTriangleCount, const core::line3d<f32>& line,
 		const core::matrix4* transform=0) const = 0;
 
+	//! Check if the selector finds collision points by itself.
+	/** \return True if getCollisionPoint() is implemented. Otherwise
+	the triangles from getTriangles() have to be tested. */
+	virtual bool hasCollisionPointQuery() const { return false; }
+
+	//! Get the nearest triangle hit by a 3d line.
+	/** Only implemented by selectors for which
+	hasCollisionPointQuery() returns true, e.g. the selector from
+	ISceneManager::createBVHTriangleSelector(). They search the
+	triangles without copying them.
+	\param ray Line with which the triangles are tested.
+	\param outIntersection The nearest collision point on the line.
+	\param outTriangle The hit triangle, in world coordinates.
+	\param outNode The scene node associated with the hit triangle.
+	\return True if a triangle was hit. */
+	virtual bool getCollisionPoint(const core::line3d<f32>& ray,
+		core::vector3df& outIntersection, core::triangle3df& outTriangle,
+		ISceneNode*& outNode) const
+	{
+		return false;
+	}
+
+	//! Get a box around all triangles of this selector, in world space.
+	/** Used by IMetaTriangleSelector to skip selectors which can't
+	have triangles in the box or line of a query.
+	\param outBox Set to a box containing all triangles which
+	getTriangles() can return without a transform.
+	\return False if the selector can't give a box, it is then always
+	queried. */
+	virtual bool getTransformedBoundingBox(core::aabbox3df& outBox) const
+	{
+		return false;
+	}
+
 	//! Get scene node associated with a given triangle.
 	/**
 	This allows to find which scene node (potentially of several) is
@@ -384,6 +384,22 @@ namespace video
 		IReferenceCounted::drop() for more information. */
 		virtual ITexture* getTexture(io::IReadFile* file) =0;
 
+		//! Loads several textures at once.
+		/** Works like calling getTexture() for each file, but decodes the
+		images on several threads. Only the textures are created one after
+		another, on the calling thread. Textures which are loaded already
+		are skipped. Files which are not in memory already are read on the
+		calling thread first, because archives share one file handle.
+		\param filenames Names of the texture files.
+		\param threadCount Number of threads which decode the images,
+		including the calling thread. 0 uses one thread per processor core.
+		\param memoryLimit Approximate limit in bytes for the memory of the
+		files and images which wait for their textures. Longer lists are
+		loaded in several batches then. 0 means no limit.
+		\return True if all textures could be loaded, otherwise false. */
+		virtual bool preloadTextures(const core::array<io::path>& filenames,
+				u32 threadCount=0, u32 memoryLimit=0) =0;
+
 		//! Returns a texture by index
 		/** \param index: Index of the texture, must be smaller than
 		getTextureCount() Please note that this index might change when
@@ -1033,6 +1049,15 @@ namespace video
 		/** \param mb Buffer to draw */
 		virtual void drawMeshBuffer(const scene::IMeshBuffer* mb) =0;
 
+		//! Draws the first triangles of a mesh buffer
+		/** The hardware buffers of the mesh buffer are used and updated
+		as a whole, so indices can stay on the graphics card while the
+		number of drawn triangles changes, e.g. for particle systems.
+		\param mb Buffer to draw
+		\param primitiveCount Number of triangles to draw, from the
+		start of the index list. At most getIndexCount()/3 are drawn. */
+		virtual void drawMeshBuffer(const scene::IMeshBuffer* mb, u32 primitiveCount) =0;
+
 		//! Draws normals of a mesh buffer
 		/** \param mb Buffer to draw the normals of
 		\param length length scale factor of the normals
@@ -167,6 +167,35 @@
 #undef _IRR_COMPILE_WITH_LEAK_HUNTER_
 #endif
 
+//! Define _IRR_COMPILE_WITH_THREADS_ to allow the engine to spread work over several CPU cores.
+/** Worker threads use pthreads on posix systems and the Win32 thread API (Vista and later)
+on Windows. All features using worker threads are opt-in, and they simply run on the calling
+thread when this define is disabled. Posix applications might have to link with -lpthread. */
+#if defined(_IRR_POSIX_API_) || defined(_IRR_OSX_PLATFORM_) || defined(_IRR_ANDROID_PLATFORM_) || (defined(_IRR_WINDOWS_) && !defined(_IRR_WINDOWS_CE_PLATFORM_))
+#define _IRR_COMPILE_WITH_THREADS_
+#endif
+#ifdef NO_IRR_COMPILE_WITH_THREADS_
+#undef _IRR_COMPILE_WITH_THREADS_
+#endif
+
+//! Define _IRR_COMPILE_WITH_SSE2_ to use SSE2 intrinsics in some CPU heavy code, like software skinning.
+/** Enabled when the compiler generates SSE2 code anyway, which is always the case for x86-64. */
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#define _IRR_COMPILE_WITH_SSE2_
+#endif
+#ifdef NO_IRR_COMPILE_WITH_SSE2_
+#undef _IRR_COMPILE_WITH_SSE2_
+#endif
+
+//! Define _IRR_COMPILE_WITH_MAPPED_FILES_ to map large files into memory instead of reading them with stdio.
+/** Loaders which support it parse such files without copying them, see IReadFile::getBuffer(). */
+#if defined(_IRR_POSIX_API_) || defined(_IRR_OSX_PLATFORM_) || defined(_IRR_ANDROID_PLATFORM_) || (defined(_IRR_WINDOWS_) && !defined(_IRR_WINDOWS_CE_PLATFORM_))
+#define _IRR_COMPILE_WITH_MAPPED_FILES_
+#endif
+#ifdef NO_IRR_COMPILE_WITH_MAPPED_FILES_
+#undef _IRR_COMPILE_WITH_MAPPED_FILES_
+#endif
+
 //! Define _IRR_COMPILE_WITH_DIRECT3D_8_ and _IRR_COMPILE_WITH_DIRECT3D_9_ to
 //! compile the Irrlicht engine with Direct3D8 and/or DIRECT3D9.
 /** If you only want to use the software device or opengl you can disable those defines.
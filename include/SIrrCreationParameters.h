@@ -281,7 +281,8 @@ namespace irr
 		//! Create the driver multithreaded.
 		/** Default is false. Enabling this can slow down your application.
 			Note that this does _not_ make Irrlicht threadsafe, but only the underlying driver-API for the graphiccard.
-			So far only supported on D3D. */
+			Supported on D3D. Burning's Video uses it to rasterize with one thread per processor core,
+			when the engine was compiled with _IRR_COMPILE_WITH_THREADS_. */
 		bool DriverMultithreaded;
 
 		//! Enables use of high performance timers on Windows platform.
@@ -49,6 +49,98 @@ namespace scene
 	};
 
 
+	//! Particles stored in one array for each member of SParticle
+	/** Used by particle systems with the storage EPS_ARRAYS, see
+	IParticleSystemSceneNode::setParticleStorage(). All arrays are 16
+	byte aligned and have room for Count rounded up to a multiple of 4,
+	so SIMD code can always process 4 particles at once. The values of
+	the particles behind Count are undefined and can be overwritten. */
+	struct SParticleArrays
+	{
+		SParticleArrays() : PosX(0), PosY(0), PosZ(0),
+			VectorX(0), VectorY(0), VectorZ(0),
+			StartVectorX(0), StartVectorY(0), StartVectorZ(0),
+			StartTime(0), EndTime(0), Color(0), StartColor(0),
+			Width(0), Height(0), StartWidth(0), StartHeight(0), Count(0)
+		{
+		}
+
+		//! Copies a particle out of the arrays
+		void getParticle(u32 i, SParticle& out) const
+		{
+			out.pos.set(PosX[i], PosY[i], PosZ[i]);
+			out.vector.set(VectorX[i], VectorY[i], VectorZ[i]);
+			out.startVector.set(StartVectorX[i], StartVectorY[i], StartVectorZ[i]);
+			out.startTime = StartTime[i];
+			out.endTime = EndTime[i];
+			out.color = Color[i];
+			out.startColor = StartColor[i];
+			out.size.set(Width[i], Height[i]);
+			out.startSize.set(StartWidth[i], StartHeight[i]);
+		}
+
+		//! Copies a particle into the arrays
+		void setParticle(u32 i, const SParticle& particle)
+		{
+			PosX[i] = particle.pos.X;
+			PosY[i] = particle.pos.Y;
+			PosZ[i] = particle.pos.Z;
+			VectorX[i] = particle.vector.X;
+			VectorY[i] = particle.vector.Y;
+			VectorZ[i] = particle.vector.Z;
+			StartVectorX[i] = particle.startVector.X;
+			StartVectorY[i] = particle.startVector.Y;
+			StartVectorZ[i] = particle.startVector.Z;
+			StartTime[i] = particle.startTime;
+			EndTime[i] = particle.endTime;
+			Color[i] = particle.color;
+			StartColor[i] = particle.startColor;
+			Width[i] = particle.size.Width;
+			Height[i] = particle.size.Height;
+			StartWidth[i] = particle.startSize.Width;
+			StartHeight[i] = particle.startSize.Height;
+		}
+
+		//! Position of the particles
+		f32* PosX;
+		f32* PosY;
+		f32* PosZ;
+
+		//! Direction and speed of the particles
+		f32* VectorX;
+		f32* VectorY;
+		f32* VectorZ;
+
+		//! Original direction and speed of the particles
+		f32* StartVectorX;
+		f32* StartVectorY;
+		f32* StartVectorZ;
+
+		//! Start life time of the particles
+		u32* StartTime;
+
+		//! End life time of the particles
+		u32* EndTime;
+
+		//! Current color of the particles
+		video::SColor* Color;
+
+		//! Original color of the particles
+		video::SColor* StartColor;
+
+		//! Current scale of the particles
+		f32* Width;
+		f32* Height;
+
+		//! Original scale of the particles
+		f32* StartWidth;
+		f32* StartHeight;
+
+		//! Number of particles in the arrays
+		u32 Count;
+	};
+
+
 } // end namespace scene
 } // end namespace irr
 
@@ -0,0 +1,195 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __S_RENDER_STATISTICS_H_INCLUDED__
+#define __S_RENDER_STATISTICS_H_INCLUDED__
+
+#include "irrTypes.h"
+
+namespace irr
+{
+namespace scene
+{
+
+	//! Statistics of the render queue of the scene manager for the last drawn frame.
+	/** All nodes which are drawn in the sky box, solid, shadow, transparent
+	and transparent effect passes are sorted in a single render queue.
+	Solid nodes are sorted by material type, then by texture and then from
+	front to back. Transparent nodes are sorted from back to front.
+	The counters show how well the sort order grouped the render states.
+	\see ISceneManager::getRenderQueueStatistics() */
+	struct SRenderQueueStatistics
+	{
+		SRenderQueueStatistics()
+		{
+			reset();
+		}
+
+		//! Sets all counters to 0.
+		void reset()
+		{
+			Nodes = 0;
+			SkyBoxNodes = 0;
+			SolidNodes = 0;
+			ShadowNodes = 0;
+			TransparentNodes = 0;
+			TransparentEffectNodes = 0;
+			MaterialTypeChanges = 0;
+			TextureChanges = 0;
+			SortPasses = 0;
+		}
+
+		//! Number of nodes in the queue
+		u32 Nodes;
+
+		//! Number of nodes in the sky box pass
+		u32 SkyBoxNodes;
+
+		//! Number of nodes in the solid pass
+		u32 SolidNodes;
+
+		//! Number of nodes in the shadow pass
+		u32 ShadowNodes;
+
+		//! Number of nodes in the transparent pass
+		u32 TransparentNodes;
+
+		//! Number of nodes in the transparent effect pass
+		u32 TransparentEffectNodes;
+
+		//! How often the material type of the first material changes between sorted solid nodes
+		u32 MaterialTypeChanges;
+
+		//! How often the first texture changes between sorted solid nodes
+		u32 TextureChanges;
+
+		//! Number of 8 bit radix sort passes done over the queue.
+		/** Passes over key bytes which are equal for all nodes are skipped. */
+		u32 SortPasses;
+	};
+
+
+	//! Statistics of one frame drawn by ISceneManager::drawAll().
+	/** Replaces the "calls", "culled" and "drawn_*" attributes which older
+	versions kept in the scene manager parameters. All times are measured
+	with the real time clock and given in microseconds.
+	\see ISceneManager::getRenderStatistics() */
+	struct SRenderStatistics
+	{
+		SRenderStatistics()
+		{
+			reset();
+		}
+
+		//! Sets all counters and times to 0.
+		void reset()
+		{
+			Frame = 0;
+			RegisteredNodes = 0;
+			CulledNodes = 0;
+			CulledByOcclusionQuery = 0;
+			CulledByBox = 0;
+			CulledByFrustumBox = 0;
+			Cameras = 0;
+			Lights = 0;
+			DrawnSkyBoxNodes = 0;
+			DrawnSolidNodes = 0;
+			DrawnShadowNodes = 0;
+			DrawnTransparentNodes = 0;
+			DrawnTransparentEffectNodes = 0;
+			AnimateTime = 0;
+			RegisterTime = 0;
+			SortTime = 0;
+			CameraPassTime = 0;
+			LightPassTime = 0;
+			SkyBoxPassTime = 0;
+			SolidPassTime = 0;
+			ShadowPassTime = 0;
+			TransparentPassTime = 0;
+			TransparentEffectPassTime = 0;
+			TotalTime = 0;
+			RenderQueue.reset();
+		}
+
+		//! Number of the frame, counts the calls of drawAll()
+		u32 Frame;
+
+		//! Number of calls to ISceneManager::registerNodeForRendering()
+		u32 RegisteredNodes;
+
+		//! Number of registrations which were rejected, mostly because the node was culled
+		u32 CulledNodes;
+
+		//! Number of nodes culled by their occlusion query, see EAC_OCC_QUERY
+		u32 CulledByOcclusionQuery;
+
+		//! Number of nodes culled by the bounding box of the view frustum, see EAC_BOX
+		u32 CulledByBox;
+
+		//! Number of nodes culled by the planes of the view frustum, see EAC_FRUSTUM_BOX
+		u32 CulledByFrustumBox;
+
+		//! Number of cameras rendered
+		u32 Cameras;
+
+		//! Number of lights registered
+		u32 Lights;
+
+		//! Number of nodes drawn in the sky box pass
+		u32 DrawnSkyBoxNodes;
+
+		//! Number of nodes drawn in the solid pass
+		u32 DrawnSolidNodes;
+
+		//! Number of nodes drawn in the shadow pass
+		u32 DrawnShadowNodes;
+
+		//! Number of nodes drawn in the transparent pass
+		u32 DrawnTransparentNodes;
+
+		//! Number of nodes drawn in the transparent effect pass
+		u32 DrawnTransparentEffectNodes;
+
+		//! Time spent animating the scene nodes
+		u32 AnimateTime;
+
+		//! Time spent registering and culling the scene nodes
+		u32 RegisterTime;
+
+		//! Time spent sorting the render queue
+		u32 SortTime;
+
+		//! Time spent in the camera pass
+		u32 CameraPassTime;
+
+		//! Time spent in the light pass
+		u32 LightPassTime;
+
+		//! Time spent in the sky box pass
+		u32 SkyBoxPassTime;
+
+		//! Time spent in the solid pass
+		u32 SolidPassTime;
+
+		//! Time spent in the shadow pass, including the stencil shadow
+		u32 ShadowPassTime;
+
+		//! Time spent in the transparent pass
+		u32 TransparentPassTime;
+
+		//! Time spent in the transparent effect pass
+		u32 TransparentEffectPassTime;
+
+		//! Time spent in drawAll()
+		u32 TotalTime;
+
+		//! Statistics of the render queue of this frame
+		SRenderQueueStatistics RenderQueue;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
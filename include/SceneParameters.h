@@ -174,6 +174,37 @@ namespace scene
 	**/
 	const c8* const DEBUG_NORMAL_COLOR = "DEBUG_Normal_Color";
 
+	//! Name of the parameter for culling the scene nodes on several threads.
+	/** When enabled, nodes registering for the solid, transparent,
+	transparent effect, automatic or shadow pass are culled after all nodes
+	called registerNodeForRendering(). The culling tests run on one thread
+	per processor core. The render lists are filled in registration order,
+	so the rendering result is the same. registerNodeForRendering() returns
+	1 for those passes then, as the culling result is not known yet.
+	Animation and registration itself still run on the calling thread.
+	isCulled() must be safe to call from several threads at once for all
+	registered nodes, which is the case for all engine scene nodes.
+	Only available with _IRR_COMPILE_WITH_THREADS_, default is false.
+	Use it like this:
+	\code
+	SceneManager->getParameters()->setAttribute(scene::PARALLEL_CULLING, true);
+	\endcode
+	**/
+	const c8* const PARALLEL_CULLING = "Parallel_Culling";
+
+	//! Name of the parameter for sharing the adjacency of shadow meshes.
+	/** When enabled, shadow volume scene nodes using the same shadow mesh
+	share its face adjacency, so it is only calculated once. Only enable it
+	when the index buffers of shared shadow meshes do not change. The
+	adjacency is calculated again when the amount of vertices or indices
+	changes. Default is false.
+	Use it like this:
+	\code
+	SceneManager->getParameters()->setAttribute(scene::SHADOW_ADJACENCY_CACHE, true);
+	\endcode
+	**/
+	const c8* const SHADOW_ADJACENCY_CACHE = "Shadow_Adjacency_Cache";
+
 
 } // end namespace scene
 } // end namespace irr
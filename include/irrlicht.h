@@ -57,6 +57,7 @@
 #include "IAnimatedMeshMD2.h"
 #include "IAnimatedMeshMD3.h"
 #include "IAnimatedMeshSceneNode.h"
+#include "IAsyncLoader.h"
 #include "IAttributeExchangingObject.h"
 #include "IAttributes.h"
 #include "IBillboardSceneNode.h"
@@ -116,6 +117,7 @@
 #include "IColladaMeshWriter.h"
 #include "IMetaTriangleSelector.h"
 #include "IOSOperator.h"
+#include "IPagedTerrainSceneNode.h"
 #include "IParticleSystemSceneNode.h" // also includes all emitters and attractors
 #include "IQ3LevelMesh.h"
 #include "IQ3Shader.h"
@@ -180,6 +182,7 @@
 #include "SMeshBufferLightMap.h"
 #include "SMeshBufferTangents.h"
 #include "SParticle.h"
+#include "SRenderStatistics.h"
 #include "SSharedMeshBuffer.h"
 #include "SSkinMeshBuffer.h"
 #include "SVertexIndex.h"
@@ -66,6 +66,7 @@ LOCAL_SRC_FILES := \
 					CDMFLoader.cpp \
 					CDummyTransformationSceneNode.cpp \
 					CEmptySceneNode.cpp \
+					CFileArchiveIndex.cpp \
 					CFileList.cpp \
 					CFileSystem.cpp \
 					CFPSCounter.cpp \
@@ -130,11 +131,14 @@ LOCAL_SRC_FILES := \
 					CLimitReadFile.cpp \
 					CLMTSMeshFileLoader.cpp \
 					CLogger.cpp \
+					CQueuedLogger.cpp \
 					CLWOMeshFileLoader.cpp \
 					CMD2MeshFileLoader.cpp \
 					CMD3MeshFileLoader.cpp \
+					CMappedReadFile.cpp \
 					CMemoryFile.cpp \
 					CMeshCache.cpp \
+					CAsyncLoader.cpp \
 					CMeshManipulator.cpp \
 					CMeshSceneNode.cpp \
 					CMetaTriangleSelector.cpp \
@@ -148,6 +152,7 @@ LOCAL_SRC_FILES := \
 					COCTLoader.cpp \
 					COctreeSceneNode.cpp \
 					COctreeTriangleSelector.cpp \
+					CBVHTriangleSelector.cpp \
 					CEGLManager.cpp \
 					COGLES2Driver.cpp \
 					COGLES2ExtensionHandler.cpp \
@@ -187,6 +192,7 @@ LOCAL_SRC_FILES := \
 					CPLYMeshWriter.cpp \
 					CQ3LevelMesh.cpp \
 					CQuake3ShaderSceneNode.cpp \
+					CRenderQueue.cpp \
 					CReadFile.cpp \
 					CSceneCollisionManager.cpp \
 					CSceneLoaderIrr.cpp \
@@ -213,6 +219,7 @@ LOCAL_SRC_FILES := \
 					CSTLMeshFileLoader.cpp \
 					CSTLMeshWriter.cpp \
 					CTarReader.cpp \
+					CPagedTerrainSceneNode.cpp \
 					CTerrainSceneNode.cpp \
 					CTerrainTriangleSelector.cpp \
 					CTextSceneNode.cpp \
@@ -252,6 +259,7 @@ LOCAL_SRC_FILES := \
 					CVolumeLightSceneNode.cpp \
 					CWADReader.cpp \
 					CWaterSurfaceSceneNode.cpp \
+					CWorkerPool.cpp \
 					CWriteFile.cpp \
 					CXMeshFileLoader.cpp \
 					CXMLReader.cpp \
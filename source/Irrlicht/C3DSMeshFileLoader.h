@@ -38,6 +38,9 @@ public:
 	//! See IReferenceCounted::drop() for more information.
 	virtual IAnimatedMesh* createMesh(io::IReadFile* file);
 
+	//! Returns true if createMesh() may be called on a background thread.
+	virtual bool canLoadInBackground() const { return true; }
+
 private:
 
 // byte-align structures
@@ -0,0 +1,518 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CAsyncLoader.h"
+#include "ISceneManager.h"
+#include "IMeshCache.h"
+#include "IMeshLoader.h"
+#include "IAnimatedMesh.h"
+#include "IFileSystem.h"
+#include "IReadFile.h"
+#include "IImage.h"
+#include "ITexture.h"
+#include "os.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! constructor
+CAsyncLoader::CAsyncLoader(ISceneManager* smgr, video::IVideoDriver* driver, io::IFileSystem* fs)
+: SceneManager(smgr), Driver(driver), FileSystem(fs), LoadFinishedCallback(0),
+	Queue(0), HandlesTextures(false), ExecutedCount(0),
+	MeshLoadersLocked(false), Quit(false), MainThreadLocks(0)
+{
+	#ifdef _DEBUG
+	setDebugName("CAsyncLoader");
+	#endif
+}
+
+
+//! destructor, cancels the pending loads
+CAsyncLoader::~CAsyncLoader()
+{
+	if (Queue)
+	{
+		// the running load gets no more answers
+		Lock.lock();
+		Quit = true;
+		Lock.unlock();
+		handleRequests();
+
+		// waits for the running load
+		Queue->drop();
+	}
+
+	// all drivers are derived from CNullDriver
+	if (HandlesTextures)
+		static_cast<video::CNullDriver*>(Driver)->setTextureRequestHandler(0);
+
+	ThreadLogger.flush();
+
+	for (u32 i=0; i<Pending.size(); ++i)
+	{
+		Pending[i]->State = EALS_FAILED;
+		Pending[i]->drop();
+	}
+
+	if (LoadFinishedCallback)
+		LoadFinishedCallback->drop();
+}
+
+
+//! Starts loading a mesh
+IAsyncLoad* CAsyncLoader::loadMesh(const io::path& filename)
+{
+	CLoad* load = new CLoad(this, filename, true);
+
+	load->Mesh = SceneManager->getMeshCache()->getMeshByName(filename);
+	if (load->Mesh)
+	{
+		load->Mesh->grab();
+		start(load, false);
+		return load;
+	}
+
+	// textures of mesh loaders on the loader thread have to be created by
+	// the main thread, a driver only forwards them to one loader though
+	if (!HandlesTextures && Driver &&
+		!static_cast<video::CNullDriver*>(Driver)->getTextureRequestHandler())
+	{
+		static_cast<video::CNullDriver*>(Driver)->setTextureRequestHandler(this);
+		HandlesTextures = true;
+	}
+
+	load->LoadOnMainThread = !HandlesTextures;
+	start(load, !load->LoadOnMainThread);
+	return load;
+}
+
+
+//! Starts loading a texture
+IAsyncLoad* CAsyncLoader::loadTexture(const io::path& filename)
+{
+	CLoad* load = new CLoad(this, filename, false);
+
+	if (Driver)
+	{
+		load->Texture = Driver->findTexture(FileSystem->getAbsolutePath(filename));
+		if (!load->Texture)
+			load->Texture = Driver->findTexture(filename);
+	}
+
+	if (load->Texture)
+		load->Texture->grab();
+
+	start(load, Driver && !load->Texture);
+	return load;
+}
+
+
+//! adds a load to the pending ones, and starts it if needed
+void CAsyncLoader::start(CLoad* load, bool needsThread)
+{
+	Pending.push_back(load);
+	load->grab();
+
+	if (!needsThread)
+	{
+		load->Executed = true;
+		return;
+	}
+
+	if (!Queue)
+		Queue = new CWorkerQueue(1);
+	Queue->enqueue(load, 0);
+}
+
+
+//! Finishes the loads which were done in the background
+void CAsyncLoader::update()
+{
+	handleRequests();
+	ThreadLogger.flush();
+
+	// the loads tell about their end themselves
+	IWorkerJob* job;
+	u32 item;
+	if (Queue)
+	{
+		while (Queue->popFinished(job, item))
+			;
+	}
+
+	core::array<CLoad*> finished;
+	Lock.lock();
+	for (u32 i=0; i<Pending.size();)
+	{
+		if (Pending[i]->Executed)
+		{
+			finished.push_back(Pending[i]);
+			Pending.erase(i);
+		}
+		else
+			++i;
+	}
+	Lock.unlock();
+
+	for (u32 i=0; i<finished.size(); ++i)
+		finish(finished[i]);
+
+	// the callback may start or wait for other loads
+	for (u32 i=0; i<finished.size(); ++i)
+	{
+		if (LoadFinishedCallback)
+			LoadFinishedCallback->OnLoadFinished(finished[i]);
+		finished[i]->drop();
+	}
+}
+
+
+//! Blocks until a load has finished
+void CAsyncLoader::wait(IAsyncLoad* load)
+{
+	while (true)
+	{
+		Lock.lock();
+		const u32 executed = ExecutedCount;
+		Lock.unlock();
+
+		update();
+
+		if (load ? load->getState() != EALS_LOADING : Pending.empty())
+			return;
+
+		// the loader thread either ends a load or needs a texture
+		Lock.lock();
+		while (ExecutedCount == executed && Requests.empty())
+			Lock.wait();
+		Lock.unlock();
+	}
+}
+
+
+//! Get the number of loads which have not finished yet
+u32 CAsyncLoader::getPendingCount() const
+{
+	return Pending.size();
+}
+
+
+//! Sets a callback interface which will be called when a load has finished.
+void CAsyncLoader::setLoadFinishedCallback(IAsyncLoadFinishedCallBack* callback)
+{
+	if (callback == LoadFinishedCallback)
+		return;
+
+	if (LoadFinishedCallback)
+		LoadFinishedCallback->drop();
+
+	LoadFinishedCallback = callback;
+
+	if (LoadFinishedCallback)
+		LoadFinishedCallback->grab();
+}
+
+
+//! Returns true if called from the loader thread
+bool CAsyncLoader::isBackgroundThread() const
+{
+	return Queue && Queue->isWorkerThread();
+}
+
+
+//! Gets a texture from the main thread, waits until it's there
+video::ITexture* CAsyncLoader::requestTexture(const io::path& filename, io::IReadFile* file)
+{
+	STextureRequest request;
+	request.Name = filename;
+	readTexture(request, file);
+
+	STextureCall textureCall(this, request);
+	callOnMainThread(textureCall);
+
+	if (request.Image)
+		request.Image->drop();
+
+	return request.Texture;
+}
+
+
+//! Executes a call on the main thread, waits until it's done
+void CAsyncLoader::callOnMainThread(video::IMainThreadCall& call)
+{
+	SCallRequest request;
+	request.Call = &call;
+	request.Done = false;
+
+	Lock.lock();
+	if (!Quit)
+	{
+		Requests.push_back(&request);
+		Lock.notify();
+		while (!request.Done)
+			Lock.wait();
+	}
+	Lock.unlock();
+}
+
+
+//! Reserves the mesh loaders for the calling thread
+void CAsyncLoader::lockMeshLoaders()
+{
+	const bool mainThread = !isBackgroundThread();
+	if (mainThread && MainThreadLocks++)
+		return;
+
+	Lock.lock();
+	while (MeshLoadersLocked)
+	{
+		// the loader thread may wait for a texture
+		if (mainThread && !Requests.empty())
+		{
+			Lock.unlock();
+			handleRequests();
+			Lock.lock();
+		}
+		else
+			Lock.wait();
+	}
+	MeshLoadersLocked = true;
+	Lock.unlock();
+}
+
+
+//! Releases the mesh loaders again
+void CAsyncLoader::unlockMeshLoaders()
+{
+	if (!isBackgroundThread() && --MainThreadLocks)
+		return;
+
+	Lock.lock();
+	MeshLoadersLocked = false;
+	Lock.notify();
+	Lock.unlock();
+}
+
+
+//! loads the file of a load, on the loader thread
+void CAsyncLoader::execute(CLoad* load)
+{
+	os::Printer::setThreadLogger(&ThreadLogger);
+
+	if (load->IsMesh)
+		readMesh(load);
+	else
+		readTexture(load->Request, 0);
+
+	os::Printer::setThreadLogger(0);
+
+	Lock.lock();
+	load->Executed = true;
+	++ExecutedCount;
+	Lock.notify();
+	Lock.unlock();
+}
+
+
+//! loads a mesh with the first matching mesh loader, on the loader thread
+void CAsyncLoader::readMesh(CLoad* load)
+{
+	io::IReadFile* file = FileSystem->createAndOpenFile(load->FileName);
+	if (!file)
+	{
+		os::Printer::log("Could not load mesh, because file could not be opened: ", load->FileName, ELL_ERROR);
+		return;
+	}
+
+	lockMeshLoaders();
+
+	// iterate the list in reverse order so user-added loaders can override the built-in ones
+	for (s32 i=SceneManager->getMeshLoaderCount()-1; i>=0; --i)
+	{
+		IMeshLoader* loader = SceneManager->getMeshLoader(i);
+		if (loader->isALoadableFileExtension(load->FileName))
+		{
+			// the main thread uses this loader in update()
+			if (!loader->canLoadInBackground())
+			{
+				load->LoadOnMainThread = true;
+				break;
+			}
+
+			// reset file to avoid side effects of previous calls to createMesh
+			file->seek(0);
+			load->Mesh = loader->createMesh(file);
+			if (load->Mesh)
+				break;
+		}
+	}
+
+	unlockMeshLoaders();
+	file->drop();
+
+	if (!load->Mesh && !load->LoadOnMainThread)
+		os::Printer::log("Could not load mesh, file format seems to be unsupported", load->FileName, ELL_ERROR);
+}
+
+
+//! opens and decodes a texture file, on the loader thread
+void CAsyncLoader::readTexture(STextureRequest& request, io::IReadFile* file)
+{
+	if (file)
+		file->grab();
+	else
+	{
+		// like CNullDriver::getTexture()
+		request.AbsolutePath = FileSystem->getAbsolutePath(request.Name);
+		file = FileSystem->createAndOpenFile(request.AbsolutePath);
+		if (!file)
+			file = FileSystem->createAndOpenFile(request.Name);
+	}
+
+	if (file)
+	{
+		request.FileName = file->getFileName();
+		request.Image = Driver->createImageFromFile(file);
+		file->drop();
+	}
+}
+
+
+//! creates the texture of a request, on the main thread
+video::ITexture* CAsyncLoader::createTexture(STextureRequest& request)
+{
+	video::ITexture* texture = 0;
+	if (request.AbsolutePath.size())
+		texture = Driver->findTexture(request.AbsolutePath);
+	if (!texture && request.Name.size())
+		texture = Driver->findTexture(request.Name);
+	if (!texture && request.FileName.size())
+		texture = Driver->findTexture(request.FileName);
+
+	// the texture was loaded while the image was decoded
+	if (texture)
+		return texture;
+
+	const io::path& name = request.Name.size() ? request.Name : request.FileName;
+	if (!request.FileName.size())
+		os::Printer::log("Could not open file of texture", name, ELL_WARNING);
+	else if (!request.Image)
+		os::Printer::log("Could not load texture", name, ELL_ERROR);
+	else
+	{
+		texture = Driver->addTexture(request.FileName, request.Image);
+		if (texture)
+			os::Printer::log("Loaded texture", request.FileName);
+	}
+
+	return texture;
+}
+
+
+//! adds the result of a load to the caches, on the main thread
+void CAsyncLoader::finish(CLoad* load)
+{
+	if (load->IsMesh)
+	{
+		IMeshCache* cache = SceneManager->getMeshCache();
+		if (load->LoadOnMainThread)
+		{
+			load->Mesh = SceneManager->getMesh(load->FileName);
+			if (load->Mesh)
+				load->Mesh->grab();
+		}
+		else if (load->Mesh && !cache->isMeshLoaded(load->FileName))
+		{
+			cache->addMesh(load->FileName, load->Mesh);
+			os::Printer::log("Loaded mesh", load->FileName, ELL_INFORMATION);
+		}
+		else if (load->Mesh && cache->getMeshByName(load->FileName) != load->Mesh)
+		{
+			// the mesh was loaded while this load was running
+			load->Mesh->drop();
+			load->Mesh = cache->getMeshByName(load->FileName);
+			load->Mesh->grab();
+		}
+
+		load->State = load->Mesh ? EALS_LOADED : EALS_FAILED;
+	}
+	else
+	{
+		if (!load->Texture && Driver)
+		{
+			load->Texture = createTexture(load->Request);
+			if (load->Texture)
+				load->Texture->grab();
+		}
+
+		if (load->Request.Image)
+		{
+			load->Request.Image->drop();
+			load->Request.Image = 0;
+		}
+
+		load->State = load->Texture ? EALS_LOADED : EALS_FAILED;
+	}
+}
+
+
+//! executes the calls which the loader thread waits for
+void CAsyncLoader::handleRequests()
+{
+	Lock.lock();
+	while (!Requests.empty())
+	{
+		core::list<SCallRequest*>::Iterator first = Requests.begin();
+		SCallRequest* request = *first;
+		Requests.erase(first);
+
+		if (!Quit)
+		{
+			Lock.unlock();
+			request->Call->call();
+			Lock.lock();
+		}
+
+		request->Done = true;
+		Lock.notify();
+	}
+	Lock.unlock();
+}
+
+
+CAsyncLoader::CLoad::CLoad(CAsyncLoader* loader, const io::path& filename, bool isMesh)
+: Loader(loader), FileName(filename), Mesh(0), Texture(0), State(EALS_LOADING),
+	IsMesh(isMesh), LoadOnMainThread(false), Executed(false)
+{
+	#ifdef _DEBUG
+	setDebugName("CAsyncLoader::CLoad");
+	#endif
+
+	Request.Name = filename;
+}
+
+
+CAsyncLoader::CLoad::~CLoad()
+{
+	if (Mesh)
+		Mesh->drop();
+	if (Texture)
+		Texture->drop();
+	if (Request.Image)
+		Request.Image->drop();
+}
+
+
+//! loads the file on the loader thread
+void CAsyncLoader::CLoad::execute(u32 item, u32 thread)
+{
+	Loader->execute(this);
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
@@ -0,0 +1,185 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_ASYNC_LOADER_H_INCLUDED__
+#define __C_ASYNC_LOADER_H_INCLUDED__
+
+#include "IAsyncLoader.h"
+#include "CNullDriver.h"
+#include "CWorkerPool.h"
+#include "CQueuedLogger.h"
+
+namespace irr
+{
+namespace io
+{
+	class IFileSystem;
+	class IReadFile;
+}
+namespace video
+{
+	class IImage;
+}
+namespace scene
+{
+	class ISceneManager;
+
+	//! Loads meshes and textures on a background thread.
+	/** The loads run one after another on the thread of a CWorkerQueue.
+	Textures requested by mesh loaders on that thread are decoded there,
+	and created by the main thread, see requestTexture(). Log messages of
+	the thread are queued and logged by update(). */
+	class CAsyncLoader : public IAsyncLoader, public video::ITextureRequestHandler
+	{
+	public:
+
+		//! constructor
+		CAsyncLoader(ISceneManager* smgr, video::IVideoDriver* driver, io::IFileSystem* fs);
+
+		//! destructor, cancels the pending loads
+		virtual ~CAsyncLoader();
+
+		//! Starts loading a mesh
+		virtual IAsyncLoad* loadMesh(const io::path& filename);
+
+		//! Starts loading a texture
+		virtual IAsyncLoad* loadTexture(const io::path& filename);
+
+		//! Finishes the loads which were done in the background
+		virtual void update();
+
+		//! Blocks until a load has finished
+		virtual void wait(IAsyncLoad* load=0);
+
+		//! Get the number of loads which have not finished yet
+		virtual u32 getPendingCount() const;
+
+		//! Sets a callback interface which will be called when a load has finished.
+		virtual void setLoadFinishedCallback(IAsyncLoadFinishedCallBack* callback=0);
+
+		//! Returns true if called from the loader thread
+		virtual bool isBackgroundThread() const;
+
+		//! Gets a texture from the main thread, waits until it's there
+		virtual video::ITexture* requestTexture(const io::path& filename, io::IReadFile* file);
+
+		//! Executes a call on the main thread, waits until it's done
+		virtual void callOnMainThread(video::IMainThreadCall& call);
+
+		//! Reserves the mesh loaders for the calling thread
+		/** Mesh loaders keep their state in members, so the main thread
+		and the loader thread must not use them at the same time. Used
+		by CSceneManager::getMesh(), may be nested on the main thread. */
+		void lockMeshLoaders();
+
+		//! Releases the mesh loaders again
+		void unlockMeshLoaders();
+
+	private:
+
+		//! a texture file which is read and decoded on the loader thread
+		struct STextureRequest
+		{
+			STextureRequest() : Image(0), Texture(0) {}
+
+			io::path Name;
+			io::path AbsolutePath;
+			io::path FileName;
+			video::IImage* Image;
+			video::ITexture* Texture;
+		};
+
+		//! creates the texture of a request on the main thread
+		struct STextureCall : public video::IMainThreadCall
+		{
+			STextureCall(CAsyncLoader* loader, STextureRequest& request)
+				: Loader(loader), Request(request) {}
+
+			virtual void call() { Request.Texture = Loader->createTexture(Request); }
+
+			CAsyncLoader* Loader;
+			STextureRequest& Request;
+		};
+
+		//! a call of the loader thread, waiting for the main thread
+		struct SCallRequest
+		{
+			video::IMainThreadCall* Call;
+			bool Done;
+		};
+
+		//! a mesh or texture load
+		class CLoad : public IAsyncLoad, public IWorkerJob
+		{
+		public:
+
+			CLoad(CAsyncLoader* loader, const io::path& filename, bool isMesh);
+			virtual ~CLoad();
+
+			virtual E_ASYNC_LOAD_STATE getState() const { return State; }
+			virtual const io::path& getFileName() const { return FileName; }
+			virtual IAnimatedMesh* getMesh() const { return State == EALS_LOADED ? Mesh : 0; }
+			virtual video::ITexture* getTexture() const { return State == EALS_LOADED ? Texture : 0; }
+
+			//! loads the file on the loader thread
+			virtual void execute(u32 item, u32 thread);
+
+			CAsyncLoader* Loader;
+			io::path FileName;
+			STextureRequest Request;
+			IAnimatedMesh* Mesh;
+			video::ITexture* Texture;
+			E_ASYNC_LOAD_STATE State;
+			bool IsMesh;
+			bool LoadOnMainThread;
+			bool Executed;
+		};
+
+		//! adds a load to the pending ones, and starts it if needed
+		void start(CLoad* load, bool needsThread);
+
+		//! loads the file of a load, on the loader thread
+		void execute(CLoad* load);
+
+		//! loads a mesh with the first matching mesh loader, on the loader thread
+		void readMesh(CLoad* load);
+
+		//! opens and decodes a texture file, on the loader thread
+		void readTexture(STextureRequest& request, io::IReadFile* file);
+
+		//! creates the texture of a request, on the main thread
+		video::ITexture* createTexture(STextureRequest& request);
+
+		//! adds the result of a load to the caches, on the main thread
+		void finish(CLoad* load);
+
+		//! executes the calls which the loader thread waits for
+		void handleRequests();
+
+		ISceneManager* SceneManager;
+		video::IVideoDriver* Driver;
+		io::IFileSystem* FileSystem;
+		IAsyncLoadFinishedCallBack* LoadFinishedCallback;
+		CWorkerQueue* Queue;
+		CQueuedLogger ThreadLogger;
+		bool HandlesTextures;
+
+		core::array<CLoad*> Pending;
+
+		// shared with the loader thread
+		CWorkerLock Lock;
+		core::list<SCallRequest*> Requests;
+		u32 ExecutedCount;
+		bool MeshLoadersLocked;
+		bool Quit;
+
+		// nesting of lockMeshLoaders() on the main thread
+		u32 MainThreadLocks;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
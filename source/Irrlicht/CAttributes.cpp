@@ -44,6 +44,7 @@ void CAttributes::clear()
 		Attributes[i]->drop();
 
 	Attributes.clear();
+	NameIndex.clear();
 }
 
 
@@ -52,23 +53,20 @@ void CAttributes::clear()
 //! \param value: Value for the attribute. Set this to 0 to delete the attribute
 void CAttributes::setAttribute(const c8* attributeName, const c8* value)
 {
-	for (u32 i=0; i<Attributes.size(); ++i)
-		if (Attributes[i]->Name == attributeName)
-		{
-			if (!value)
-			{
-				Attributes[i]->drop();
-				Attributes.erase(i);
-			}
-			else
-				Attributes[i]->setString(value);
+	const s32 i = findAttribute(attributeName);
+	if (i != -1)
+	{
+		if (!value)
+			removeAttribute(i);
+		else
+			Attributes[i]->setString(value);
 
-			return;
-		}
+		return;
+	}
 
 	if (value)
 	{
-		Attributes.push_back(new CStringAttribute(attributeName, value));
+		addAttribute(new CStringAttribute(attributeName, value));
 	}
 }
 
@@ -118,25 +116,20 @@ core::stringc CAttributes::getAttributeAsString(s32 index)
 //! \param value: Value for the attribute. Set this to 0 to delete the attribute
 void CAttributes::setAttribute(const c8* attributeName, const wchar_t* value)
 {
-	for (u32 i=0; i<Attributes.size(); ++i)
+	const s32 i = findAttribute(attributeName);
+	if (i != -1)
 	{
-		if (Attributes[i]->Name == attributeName)
-		{
-			if (!value)
-			{
-				Attributes[i]->drop();
-				Attributes.erase(i);
-			}
-			else
-				Attributes[i]->setString(value);
+		if (!value)
+			removeAttribute(i);
+		else
+			Attributes[i]->setString(value);
 
-			return;
-		}
+		return;
 	}
 
 	if (value)
 	{
-		Attributes.push_back(new CStringAttribute(attributeName, value));
+		addAttribute(new CStringAttribute(attributeName, value));
 	}
 }
 
@@ -183,7 +176,7 @@ core::stringw CAttributes::getAttributeAsStringW(s32 index)
 //! Adds an attribute as an array of wide strings
 void CAttributes::addArray(const c8* attributeName, const core::array<core::stringw>& value)
 {
-	Attributes.push_back(new CStringWArrayAttribute(attributeName, value));
+	addAttribute(new CStringWArrayAttribute(attributeName, value));
 }
 
 //! Sets an attribute value as an array of wide strings.
@@ -194,7 +187,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::array<core::
 		att->setArray(value);
 	else
 	{
-		Attributes.push_back(new CStringWArrayAttribute(attributeName, value));
+		addAttribute(new CStringWArrayAttribute(attributeName, value));
 	}
 }
 
@@ -232,9 +225,23 @@ void CAttributes::setAttribute(s32 index, const core::array<core::stringw>& valu
 //! Returns attribute index from name, -1 if not found
 s32 CAttributes::findAttribute(const c8* attributeName) const
 {
-	for (u32 i=0; i<Attributes.size(); ++i)
-		if (Attributes[i]->Name == attributeName)
-			return i;
+	if (NameIndex.empty())
+	{
+		for (u32 i=0; i<Attributes.size(); ++i)
+			if (Attributes[i]->Name == attributeName)
+				return i;
+
+		return -1;
+	}
+
+	const u32 hash = hashName(attributeName);
+	const u32 mask = NameIndex.size() - 1;
+	for (u32 slot = hash & mask; NameIndex[slot].Index != -1; slot = (slot + 1) & mask)
+	{
+		const SNameSlot& s = NameIndex[slot];
+		if (s.Hash == hash && Attributes[s.Index]->Name == attributeName)
+			return s.Index;
+	}
 
 	return -1;
 }
@@ -242,11 +249,88 @@ s32 CAttributes::findAttribute(const c8* attributeName) const
 
 IAttribute* CAttributes::getAttributeP(const c8* attributeName) const
 {
-	for (u32 i=0; i<Attributes.size(); ++i)
-		if (Attributes[i]->Name == attributeName)
-			return Attributes[i];
+	const s32 i = findAttribute(attributeName);
+	return i != -1 ? Attributes[i] : 0;
+}
+
+
+//! FNV-1a hash of an attribute name
+u32 CAttributes::hashName(const c8* name)
+{
+	u32 hash = 2166136261u;
+	for (; *name; ++name)
+		hash = (hash ^ (u8)*name) * 16777619u;
+	return hash;
+}
+
+
+//! inserts an attribute into the name index, unless its name is already there
+void CAttributes::indexAttribute(u32 index)
+{
+	const c8* name = Attributes[index]->Name.c_str();
+	const u32 hash = hashName(name);
+	const u32 mask = NameIndex.size() - 1;
+
+	u32 slot = hash & mask;
+	for (; NameIndex[slot].Index != -1; slot = (slot + 1) & mask)
+	{
+		// lookups have to find the first attribute of that name
+		if (NameIndex[slot].Hash == hash && Attributes[NameIndex[slot].Index]->Name == name)
+			return;
+	}
+
+	NameIndex[slot].Hash = hash;
+	NameIndex[slot].Index = index;
+}
+
+
+//! builds the name index for the current attributes, or removes it for few attributes
+void CAttributes::rebuildNameIndex()
+{
+	NameIndex.clear();
+
+	const u32 count = Attributes.size();
+	if (count < NAME_INDEX_MIN_ATTRIBUTES)
+		return;
+
+	// power of two, at most half filled
+	u32 size = 16;
+	while (size < count * 2)
+		size <<= 1;
+
+	SNameSlot empty;
+	empty.Hash = 0;
+	empty.Index = -1;
+	NameIndex.set_used(size);
+	for (u32 i=0; i<size; ++i)
+		NameIndex[i] = empty;
+
+	for (u32 i=0; i<count; ++i)
+		indexAttribute(i);
+}
+
+
+//! appends an attribute and adds it to the name index
+void CAttributes::addAttribute(IAttribute* attribute)
+{
+	Attributes.push_back(attribute);
+
+	const u32 count = Attributes.size();
+	if (count * 2 > NameIndex.size())
+		rebuildNameIndex();
+	else
+		indexAttribute(count - 1);
+}
+
+
+//! drops and removes the attribute at an index
+void CAttributes::removeAttribute(u32 index)
+{
+	Attributes[index]->drop();
+	Attributes.erase(index);
 
-	return 0;
+	// indices behind the removed attribute changed
+	rebuildNameIndex();
 }
 
 
@@ -258,7 +342,7 @@ void CAttributes::setAttribute(const c8* attributeName, bool value)
 		att->setBool(value);
 	else
 	{
-		Attributes.push_back(new CBoolAttribute(attributeName, value));
+		addAttribute(new CBoolAttribute(attributeName, value));
 	}
 }
 
@@ -283,7 +367,7 @@ void CAttributes::setAttribute(const c8* attributeName, s32 value)
 		att->setInt(value);
 	else
 	{
-		Attributes.push_back(new CIntAttribute(attributeName, value));
+		addAttribute(new CIntAttribute(attributeName, value));
 	}
 }
 
@@ -307,7 +391,7 @@ void CAttributes::setAttribute(const c8* attributeName, f32 value)
 	if (att)
 		att->setFloat(value);
 	else
-		Attributes.push_back(new CFloatAttribute(attributeName, value));
+		addAttribute(new CFloatAttribute(attributeName, value));
 }
 
 //! Gets a attribute as integer value
@@ -330,7 +414,7 @@ void CAttributes::setAttribute(const c8* attributeName, video::SColor value)
 	if (att)
 		att->setColor(value);
 	else
-		Attributes.push_back(new CColorAttribute(attributeName, value));
+		addAttribute(new CColorAttribute(attributeName, value));
 }
 
 //! Gets an attribute as color
@@ -352,7 +436,7 @@ void CAttributes::setAttribute(const c8* attributeName, video::SColorf value)
 	if (att)
 		att->setColor(value);
 	else
-		Attributes.push_back(new CColorfAttribute(attributeName, value));
+		addAttribute(new CColorfAttribute(attributeName, value));
 }
 
 //! Gets an attribute as floating point color
@@ -374,7 +458,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::position2di value)
 	if (att)
 		att->setPosition(value);
 	else
-		Attributes.push_back(new CPosition2DAttribute(attributeName, value));
+		addAttribute(new CPosition2DAttribute(attributeName, value));
 }
 
 //! Gets an attribute as 2d position
@@ -396,7 +480,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::rect<s32> value)
 	if (att)
 		att->setRect(value);
 	else
-		Attributes.push_back(new CRectAttribute(attributeName, value));
+		addAttribute(new CRectAttribute(attributeName, value));
 }
 
 //! Gets an attribute as rectangle
@@ -418,7 +502,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::dimension2d<u32> v
 	if (att)
 		att->setDimension2d(value);
 	else
-		Attributes.push_back(new CDimension2dAttribute(attributeName, value));
+		addAttribute(new CDimension2dAttribute(attributeName, value));
 }
 
 //! Gets an attribute as dimension2d
@@ -440,7 +524,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::vector3df value)
 	if (att)
 		att->setVector(value);
 	else
-		Attributes.push_back(new CVector3DAttribute(attributeName, value));
+		addAttribute(new CVector3DAttribute(attributeName, value));
 }
 
 //! Sets a attribute as vector
@@ -450,7 +534,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::vector2df value)
 	if (att)
 		att->setVector2d(value);
 	else
-		Attributes.push_back(new CVector2DAttribute(attributeName, value));
+		addAttribute(new CVector2DAttribute(attributeName, value));
 }
 
 //! Gets an attribute as vector
@@ -482,7 +566,7 @@ void CAttributes::setAttribute(const c8* attributeName, void* data, s32 dataSize
 	if (att)
 		att->setBinary(data, dataSizeInBytes);
 	else
-		Attributes.push_back(new CBinaryAttribute(attributeName, data, dataSizeInBytes));
+		addAttribute(new CBinaryAttribute(attributeName, data, dataSizeInBytes));
 }
 
 //! Gets an attribute as binary data
@@ -501,7 +585,7 @@ void CAttributes::setAttribute(const c8* attributeName, const char* enumValue, c
 	if (att)
 		att->setEnum(enumValue, enumerationLiterals);
 	else
-		Attributes.push_back(new CEnumAttribute(attributeName, enumValue, enumerationLiterals));
+		addAttribute(new CEnumAttribute(attributeName, enumValue, enumerationLiterals));
 }
 
 //! Gets an attribute as enumeration
@@ -552,7 +636,7 @@ void CAttributes::setAttribute(const c8* attributeName, video::ITexture* value,
 	if (att)
 		att->setTexture(value, filename);
 	else
-		Attributes.push_back(new CTextureAttribute(attributeName, value, Driver, filename));
+		addAttribute(new CTextureAttribute(attributeName, value, Driver, filename));
 }
 
 
@@ -797,37 +881,37 @@ void CAttributes::getAttributeEnumerationLiteralsOfEnumeration(s32 index, core::
 //! Adds an attribute as integer
 void CAttributes::addInt(const c8* attributeName, s32 value)
 {
-	Attributes.push_back(new CIntAttribute(attributeName, value));
+	addAttribute(new CIntAttribute(attributeName, value));
 }
 
 //! Adds an attribute as float
 void CAttributes::addFloat(const c8* attributeName, f32 value)
 {
-	Attributes.push_back(new CFloatAttribute(attributeName, value));
+	addAttribute(new CFloatAttribute(attributeName, value));
 }
 
 //! Adds an attribute as string
 void CAttributes::addString(const c8* attributeName, const char* value)
 {
-	Attributes.push_back(new CStringAttribute(attributeName, value));
+	addAttribute(new CStringAttribute(attributeName, value));
 }
 
 //! Adds an attribute as wchar string
 void CAttributes::addString(const c8* attributeName, const wchar_t* value)
 {
-	Attributes.push_back(new CStringAttribute(attributeName, value));
+	addAttribute(new CStringAttribute(attributeName, value));
 }
 
 //! Adds an attribute as bool
 void CAttributes::addBool(const c8* attributeName, bool value)
 {
-	Attributes.push_back(new CBoolAttribute(attributeName, value));
+	addAttribute(new CBoolAttribute(attributeName, value));
 }
 
 //! Adds an attribute as enum
 void CAttributes::addEnum(const c8* attributeName, const char* enumValue, const char* const* enumerationLiterals)
 {
-	Attributes.push_back(new CEnumAttribute(attributeName, enumValue, enumerationLiterals));
+	addAttribute(new CEnumAttribute(attributeName, enumValue, enumerationLiterals));
 }
 
 //! Adds an attribute as enum
@@ -840,56 +924,56 @@ void CAttributes::addEnum(const c8* attributeName, s32 enumValue, const char* co
 //! Adds an attribute as color
 void CAttributes::addColor(const c8* attributeName, video::SColor value)
 {
-	Attributes.push_back(new CColorAttribute(attributeName, value));
+	addAttribute(new CColorAttribute(attributeName, value));
 }
 
 //! Adds an attribute as floating point color
 void CAttributes::addColorf(const c8* attributeName, video::SColorf value)
 {
-	Attributes.push_back(new CColorfAttribute(attributeName, value));
+	addAttribute(new CColorfAttribute(attributeName, value));
 }
 
 //! Adds an attribute as 3d vector
 void CAttributes::addVector3d(const c8* attributeName, core::vector3df value)
 {
-	Attributes.push_back(new CVector3DAttribute(attributeName, value));
+	addAttribute(new CVector3DAttribute(attributeName, value));
 }
 
 //! Adds an attribute as 2d vector
 void CAttributes::addVector2d(const c8* attributeName, core::vector2df value)
 {
-	Attributes.push_back(new CVector2DAttribute(attributeName, value));
+	addAttribute(new CVector2DAttribute(attributeName, value));
 }
 
 
 //! Adds an attribute as 2d position
 void CAttributes::addPosition2d(const c8* attributeName, core::position2di value)
 {
-	Attributes.push_back(new CPosition2DAttribute(attributeName, value));
+	addAttribute(new CPosition2DAttribute(attributeName, value));
 }
 
 //! Adds an attribute as rectangle
 void CAttributes::addRect(const c8* attributeName, core::rect<s32> value)
 {
-	Attributes.push_back(new CRectAttribute(attributeName, value));
+	addAttribute(new CRectAttribute(attributeName, value));
 }
 
 //! Adds an attribute as dimension2d
 void CAttributes::addDimension2d(const c8* attributeName, core::dimension2d<u32> value)
 {
-	Attributes.push_back(new CDimension2dAttribute(attributeName, value));
+	addAttribute(new CDimension2dAttribute(attributeName, value));
 }
 
 //! Adds an attribute as binary data
 void CAttributes::addBinary(const c8* attributeName, void* data, s32 dataSizeInBytes)
 {
-	Attributes.push_back(new CBinaryAttribute(attributeName, data, dataSizeInBytes));
+	addAttribute(new CBinaryAttribute(attributeName, data, dataSizeInBytes));
 }
 
 //! Adds an attribute as texture reference
 void CAttributes::addTexture(const c8* attributeName, video::ITexture* texture, const io::path& filename)
 {
-	Attributes.push_back(new CTextureAttribute(attributeName, texture, Driver, filename));
+	addAttribute(new CTextureAttribute(attributeName, texture, Driver, filename));
 }
 
 //! Returns if an attribute with a name exists
@@ -1011,7 +1095,7 @@ void CAttributes::setAttribute(s32 index, video::ITexture* texture, const io::pa
 //! Adds an attribute as matrix
 void CAttributes::addMatrix(const c8* attributeName, const core::matrix4& v)
 {
-	Attributes.push_back(new CMatrixAttribute(attributeName, v));
+	addAttribute(new CMatrixAttribute(attributeName, v));
 }
 
 
@@ -1022,7 +1106,7 @@ void CAttributes::setAttribute(const c8* attributeName, const core::matrix4& v)
 	if (att)
 		att->setMatrix(v);
 	else
-		Attributes.push_back(new CMatrixAttribute(attributeName, v));
+		addAttribute(new CMatrixAttribute(attributeName, v));
 }
 
 //! Gets an attribute as a matrix4
@@ -1056,7 +1140,7 @@ void CAttributes::setAttribute(s32 index, const core::matrix4& v)
 //! Adds an attribute as quaternion
 void CAttributes::addQuaternion(const c8* attributeName, core::quaternion v)
 {
-	Attributes.push_back(new CQuaternionAttribute(attributeName, v));
+	addAttribute(new CQuaternionAttribute(attributeName, v));
 }
 
 
@@ -1068,7 +1152,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::quaternion v)
 		att->setQuaternion(v);
 	else
 	{
-		Attributes.push_back(new CQuaternionAttribute(attributeName, v));
+		addAttribute(new CQuaternionAttribute(attributeName, v));
 	}
 }
 
@@ -1103,7 +1187,7 @@ if (index >= 0 && index < (s32)Attributes.size() )
 //! Adds an attribute as axis aligned bounding box
 void CAttributes::addBox3d(const c8* attributeName, core::aabbox3df v)
 {
-	Attributes.push_back(new CBBoxAttribute(attributeName, v));
+	addAttribute(new CBBoxAttribute(attributeName, v));
 }
 
 //! Sets an attribute as axis aligned bounding box
@@ -1114,7 +1198,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::aabbox3df v)
 		att->setBBox(v);
 	else
 	{
-		Attributes.push_back(new CBBoxAttribute(attributeName, v));
+		addAttribute(new CBBoxAttribute(attributeName, v));
 	}
 }
 
@@ -1149,7 +1233,7 @@ if (index >= 0 && index < (s32)Attributes.size() )
 //! Adds an attribute as 3d plane
 void CAttributes::addPlane3d(const c8* attributeName, core::plane3df v)
 {
-	Attributes.push_back(new CPlaneAttribute(attributeName, v));
+	addAttribute(new CPlaneAttribute(attributeName, v));
 }
 
 //! Sets an attribute as 3d plane
@@ -1160,7 +1244,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::plane3df v)
 		att->setPlane(v);
 	else
 	{
-		Attributes.push_back(new CPlaneAttribute(attributeName, v));
+		addAttribute(new CPlaneAttribute(attributeName, v));
 	}
 }
 
@@ -1195,7 +1279,7 @@ void CAttributes::setAttribute(s32 index, core::plane3df v)
 //! Adds an attribute as 3d triangle
 void CAttributes::addTriangle3d(const c8* attributeName, core::triangle3df v)
 {
-	Attributes.push_back(new CTriangleAttribute(attributeName, v));
+	addAttribute(new CTriangleAttribute(attributeName, v));
 }
 
 //! Sets an attribute as 3d triangle
@@ -1206,7 +1290,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::triangle3df v)
 		att->setTriangle(v);
 	else
 	{
-		Attributes.push_back(new CTriangleAttribute(attributeName, v));
+		addAttribute(new CTriangleAttribute(attributeName, v));
 	}
 }
 
@@ -1242,7 +1326,7 @@ void CAttributes::setAttribute(s32 index, core::triangle3df v)
 //! Adds an attribute as a 2d line
 void CAttributes::addLine2d(const c8* attributeName, core::line2df v)
 {
-	Attributes.push_back(new CLine2dAttribute(attributeName, v));
+	addAttribute(new CLine2dAttribute(attributeName, v));
 }
 
 //! Sets an attribute as a 2d line
@@ -1253,7 +1337,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::line2df v)
 		att->setLine2d(v);
 	else
 	{
-		Attributes.push_back(new CLine2dAttribute(attributeName, v));
+		addAttribute(new CLine2dAttribute(attributeName, v));
 	}
 }
 
@@ -1288,7 +1372,7 @@ void CAttributes::setAttribute(s32 index, core::line2df v)
 //! Adds an attribute as a 3d line
 void CAttributes::addLine3d(const c8* attributeName, core::line3df v)
 {
-	Attributes.push_back(new CLine3dAttribute(attributeName, v));
+	addAttribute(new CLine3dAttribute(attributeName, v));
 }
 
 //! Sets an attribute as a 3d line
@@ -1299,7 +1383,7 @@ void CAttributes::setAttribute(const c8* attributeName, core::line3df v)
 		att->setLine3d(v);
 	else
 	{
-		Attributes.push_back(new CLine3dAttribute(attributeName, v));
+		addAttribute(new CLine3dAttribute(attributeName, v));
 	}
 }
 
@@ -1336,7 +1420,7 @@ void CAttributes::setAttribute(s32 index, core::line3df v)
 //! Adds an attribute as user pointner
 void CAttributes::addUserPointer(const c8* attributeName, void* userPointer)
 {
-	Attributes.push_back(new CUserPointerAttribute(attributeName, userPointer));
+	addAttribute(new CUserPointerAttribute(attributeName, userPointer));
 }
 
 //! Sets an attribute as user pointer
@@ -1347,7 +1431,7 @@ void CAttributes::setAttribute(const c8* attributeName, void* userPointer)
 		att->setUserPointer(userPointer);
 	else
 	{
-		Attributes.push_back(new CUserPointerAttribute(attributeName, userPointer));
+		addAttribute(new CUserPointerAttribute(attributeName, userPointer));
 	}
 }
 
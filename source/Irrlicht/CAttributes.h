@@ -728,7 +728,32 @@ protected:
 
 	IAttribute* getAttributeP(const c8* attributeName) const;
 
+	//! appends an attribute and adds it to the name index
+	void addAttribute(IAttribute* attribute);
+
+	//! drops and removes the attribute at an index
+	void removeAttribute(u32 index);
+
 	video::IVideoDriver* Driver;
+
+private:
+
+	//! attribute collections smaller than this are searched linearly
+	enum { NAME_INDEX_MIN_ATTRIBUTES = 8 };
+
+	//! slot of the open addressing name index
+	struct SNameSlot
+	{
+		u32 Hash;
+		s32 Index;
+	};
+
+	static u32 hashName(const c8* name);
+	void indexAttribute(u32 index);
+	void rebuildNameIndex();
+
+	//! hash table of attribute indices by name, linear probing, empty for few attributes
+	core::array<SNameSlot> NameIndex;
 };
 
 } // end namespace io
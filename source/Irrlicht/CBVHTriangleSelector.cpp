@@ -0,0 +1,644 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CBVHTriangleSelector.h"
+#include "ISceneNode.h"
+#include "IMeshBuffer.h"
+
+#include "os.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! number of bins for the surface area heuristic
+static const u32 BVH_BINS = 16;
+
+//! below this depth the nodes are split in the middle, this bounds the traversal stack
+static const u32 BVH_MAX_SAH_DEPTH = 40;
+static const u32 BVH_STACK_SIZE = 96;
+
+//! leaves may grow up to this size when splitting does not pay off
+static const u32 BVH_MAX_LEAF_SIZE = 255;
+
+namespace
+{
+	inline f32 surfaceArea(const core::aabbox3df& box)
+	{
+		const core::vector3df e = box.getExtent();
+		return 2.f * (e.X*e.Y + e.Y*e.Z + e.Z*e.X);
+	}
+
+	inline f32 axisValue(const core::vector3df& v, u32 axis)
+	{
+		return axis == 0 ? v.X : axis == 1 ? v.Y : v.Z;
+	}
+}
+
+
+//! constructor
+CBVHTriangleSelector::CBVHTriangleSelector(const IMesh* mesh,
+		ISceneNode* node, s32 maximalPolysPerLeaf)
+	: CTriangleSelector(mesh, node),
+	MaximalPolysPerLeaf(core::s32_clamp(maximalPolysPerLeaf, 1, BVH_MAX_LEAF_SIZE))
+{
+	#ifdef _DEBUG
+	setDebugName("CBVHTriangleSelector");
+	#endif
+
+	buildHierarchy(false);
+}
+
+
+//! constructor for an animated mesh scene node
+CBVHTriangleSelector::CBVHTriangleSelector(IAnimatedMeshSceneNode* node,
+		s32 maximalPolysPerLeaf)
+	: CTriangleSelector(node),
+	MaximalPolysPerLeaf(core::s32_clamp(maximalPolysPerLeaf, 1, BVH_MAX_LEAF_SIZE))
+{
+	#ifdef _DEBUG
+	setDebugName("CBVHTriangleSelector");
+	#endif
+
+	buildHierarchy(true);
+}
+
+
+//! builds the hierarchy over the triangles and sorts them into leaf order
+void CBVHTriangleSelector::buildHierarchy(bool keepPositions)
+{
+	if (Triangles.empty())
+		return;
+
+	const u32 start = os::Timer::getRealTime();
+	const u32 cnt = Triangles.size();
+
+	core::array<SBuildTriangle> info;
+	core::array<u32> order;
+	info.set_used(cnt);
+	order.set_used(cnt);
+	for (u32 i=0; i<cnt; ++i)
+	{
+		const core::triangle3df& tri = Triangles[i];
+		info[i].Box.reset(tri.pointA);
+		info[i].Box.addInternalPoint(tri.pointB);
+		info[i].Box.addInternalPoint(tri.pointC);
+		info[i].Center = info[i].Box.getCenter();
+		order[i] = i;
+	}
+
+	Nodes.reallocate(2 * cnt / MaximalPolysPerLeaf + 1);
+	Nodes.push_back(SBVHNode());
+	build(0, 0, cnt, 0, info, order);
+
+	// sort the triangles into leaf order
+	core::array<core::triangle3df> sorted;
+	sorted.set_used(cnt);
+	for (u32 i=0; i<cnt; ++i)
+		sorted[i] = Triangles[order[i]];
+	Triangles.swap(sorted);
+
+	// triangles of later frames are written to their sorted position
+	if (keepPositions)
+	{
+		TrianglePositions.set_used(cnt);
+		for (u32 i=0; i<cnt; ++i)
+			TrianglePositions[order[i]] = i;
+	}
+
+	c8 tmp[256];
+	sprintf(tmp, "Needed %ums to create BVHTriangleSelector.(%u nodes, %u polys)",
+		os::Timer::getRealTime() - start, Nodes.size(), cnt);
+	os::Printer::log(tmp, ELL_INFORMATION);
+}
+
+
+//! Refits the hierarchy to the triangles of a new frame
+void CBVHTriangleSelector::updateFromMesh(const IMesh* mesh) const
+{
+	if (!mesh || TrianglePositions.empty())
+		return;
+
+	const u32 meshBuffers = mesh->getMeshBufferCount();
+	u32 triangleCount = 0;
+	u32 i;
+	for (i=0; i<meshBuffers; ++i)
+		triangleCount += mesh->getMeshBuffer(i)->getIndexCount() / 3;
+
+	// the hierarchy is only valid for the triangles it was built for
+	if (triangleCount != TrianglePositions.size())
+		return;
+
+	triangleCount = 0;
+	for (i=0; i<meshBuffers; ++i)
+	{
+		const IMeshBuffer* buf = mesh->getMeshBuffer(i);
+		const u32 idxCnt = buf->getIndexCount();
+		const u16* indices = buf->getIndices();
+
+		for (u32 index=0; index<idxCnt; index+=3)
+		{
+			core::triangle3df& tri = Triangles[TrianglePositions[triangleCount++]];
+			tri.pointA = buf->getPosition(indices[index + 0]);
+			tri.pointB = buf->getPosition(indices[index + 1]);
+			tri.pointC = buf->getPosition(indices[index + 2]);
+		}
+	}
+
+	refit();
+}
+
+
+//! recomputes the boxes of all nodes from their triangles
+/** Children are always stored behind their parent, so going backwards
+through the nodes fits the children before their parent. */
+void CBVHTriangleSelector::refit() const
+{
+	for (u32 i=Nodes.size(); i>0; --i)
+	{
+		SBVHNode& node = Nodes[i-1];
+		if (node.Count)
+		{
+			node.Box.reset(Triangles[node.First].pointA);
+			for (u32 j=node.First; j<node.First+node.Count; ++j)
+			{
+				node.Box.addInternalPoint(Triangles[j].pointA);
+				node.Box.addInternalPoint(Triangles[j].pointB);
+				node.Box.addInternalPoint(Triangles[j].pointC);
+			}
+		}
+		else
+		{
+			// the left child follows the node
+			node.Box = Nodes[i].Box;
+			node.Box.addInternalBox(Nodes[node.First].Box);
+		}
+	}
+
+	BoundingBox = Nodes[0].Box;
+}
+
+
+//! builds the node for the triangles [begin, end) of order
+void CBVHTriangleSelector::build(u32 node, u32 begin, u32 end, u32 depth,
+		core::array<SBuildTriangle>& info, core::array<u32>& order)
+{
+	const u32 count = end - begin;
+
+	core::aabbox3df box(info[order[begin]].Box);
+	core::aabbox3df centers(info[order[begin]].Center);
+	for (u32 i=begin+1; i<end; ++i)
+	{
+		box.addInternalBox(info[order[i]].Box);
+		centers.addInternalPoint(info[order[i]].Center);
+	}
+
+	Nodes[node].Box = box;
+	Nodes[node].First = begin;
+	Nodes[node].Count = (u16)count;
+	Nodes[node].Axis = 0;
+
+	if (count <= (u32)MaximalPolysPerLeaf)
+		return;
+
+	// find the cheapest split between bins, the cost of a leaf is its triangle count
+	s32 bestAxis = -1;
+	u32 bestSplit = 0;
+	f32 bestCost = (f32)count;
+	const f32 invArea = core::reciprocal(core::max_(surfaceArea(box), 1e-20f));
+
+	for (u32 axis=0; axis<3 && depth<BVH_MAX_SAH_DEPTH; ++axis)
+	{
+		const f32 minC = axisValue(centers.MinEdge, axis);
+		const f32 extent = axisValue(centers.MaxEdge, axis) - minC;
+		if (extent <= 0.f)
+			continue;
+
+		const f32 scale = BVH_BINS / extent * 0.9999f;
+
+		u32 binCount[BVH_BINS];
+		core::aabbox3df binBox[BVH_BINS];
+		u32 b;
+		for (b=0; b<BVH_BINS; ++b)
+			binCount[b] = 0;
+
+		for (u32 i=begin; i<end; ++i)
+		{
+			const SBuildTriangle& t = info[order[i]];
+			b = core::min_((u32)((axisValue(t.Center, axis) - minC) * scale), BVH_BINS-1);
+			if (binCount[b]++)
+				binBox[b].addInternalBox(t.Box);
+			else
+				binBox[b] = t.Box;
+		}
+
+		// area and count right of each split
+		f32 rightArea[BVH_BINS];
+		u32 rightCount[BVH_BINS];
+		core::aabbox3df sweep;
+		u32 sum = 0;
+		for (b=BVH_BINS-1; b>0; --b)
+		{
+			if (binCount[b])
+			{
+				if (sum)
+					sweep.addInternalBox(binBox[b]);
+				else
+					sweep = binBox[b];
+				sum += binCount[b];
+			}
+			rightArea[b] = sum ? surfaceArea(sweep) : 0.f;
+			rightCount[b] = sum;
+		}
+
+		sum = 0;
+		for (b=0; b<BVH_BINS-1; ++b)
+		{
+			if (binCount[b])
+			{
+				if (sum)
+					sweep.addInternalBox(binBox[b]);
+				else
+					sweep = binBox[b];
+				sum += binCount[b];
+			}
+
+			if (!sum || !rightCount[b+1])
+				continue;
+
+			const f32 cost = 1.f + (surfaceArea(sweep) * sum + rightArea[b+1] * rightCount[b+1]) * invArea;
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = b+1;
+			}
+		}
+	}
+
+	u32 mid = begin;
+	if (bestAxis >= 0)
+	{
+		const f32 minC = axisValue(centers.MinEdge, bestAxis);
+		const f32 scale = BVH_BINS / (axisValue(centers.MaxEdge, bestAxis) - minC) * 0.9999f;
+
+		u32 last = end;
+		while (mid < last)
+		{
+			const u32 b = core::min_((u32)((axisValue(info[order[mid]].Center, bestAxis) - minC) * scale), BVH_BINS-1);
+			if (b < bestSplit)
+				++mid;
+			else
+				core::swap(order[mid], order[--last]);
+		}
+	}
+	else if (count <= BVH_MAX_LEAF_SIZE && depth < BVH_MAX_SAH_DEPTH)
+		return;
+	else
+	{
+		// splitting does not pay off but the leaf would be too large,
+		// or the tree is too deep: split at the median of the longest axis
+		const core::vector3df extent = centers.getExtent();
+		bestAxis = extent.X >= extent.Y && extent.X >= extent.Z ? 0 : extent.Y >= extent.Z ? 1 : 2;
+		mid = begin + count / 2;
+		selectMedian(begin, end, mid, bestAxis, info, order);
+	}
+
+	Nodes[node].Count = 0;
+	Nodes[node].Axis = (u16)bestAxis;
+
+	const u32 left = Nodes.size();
+	Nodes.push_back(SBVHNode());
+	build(left, begin, mid, depth+1, info, order);
+
+	const u32 right = Nodes.size();
+	Nodes.push_back(SBVHNode());
+	Nodes[node].First = right;
+	build(right, mid, end, depth+1, info, order);
+}
+
+
+//! moves the triangles of [begin, end) with centers below the one at nth in front of it
+void CBVHTriangleSelector::selectMedian(u32 begin, u32 end, u32 nth, u32 axis,
+		const core::array<SBuildTriangle>& info, core::array<u32>& order)
+{
+	while (end - begin > 1)
+	{
+		const f32 pivot = axisValue(info[order[begin + (end - begin) / 2]].Center, axis);
+		u32 lo = begin;
+		u32 hi = end - 1;
+		while (lo <= hi)
+		{
+			while (axisValue(info[order[lo]].Center, axis) < pivot)
+				++lo;
+			while (axisValue(info[order[hi]].Center, axis) > pivot)
+				--hi;
+			if (lo > hi)
+				break;
+			core::swap(order[lo], order[hi]);
+			++lo;
+			if (hi == 0)
+				break;
+			--hi;
+		}
+
+		if (nth <= hi)
+			end = hi + 1;
+		else if (nth >= lo)
+			begin = lo;
+		else
+			return;
+	}
+}
+
+
+//! returns the entry parameter of the segment start+dir*t, t in [0,maxT], into a box, or -1
+f32 CBVHTriangleSelector::intersectSegment(const core::aabbox3df& box,
+		const core::vector3df& start, const core::vector3df& invDir, f32 maxT)
+{
+	f32 t0 = (box.MinEdge.X - start.X) * invDir.X;
+	f32 t1 = (box.MaxEdge.X - start.X) * invDir.X;
+	f32 tmin = core::min_(t0, t1);
+	f32 tmax = core::max_(t0, t1);
+
+	t0 = (box.MinEdge.Y - start.Y) * invDir.Y;
+	t1 = (box.MaxEdge.Y - start.Y) * invDir.Y;
+	tmin = core::max_(tmin, core::min_(t0, t1));
+	tmax = core::min_(tmax, core::max_(t0, t1));
+
+	t0 = (box.MinEdge.Z - start.Z) * invDir.Z;
+	t1 = (box.MaxEdge.Z - start.Z) * invDir.Z;
+	tmin = core::max_(tmin, core::min_(t0, t1));
+	tmax = core::min_(tmax, core::max_(t0, t1));
+
+	tmin = core::max_(tmin, 0.f);
+	if (tmin > tmax || tmin > maxT)
+		return -1.f;
+	return tmin;
+}
+
+
+namespace
+{
+	//! reciprocal of the direction, large for zero components
+	inline core::vector3df invertDirection(const core::vector3df& dir)
+	{
+		return core::vector3df(
+			dir.X != 0.f ? 1.f / dir.X : FLT_MAX,
+			dir.Y != 0.f ? 1.f / dir.Y : FLT_MAX,
+			dir.Z != 0.f ? 1.f / dir.Z : FLT_MAX);
+	}
+}
+
+
+//! Gets all triangles which lie within a specific bounding box.
+void CBVHTriangleSelector::getTriangles(core::triangle3df* triangles,
+					s32 arraySize, s32& outTriangleCount,
+					const core::aabbox3d<f32>& box,
+					const core::matrix4* transform) const
+{
+	// Update my triangles if necessary
+	update();
+
+	core::matrix4 mat(core::matrix4::EM4CONST_NOTHING);
+	core::aabbox3d<f32> invbox = box;
+
+	if (SceneNode)
+	{
+		SceneNode->getAbsoluteTransformation().getInverse(mat);
+		mat.transformBoxEx(invbox);
+	}
+
+	if (transform)
+		mat = *transform;
+	else
+		mat.makeIdentity();
+
+	if (SceneNode)
+		mat *= SceneNode->getAbsoluteTransformation();
+
+	s32 trianglesWritten = 0;
+	u32 stack[BVH_STACK_SIZE];
+	u32 top = 0;
+	if (!Nodes.empty() && arraySize > 0)
+		stack[top++] = 0;
+
+	while (top)
+	{
+		const u32 index = stack[--top];
+		const SBVHNode& node = Nodes[index];
+		if (!invbox.intersectsWithBox(node.Box))
+			continue;
+
+		if (node.Count)
+		{
+			for (u32 i=node.First; i<node.First+node.Count; ++i)
+			{
+				const core::triangle3df& srcTri = Triangles[i];
+				// This isn't an accurate test, but it's fast, and the
+				// API contract doesn't guarantee complete accuracy.
+				if (srcTri.isTotalOutsideBox(invbox))
+					continue;
+
+				core::triangle3df& dstTri = triangles[trianglesWritten];
+				mat.transformVect(dstTri.pointA, srcTri.pointA);
+				mat.transformVect(dstTri.pointB, srcTri.pointB);
+				mat.transformVect(dstTri.pointC, srcTri.pointC);
+
+				// Halt when the out array is full.
+				if (++trianglesWritten == arraySize)
+				{
+					outTriangleCount = trianglesWritten;
+					return;
+				}
+			}
+		}
+		else
+		{
+			stack[top++] = node.First;
+			stack[top++] = index + 1;
+		}
+	}
+
+	outTriangleCount = trianglesWritten;
+}
+
+
+//! Gets all triangles which have or may have contact with a 3d line.
+void CBVHTriangleSelector::getTriangles(core::triangle3df* triangles, s32 arraySize,
+		s32& outTriangleCount, const core::line3d<f32>& line,
+		const core::matrix4* transform) const
+{
+	// Update my triangles if necessary
+	update();
+
+	core::matrix4 mat(core::matrix4::EM4CONST_NOTHING);
+
+	core::vector3df vectStartInv(line.start), vectEndInv(line.end);
+	if (SceneNode)
+	{
+		SceneNode->getAbsoluteTransformation().getInverse(mat);
+		mat.transformVect(vectStartInv, line.start);
+		mat.transformVect(vectEndInv, line.end);
+	}
+	const core::vector3df invDir = invertDirection(vectEndInv - vectStartInv);
+
+	if (transform)
+		mat = *transform;
+	else
+		mat.makeIdentity();
+
+	if (SceneNode)
+		mat *= SceneNode->getAbsoluteTransformation();
+
+	s32 trianglesWritten = 0;
+	u32 stack[BVH_STACK_SIZE];
+	u32 top = 0;
+	if (!Nodes.empty() && arraySize > 0)
+		stack[top++] = 0;
+
+	while (top)
+	{
+		const u32 index = stack[--top];
+		const SBVHNode& node = Nodes[index];
+		if (intersectSegment(node.Box, vectStartInv, invDir, 1.f) < 0.f)
+			continue;
+
+		if (node.Count)
+		{
+			for (u32 i=node.First; i<node.First+node.Count; ++i)
+			{
+				const core::triangle3df& srcTri = Triangles[i];
+				core::triangle3df& dstTri = triangles[trianglesWritten];
+				mat.transformVect(dstTri.pointA, srcTri.pointA);
+				mat.transformVect(dstTri.pointB, srcTri.pointB);
+				mat.transformVect(dstTri.pointC, srcTri.pointC);
+
+				if (++trianglesWritten == arraySize)
+				{
+					outTriangleCount = trianglesWritten;
+					return;
+				}
+			}
+		}
+		else
+		{
+			stack[top++] = node.First;
+			stack[top++] = index + 1;
+		}
+	}
+
+	outTriangleCount = trianglesWritten;
+}
+
+
+//! Gets the nearest triangle hit by a 3d line.
+bool CBVHTriangleSelector::getCollisionPoint(const core::line3d<f32>& ray,
+		core::vector3df& outIntersection, core::triangle3df& outTriangle,
+		ISceneNode*& outNode) const
+{
+	// Update my triangles if necessary
+	update();
+
+	if (Nodes.empty())
+		return false;
+
+	core::vector3df start(ray.start), end(ray.end);
+	if (SceneNode)
+	{
+		core::matrix4 inv(core::matrix4::EM4CONST_NOTHING);
+		SceneNode->getAbsoluteTransformation().getInverse(inv);
+		inv.transformVect(start, ray.start);
+		inv.transformVect(end, ray.end);
+	}
+
+	// the segment is start + dir*t with t in [0,1], which does not
+	// change with the transformation of the node
+	const core::vector3df dir = end - start;
+	const core::vector3df invDir = invertDirection(dir);
+	const u32 dirNegative[3] = { dir.X < 0.f, dir.Y < 0.f, dir.Z < 0.f };
+
+	f32 nearest = 1.f;
+	s32 hit = -1;
+
+	u32 stack[BVH_STACK_SIZE];
+	u32 top = 0;
+	stack[top++] = 0;
+
+	while (top)
+	{
+		const u32 index = stack[--top];
+		const SBVHNode& node = Nodes[index];
+		if (intersectSegment(node.Box, start, invDir, nearest) < 0.f)
+			continue;
+
+		if (node.Count)
+		{
+			for (u32 i=node.First; i<node.First+node.Count; ++i)
+			{
+				// Moeller-Trumbore, both sides of the triangle
+				const core::triangle3df& tri = Triangles[i];
+				const core::vector3df e1 = tri.pointB - tri.pointA;
+				const core::vector3df e2 = tri.pointC - tri.pointA;
+				const core::vector3df p = dir.crossProduct(e2);
+				const f32 det = e1.dotProduct(p);
+				if (det == 0.f)
+					continue;
+
+				const f32 invDet = 1.f / det;
+				const core::vector3df s = start - tri.pointA;
+				const f32 u = s.dotProduct(p) * invDet;
+				if (u < 0.f || u > 1.f)
+					continue;
+
+				const core::vector3df q = s.crossProduct(e1);
+				const f32 v = dir.dotProduct(q) * invDet;
+				if (v < 0.f || u + v > 1.f)
+					continue;
+
+				const f32 t = e2.dotProduct(q) * invDet;
+				if (t >= 0.f && t < nearest)
+				{
+					nearest = t;
+					hit = i;
+				}
+			}
+		}
+		else
+		{
+			// visit the near child first
+			if (dirNegative[node.Axis])
+			{
+				stack[top++] = index + 1;
+				stack[top++] = node.First;
+			}
+			else
+			{
+				stack[top++] = node.First;
+				stack[top++] = index + 1;
+			}
+		}
+	}
+
+	if (hit < 0)
+		return false;
+
+	outIntersection = ray.start + (ray.end - ray.start) * nearest;
+	outTriangle = Triangles[hit];
+	if (SceneNode)
+	{
+		const core::matrix4& mat = SceneNode->getAbsoluteTransformation();
+		mat.transformVect(outTriangle.pointA);
+		mat.transformVect(outTriangle.pointB);
+		mat.transformVect(outTriangle.pointC);
+	}
+	outNode = SceneNode;
+	return true;
+}
+
+
+} // end namespace scene
+} // end namespace irr
+
@@ -0,0 +1,102 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_BVH_TRIANGLE_SELECTOR_H_INCLUDED__
+#define __C_BVH_TRIANGLE_SELECTOR_H_INCLUDED__
+
+#include "CTriangleSelector.h"
+
+namespace irr
+{
+namespace scene
+{
+
+class ISceneNode;
+
+//! Triangle selector with a bounding volume hierarchy over the triangles
+/** The hierarchy is built with the surface area heuristic. The triangles
+are sorted so that each leaf uses a continuous range of them. For an
+animated mesh scene node the hierarchy is built once, and only its boxes
+are refitted when the frame changes. */
+class CBVHTriangleSelector : public CTriangleSelector
+{
+public:
+
+	//! Constructs a selector based on a mesh
+	CBVHTriangleSelector(const IMesh* mesh, ISceneNode* node, s32 maximalPolysPerLeaf);
+
+	//! Constructs a selector based on an animated mesh scene node
+	//!\param node An animated mesh scene node, which must have a valid mesh
+	CBVHTriangleSelector(IAnimatedMeshSceneNode* node, s32 maximalPolysPerLeaf);
+
+	//! Gets all triangles which lie within a specific bounding box.
+	virtual void getTriangles(core::triangle3df* triangles, s32 arraySize, s32& outTriangleCount,
+		const core::aabbox3d<f32>& box, const core::matrix4* transform=0) const;
+
+	//! Gets all triangles which have or may have contact with a 3d line.
+	virtual void getTriangles(core::triangle3df* triangles, s32 arraySize,
+		s32& outTriangleCount, const core::line3d<f32>& line,
+		const core::matrix4* transform=0) const;
+
+	//! Returns true, getCollisionPoint searches the hierarchy
+	virtual bool hasCollisionPointQuery() const { return true; }
+
+	//! Gets the nearest triangle hit by a 3d line.
+	virtual bool getCollisionPoint(const core::line3d<f32>& ray,
+		core::vector3df& outIntersection, core::triangle3df& outTriangle,
+		ISceneNode*& outNode) const;
+
+protected:
+
+	//! Refits the hierarchy to the triangles of a new frame
+	virtual void updateFromMesh(const IMesh* mesh) const;
+
+private:
+
+	//! Node of the hierarchy, 32 bytes
+	/** The left child of an inner node follows the node, the right
+	child is at index First. A leaf has Count triangles starting at
+	First. */
+	struct SBVHNode
+	{
+		core::aabbox3df Box;
+		u32 First;
+		u16 Count;
+		u16 Axis;
+	};
+
+	//! bounding box and centroid of a triangle during the build
+	struct SBuildTriangle
+	{
+		core::aabbox3df Box;
+		core::vector3df Center;
+	};
+
+	void buildHierarchy(bool keepPositions);
+
+	void build(u32 node, u32 begin, u32 end, u32 depth,
+		core::array<SBuildTriangle>& info, core::array<u32>& order);
+
+	static void selectMedian(u32 begin, u32 end, u32 nth, u32 axis,
+		const core::array<SBuildTriangle>& info, core::array<u32>& order);
+
+	//! returns the entry parameter of the segment start+dir*t, t in [0,maxT], into a box, or -1
+	static f32 intersectSegment(const core::aabbox3df& box, const core::vector3df& start,
+		const core::vector3df& invDir, f32 maxT);
+
+	//! recomputes the boxes of all nodes from their triangles
+	void refit() const;
+
+	mutable core::array<SBVHNode> Nodes;
+
+	//! sorted position of each triangle of the mesh, only for animated nodes
+	core::array<u32> TrianglePositions;
+	s32 MaximalPolysPerLeaf;
+};
+
+} // end namespace scene
+} // end namespace irr
+
+
+#endif
@@ -64,6 +64,9 @@ namespace scene
 		//! creates/loads an animated mesh from the file.
 		virtual IAnimatedMesh* createMesh(io::IReadFile* file);
 
+		//! Returns true if createMesh() may be called on a background thread.
+		virtual bool canLoadInBackground() const { return true; }
+
 	private:
 
 		scene::IMesh* createCSMMesh(io::IReadFile* file);
@@ -1276,7 +1276,7 @@ void CD3D9Driver::deleteHardwareBuffer(SHWBufferLink *_HWBuffer)
 
 
 //! Draw hardware buffer
-void CD3D9Driver::drawHardwareBuffer(SHWBufferLink *_HWBuffer)
+void CD3D9Driver::drawHardwareBuffer(SHWBufferLink *_HWBuffer, u32 primitiveCount)
 {
 	if (!_HWBuffer)
 		return;
@@ -1303,7 +1303,7 @@ void CD3D9Driver::drawHardwareBuffer(SHWBufferLink *_HWBuffer)
 		iPtr=0;
 	}
 
-	drawVertexPrimitiveList(vPtr, mb->getVertexCount(), iPtr, mb->getIndexCount()/3, mb->getVertexType(), scene::EPT_TRIANGLES, mb->getIndexType());
+	drawVertexPrimitiveList(vPtr, mb->getVertexCount(), iPtr, primitiveCount, mb->getVertexType(), scene::EPT_TRIANGLES, mb->getIndexType());
 
 	if (HWBuffer->vertexBuffer)
 		pID3DDevice->SetStreamSource(0, 0, 0, 0);
@@ -0,0 +1,273 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CFileArchiveIndex.h"
+#include "IFileList.h"
+
+namespace irr
+{
+namespace io
+{
+
+//! constructor
+CFileArchiveIndex::CFileArchiveIndex()
+: FreeEntries(-1), Count(0), IgnorePathsCount(0), UnindexedCount(0)
+{
+}
+
+
+//! Adds the files of an archive, with a lower priority than the files of the other archives
+void CFileArchiveIndex::addArchive(IFileArchive* archive)
+{
+	if (!isIndexed(archive))
+	{
+		++UnindexedCount;
+		return;
+	}
+
+	const IFileList* list = archive->getFileList();
+	const bool ignorePaths = list->isIgnoringPaths();
+	if (ignorePaths)
+		++IgnorePathsCount;
+
+	io::path name;
+	for (u32 i=0; i < list->getFileCount(); ++i)
+	{
+		if (list->isDirectory(i))
+			continue;
+
+		name = list->getFullFileName(i);
+
+		// archives which were added before have a higher priority
+		const u32 hash = getHash(name, ignorePaths);
+		const s32 e = find(name, hash, ignorePaths);
+		if (e == -1)
+			insert(name, hash, ignorePaths, archive, i);
+		else if (Entries[e].Archive == archive)
+		{
+			// the name is in the archive more than once, take the
+			// file which the archive would find
+			const s32 index = list->findFile(name, false);
+			if (index != -1)
+				Entries[e].Index = (u32)index;
+		}
+	}
+}
+
+
+//! Removes the files of an archive
+void CFileArchiveIndex::removeArchive(IFileArchive* archive, const core::array<IFileArchive*>& archives)
+{
+	if (!isIndexed(archive))
+	{
+		--UnindexedCount;
+		return;
+	}
+
+	if (archive->getFileList()->isIgnoringPaths())
+		--IgnorePathsCount;
+
+	// unlink the entries of the archive
+	core::array<s32> removed;
+	u32 b;
+	for (b=0; b < Buckets.size(); ++b)
+	{
+		s32* link = &Buckets[b];
+		while (*link != -1)
+		{
+			SEntry& entry = Entries[*link];
+			if (entry.Archive == archive)
+			{
+				removed.push_back(*link);
+				*link = entry.Next;
+			}
+			else
+				link = &entry.Next;
+		}
+	}
+
+	// the names are linked again for the remaining archive with the
+	// highest priority which contains them
+	for (u32 i=0; i < removed.size(); ++i)
+	{
+		SEntry& entry = Entries[removed[i]];
+		entry.Archive = 0;
+
+		for (u32 a=0; a < archives.size(); ++a)
+		{
+			if (!isIndexed(archives[a]))
+				continue;
+
+			const IFileList* list = archives[a]->getFileList();
+			if (list->isIgnoringPaths() != entry.IgnorePaths)
+				continue;
+
+			const s32 index = list->findFile(entry.Name, false);
+			if (index != -1)
+			{
+				entry.Archive = archives[a];
+				entry.Index = (u32)index;
+				break;
+			}
+		}
+
+		if (entry.Archive)
+			link(removed[i]);
+		else
+		{
+			entry.Name = "";
+			entry.Next = FreeEntries;
+			FreeEntries = removed[i];
+			--Count;
+		}
+	}
+}
+
+
+//! Indexes all archives again, after their order has changed
+void CFileArchiveIndex::rebuild(const core::array<IFileArchive*>& archives)
+{
+	Entries.clear();
+	Buckets.clear();
+	FreeEntries = -1;
+	Count = 0;
+	IgnorePathsCount = 0;
+	UnindexedCount = 0;
+
+	for (u32 i=0; i < archives.size(); ++i)
+		addArchive(archives[i]);
+}
+
+
+//! Finds a file in the indexed archives
+bool CFileArchiveIndex::findFile(const io::path& filename, const core::array<IFileArchive*>& archives,
+		IFileArchive*& archive, u32& index) const
+{
+	archive = 0;
+
+	// same normalization as CFileList::findFile()
+	io::path name(filename);
+	name.replace('\\', '/');
+	if (name.lastChar() == '/')
+		return false;
+
+	if (!Count)
+		return true;
+
+	name.make_lower();
+	s32 entry = find(name, getHash(name, false), false);
+
+	if (IgnorePathsCount)
+	{
+		core::deletePathFromFilename(name);
+		const s32 other = find(name, getHash(name, true), true);
+
+		// both kinds of archives contain the file, take the one which was added first
+		if (other != -1 && (entry == -1 ||
+			archives.linear_search(Entries[other].Archive) < archives.linear_search(Entries[entry].Archive)))
+			entry = other;
+	}
+
+	if (entry != -1)
+	{
+		archive = Entries[entry].Archive;
+		index = Entries[entry].Index;
+	}
+	return true;
+}
+
+
+//! Check if the files of an archive are indexed
+bool CFileArchiveIndex::isIndexed(const IFileArchive* archive)
+{
+	return archive->opensFilesByFileList() && archive->getFileList()->isIgnoringCase();
+}
+
+
+//! returns the hash of a lower case name
+u32 CFileArchiveIndex::getHash(const io::path& name, bool ignorePaths)
+{
+	// FNV-1a
+	u32 hash = ignorePaths ? 2166136261u ^ 1 : 2166136261u;
+	for (u32 i=0; i < name.size(); ++i)
+	{
+		hash ^= (u32)name[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+
+//! returns the entry of a name, or -1
+s32 CFileArchiveIndex::find(const io::path& name, u32 hash, bool ignorePaths) const
+{
+	if (Buckets.empty())
+		return -1;
+
+	s32 e = Buckets[hash & (Buckets.size()-1)];
+	while (e != -1)
+	{
+		const SEntry& entry = Entries[e];
+		if (entry.Hash == hash && entry.IgnorePaths == ignorePaths && entry.Name == name)
+			return e;
+		e = entry.Next;
+	}
+	return -1;
+}
+
+
+//! adds an entry for a name which is not in the table yet
+void CFileArchiveIndex::insert(const io::path& name, u32 hash, bool ignorePaths, IFileArchive* archive, u32 index)
+{
+	if (Count >= Buckets.size())
+		grow();
+
+	s32 e = FreeEntries;
+	if (e != -1)
+		FreeEntries = Entries[e].Next;
+	else
+	{
+		e = Entries.size();
+		Entries.push_back(SEntry());
+	}
+
+	SEntry& entry = Entries[e];
+	entry.Name = name;
+	entry.Archive = archive;
+	entry.Index = index;
+	entry.Hash = hash;
+	entry.IgnorePaths = ignorePaths;
+	link(e);
+	++Count;
+}
+
+
+//! adds an entry to the chain of its bucket
+void CFileArchiveIndex::link(s32 entry)
+{
+	s32& bucket = Buckets[Entries[entry].Hash & (Buckets.size()-1)];
+	Entries[entry].Next = bucket;
+	bucket = entry;
+}
+
+
+//! doubles the number of buckets
+void CFileArchiveIndex::grow()
+{
+	const u32 size = Buckets.size() ? Buckets.size()*2 : 64;
+	Buckets.set_used(size);
+	for (u32 b=0; b < size; ++b)
+		Buckets[b] = -1;
+
+	for (u32 e=0; e < Entries.size(); ++e)
+	{
+		if (Entries[e].Archive)
+			link(e);
+	}
+}
+
+
+} // end namespace io
+} // end namespace irr
+
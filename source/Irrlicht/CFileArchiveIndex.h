@@ -0,0 +1,101 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_FILE_ARCHIVE_INDEX_H_INCLUDED__
+#define __C_FILE_ARCHIVE_INDEX_H_INCLUDED__
+
+#include "IFileArchive.h"
+#include "irrArray.h"
+
+namespace irr
+{
+namespace io
+{
+
+	//! Hash table of the files in the archives of the file system
+	/** Maps the lower case name of each file to the archive with the
+	highest priority which contains it, so opening a file doesn't need to
+	search each archive. Only archives which open their files by the file
+	list and ignore the case of the names are indexed, see isIndexed().
+	Archives which ignore paths are indexed by the names of the files
+	without path. */
+	class CFileArchiveIndex
+	{
+	public:
+
+		//! constructor
+		CFileArchiveIndex();
+
+		//! Adds the files of an archive, with a lower priority than the files of the other archives
+		void addArchive(IFileArchive* archive);
+
+		//! Removes the files of an archive
+		/** Files which are in other archives, too, are looked up there.
+		\param archive The removed archive, must not be dropped yet.
+		\param archives The remaining archives, in the order of their priority. */
+		void removeArchive(IFileArchive* archive, const core::array<IFileArchive*>& archives);
+
+		//! Indexes all archives again, after their order has changed
+		void rebuild(const core::array<IFileArchive*>& archives);
+
+		//! Finds a file in the indexed archives
+		/** \param filename Name of the file.
+		\param archives The archives, in the order of their priority.
+		\param archive Receives the archive with the highest priority
+		which contains the file, or 0 if no indexed archive contains it.
+		\param index Receives the index of the file in the file list of the archive.
+		\return False if the index can't look up such names, like names of
+		folders. Then each archive has to be searched. */
+		bool findFile(const io::path& filename, const core::array<IFileArchive*>& archives,
+				IFileArchive*& archive, u32& index) const;
+
+		//! Get the number of archives which are not indexed
+		u32 getUnindexedCount() const { return UnindexedCount; }
+
+		//! Check if the files of an archive are indexed
+		/** The names in the file list of such archives are lower case
+		like the names in the index, see IFileList::isIgnoringCase(). */
+		static bool isIndexed(const IFileArchive* archive);
+
+	private:
+
+		//! a file, in the chain of its bucket or in the chain of free entries
+		struct SEntry
+		{
+			io::path Name;
+			IFileArchive* Archive;
+			u32 Index;
+			u32 Hash;
+			s32 Next;
+			bool IgnorePaths;
+		};
+
+		//! returns the hash of a lower case name
+		static u32 getHash(const io::path& name, bool ignorePaths);
+
+		//! returns the entry of a name, or -1
+		s32 find(const io::path& name, u32 hash, bool ignorePaths) const;
+
+		//! adds an entry for a name which is not in the table yet
+		void insert(const io::path& name, u32 hash, bool ignorePaths, IFileArchive* archive, u32 index);
+
+		//! adds an entry to the chain of its bucket
+		void link(s32 entry);
+
+		//! doubles the number of buckets
+		void grow();
+
+		core::array<SEntry> Entries;
+		core::array<s32> Buckets;
+		s32 FreeEntries;
+		u32 Count;
+		u32 IgnorePathsCount;
+		u32 UnindexedCount;
+	};
+
+} // end namespace io
+} // end namespace irr
+
+#endif
+
@@ -160,6 +160,20 @@ const io::path& CFileList::getPath() const
 }
 
 
+//! Check if the list ignores the paths of the files
+bool CFileList::isIgnoringPaths() const
+{
+	return IgnorePaths;
+}
+
+
+//! Check if the list ignores the case of the names
+bool CFileList::isIgnoringCase() const
+{
+	return IgnoreCase;
+}
+
+
 } // end namespace irr
 } // end namespace io
 
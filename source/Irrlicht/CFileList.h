@@ -114,6 +114,12 @@ public:
 	//! Returns the base path of the file list
 	virtual const io::path& getPath() const;
 
+	//! Check if the list ignores the paths of the files
+	virtual bool isIgnoringPaths() const;
+
+	//! Check if the list ignores the case of the names
+	virtual bool isIgnoringCase() const;
+
 protected:
 
 	//! Ignore paths when adding or searching for files
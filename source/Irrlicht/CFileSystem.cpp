@@ -108,9 +108,42 @@ CFileSystem::~CFileSystem()
 IReadFile* CFileSystem::createAndOpenFile(const io::path& filename)
 {
 	IReadFile* file = 0;
-	u32 i;
+	u32 i = 0;
 
-	for (i=0; i< FileArchives.size(); ++i)
+	IFileArchive* archive = 0;
+	u32 index = 0;
+	if (ArchiveIndex.findFile(filename, FileArchives, archive, index))
+	{
+		// indexed archives don't need to be asked, only the other
+		// ones which have a higher priority
+		if (ArchiveIndex.getUnindexedCount())
+		{
+			const u32 end = archive ? FileArchives.linear_search(archive) : FileArchives.size();
+			for (; i < end; ++i)
+			{
+				if (CFileArchiveIndex::isIndexed(FileArchives[i]))
+					continue;
+
+				file = FileArchives[i]->createAndOpenFile(filename);
+				if (file)
+					return file;
+			}
+		}
+
+		if (archive)
+		{
+			file = archive->createAndOpenFile(index);
+			if (file)
+				return file;
+
+			// continue with the archives after it
+			i = FileArchives.linear_search(archive) + 1;
+		}
+		else
+			i = FileArchives.size();
+	}
+
+	for (; i < FileArchives.size(); ++i)
 	{
 		file = FileArchives[i]->createAndOpenFile(filename);
 		if (file)
@@ -207,6 +240,9 @@ bool CFileSystem::moveFileArchive(u32 sourceIndex, s32 relative)
 		FileArchives[s] = t;
 		r = true;
 	}
+
+	if (r)
+		ArchiveIndex.rebuild(FileArchives);
 	return r;
 }
 
@@ -304,6 +340,7 @@ bool CFileSystem::addFileArchive(const io::path& filename, bool ignoreCase,
 	if (archive)
 	{
 		FileArchives.push_back(archive);
+		ArchiveIndex.addArchive(archive);
 		if (password.size())
 			archive->Password=password;
 		if (retArchive)
@@ -410,6 +447,7 @@ bool CFileSystem::addFileArchive(IReadFile* file, bool ignoreCase,
 		if (archive)
 		{
 			FileArchives.push_back(archive);
+			ArchiveIndex.addArchive(archive);
 			if (password.size())
 				archive->Password=password;
 			if (retArchive)
@@ -438,6 +476,7 @@ bool CFileSystem::addFileArchive(IFileArchive* archive)
 		}
 	}
 	FileArchives.push_back(archive);
+	ArchiveIndex.addArchive(archive);
 	return true;
 }
 
@@ -448,8 +487,10 @@ bool CFileSystem::removeFileArchive(u32 index)
 	bool ret = false;
 	if (index < FileArchives.size())
 	{
-		FileArchives[index]->drop();
+		IFileArchive* archive = FileArchives[index];
 		FileArchives.erase(index);
+		ArchiveIndex.removeArchive(archive, FileArchives);
+		archive->drop();
 		ret = true;
 	}
 	_IRR_IMPLEMENT_MANAGED_MARSHALLING_BUGFIX;
@@ -955,10 +996,28 @@ IFileList* CFileSystem::createEmptyFileList(const io::path& path, bool ignoreCas
 //! determines if a file exists and would be able to be opened.
 bool CFileSystem::existFile(const io::path& filename) const
 {
-	for (u32 i=0; i < FileArchives.size(); ++i)
-		if (FileArchives[i]->getFileList()->findFile(filename)!=-1)
+	IFileArchive* archive = 0;
+	u32 index;
+	if (ArchiveIndex.findFile(filename, FileArchives, archive, index))
+	{
+		if (archive)
 			return true;
 
+		if (ArchiveIndex.getUnindexedCount())
+		{
+			for (u32 i=0; i < FileArchives.size(); ++i)
+				if (!CFileArchiveIndex::isIndexed(FileArchives[i]) &&
+					FileArchives[i]->getFileList()->findFile(filename)!=-1)
+					return true;
+		}
+	}
+	else
+	{
+		for (u32 i=0; i < FileArchives.size(); ++i)
+			if (FileArchives[i]->getFileList()->findFile(filename)!=-1)
+				return true;
+	}
+
 #if defined(_IRR_WINDOWS_CE_PLATFORM_)
 #if defined(_IRR_WCHAR_FILESYSTEM)
 	HANDLE hFile = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
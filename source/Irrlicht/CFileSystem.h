@@ -7,6 +7,7 @@
 
 #include "IFileSystem.h"
 #include "irrArray.h"
+#include "CFileArchiveIndex.h"
 
 namespace irr
 {
@@ -163,6 +164,8 @@ private:
 	core::array<IArchiveLoader*> ArchiveLoader;
 	//! currently attached Archives
 	core::array<IFileArchive*> FileArchives;
+	//! files of the attached Archives
+	CFileArchiveIndex ArchiveIndex;
 };
 
 
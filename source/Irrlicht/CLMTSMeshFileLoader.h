@@ -44,6 +44,9 @@ public:
 
 	virtual IAnimatedMesh* createMesh(io::IReadFile* file);
 
+	//! Returns true if createMesh() may be called on a background thread.
+	virtual bool canLoadInBackground() const { return true; }
+
 private:
 	void constructMesh(SMesh* mesh);
 	void loadTextures(SMesh* mesh);
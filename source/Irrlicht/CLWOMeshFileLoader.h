@@ -43,6 +43,9 @@ public:
 	//! See IUnknown::drop() for more information.
 	virtual IAnimatedMesh* createMesh(io::IReadFile* file);
 
+	//! Returns true if createMesh() may be called on a background thread.
+	virtual bool canLoadInBackground() const { return true; }
+
 private:
 
 	struct tLWOMaterial;
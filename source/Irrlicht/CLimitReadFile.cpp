@@ -116,6 +116,17 @@ const io::path& CLimitReadFile::getFileName() const
 }
 
 
+//! returns the area in the contents of the file, if it has them in memory
+const void* CLimitReadFile::getBuffer() const
+{
+	if (!File || AreaEnd > File->getSize())
+		return 0;
+
+	const c8* buffer = (const c8*)File->getBuffer();
+	return buffer ? buffer + AreaStart : 0;
+}
+
+
 IReadFile* createLimitReadFile(const io::path& fileName, IReadFile* alreadyOpenedFile, long pos, long areaSize)
 {
 	return new CLimitReadFile(alreadyOpenedFile, pos, areaSize, fileName);
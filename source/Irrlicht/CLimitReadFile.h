@@ -46,6 +46,9 @@ namespace io
 		//! returns name of file
 		virtual const io::path& getFileName() const;
 
+		//! returns the area in the contents of the file, if it has them in memory
+		virtual const void* getBuffer() const;
+
 	private:
 
 		io::path Filename;
@@ -32,6 +32,9 @@ public:
 	//! See IReferenceCounted::drop() for more information.
 	virtual IAnimatedMesh* createMesh(io::IReadFile* file);
 
+	//! Returns true if createMesh() may be called on a background thread.
+	virtual bool canLoadInBackground() const { return true; }
+
 private:
 	//! Loads the file data into the mesh
 	bool loadFile(io::IReadFile* file, CAnimatedMeshMD2* mesh);
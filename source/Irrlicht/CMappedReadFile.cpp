@@ -0,0 +1,170 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CMappedReadFile.h"
+
+#ifdef _IRR_COMPILE_WITH_MAPPED_FILES_
+
+#include <limits.h>
+
+#if defined(_IRR_WINDOWS_API_)
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace irr
+{
+namespace io
+{
+
+
+CMappedReadFile::CMappedReadFile(const io::path& fileName, const void* data, long size)
+: Data((const c8*)data), Size(size), Pos(0), Filename(fileName)
+{
+	#ifdef _DEBUG
+	setDebugName("CMappedReadFile");
+	#endif
+}
+
+
+CMappedReadFile::~CMappedReadFile()
+{
+#if defined(_IRR_WINDOWS_API_)
+	UnmapViewOfFile(Data);
+#else
+	munmap((void*)Data, Size);
+#endif
+}
+
+
+//! returns how much was read
+s32 CMappedReadFile::read(void* buffer, u32 sizeToRead)
+{
+	long amount = core::min_((long)sizeToRead, Size - Pos);
+	if (amount <= 0)
+		return 0;
+
+	memcpy(buffer, Data + Pos, amount);
+	Pos += amount;
+
+	return (s32)amount;
+}
+
+
+//! changes position in file, returns true if successful
+//! if relativeMovement==true, the pos is changed relative to current pos,
+//! otherwise from begin of file
+bool CMappedReadFile::seek(long finalPos, bool relativeMovement)
+{
+	if (relativeMovement)
+		finalPos += Pos;
+
+	if (finalPos < 0 || finalPos > Size)
+		return false;
+
+	Pos = finalPos;
+	return true;
+}
+
+
+//! returns size of file
+long CMappedReadFile::getSize() const
+{
+	return Size;
+}
+
+
+//! returns where in the file we are.
+long CMappedReadFile::getPos() const
+{
+	return Pos;
+}
+
+
+//! returns name of file
+const io::path& CMappedReadFile::getFileName() const
+{
+	return Filename;
+}
+
+
+//! returns the contents of the file
+const void* CMappedReadFile::getBuffer() const
+{
+	return Data;
+}
+
+
+//! map a file on disk into memory
+IReadFile* CMappedReadFile::createMappedFile(const io::path& fileName, long minSize)
+{
+	if (fileName.size() == 0)
+		return 0;
+
+	const void* data = 0;
+	long size = 0;
+
+#if defined(_IRR_WINDOWS_API_)
+#if defined(_IRR_WCHAR_FILESYSTEM)
+	HANDLE file = CreateFileW(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+		0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+#else
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+		0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+#endif
+	if (file == INVALID_HANDLE_VALUE)
+		return 0;
+
+	// larger files can't be handled with the long positions of IReadFile
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= minSize && fileSize.QuadPart <= LONG_MAX)
+	{
+		HANDLE mapping = CreateFileMapping(file, 0, PAGE_READONLY, 0, 0, 0);
+		if (mapping)
+		{
+			// the view keeps the mapping and the file open
+			data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			size = (long)fileSize.QuadPart;
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+#elif defined(_IRR_WCHAR_FILESYSTEM)
+	// no wide character open() on posix systems
+	return 0;
+#else
+	const int file = open(fileName.c_str(), O_RDONLY);
+	if (file < 0)
+		return 0;
+
+	// larger files can't be handled with the long positions of IReadFile
+	struct stat info;
+	if (fstat(file, &info) == 0 && S_ISREG(info.st_mode) &&
+		info.st_size >= (off_t)minSize && info.st_size <= (off_t)LONG_MAX)
+	{
+		// the mapping stays valid when the file is closed
+		data = mmap(0, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		if (data == MAP_FAILED)
+			data = 0;
+		size = (long)info.st_size;
+	}
+	close(file);
+#endif
+
+	if (!data)
+		return 0;
+
+	return new CMappedReadFile(fileName, data, size);
+}
+
+
+} // end namespace io
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_MAPPED_FILES_
+
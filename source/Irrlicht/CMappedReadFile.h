@@ -0,0 +1,73 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_MAPPED_READ_FILE_H_INCLUDED__
+#define __C_MAPPED_READ_FILE_H_INCLUDED__
+
+#include "IrrCompileConfig.h"
+
+#ifdef _IRR_COMPILE_WITH_MAPPED_FILES_
+
+#include "IReadFile.h"
+#include "irrString.h"
+
+namespace irr
+{
+
+namespace io
+{
+
+	/*!
+		Class for reading a real file from disk, which is mapped into memory.
+		Reading only copies from the mapping, and getBuffer() gives loaders
+		direct access to the contents.
+	*/
+	class CMappedReadFile : public IReadFile
+	{
+	public:
+
+		//! Destructor, unmaps the file
+		virtual ~CMappedReadFile();
+
+		//! returns how much was read
+		virtual s32 read(void* buffer, u32 sizeToRead);
+
+		//! changes position in file, returns true if successful
+		virtual bool seek(long finalPos, bool relativeMovement = false);
+
+		//! returns size of file
+		virtual long getSize() const;
+
+		//! returns where in the file we are.
+		virtual long getPos() const;
+
+		//! returns name of file
+		virtual const io::path& getFileName() const;
+
+		//! returns the contents of the file
+		virtual const void* getBuffer() const;
+
+		//! map a file on disk into memory
+		/** \param fileName Name of the file.
+		\param minSize Smaller files are not mapped.
+		\return The file, or 0 if it could not be opened or mapped, or is too small. */
+		static IReadFile* createMappedFile(const io::path& fileName, long minSize);
+
+	private:
+
+		CMappedReadFile(const io::path& fileName, const void* data, long size);
+
+		const c8* Data;
+		long Size;
+		long Pos;
+		io::path Filename;
+	};
+
+} // end namespace io
+} // end namespace irr
+
+#endif // _IRR_COMPILE_WITH_MAPPED_FILES_
+
+#endif
+
@@ -90,6 +90,13 @@ const io::path& CMemoryReadFile::getFileName() const
 }
 
 
+//! returns the memory of the file
+const void* CMemoryReadFile::getBuffer() const
+{
+	return Buffer;
+}
+
+
 CMemoryWriteFile::CMemoryWriteFile(void* memory, long len, const io::path& fileName, bool d)
 : Buffer(memory), Len(len), Pos(0), Filename(fileName), deleteMemoryWhenDropped(d)
 {
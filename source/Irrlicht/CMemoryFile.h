@@ -43,6 +43,9 @@ namespace io
 		//! returns name of file
 		virtual const io::path& getFileName() const;
 
+		//! returns the memory of the file
+		virtual const void* getBuffer() const;
+
 	private:
 
 		const void *Buffer;
@@ -9,12 +9,43 @@
 #include "os.h"
 #include "irrMap.h"
 #include "triangle3d.h"
+#include "CWorkerPool.h"
 
 namespace irr
 {
 namespace scene
 {
 
+#ifdef _IRR_COMPILE_WITH_THREADS_
+//! worker threads shared by the mesh manipulators for the normals of large mesh buffers
+static CWorkerPool* NormalsPool = 0;
+
+//! normals can also be recalculated by mesh loaders on the thread of the async loader
+static CWorkerLock NormalsPoolLock;
+#endif
+
+//! constructor
+CMeshManipulator::CMeshManipulator()
+: UsesNormalsPool(false)
+{
+}
+
+
+//! destructor
+CMeshManipulator::~CMeshManipulator()
+{
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	if (UsesNormalsPool)
+	{
+		NormalsPoolLock.lock();
+		if (NormalsPool->drop())
+			NormalsPool = 0;
+		NormalsPoolLock.unlock();
+	}
+#endif
+}
+
+
 static inline core::vector3df getAngleWeight(const core::vector3df& v1,
 		const core::vector3df& v2,
 		const core::vector3df& v3)
@@ -36,6 +67,137 @@ static inline core::vector3df getAngleWeight(const core::vector3df& v1,
 }
 
 
+//! vertex comparisons for createMeshWelded
+static inline bool weldEquals(const video::S3DVertex& a, const video::S3DVertex& b, f32 tolerance)
+{
+	return a.Pos.equals(b.Pos, tolerance) &&
+		a.Normal.equals(b.Normal, tolerance) &&
+		a.TCoords.equals(b.TCoords) &&
+		(a.Color == b.Color);
+}
+
+static inline bool weldEquals(const video::S3DVertex2TCoords& a, const video::S3DVertex2TCoords& b, f32 tolerance)
+{
+	return a.Pos.equals(b.Pos, tolerance) &&
+		a.Normal.equals(b.Normal, tolerance) &&
+		a.TCoords.equals(b.TCoords) &&
+		a.TCoords2.equals(b.TCoords2) &&
+		(a.Color == b.Color);
+}
+
+static inline bool weldEquals(const video::S3DVertexTangents& a, const video::S3DVertexTangents& b, f32 tolerance)
+{
+	return a.Pos.equals(b.Pos, tolerance) &&
+		a.Normal.equals(b.Normal, tolerance) &&
+		a.TCoords.equals(b.TCoords) &&
+		a.Tangent.equals(b.Tangent, tolerance) &&
+		a.Binormal.equals(b.Binormal, tolerance) &&
+		(a.Color == b.Color);
+}
+
+
+//! grid cell of a coordinate for createMeshWelded
+static inline s32 weldCell(f32 value, f32 invCellSize)
+{
+	return (s32)floorf(core::clamp(value * invCellSize, -1.0e9f, 1.0e9f));
+}
+
+
+//! hash bucket of a grid cell for createMeshWelded
+static inline u32 weldBucket(s32 x, s32 y, s32 z, u32 mask)
+{
+	return (((u32)x * 73856093u) ^ ((u32)y * 19349663u) ^ ((u32)z * 83492791u)) & mask;
+}
+
+
+//! Welds the vertices of a buffer.
+/** Each vertex is redirected to the first vertex before it which is equal
+within the tolerance, as a comparison with all previous vertices would do.
+The positions are put into a hashed grid, and only vertices in the cells
+overlapping the tolerance box of a vertex are compared. */
+template <class T>
+static void weldVertices(const T* v, u32 vertexCount, f32 tolerance,
+		core::array<T>& out, core::array<u16>& redirects)
+{
+	if (!vertexCount)
+		return;
+
+	// the cell size only changes the speed, any size finds all neighbours
+	core::aabbox3df box(v[0].Pos);
+	u32 i;
+	for (i=1; i<vertexCount; ++i)
+		box.addInternalPoint(v[i].Pos);
+	const core::vector3df extent = box.getExtent();
+	const f32 cellSize = core::max_(tolerance,
+		core::max_(extent.X, extent.Y, extent.Z) * (1.f / 1024.f),
+		core::ROUNDING_ERROR_f32);
+	const f32 invCellSize = 1.f / cellSize;
+
+	u32 bucketCount = 16;
+	while (bucketCount < vertexCount * 2)
+		bucketCount <<= 1;
+	const u32 mask = bucketCount - 1;
+
+	// vertices of a bucket are chained in ascending order
+	core::array<s32> head;
+	core::array<s32> tail;
+	core::array<s32> next;
+	head.set_used(bucketCount);
+	tail.set_used(bucketCount);
+	next.set_used(vertexCount);
+	for (i=0; i<bucketCount; ++i)
+	{
+		head[i] = -1;
+		tail[i] = -1;
+	}
+
+	for (i=0; i < vertexCount; ++i)
+	{
+		const core::vector3df& p = v[i].Pos;
+
+		// cells which can hold positions within the tolerance
+		const s32 x0 = weldCell(p.X - tolerance, invCellSize);
+		const s32 x1 = weldCell(p.X + tolerance, invCellSize);
+		const s32 y0 = weldCell(p.Y - tolerance, invCellSize);
+		const s32 y1 = weldCell(p.Y + tolerance, invCellSize);
+		const s32 z0 = weldCell(p.Z - tolerance, invCellSize);
+		const s32 z1 = weldCell(p.Z + tolerance, invCellSize);
+
+		s32 found = -1;
+		for (s32 x=x0; x<=x1; ++x)
+		for (s32 y=y0; y<=y1; ++y)
+		for (s32 z=z0; z<=z1; ++z)
+		{
+			for (s32 j=head[weldBucket(x, y, z, mask)]; j != -1 && (found == -1 || j < found); j=next[j])
+			{
+				if (weldEquals(v[i], v[j], tolerance))
+				{
+					found = j;
+					break;
+				}
+			}
+		}
+
+		if (found != -1)
+			redirects[i] = redirects[found];
+		else
+		{
+			redirects[i] = out.size();
+			out.push_back(v[i]);
+		}
+
+		const u32 bucket = weldBucket(weldCell(p.X, invCellSize),
+			weldCell(p.Y, invCellSize), weldCell(p.Z, invCellSize), mask);
+		next[i] = -1;
+		if (tail[bucket] == -1)
+			head[bucket] = i;
+		else
+			next[tail[bucket]] = i;
+		tail[bucket] = i;
+	}
+}
+
+
 //! Flips the direction of surfaces. Changes backfacing triangles to frontfacing
 //! triangles and vice versa.
 //! \param mesh: Mesh on which the operation is performed.
@@ -75,6 +237,123 @@ void CMeshManipulator::flipSurfaces(scene::IMesh* mesh) const
 
 namespace
 {
+//! mesh buffers with at least this many triangles calculate their normals on several threads
+const u32 PARALLEL_NORMALS_TRIANGLES = 65536;
+
+//! number of triangles or vertices handled by one work item of the normal job
+const u32 NORMAL_BLOCK_SIZE = 4096;
+
+//! calculates the normals of a large mesh buffer on the worker threads
+/** The first pass calculates the normals of blocks of triangles. The second
+pass sums them up for blocks of vertices, each vertex in the order of its
+triangles, so the results are the same as in the serial loops. */
+template <typename T>
+struct SRecalculateNormalsJob : public IWorkerJob
+{
+	virtual void execute(u32 block, u32 thread)
+	{
+		const u32 first = block * NORMAL_BLOCK_SIZE;
+
+		if (!SumPass)
+		{
+			const u32 last = core::min_(first + NORMAL_BLOCK_SIZE, TriangleNormals.size());
+			for (u32 i=first; i<last; ++i)
+			{
+				const core::vector3df& v1 = Buffer->getPosition(Indices[i*3+0]);
+				const core::vector3df& v2 = Buffer->getPosition(Indices[i*3+1]);
+				const core::vector3df& v3 = Buffer->getPosition(Indices[i*3+2]);
+				TriangleNormals[i] = core::plane3d<f32>(v1, v2, v3).Normal;
+
+				if (AngleWeighted)
+				{
+					const core::vector3df weight = irr::scene::getAngleWeight(v1, v2, v3);
+					Weights[i*3+0] = weight.X;
+					Weights[i*3+1] = weight.Y;
+					Weights[i*3+2] = weight.Z;
+				}
+			}
+			return;
+		}
+
+		const u32 last = core::min_(first + NORMAL_BLOCK_SIZE, VertexCorners.size()-1);
+		for (u32 v=first; v<last; ++v)
+		{
+			const u32 begin = VertexCorners[v];
+			const u32 end = VertexCorners[v+1];
+
+			// the last triangle of a vertex wins, unused vertices keep their normal
+			if (!Smooth)
+			{
+				if (begin != end)
+					Buffer->getNormal(v) = TriangleNormals[Corners[end-1]/3];
+				continue;
+			}
+
+			core::vector3df normal(0.f, 0.f, 0.f);
+			for (u32 c=begin; c<end; ++c)
+			{
+				const u32 corner = Corners[c];
+				const f32 weight = AngleWeighted ? Weights[corner] : 1.f;
+				normal += weight*TriangleNormals[corner/3];
+			}
+			Buffer->getNormal(v) = normal.normalize();
+		}
+	}
+
+	IMeshBuffer* Buffer;
+	const T* Indices;
+	bool Smooth;
+	bool AngleWeighted;
+	bool SumPass;
+
+	core::array<core::vector3df> TriangleNormals;
+	//! angle weights of the triangle corners
+	core::array<f32> Weights;
+	//! start of the corners of each vertex in Corners, one more entry than vertices
+	core::array<u32> VertexCorners;
+	//! indices into the index list, sorted by vertex
+	core::array<u32> Corners;
+};
+
+
+template <typename T>
+void recalculateNormalsParallel(CWorkerPool* pool, IMeshBuffer* buffer, bool smooth, bool angleWeighted)
+{
+	const u32 vtxcnt = buffer->getVertexCount();
+	const u32 idxcnt = buffer->getIndexCount() / 3 * 3;
+	const T* idx = reinterpret_cast<T*>(buffer->getIndices());
+
+	SRecalculateNormalsJob<T> job;
+	job.Buffer = buffer;
+	job.Indices = idx;
+	job.Smooth = smooth;
+	job.AngleWeighted = smooth && angleWeighted;
+	job.SumPass = false;
+	job.TriangleNormals.set_used(idxcnt / 3);
+	if (job.AngleWeighted)
+		job.Weights.set_used(idxcnt);
+
+	// sort the corners by vertex, counting sort keeps the order of the triangles
+	job.VertexCorners.set_used(vtxcnt + 1);
+	u32 i;
+	for (i=0; i<=vtxcnt; ++i)
+		job.VertexCorners[i] = 0;
+	for (i=0; i<idxcnt; ++i)
+		++job.VertexCorners[idx[i] + 1];
+	for (i=0; i<vtxcnt; ++i)
+		job.VertexCorners[i+1] += job.VertexCorners[i];
+
+	job.Corners.set_used(idxcnt);
+	core::array<u32> next(job.VertexCorners);
+	for (i=0; i<idxcnt; ++i)
+		job.Corners[next[idx[i]]++] = i;
+
+	pool->run(&job, (job.TriangleNormals.size() + NORMAL_BLOCK_SIZE - 1) / NORMAL_BLOCK_SIZE);
+	job.SumPass = true;
+	pool->run(&job, (vtxcnt + NORMAL_BLOCK_SIZE - 1) / NORMAL_BLOCK_SIZE);
+}
+
+
 template <typename T>
 void recalculateNormalsT(IMeshBuffer* buffer, bool smooth, bool angleWeighted)
 {
@@ -132,6 +411,30 @@ void CMeshManipulator::recalculateNormals(IMeshBuffer* buffer, bool smooth, bool
 	if (!buffer)
 		return;
 
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	// the threads stay around, meshes which are deformed at runtime
+	// recalculate their normals each frame
+	if (buffer->getIndexCount() / 3 >= PARALLEL_NORMALS_TRIANGLES && CWorkerPool::getProcessorCount() > 1)
+	{
+		NormalsPoolLock.lock();
+		if (!UsesNormalsPool)
+		{
+			if (NormalsPool)
+				NormalsPool->grab();
+			else
+				NormalsPool = new CWorkerPool();
+			UsesNormalsPool = true;
+		}
+
+		if (buffer->getIndexType()==video::EIT_16BIT)
+			recalculateNormalsParallel<u16>(NormalsPool, buffer, smooth, angleWeighted);
+		else
+			recalculateNormalsParallel<u32>(NormalsPool, buffer, smooth, angleWeighted);
+		NormalsPoolLock.unlock();
+		return;
+	}
+#endif
+
 	if (buffer->getIndexType()==video::EIT_16BIT)
 		recalculateNormalsT<u16>(buffer, smooth, angleWeighted);
 	else
@@ -801,27 +1104,7 @@ IMesh* CMeshManipulator::createMeshWelded(IMesh *mesh, f32 tolerance) const
 
 			buffer->Vertices.reallocate(vertexCount);
 
-			for (u32 i=0; i < vertexCount; ++i)
-			{
-				bool found = false;
-				for (u32 j=0; j < i; ++j)
-				{
-					if ( v[i].Pos.equals( v[j].Pos, tolerance) &&
-						 v[i].Normal.equals( v[j].Normal, tolerance) &&
-						 v[i].TCoords.equals( v[j].TCoords ) &&
-						(v[i].Color == v[j].Color) )
-					{
-						redirects[i] = redirects[j];
-						found = true;
-						break;
-					}
-				}
-				if (!found)
-				{
-					redirects[i] = buffer->Vertices.size();
-					buffer->Vertices.push_back(v[i]);
-				}
-			}
+			weldVertices(v, vertexCount, tolerance, buffer->Vertices, redirects);
 
 			break;
 		}
@@ -844,28 +1127,7 @@ IMesh* CMeshManipulator::createMeshWelded(IMesh *mesh, f32 tolerance) const
 
 			buffer->Vertices.reallocate(vertexCount);
 
-			for (u32 i=0; i < vertexCount; ++i)
-			{
-				bool found = false;
-				for (u32 j=0; j < i; ++j)
-				{
-					if ( v[i].Pos.equals( v[j].Pos, tolerance) &&
-						 v[i].Normal.equals( v[j].Normal, tolerance) &&
-						 v[i].TCoords.equals( v[j].TCoords ) &&
-						 v[i].TCoords2.equals( v[j].TCoords2 ) &&
-						(v[i].Color == v[j].Color) )
-					{
-						redirects[i] = redirects[j];
-						found = true;
-						break;
-					}
-				}
-				if (!found)
-				{
-					redirects[i] = buffer->Vertices.size();
-					buffer->Vertices.push_back(v[i]);
-				}
-			}
+			weldVertices(v, vertexCount, tolerance, buffer->Vertices, redirects);
 			break;
 		}
 		case video::EVT_TANGENTS:
@@ -887,29 +1149,7 @@ IMesh* CMeshManipulator::createMeshWelded(IMesh *mesh, f32 tolerance) const
 
 			buffer->Vertices.reallocate(vertexCount);
 
-			for (u32 i=0; i < vertexCount; ++i)
-			{
-				bool found = false;
-				for (u32 j=0; j < i; ++j)
-				{
-					if ( v[i].Pos.equals( v[j].Pos, tolerance) &&
-						 v[i].Normal.equals( v[j].Normal, tolerance) &&
-						 v[i].TCoords.equals( v[j].TCoords ) &&
-						 v[i].Tangent.equals( v[j].Tangent, tolerance ) &&
-						 v[i].Binormal.equals( v[j].Binormal, tolerance ) &&
-						(v[i].Color == v[j].Color) )
-					{
-						redirects[i] = redirects[j];
-						found = true;
-						break;
-					}
-				}
-				if (!found)
-				{
-					redirects[i] = buffer->Vertices.size();
-					buffer->Vertices.push_back(v[i]);
-				}
-			}
+			weldVertices(v, vertexCount, tolerance, buffer->Vertices, redirects);
 			break;
 		}
 		default:
@@ -20,6 +20,12 @@ not intended for doing mesh modifications and/or animations during runtime.
 class CMeshManipulator : public IMeshManipulator
 {
 public:
+	//! constructor
+	CMeshManipulator();
+
+	//! destructor
+	virtual ~CMeshManipulator();
+
 	//! Flips the direction of surfaces.
 	/** Changes backfacing triangles to frontfacing triangles and vice versa.
 	\param mesh: Mesh on which the operation is performed. */
@@ -92,6 +98,11 @@ public:
 
 	//! Optimizes the mesh using an algorithm tuned for heightmaps
 	virtual void heightmapOptimizeMesh(IMeshBuffer * const m, const f32 tolerance = core::ROUNDING_ERROR_f32) const;
+
+private:
+
+	//! true if this manipulator holds a reference to the worker threads for normals
+	mutable bool UsesNormalsPool;
 };
 
 } // end namespace scene
@@ -3,6 +3,8 @@
 // For conditions of distribution and use, see copyright notice in irrlicht.h
 
 #include "CMetaTriangleSelector.h"
+#include "IAnimatedMeshSceneNode.h"
+#include "os.h"
 
 namespace irr
 {
@@ -11,6 +13,7 @@ namespace scene
 
 //! constructor
 CMetaTriangleSelector::CMetaTriangleSelector()
+: BoxRoot(-1), FreeBoxNode(-1), BoxTreeTime(0), NewSelectors(false)
 {
 	#ifdef _DEBUG
 	setDebugName("CMetaTriangleSelector");
@@ -36,6 +39,25 @@ s32 CMetaTriangleSelector::getTriangleCount() const
 }
 
 
+//! Gets a box around the triangles of all selectors, in world space.
+bool CMetaTriangleSelector::getTransformedBoundingBox(core::aabbox3df& outBox) const
+{
+	for (u32 i=0; i<TriangleSelectors.size(); ++i)
+	{
+		core::aabbox3df box;
+		if (!TriangleSelectors[i]->getTransformedBoundingBox(box))
+			return false;
+
+		if (i)
+			outBox.addInternalBox(box);
+		else
+			outBox = box;
+	}
+
+	return !TriangleSelectors.empty();
+}
+
+
 //! Gets all triangles.
 void CMetaTriangleSelector::getTriangles(core::triangle3df* triangles, s32 arraySize,
 		s32& outTriangleCount, const core::matrix4* transform) const
@@ -60,11 +82,14 @@ void CMetaTriangleSelector::getTriangles(core::triangle3df* triangles, s32 array
 		s32& outTriangleCount, const core::aabbox3d<f32>& box,
 		const core::matrix4* transform) const
 {
+	updateBoxTree();
+	querySelectors(box);
+
 	s32 outWritten = 0;
-	for (u32 i=0; i<TriangleSelectors.size(); ++i)
+	for (u32 j=0; j<QueriedSelectors.size(); ++j)
 	{
 		s32 t = 0;
-		TriangleSelectors[i]->getTriangles(triangles + outWritten,
+		TriangleSelectors[QueriedSelectors[j]]->getTriangles(triangles + outWritten,
 				arraySize - outWritten, t, box, transform);
 		outWritten += t;
 		if (outWritten==arraySize)
@@ -80,11 +105,17 @@ void CMetaTriangleSelector::getTriangles(core::triangle3df* triangles, s32 array
 		s32& outTriangleCount, const core::line3d<f32>& line,
 		const core::matrix4* transform) const
 {
+	core::aabbox3df box(line.start);
+	box.addInternalPoint(line.end);
+
+	updateBoxTree();
+	querySelectors(box);
+
 	s32 outWritten = 0;
-	for (u32 i=0; i<TriangleSelectors.size(); ++i)
+	for (u32 j=0; j<QueriedSelectors.size(); ++j)
 	{
 		s32 t = 0;
-		TriangleSelectors[i]->getTriangles(triangles + outWritten,
+		TriangleSelectors[QueriedSelectors[j]]->getTriangles(triangles + outWritten,
 				arraySize - outWritten, t, line, transform);
 		outWritten += t;
 		if (outWritten==arraySize)
@@ -103,6 +134,10 @@ void CMetaTriangleSelector::addTriangleSelector(ITriangleSelector* toAdd)
 		return;
 
 	TriangleSelectors.push_back(toAdd);
+	SelectorStates.push_back(SSelectorState());
+	SelectorStates.getLast().Leaf = -1;
+	SelectorStates.getLast().Valid = false;
+	NewSelectors = true;
 	toAdd->grab();
 }
 
@@ -114,8 +149,22 @@ bool CMetaTriangleSelector::removeTriangleSelector(ITriangleSelector* toRemove)
 	{
 		if (toRemove == TriangleSelectors[i])
 		{
+			if (SelectorStates[i].Leaf >= 0)
+			{
+				removeLeaf(SelectorStates[i].Leaf);
+				freeBoxNode(SelectorStates[i].Leaf);
+			}
+
 			TriangleSelectors[i]->drop();
 			TriangleSelectors.erase(i);
+			SelectorStates.erase(i);
+
+			// leaves of the following selectors point to their new index
+			for (u32 j=i; j<SelectorStates.size(); ++j)
+			{
+				if (SelectorStates[j].Leaf >= 0)
+					BoxNodes[SelectorStates[j].Leaf].Selector = j;
+			}
 			return true;
 		}
 	}
@@ -131,6 +180,267 @@ void CMetaTriangleSelector::removeAllTriangleSelectors()
 		TriangleSelectors[i]->drop();
 
 	TriangleSelectors.clear();
+	SelectorStates.clear();
+	BoxNodes.clear();
+	BoxRoot = -1;
+	FreeBoxNode = -1;
+}
+
+
+//! fetches the boxes of the changed selectors and moves the leaves of those which left their box
+void CMetaTriangleSelector::updateBoxTree() const
+{
+	// nodes move between frames, or anytime while the timer is stopped
+	const u32 time = os::Timer::getTime();
+	const bool checkAll = (time != BoxTreeTime) || os::Timer::isStopped();
+	if (!checkAll && !NewSelectors)
+		return;
+
+	BoxTreeTime = time;
+	NewSelectors = false;
+
+	for (u32 i=0; i<TriangleSelectors.size(); ++i)
+	{
+		if (!checkAll && SelectorStates[i].Valid)
+			continue;
+		if (!updateSelectorState(i))
+			continue;
+
+		SelectorStates[i].Valid = true;
+		s32 leaf = SelectorStates[i].Leaf;
+
+		core::aabbox3df box;
+		if (!TriangleSelectors[i]->getTransformedBoundingBox(box))
+		{
+			if (leaf >= 0)
+			{
+				removeLeaf(leaf);
+				freeBoxNode(leaf);
+				SelectorStates[i].Leaf = -1;
+			}
+			continue;
+		}
+
+		if (leaf >= 0)
+		{
+			if (box.isFullInside(BoxNodes[leaf].Box))
+				continue;
+			removeLeaf(leaf);
+		}
+		else
+		{
+			leaf = allocateBoxNode();
+			BoxNodes[leaf].Left = -1;
+			BoxNodes[leaf].Right = -1;
+			BoxNodes[leaf].Selector = i;
+			SelectorStates[i].Leaf = leaf;
+		}
+
+		// reserve some space around the box for small movements
+		const core::vector3df margin = box.getExtent() * 0.25f;
+		BoxNodes[leaf].Box.MinEdge = box.MinEdge - margin;
+		BoxNodes[leaf].Box.MaxEdge = box.MaxEdge + margin;
+		insertLeaf(leaf);
+	}
+}
+
+
+//! checks if the node of a selector changed since its box was fetched
+bool CMetaTriangleSelector::updateSelectorState(u32 index) const
+{
+	SSelectorState& state = SelectorStates[index];
+	const ITriangleSelector* selector = TriangleSelectors[index];
+
+	// selectors of several nodes are always updated
+	if (selector->getSelectorCount() != 1)
+		return true;
+
+	// the boxes of selectors without node don't move
+	const ISceneNode* node = selector->getSceneNodeForTriangle(0);
+	if (!node)
+		return !state.Valid;
+
+	const f32 frame = (node->getType() == ESNT_ANIMATED_MESH) ?
+		static_cast<const IAnimatedMeshSceneNode*>(node)->getFrameNr() : 0.f;
+	const core::matrix4& transform = node->getAbsoluteTransformation();
+	const core::aabbox3df& nodeBox = node->getBoundingBox();
+
+	if (state.Valid && state.Frame == frame && state.Transform == transform && state.NodeBox == nodeBox)
+		return false;
+
+	state.Frame = frame;
+	state.Transform = transform;
+	state.NodeBox = nodeBox;
+	return true;
+}
+
+
+//! collects the indices of the selectors which may have triangles in the box
+/** The indices are sorted, so the triangles are returned in the order
+of the selectors like without the tree. */
+void CMetaTriangleSelector::querySelectors(const core::aabbox3df& box) const
+{
+	QueriedSelectors.set_used(0);
+
+	for (u32 i=0; i<SelectorStates.size(); ++i)
+	{
+		if (SelectorStates[i].Leaf < 0)
+			QueriedSelectors.push_back(i);
+	}
+
+	QueryStack.set_used(0);
+	if (BoxRoot >= 0)
+		QueryStack.push_back(BoxRoot);
+
+	while (!QueryStack.empty())
+	{
+		const SBoxNode& node = BoxNodes[QueryStack.getLast()];
+		QueryStack.erase(QueryStack.size()-1);
+
+		if (!node.Box.intersectsWithBox(box))
+			continue;
+
+		if (node.Left < 0)
+			QueriedSelectors.push_back(node.Selector);
+		else
+		{
+			QueryStack.push_back(node.Left);
+			QueryStack.push_back(node.Right);
+		}
+	}
+
+	QueriedSelectors.sort();
+}
+
+
+s32 CMetaTriangleSelector::allocateBoxNode() const
+{
+	if (FreeBoxNode < 0)
+	{
+		BoxNodes.push_back(SBoxNode());
+		return BoxNodes.size() - 1;
+	}
+
+	const s32 node = FreeBoxNode;
+	FreeBoxNode = BoxNodes[node].Parent;
+	return node;
+}
+
+
+void CMetaTriangleSelector::freeBoxNode(s32 node) const
+{
+	BoxNodes[node].Parent = FreeBoxNode;
+	FreeBoxNode = node;
+}
+
+
+//! adds a leaf to the tree, next to the node for which the tree grows least
+void CMetaTriangleSelector::insertLeaf(s32 leaf) const
+{
+	if (BoxRoot < 0)
+	{
+		BoxRoot = leaf;
+		BoxNodes[leaf].Parent = -1;
+		return;
+	}
+
+	const core::aabbox3df leafBox = BoxNodes[leaf].Box;
+
+	// descend while it is cheaper to grow a child than to put the leaf next to the node
+	s32 sibling = BoxRoot;
+	while (BoxNodes[sibling].Left >= 0)
+	{
+		const SBoxNode& node = BoxNodes[sibling];
+
+		core::aabbox3df combined(node.Box);
+		combined.addInternalBox(leafBox);
+		const f32 combinedArea = combined.getArea();
+
+		// a new parent here costs its area, the parents above grow by the same for all choices
+		const f32 cost = 2.f * combinedArea;
+		const f32 inheritance = 2.f * (combinedArea - node.Box.getArea());
+
+		f32 childCost[2];
+		const s32 children[2] = { node.Left, node.Right };
+		for (u32 c=0; c<2; ++c)
+		{
+			const SBoxNode& child = BoxNodes[children[c]];
+			core::aabbox3df box(child.Box);
+			box.addInternalBox(leafBox);
+			childCost[c] = box.getArea() + inheritance;
+			if (child.Left >= 0)
+				childCost[c] -= child.Box.getArea();
+		}
+
+		if (cost < childCost[0] && cost < childCost[1])
+			break;
+
+		sibling = childCost[0] < childCost[1] ? node.Left : node.Right;
+	}
+
+	const s32 oldParent = BoxNodes[sibling].Parent;
+	const s32 newParent = allocateBoxNode();
+	SBoxNode& parent = BoxNodes[newParent];
+	parent.Parent = oldParent;
+	parent.Left = sibling;
+	parent.Right = leaf;
+	parent.Selector = -1;
+	parent.Box = BoxNodes[sibling].Box;
+	parent.Box.addInternalBox(leafBox);
+	BoxNodes[sibling].Parent = newParent;
+	BoxNodes[leaf].Parent = newParent;
+
+	if (oldParent < 0)
+		BoxRoot = newParent;
+	else if (BoxNodes[oldParent].Left == sibling)
+		BoxNodes[oldParent].Left = newParent;
+	else
+		BoxNodes[oldParent].Right = newParent;
+
+	// grow the boxes above
+	for (s32 i=oldParent; i>=0; i=BoxNodes[i].Parent)
+	{
+		SBoxNode& node = BoxNodes[i];
+		node.Box = BoxNodes[node.Left].Box;
+		node.Box.addInternalBox(BoxNodes[node.Right].Box);
+	}
+}
+
+
+//! takes a leaf out of the tree, its parent is replaced by the sibling
+void CMetaTriangleSelector::removeLeaf(s32 leaf) const
+{
+	if (leaf == BoxRoot)
+	{
+		BoxRoot = -1;
+		return;
+	}
+
+	const s32 parent = BoxNodes[leaf].Parent;
+	const s32 grandParent = BoxNodes[parent].Parent;
+	const s32 sibling = BoxNodes[parent].Left == leaf ? BoxNodes[parent].Right : BoxNodes[parent].Left;
+
+	BoxNodes[sibling].Parent = grandParent;
+	freeBoxNode(parent);
+
+	if (grandParent < 0)
+	{
+		BoxRoot = sibling;
+		return;
+	}
+
+	if (BoxNodes[grandParent].Left == parent)
+		BoxNodes[grandParent].Left = sibling;
+	else
+		BoxNodes[grandParent].Right = sibling;
+
+	// shrink the boxes above
+	for (s32 i=grandParent; i>=0; i=BoxNodes[i].Parent)
+	{
+		SBoxNode& node = BoxNodes[i];
+		node.Box = BoxNodes[node.Left].Box;
+		node.Box.addInternalBox(BoxNodes[node.Right].Box);
+	}
 }
 
 
@@ -7,6 +7,7 @@
 
 #include "IMetaTriangleSelector.h"
 #include "irrArray.h"
+#include "matrix4.h"
 
 namespace irr
 {
@@ -27,6 +28,9 @@ public:
 	//! Get amount of all available triangles in this selector
 	virtual s32 getTriangleCount() const;
 
+	//! Gets a box around the triangles of all selectors, in world space.
+	virtual bool getTransformedBoundingBox(core::aabbox3df& outBox) const;
+
 	//! Gets all triangles.
 	virtual void getTriangles(core::triangle3df* triangles, s32 arraySize,
 		s32& outTriangleCount, const core::matrix4* transform=0) const;
@@ -65,7 +69,60 @@ public:
 
 private:
 
+	//! node of the tree over the bounding boxes of the selectors
+	/** Leaves have no children and reserve an enlarged box for their
+	selector, so it can move a bit without changing the tree. Unused
+	nodes are chained by Parent. */
+	struct SBoxNode
+	{
+		core::aabbox3df Box;
+		s32 Parent;
+		s32 Left;
+		s32 Right;
+		s32 Selector;
+	};
+
+	//! the leaf of a selector, and what its box was fetched for
+	/** The box of a selector only changes with the transformation,
+	bounding box or frame of its node. */
+	struct SSelectorState
+	{
+		core::matrix4 Transform;
+		core::aabbox3df NodeBox;
+		f32 Frame;
+		//! leaf of the selector, -1 if it has no box and is always queried
+		s32 Leaf;
+		//! false until the box of the selector was fetched
+		bool Valid;
+	};
+
+	//! fetches the boxes of the changed selectors and moves the leaves of those which left their box
+	/** The selectors are checked once for each time of the timer, so
+	further queries of the same frame only walk the tree. */
+	void updateBoxTree() const;
+
+	//! checks if the node of a selector changed since its box was fetched
+	bool updateSelectorState(u32 index) const;
+
+	//! collects the indices of the selectors which may have triangles in the box
+	void querySelectors(const core::aabbox3df& box) const;
+
+	s32 allocateBoxNode() const;
+	void freeBoxNode(s32 node) const;
+	void insertLeaf(s32 leaf) const;
+	void removeLeaf(s32 leaf) const;
+
 	core::array<ITriangleSelector*> TriangleSelectors;
+
+	mutable core::array<SSelectorState> SelectorStates;
+	mutable core::array<SBoxNode> BoxNodes;
+	mutable s32 BoxRoot;
+	mutable s32 FreeBoxNode;
+	mutable u32 BoxTreeTime;
+	mutable bool NewSelectors;
+
+	mutable core::array<s32> QueryStack;
+	mutable core::array<u32> QueriedSelectors;
 };
 
 } // end namespace scene
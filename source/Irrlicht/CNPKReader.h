@@ -107,6 +107,9 @@ namespace io
 		//! returns the list of files
 		virtual const IFileList* getFileList() const;
 
+		//! Check if files are opened by looking them up in the file list
+		virtual bool opensFilesByFileList() const { return true; }
+
 		//! get the class Type
 		virtual E_FILE_ARCHIVE_TYPE getType() const { return EFAT_NPK; }
 
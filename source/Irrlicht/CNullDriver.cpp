@@ -15,6 +15,8 @@
 #include "CMeshManipulator.h"
 #include "CColorConverter.h"
 #include "IAttributeExchangingObject.h"
+#include "CWorkerPool.h"
+#include "CQueuedLogger.h"
 
 
 namespace irr
@@ -83,9 +85,76 @@ IImageWriter* createImageWriterPNG();
 //! creates a writer which is able to save ppm images
 IImageWriter* createImageWriterPPM();
 
+namespace
+{
+	//! findTexture() for other threads
+	struct SFindTextureCall : public IMainThreadCall
+	{
+		SFindTextureCall(IVideoDriver* driver, const io::path& filename)
+			: Driver(driver), Filename(filename), Texture(0) {}
+
+		virtual void call() { Texture = Driver->findTexture(Filename); }
+
+		IVideoDriver* Driver;
+		const io::path& Filename;
+		ITexture* Texture;
+	};
+
+	//! addTexture() of an image for other threads
+	struct SAddTextureCall : public IMainThreadCall
+	{
+		SAddTextureCall(IVideoDriver* driver, const io::path& name, IImage* image, void* mipmapData)
+			: Driver(driver), Name(name), Image(image), MipmapData(mipmapData), Texture(0) {}
+
+		virtual void call() { Texture = Driver->addTexture(Name, Image, MipmapData); }
+
+		IVideoDriver* Driver;
+		const io::path& Name;
+		IImage* Image;
+		void* MipmapData;
+		ITexture* Texture;
+	};
+
+	//! makeNormalMapTexture() for other threads
+	struct SNormalMapCall : public IMainThreadCall
+	{
+		SNormalMapCall(const IVideoDriver* driver, ITexture* texture, f32 amplitude)
+			: Driver(driver), Texture(texture), Amplitude(amplitude) {}
+
+		virtual void call() { Driver->makeNormalMapTexture(Texture, Amplitude); }
+
+		const IVideoDriver* Driver;
+		ITexture* Texture;
+		f32 Amplitude;
+	};
+
+	//! decodes the images of preloadTextures() on several threads
+	class CPreloadJob : public IWorkerJob
+	{
+	public:
+		CPreloadJob(IVideoDriver* driver, const core::array<io::IReadFile*>& files,
+				core::array<IImage*>& images, ILogger* logger)
+			: Driver(driver), Files(files), Images(images), Logger(logger) {}
+
+		virtual void execute(u32 item, u32 thread)
+		{
+			// the logger of the device is only used by the calling thread
+			os::Printer::setThreadLogger(Logger);
+			Images[item] = Driver->createImageFromFile(Files[item]);
+			os::Printer::setThreadLogger(0);
+		}
+
+		IVideoDriver* Driver;
+		const core::array<io::IReadFile*>& Files;
+		core::array<IImage*>& Images;
+		ILogger* Logger;
+	};
+} // end anonymous namespace
+
+
 //! constructor
 CNullDriver::CNullDriver(io::IFileSystem* io, const core::dimension2d<u32>& screenSize)
-: FileSystem(io), MeshManipulator(0), ViewPort(0,0,0,0), ScreenSize(screenSize),
+: FileSystem(io), TextureRequestHandler(0), MeshManipulator(0), ViewPort(0,0,0,0), ScreenSize(screenSize),
 	PrimitivesDrawn(0), MinVertexCountForVBO(500), TextureCreationFlags(0),
 	OverrideMaterial2DEnabled(false), AllowZWriteOnTransparent(false)
 {
@@ -426,6 +495,9 @@ void CNullDriver::renameTexture(ITexture* texture, const io::path& newName)
 //! loads a Texture
 ITexture* CNullDriver::getTexture(const io::path& filename)
 {
+	if (TextureRequestHandler && TextureRequestHandler->isBackgroundThread())
+		return TextureRequestHandler->requestTexture(filename, 0);
+
 	// Identify textures by their absolute filenames if possible.
 	const io::path absolutePath = FileSystem->getAbsolutePath(filename);
 
@@ -480,6 +552,9 @@ ITexture* CNullDriver::getTexture(const io::path& filename)
 //! loads a Texture
 ITexture* CNullDriver::getTexture(io::IReadFile* file)
 {
+	if (file && TextureRequestHandler && TextureRequestHandler->isBackgroundThread())
+		return TextureRequestHandler->requestTexture("", file);
+
 	ITexture* texture = 0;
 
 	if (file)
@@ -505,6 +580,161 @@ ITexture* CNullDriver::getTexture(io::IReadFile* file)
 }
 
 
+//! Loads several textures at once.
+bool CNullDriver::preloadTextures(const core::array<io::path>& filenames,
+		u32 threadCount, u32 memoryLimit)
+{
+	bool result = true;
+
+	// the textures of a loader thread are created one by one anyway
+	if (TextureRequestHandler && TextureRequestHandler->isBackgroundThread())
+	{
+		for (u32 i=0; i<filenames.size(); ++i)
+		{
+			if (!getTexture(filenames[i]))
+				result = false;
+		}
+		return result;
+	}
+
+	CWorkerPool* pool = new CWorkerPool(threadCount);
+	CQueuedLogger logger;
+	core::array<io::IReadFile*> files;
+	core::map<io::path, bool> names;
+
+	// the size of the images is only known after decoding, so the memory
+	// of a batch is estimated from the sizes of the previous images
+	f64 fileBytes = 0.0;
+	f64 imageBytes = 0.0;
+	f64 batchMemory = 0.0;
+
+	for (u32 i=0; i<filenames.size(); ++i)
+	{
+		const io::path& filename = filenames[i];
+
+		// same lookup as getTexture()
+		const io::path absolutePath = FileSystem->getAbsolutePath(filename);
+		if (findTexture(absolutePath) || findTexture(filename))
+			continue;
+
+		io::IReadFile* file = FileSystem->createAndOpenFile(absolutePath);
+		if (!file)
+			file = FileSystem->createAndOpenFile(filename);
+
+		if (!file)
+		{
+			os::Printer::log("Could not open file of texture", filename, ELL_WARNING);
+			result = false;
+			continue;
+		}
+
+		if (findTexture(file->getFileName()) || names.find(file->getFileName()))
+		{
+			file->drop();
+			continue;
+		}
+		names.insert(file->getFileName(), true);
+
+		// files of archives share the file handle of the archive
+		if (!file->getBuffer())
+		{
+			const long size = file->getSize();
+			c8* data = new c8[size];
+			const s32 read = file->read(data, size);
+			io::IReadFile* copy = FileSystem->createMemoryReadFile(data, core::max_(read, 0), file->getFileName(), true);
+			file->drop();
+			file = copy;
+		}
+
+		const f64 ratio = fileBytes > 0.0 ? imageBytes / fileBytes : 4.0;
+		const f64 memory = file->getSize() * (1.0 + ratio);
+		if (memoryLimit && files.size() && batchMemory + memory > memoryLimit)
+		{
+			if (!addPreloadedTextures(files, pool, logger, imageBytes))
+				result = false;
+			batchMemory = 0.0;
+		}
+
+		files.push_back(file);
+		fileBytes += file->getSize();
+		batchMemory += memory;
+	}
+
+	if (!addPreloadedTextures(files, pool, logger, imageBytes))
+		result = false;
+
+	pool->drop();
+	return result;
+}
+
+
+//! decodes the images of preloadTextures() on the pool and adds their textures
+bool CNullDriver::addPreloadedTextures(core::array<io::IReadFile*>& files, CWorkerPool* pool,
+		CQueuedLogger& logger, f64& imageBytes)
+{
+	core::array<IImage*> images;
+	images.set_used(files.size());
+
+	CPreloadJob job(this, files, images, &logger);
+	pool->run(&job, files.size());
+	logger.flush();
+
+	bool result = true;
+	const u32 textureCount = Textures.size();
+
+	for (u32 i=0; i<files.size(); ++i)
+	{
+		const io::path& name = files[i]->getFileName();
+		ITexture* texture = 0;
+
+		if (images[i])
+		{
+			imageBytes += images[i]->getImageDataSizeInBytes();
+			texture = createDeviceDependentTexture(images[i], name);
+			images[i]->drop();
+		}
+
+		if (texture)
+		{
+			os::Printer::log("Loaded texture", name);
+
+			// keeps the reference of the creation, like addTexture() and drop()
+			SSurface s;
+			s.Surface = texture;
+			Textures.push_back(s);
+		}
+		else
+		{
+			os::Printer::log("Could not load texture", name, ELL_ERROR);
+			result = false;
+		}
+
+		files[i]->drop();
+	}
+
+	// once for all new textures, instead of once per texture in addTexture()
+	if (Textures.size() != textureCount)
+		Textures.sort();
+
+	files.clear();
+	return result;
+}
+
+
+//! Sets the handler which gets textures for other threads, 0 to remove it
+void CNullDriver::setTextureRequestHandler(ITextureRequestHandler* handler)
+{
+	TextureRequestHandler = handler;
+}
+
+
+//! Returns the handler which gets textures for other threads
+ITextureRequestHandler* CNullDriver::getTextureRequestHandler() const
+{
+	return TextureRequestHandler;
+}
+
+
 //! opens the file and loads it into the surface
 video::ITexture* CNullDriver::loadTextureFromFile(io::IReadFile* file, const io::path& hashName )
 {
@@ -550,6 +780,14 @@ void CNullDriver::addTexture(video::ITexture* texture)
 //! looks if the image is already loaded
 video::ITexture* CNullDriver::findTexture(const io::path& filename)
 {
+	// the search may sort the textures
+	if (TextureRequestHandler && TextureRequestHandler->isBackgroundThread())
+	{
+		SFindTextureCall findCall(this, filename);
+		TextureRequestHandler->callOnMainThread(findCall);
+		return findCall.Texture;
+	}
+
 	SSurface s;
 	SDummyTexture dummy(filename);
 	s.Surface = &dummy;
@@ -595,6 +833,14 @@ ITexture* CNullDriver::addTexture(const io::path& name, IImage* image, void* mip
 	if ( 0 == name.size() || !image)
 		return 0;
 
+	// textures are created by the thread of the device
+	if (TextureRequestHandler && TextureRequestHandler->isBackgroundThread())
+	{
+		SAddTextureCall addCall(this, name, image, mipmapData);
+		TextureRequestHandler->callOnMainThread(addCall);
+		return addCall.Texture;
+	}
+
 	ITexture* t = createDeviceDependentTexture(image, name, mipmapData);
 	if (t)
 	{
@@ -1170,6 +1416,13 @@ void CNullDriver::makeNormalMapTexture(video::ITexture* texture, f32 amplitude)
 	if (!texture)
 		return;
 
+	if (TextureRequestHandler && TextureRequestHandler->isBackgroundThread())
+	{
+		SNormalMapCall normalMapCall(this, texture, amplitude);
+		TextureRequestHandler->callOnMainThread(normalMapCall);
+		return;
+	}
+
 	if (texture->getColorFormat() != ECF_A1R5G5B5 &&
 		texture->getColorFormat() != ECF_A8R8G8B8 )
 	{
@@ -1551,13 +1804,25 @@ void CNullDriver::drawMeshBuffer(const scene::IMeshBuffer* mb)
 	if (!mb)
 		return;
 
+	drawMeshBuffer(mb, mb->getIndexCount()/3);
+}
+
+
+//! Draws the first triangles of a mesh buffer
+void CNullDriver::drawMeshBuffer(const scene::IMeshBuffer* mb, u32 primitiveCount)
+{
+	if (!mb)
+		return;
+
+	primitiveCount = core::min_(primitiveCount, mb->getIndexCount()/3);
+
 	//IVertexBuffer and IIndexBuffer later
 	SHWBufferLink *HWBuffer=getBufferLink(mb);
 
 	if (HWBuffer)
-		drawHardwareBuffer(HWBuffer);
+		drawHardwareBuffer(HWBuffer, primitiveCount);
 	else
-		drawVertexPrimitiveList(mb->getVertices(), mb->getVertexCount(), mb->getIndices(), mb->getIndexCount()/3, mb->getVertexType(), scene::EPT_TRIANGLES, mb->getIndexType());
+		drawVertexPrimitiveList(mb->getVertices(), mb->getVertexCount(), mb->getIndices(), primitiveCount, mb->getVertexType(), scene::EPT_TRIANGLES, mb->getIndexType());
 }
 
 
@@ -28,6 +28,8 @@
 
 namespace irr
 {
+	class CWorkerPool;
+	class CQueuedLogger;
 namespace io
 {
 	class IWriteFile;
@@ -38,6 +40,34 @@ namespace video
 	class IImageLoader;
 	class IImageWriter;
 
+	//! Work which has to be done on the main thread, see ITextureRequestHandler
+	class IMainThreadCall
+	{
+	public:
+
+		virtual ~IMainThreadCall() {}
+
+		virtual void call() = 0;
+	};
+
+	//! Does the texture work of loaders which run on other threads, see CAsyncLoader
+	class ITextureRequestHandler
+	{
+	public:
+
+		virtual ~ITextureRequestHandler() {}
+
+		//! Returns true if the calling thread must not touch the textures
+		virtual bool isBackgroundThread() const = 0;
+
+		//! Gets a texture from the main thread, waits until it's there
+		/** Either filename or file is set, see the getTexture() methods. */
+		virtual ITexture* requestTexture(const io::path& filename, io::IReadFile* file) = 0;
+
+		//! Executes a call on the main thread, waits until it's done
+		virtual void callOnMainThread(IMainThreadCall& call) = 0;
+	};
+
 	class CNullDriver : public IVideoDriver, public IGPUProgrammingServices
 	{
 	public:
@@ -88,6 +118,10 @@ namespace video
 		//! loads a Texture
 		virtual ITexture* getTexture(io::IReadFile* file);
 
+		//! Loads several textures at once.
+		virtual bool preloadTextures(const core::array<io::path>& filenames,
+				u32 threadCount=0, u32 memoryLimit=0);
+
 		//! Returns a texture by index
 		virtual ITexture* getTextureByIndex(u32 index);
 
@@ -379,6 +413,9 @@ namespace video
 		//! Draws a mesh buffer
 		virtual void drawMeshBuffer(const scene::IMeshBuffer* mb);
 
+		//! Draws the first triangles of a mesh buffer
+		virtual void drawMeshBuffer(const scene::IMeshBuffer* mb, u32 primitiveCount);
+
 		//! Draws the normals of a mesh buffer
 		virtual void drawMeshBufferNormals(const scene::IMeshBuffer* mb, f32 length=10.f, SColor color=0xffffffff);
 
@@ -415,7 +452,7 @@ namespace video
 		virtual bool updateHardwareBuffer(SHWBufferLink *HWBuffer) {return false;}
 
 		//! Draw hardware buffer (only some drivers can)
-		virtual void drawHardwareBuffer(SHWBufferLink *HWBuffer) {}
+		virtual void drawHardwareBuffer(SHWBufferLink *HWBuffer, u32 primitiveCount) {}
 
 		//! Delete hardware buffer
 		virtual void deleteHardwareBuffer(SHWBufferLink *HWBuffer);
@@ -668,6 +705,13 @@ namespace video
 				const c8* name=0);
 
 		virtual bool checkDriverReset() {return false;}
+
+		//! Sets the handler which gets textures for other threads, 0 to remove it
+		void setTextureRequestHandler(ITextureRequestHandler* handler);
+
+		//! Returns the handler which gets textures for other threads
+		ITextureRequestHandler* getTextureRequestHandler() const;
+
 	protected:
 
 		//! deletes all textures
@@ -679,6 +723,10 @@ namespace video
 		//! adds a surface, not loaded or created by the Irrlicht Engine
 		void addTexture(ITexture* surface);
 
+		//! decodes the images of preloadTextures() on the pool and adds their textures
+		bool addPreloadedTextures(core::array<io::IReadFile*>& files, CWorkerPool* pool,
+				CQueuedLogger& logger, f64& imageBytes);
+
 		//! returns a device dependent texture from a software surface (IImage)
 		//! THIS METHOD HAS TO BE OVERRIDDEN BY DERIVED DRIVERS WITH OWN TEXTURES
 		virtual ITexture* createDeviceDependentTexture(IImage* surface, const io::path& name, void* mipmapData=0);
@@ -822,6 +870,7 @@ namespace video
 		core::map< const scene::IMeshBuffer* , SHWBufferLink* > HWBufferMap;
 
 		io::IFileSystem* FileSystem;
+		ITextureRequestHandler* TextureRequestHandler;
 
 		//! mesh manipulator
 		scene::IMeshManipulator* MeshManipulator;
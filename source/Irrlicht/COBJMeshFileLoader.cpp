@@ -80,9 +80,16 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 	const io::path fullName = file->getFileName();
 	const io::path relPath = FileSystem->getFileDir(fullName)+"/";
 
-	c8* buf = new c8[filesize];
-	memset(buf, 0, filesize);
-	file->read((void*)buf, filesize);
+	// parse files in memory directly, copy the others
+	c8* copy = 0;
+	const c8* buf = (const c8*)file->getBuffer();
+	if (!buf)
+	{
+		copy = new c8[filesize];
+		memset(copy, 0, filesize);
+		file->read((void*)copy, filesize);
+		buf = copy;
+	}
 	const c8* const bufEnd = buf+filesize;
 
 	// Process obj information
@@ -110,7 +117,7 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 			break;
 
 		case 'v':               // v, vn, vt
-			switch(bufPtr[1])
+			switch((bufPtr+1 != bufEnd) ? bufPtr[1] : 0)
 			{
 			case ' ':          // vertex
 				{
@@ -255,7 +262,7 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 			}
 
 			// triangulate the face
-			for ( u32 i = 1; i < faceCorners.size() - 1; ++i )
+			for ( u32 i = 1; i+1 < faceCorners.size(); ++i )
 			{
 				// Add a triangle
 				currMtl->Meshbuffer->Indices.push_back( faceCorners[i+1] );
@@ -310,7 +317,7 @@ IAnimatedMesh* COBJMeshFileLoader::createMesh(io::IReadFile* file)
 	}
 
 	// Clean up the allocate obj file contents
-	delete [] buf;
+	delete [] copy;
 	// more cleaning up
 	cleanUp();
 	mesh->drop();
@@ -543,7 +550,7 @@ void COBJMeshFileLoader::readMTL(const c8* fileName, const io::path& relPath)
 			case 'N':
 			if ( currMaterial )
 			{
-				switch(bufPtr[1])
+				switch((bufPtr+1 != bufEnd) ? bufPtr[1] : 0)
 				{
 				case 's': // Ns - shininess
 					{
@@ -570,7 +577,7 @@ void COBJMeshFileLoader::readMTL(const c8* fileName, const io::path& relPath)
 			case 'K':
 			if ( currMaterial )
 			{
-				switch(bufPtr[1])
+				switch((bufPtr+1 != bufEnd) ? bufPtr[1] : 0)
 				{
 				case 'd':		// Kd = diffuse
 					{
@@ -622,7 +629,7 @@ void COBJMeshFileLoader::readMTL(const c8* fileName, const io::path& relPath)
 			case 'T':
 			if ( currMaterial )
 			{
-				switch ( bufPtr[1] )
+				switch ( (bufPtr+1 != bufEnd) ? bufPtr[1] : 0 )
 				{
 				case 'f':		// Tf - Transmitivity
 					const u32 COLOR_BUFFER_LENGTH = 16;
@@ -802,9 +809,9 @@ u32 COBJMeshFileLoader::copyWord(c8* outBuf, const c8* const inBuf, u32 outBufLe
 	}
 
 	u32 i = 0;
-	while(inBuf[i])
+	while(&(inBuf[i]) != bufEnd && inBuf[i])
 	{
-		if (core::isspace(inBuf[i]) || &(inBuf[i]) == bufEnd)
+		if (core::isspace(inBuf[i]))
 			break;
 		++i;
 	}
@@ -705,7 +705,7 @@ bool COGLES2Driver::endScene()
 
 
 	//! Draw hardware buffer
-	void COGLES2Driver::drawHardwareBuffer(SHWBufferLink *_HWBuffer)
+	void COGLES2Driver::drawHardwareBuffer(SHWBufferLink *_HWBuffer, u32 primitiveCount)
 	{
 		if (!_HWBuffer)
 			return;
@@ -734,7 +734,7 @@ bool COGLES2Driver::endScene()
 
 
 		drawVertexPrimitiveList(vertices, mb->getVertexCount(),
-				indexList, mb->getIndexCount() / 3,
+				indexList, primitiveCount,
 				mb->getVertexType(), scene::EPT_TRIANGLES,
 				mb->getIndexType());
 
@@ -645,7 +645,7 @@ void COGLES1Driver::deleteHardwareBuffer(SHWBufferLink *_HWBuffer)
 
 
 //! Draw hardware buffer
-void COGLES1Driver::drawHardwareBuffer(SHWBufferLink *_HWBuffer)
+void COGLES1Driver::drawHardwareBuffer(SHWBufferLink *_HWBuffer, u32 primitiveCount)
 {
 	if (!_HWBuffer)
 		return;
@@ -674,7 +674,7 @@ void COGLES1Driver::drawHardwareBuffer(SHWBufferLink *_HWBuffer)
 
 
 	drawVertexPrimitiveList(vertices, mb->getVertexCount(), indexList,
-			mb->getIndexCount()/3, mb->getVertexType(),
+			primitiveCount, mb->getVertexType(),
 			scene::EPT_TRIANGLES, mb->getIndexType());
 
 	if (HWBuffer->Mapped_Vertex!=scene::EHM_NEVER)
@@ -83,7 +83,7 @@ namespace video
 		virtual void deleteHardwareBuffer(SHWBufferLink *HWBuffer);
 
 		//! Draw hardware buffer
-		virtual void drawHardwareBuffer(SHWBufferLink *HWBuffer);
+		virtual void drawHardwareBuffer(SHWBufferLink *HWBuffer, u32 primitiveCount);
 
 		//! draws a vertex primitive list
 		virtual void drawVertexPrimitiveList(const void* vertices, u32 vertexCount,
@@ -104,7 +104,7 @@ namespace video
 		virtual void deleteHardwareBuffer(SHWBufferLink *HWBuffer);
 
 		//! Draw hardware buffer
-		virtual void drawHardwareBuffer(SHWBufferLink *HWBuffer);
+		virtual void drawHardwareBuffer(SHWBufferLink *HWBuffer, u32 primitiveCount);
 
 		//! Create occlusion query.
 		/** Use node for identification and mesh for occlusion test. */
@@ -43,6 +43,9 @@ public:
 	//! creates/loads an animated mesh from the file.
 	virtual IAnimatedMesh* createMesh(io::IReadFile* file);
 
+	//! Returns true if createMesh() may be called on a background thread.
+	virtual bool canLoadInBackground() const { return true; }
+
 private:
 
 	struct SPLYProperty
@@ -0,0 +1,378 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CPagedTerrainSceneNode.h"
+#include "CTerrainSceneNode.h"
+#include "ISceneManager.h"
+#include "ICameraSceneNode.h"
+#include "IFileSystem.h"
+#include "IReadFile.h"
+#include "os.h"
+
+namespace irr
+{
+namespace scene
+{
+
+	//! constructor
+	CPagedTerrainSceneNode::CPagedTerrainSceneNode(ISceneNode* parent, ISceneManager* mgr,
+			io::IFileSystem* fs, io::IReadFile* file, s32 id,
+			s32 tileSize, s32 tileCountX, s32 tileCountZ,
+			s32 bitsPerPixel, bool signedData, bool floatVals,
+			const core::vector3df& position, const core::vector3df& scale,
+			video::SColor vertexColor, s32 maxLOD, E_TERRAIN_PATCH_SIZE patchSize)
+	: IPagedTerrainSceneNode(parent, mgr, id, position, scale),
+	FileSystem(fs), File(file), Queue(0), VertexColor(vertexColor),
+	TileSize(tileSize), TileCountX(tileCountX), TileCountZ(tileCountZ),
+	BitsPerPixel(bitsPerPixel), MaxLOD(maxLOD), PatchSize(patchSize),
+	LoadRadius(2), TCoordScale1(1.0f), TCoordScale2(0.0f),
+	SignedData(signedData), FloatVals(floatVals)
+	{
+		#ifdef _DEBUG
+		setDebugName("CPagedTerrainSceneNode");
+		#endif
+
+		if (FileSystem)
+			FileSystem->grab();
+		if (File)
+			File->grab();
+
+		// only one thread reads the file
+		Queue = new CWorkerQueue(1);
+		Reader.Terrain = this;
+
+		TileStates.set_used(TileCountX * TileCountZ);
+		for (u32 i=0; i<TileStates.size(); ++i)
+			TileStates[i] = ETLS_UNLOADED;
+
+		setAutomaticCulling(EAC_OFF);
+		updateAbsolutePosition();
+		updateBoundingBox();
+	}
+
+
+	//! destructor
+	CPagedTerrainSceneNode::~CPagedTerrainSceneNode()
+	{
+		// stops reading before the file is closed
+		Queue->drop();
+
+		for (u32 i=0; i<Tiles.size(); ++i)
+			Tiles[i].Node->drop();
+
+		if (File)
+			File->drop();
+		if (FileSystem)
+			FileSystem->drop();
+	}
+
+
+	//! Loads and removes tiles around the active camera
+	void CPagedTerrainSceneNode::OnRegisterSceneNode()
+	{
+		if (IsVisible)
+		{
+			ICameraSceneNode* camera = SceneManager->getActiveCamera();
+			if (camera)
+				updateTiles(camera->getAbsolutePosition(), false);
+
+			for (u32 i=0; i<Tiles.size(); ++i)
+				Tiles[i].Node->getMaterial(0) = Material;
+		}
+
+		ISceneNode::OnRegisterSceneNode();
+	}
+
+
+	//! Returns the bounding box of the loaded tiles, in world coordinates
+	const core::aabbox3d<f32>& CPagedTerrainSceneNode::getBoundingBox() const
+	{
+		return BoundingBox;
+	}
+
+
+	//! Returns the material used for all tiles
+	video::SMaterial& CPagedTerrainSceneNode::getMaterial(u32 i)
+	{
+		return Material;
+	}
+
+
+	//! Returns amount of materials used by this scene node ( always 1 )
+	u32 CPagedTerrainSceneNode::getMaterialCount() const
+	{
+		return 1;
+	}
+
+
+	//! Get a loaded tile
+	ITerrainSceneNode* CPagedTerrainSceneNode::getTile(s32 tileX, s32 tileZ) const
+	{
+		for (u32 i=0; i<Tiles.size(); ++i)
+		{
+			if (Tiles[i].X == tileX && Tiles[i].Z == tileZ)
+				return (ITerrainSceneNode*)Tiles[i].Node;
+		}
+		return 0;
+	}
+
+
+	//! Set how many tiles around the tile of the camera are loaded
+	void CPagedTerrainSceneNode::setLoadRadius(s32 radius)
+	{
+		LoadRadius = core::max_(radius, 0);
+	}
+
+
+	//! Loads all missing tiles around a position at once.
+	void CPagedTerrainSceneNode::loadTilesAround(const core::vector3df& position)
+	{
+		updateTiles(position, true);
+	}
+
+
+	//! Get the height of the terrain at a position
+	f32 CPagedTerrainSceneNode::getHeight(f32 x, f32 z) const
+	{
+		s32 tileX, tileZ;
+		getTileAt(core::vector3df(x, 0.f, z), tileX, tileZ);
+
+		const ITerrainSceneNode* tile = getTile(tileX, tileZ);
+		return tile ? tile->getHeight(x, z) : -FLT_MAX;
+	}
+
+
+	//! Scales the texture coordinates of the tiles
+	void CPagedTerrainSceneNode::scaleTexture(f32 scale, f32 scale2)
+	{
+		TCoordScale1 = scale;
+		TCoordScale2 = scale2;
+
+		for (u32 i=0; i<Tiles.size(); ++i)
+			Tiles[i].Node->scaleTexture(TCoordScale1, TCoordScale2);
+	}
+
+
+	//! requests, collects, creates and removes tiles
+	void CPagedTerrainSceneNode::updateTiles(const core::vector3df& position, bool wait)
+	{
+		s32 centerX, centerZ;
+		getTileAt(position, centerX, centerZ);
+
+		// Remove the tiles which are too far away. One more ring is
+		// kept, so tiles don't flicker when the camera moves along a
+		// tile border.
+		const s32 keepRadius = LoadRadius + 1;
+		bool changed = false;
+		for (u32 i=0; i<Tiles.size();)
+		{
+			if (core::abs_(Tiles[i].X - centerX) > keepRadius ||
+				core::abs_(Tiles[i].Z - centerZ) > keepRadius)
+			{
+				TileStates[Tiles[i].X * TileCountZ + Tiles[i].Z] = ETLS_UNLOADED;
+				Tiles[i].Node->remove();
+				Tiles[i].Node->drop();
+				Tiles[i] = Tiles.getLast();
+				Tiles.erase(Tiles.size()-1);
+				changed = true;
+			}
+			else
+				++i;
+		}
+
+		if (wait)
+		{
+			// each round may free requests for more tiles
+			u32 created;
+			do
+			{
+				requestTiles(centerX, centerZ);
+				Queue->waitForAll();
+				created = createReadTiles(centerX, centerZ, LOAD_REQUEST_COUNT);
+				changed |= (created != 0);
+			} while (created);
+		}
+		else
+		{
+			changed |= (createReadTiles(centerX, centerZ, 1) != 0);
+			requestTiles(centerX, centerZ);
+		}
+
+		if (changed)
+			updateBoundingBox();
+	}
+
+
+	//! creates the terrains of the nearest read tiles
+	u32 CPagedTerrainSceneNode::createReadTiles(s32 centerX, s32 centerZ, u32 maxCount)
+	{
+		IWorkerJob* job;
+		u32 item;
+		while (Queue->popFinished(job, item))
+			Requests[item].State = ERS_READ;
+
+		const s32 keepRadius = LoadRadius + 1;
+		u32 count = 0;
+		while (count < maxCount)
+		{
+			s32 nearest = -1;
+			s32 nearestDistance = 0;
+			for (s32 i=0; i<LOAD_REQUEST_COUNT; ++i)
+			{
+				if (Requests[i].State != ERS_READ)
+					continue;
+
+				const s32 distance = core::max_(core::abs_(Requests[i].X - centerX),
+					core::abs_(Requests[i].Z - centerZ));
+
+				// the camera moved away while the tile was read
+				if (distance > keepRadius)
+				{
+					TileStates[Requests[i].X * TileCountZ + Requests[i].Z] = ETLS_UNLOADED;
+					Requests[i].State = ERS_FREE;
+					continue;
+				}
+
+				if (nearest < 0 || distance < nearestDistance)
+				{
+					nearest = i;
+					nearestDistance = distance;
+				}
+			}
+
+			if (nearest < 0)
+				break;
+
+			createTile(Requests[nearest]);
+			++count;
+		}
+		return count;
+	}
+
+
+	//! finds the tile containing a position
+	void CPagedTerrainSceneNode::getTileAt(const core::vector3df& position, s32& tileX, s32& tileZ) const
+	{
+		const core::vector3df& scale = getScale();
+		const core::vector3df pos = position - getAbsolutePosition();
+		tileX = core::floor32(pos.X / (scale.X * (TileSize - 1)));
+		tileZ = core::floor32(pos.Z / (scale.Z * (TileSize - 1)));
+	}
+
+
+	//! starts reading the missing tiles nearest to the center tile
+	void CPagedTerrainSceneNode::requestTiles(s32 centerX, s32 centerZ)
+	{
+		s32 request = 0;
+		for (s32 ring=0; ring<=LoadRadius; ++ring)
+		{
+			for (s32 x=centerX-ring; x<=centerX+ring; ++x)
+			{
+				if (x < 0 || x >= TileCountX)
+					continue;
+
+				for (s32 z=centerZ-ring; z<=centerZ+ring; ++z)
+				{
+					if (z < 0 || z >= TileCountZ)
+						continue;
+
+					// only the tiles on the border of the ring
+					if (core::abs_(x - centerX) != ring && core::abs_(z - centerZ) != ring)
+						continue;
+
+					u8& state = TileStates[x * TileCountZ + z];
+					if (state != ETLS_UNLOADED)
+						continue;
+
+					while (request < LOAD_REQUEST_COUNT && Requests[request].State != ERS_FREE)
+						++request;
+					if (request == LOAD_REQUEST_COUNT)
+						return;
+
+					SLoadRequest& r = Requests[request];
+					r.X = x;
+					r.Z = z;
+					r.State = ERS_READING;
+					r.Failed = false;
+					r.Data.set_used(TileSize * TileSize * (BitsPerPixel / 8));
+					state = ETLS_LOADING;
+
+					Queue->enqueue(&Reader, request);
+				}
+			}
+		}
+	}
+
+
+	//! reads the data of a load request on the background thread
+	void CPagedTerrainSceneNode::STileReader::execute(u32 item, u32 thread)
+	{
+		SLoadRequest& r = Terrain->Requests[item];
+		const long tile = r.X * Terrain->TileCountZ + r.Z;
+
+		// addPagedTerrainSceneNode() makes sure that the offsets fit into long
+		r.Failed = !Terrain->File->seek(tile * (long)r.Data.size()) ||
+			Terrain->File->read(r.Data.pointer(), r.Data.size()) != (s32)r.Data.size();
+	}
+
+
+	//! creates the terrain of a read tile
+	void CPagedTerrainSceneNode::createTile(SLoadRequest& request)
+	{
+		request.State = ERS_FREE;
+		u8& state = TileStates[request.X * TileCountZ + request.Z];
+
+		if (request.Failed)
+		{
+			os::Printer::log("Could not read tile of paged terrain", File->getFileName(), ELL_ERROR);
+			state = ETLS_FAILED;
+			return;
+		}
+
+		const core::vector3df& scale = getScale();
+		const core::vector3df position = getAbsolutePosition() + core::vector3df(
+			request.X * (TileSize - 1) * scale.X, 0.f, request.Z * (TileSize - 1) * scale.Z);
+
+		CTerrainSceneNode* node = new CTerrainSceneNode(0, SceneManager, FileSystem, -1,
+			MaxLOD, PatchSize, position, core::vector3df(0.f, 0.f, 0.f), scale);
+
+		io::IReadFile* file = FileSystem->createMemoryReadFile(request.Data.pointer(),
+			request.Data.size(), File->getFileName(), false);
+
+		const bool loaded = node->loadHeightMapRAW(file, BitsPerPixel, SignedData, FloatVals,
+			TileSize, VertexColor, 0);
+		file->drop();
+
+		if (!loaded)
+		{
+			node->drop();
+			state = ETLS_FAILED;
+			return;
+		}
+
+		node->scaleTexture(TCoordScale1, TCoordScale2);
+		node->getMaterial(0) = Material;
+		addChild(node);
+
+		STile tile;
+		tile.X = request.X;
+		tile.Z = request.Z;
+		tile.Node = node;
+		Tiles.push_back(tile);
+		state = ETLS_LOADED;
+	}
+
+
+	//! recalculates the bounding box from the loaded tiles
+	void CPagedTerrainSceneNode::updateBoundingBox()
+	{
+		BoundingBox.reset(getAbsolutePosition());
+		for (u32 i=0; i<Tiles.size(); ++i)
+			BoundingBox.addInternalBox(Tiles[i].Node->getBoundingBox());
+	}
+
+
+} // end namespace scene
+} // end namespace irr
+
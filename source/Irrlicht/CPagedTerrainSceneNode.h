@@ -0,0 +1,184 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_PAGED_TERRAIN_SCENE_NODE_H_INCLUDED__
+#define __C_PAGED_TERRAIN_SCENE_NODE_H_INCLUDED__
+
+#include "IPagedTerrainSceneNode.h"
+#include "ETerrainElements.h"
+#include "CWorkerPool.h"
+
+namespace irr
+{
+namespace io
+{
+	class IFileSystem;
+	class IReadFile;
+}
+namespace scene
+{
+	class CTerrainSceneNode;
+
+	//! A terrain which is streamed from a tiled heightmap file.
+	/** The file is read on a background thread. The terrains of the tiles
+	are created on the main thread, at most one per frame. */
+	class CPagedTerrainSceneNode : public IPagedTerrainSceneNode
+	{
+	public:
+
+		//! constructor
+		CPagedTerrainSceneNode(ISceneNode* parent, ISceneManager* mgr,
+			io::IFileSystem* fs, io::IReadFile* file, s32 id,
+			s32 tileSize, s32 tileCountX, s32 tileCountZ,
+			s32 bitsPerPixel, bool signedData, bool floatVals,
+			const core::vector3df& position, const core::vector3df& scale,
+			video::SColor vertexColor, s32 maxLOD, E_TERRAIN_PATCH_SIZE patchSize);
+
+		//! destructor
+		virtual ~CPagedTerrainSceneNode();
+
+		//! Loads and removes tiles around the active camera
+		virtual void OnRegisterSceneNode();
+
+		//! Does nothing, the tiles render themselves
+		virtual void render() {}
+
+		//! Returns the bounding box of the loaded tiles, in world coordinates
+		virtual const core::aabbox3d<f32>& getBoundingBox() const;
+
+		//! Returns the material used for all tiles
+		virtual video::SMaterial& getMaterial(u32 i);
+
+		//! Returns amount of materials used by this scene node ( always 1 )
+		virtual u32 getMaterialCount() const;
+
+		//! Returns type of the scene node
+		virtual ESCENE_NODE_TYPE getType() const { return ESNT_PAGED_TERRAIN; }
+
+		//! Get the number of tiles along the X axis
+		virtual s32 getTileCountX() const { return TileCountX; }
+
+		//! Get the number of tiles along the Z axis
+		virtual s32 getTileCountZ() const { return TileCountZ; }
+
+		//! Get a loaded tile
+		virtual ITerrainSceneNode* getTile(s32 tileX, s32 tileZ) const;
+
+		//! Get the number of tiles which are currently loaded
+		virtual u32 getLoadedTileCount() const { return Tiles.size(); }
+
+		//! Set how many tiles around the tile of the camera are loaded
+		virtual void setLoadRadius(s32 radius);
+
+		//! Get how many tiles around the tile of the camera are loaded
+		virtual s32 getLoadRadius() const { return LoadRadius; }
+
+		//! Loads all missing tiles around a position at once.
+		virtual void loadTilesAround(const core::vector3df& position);
+
+		//! Get the height of the terrain at a position
+		virtual f32 getHeight(f32 x, f32 z) const;
+
+		//! Scales the texture coordinates of the tiles
+		virtual void scaleTexture(f32 scale = 1.0f, f32 scale2 = 0.0f);
+
+	private:
+
+		enum E_TILE_STATE
+		{
+			ETLS_UNLOADED = 0,
+			ETLS_LOADING,
+			ETLS_LOADED,
+			ETLS_FAILED
+		};
+
+		enum E_REQUEST_STATE
+		{
+			ERS_FREE = 0,
+			ERS_READING,
+			ERS_READ
+		};
+
+		//! a tile which is in memory
+		struct STile
+		{
+			s32 X;
+			s32 Z;
+			CTerrainSceneNode* Node;
+		};
+
+		//! a tile which is read from the file, the data is reused for the next tile
+		struct SLoadRequest
+		{
+			SLoadRequest() : X(0), Z(0), State(ERS_FREE), Failed(false) {}
+
+			s32 X;
+			s32 Z;
+			E_REQUEST_STATE State;
+			bool Failed;
+			core::array<u8> Data;
+		};
+
+		//! reads the data of load requests on the background thread
+		struct STileReader : public IWorkerJob
+		{
+			virtual void execute(u32 item, u32 thread);
+
+			CPagedTerrainSceneNode* Terrain;
+		};
+
+		//! number of tiles which are read at the same time
+		enum { LOAD_REQUEST_COUNT = 4 };
+
+		//! requests, collects, creates and removes tiles
+		/** \param wait Blocks until all tiles around the position are loaded. */
+		void updateTiles(const core::vector3df& position, bool wait);
+
+		//! finds the tile containing a position
+		void getTileAt(const core::vector3df& position, s32& tileX, s32& tileZ) const;
+
+		//! starts reading the missing tiles nearest to the center tile
+		void requestTiles(s32 centerX, s32 centerZ);
+
+		//! creates the terrains of the nearest read tiles
+		/** \return Number of handled tiles. */
+		u32 createReadTiles(s32 centerX, s32 centerZ, u32 maxCount);
+
+		//! creates the terrain of a read tile
+		void createTile(SLoadRequest& request);
+
+		//! recalculates the bounding box from the loaded tiles
+		void updateBoundingBox();
+
+		io::IFileSystem* FileSystem;
+		io::IReadFile* File;
+		CWorkerQueue* Queue;
+		STileReader Reader;
+
+		core::array<u8> TileStates;
+		core::array<STile> Tiles;
+		SLoadRequest Requests[LOAD_REQUEST_COUNT];
+
+		core::aabbox3df BoundingBox;
+		video::SMaterial Material;
+		video::SColor VertexColor;
+
+		s32 TileSize;
+		s32 TileCountX;
+		s32 TileCountZ;
+		s32 BitsPerPixel;
+		s32 MaxLOD;
+		E_TERRAIN_PATCH_SIZE PatchSize;
+		s32 LoadRadius;
+		f32 TCoordScale1;
+		f32 TCoordScale2;
+		bool SignedData;
+		bool FloatVals;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -5,6 +5,10 @@
 #include "CParticleAttractionAffector.h"
 #include "IAttributes.h"
 
+#ifdef _IRR_COMPILE_WITH_SSE2_
+#include <emmintrin.h>
+#endif
+
 namespace irr
 {
 namespace scene
@@ -15,7 +19,7 @@ CParticleAttractionAffector::CParticleAttractionAffector(
 		const core::vector3df& point, f32 speed, bool attract,
 		bool affectX, bool affectY, bool affectZ )
 	: Point(point), Speed(speed), AffectX(affectX), AffectY(affectY),
-		AffectZ(affectZ), Attract(attract), LastTime(0)
+		AffectZ(affectZ), Attract(attract), LastTime(0), TimeDelta(0.0f)
 {
 	#ifdef _DEBUG
 	setDebugName("CParticleAttractionAffector");
@@ -57,6 +61,79 @@ void CParticleAttractionAffector::affect(u32 now, SParticle* particlearray, u32
 	}
 }
 
+
+//! Advances the time of the last update for affectArrays()
+bool CParticleAttractionAffector::prepareAffectArrays(u32 now)
+{
+	if( LastTime == 0 )
+		TimeDelta = 0.0f;
+	else
+		TimeDelta = ( now - LastTime ) / 1000.0f;
+	LastTime = now;
+
+	return true;
+}
+
+
+//! Affects particles stored in arrays, 4 at once.
+bool CParticleAttractionAffector::affectArrays(u32 now, SParticleArrays& particles)
+{
+	const f32 timeDelta = TimeDelta;
+	if( !Enabled || timeDelta == 0.0f )
+		return true;
+
+	const f32 speed = Attract ? Speed * timeDelta : -Speed * timeDelta;
+	u32 i=0;
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+	const __m128 px = _mm_set1_ps(Point.X);
+	const __m128 py = _mm_set1_ps(Point.Y);
+	const __m128 pz = _mm_set1_ps(Point.Z);
+	const __m128 s = _mm_set1_ps(speed);
+	const __m128 zero = _mm_setzero_ps();
+
+	for (; i<particles.Count; i+=4)
+	{
+		const __m128 x = _mm_load_ps(particles.PosX+i);
+		const __m128 y = _mm_load_ps(particles.PosY+i);
+		const __m128 z = _mm_load_ps(particles.PosZ+i);
+		const __m128 dx = _mm_sub_ps(px, x);
+		const __m128 dy = _mm_sub_ps(py, y);
+		const __m128 dz = _mm_sub_ps(pz, z);
+
+		// particles at the point don't move, like with vector3df::normalize()
+		const __m128 length = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+		const __m128 f = _mm_and_ps(_mm_cmpneq_ps(length, zero), _mm_div_ps(s, _mm_sqrt_ps(length)));
+
+		if( AffectX )
+			_mm_store_ps(particles.PosX+i, _mm_add_ps(x, _mm_mul_ps(dx, f)));
+		if( AffectY )
+			_mm_store_ps(particles.PosY+i, _mm_add_ps(y, _mm_mul_ps(dy, f)));
+		if( AffectZ )
+			_mm_store_ps(particles.PosZ+i, _mm_add_ps(z, _mm_mul_ps(dz, f)));
+	}
+#endif
+
+	for (; i<particles.Count; ++i)
+	{
+		core::vector3df direction(Point.X - particles.PosX[i],
+			Point.Y - particles.PosY[i], Point.Z - particles.PosZ[i]);
+		direction.normalize();
+		direction *= speed;
+
+		if( AffectX )
+			particles.PosX[i] += direction.X;
+
+		if( AffectY )
+			particles.PosY[i] += direction.Y;
+
+		if( AffectZ )
+			particles.PosZ[i] += direction.Z;
+	}
+
+	return true;
+}
+
 //! Writes attributes of the object.
 void CParticleAttractionAffector::serializeAttributes(io::IAttributes* out, io::SAttributeReadWriteOptions* options) const
 {
@@ -25,6 +25,12 @@ public:
 	//! Affects a particle.
 	virtual void affect(u32 now, SParticle* particlearray, u32 count);
 
+	//! Affects particles stored in arrays, 4 at once.
+	virtual bool affectArrays(u32 now, SParticleArrays& particles);
+
+	//! Advances the time of the last update for affectArrays()
+	virtual bool prepareAffectArrays(u32 now);
+
 	//! Set the point that particles will attract to
 	virtual void setPoint( const core::vector3df& point ) { Point = point; }
 
@@ -77,6 +83,9 @@ private:
 	bool AffectZ;
 	bool Attract;
 	u32 LastTime;
+
+	//! seconds since the last update, set by prepareAffectArrays()
+	f32 TimeDelta;
 };
 
 } // end namespace scene
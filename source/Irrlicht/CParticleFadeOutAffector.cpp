@@ -6,6 +6,10 @@
 #include "IAttributes.h"
 #include "os.h"
 
+#ifdef _IRR_COMPILE_WITH_SSE2_
+#include <emmintrin.h>
+#endif
+
 namespace irr
 {
 namespace scene
@@ -44,6 +48,71 @@ void CParticleFadeOutAffector::affect(u32 now, SParticle* particlearray, u32 cou
 }
 
 
+//! Affects particles stored in arrays, 4 at once.
+bool CParticleFadeOutAffector::affectArrays(u32 now, SParticleArrays& particles)
+{
+	if (!Enabled)
+		return true;
+
+	u32 i=0;
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+	const __m128i n = _mm_set1_epi32(now);
+	const __m128i channel = _mm_set1_epi32(0xff);
+	const __m128 fadeOutTime = _mm_set1_ps(FadeOutTime);
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 ta = _mm_set1_ps((f32)TargetColor.getAlpha());
+	const __m128 tr = _mm_set1_ps((f32)TargetColor.getRed());
+	const __m128 tg = _mm_set1_ps((f32)TargetColor.getGreen());
+	const __m128 tb = _mm_set1_ps((f32)TargetColor.getBlue());
+
+	for (; i<particles.Count; i+=4)
+	{
+		// only particles with less than FadeOutTime left, endTime-now is unsigned in affect()
+		const __m128i diff = _mm_sub_epi32(_mm_load_si128((const __m128i*)(particles.EndTime+i)), n);
+		const __m128 left = _mm_cvtepi32_ps(diff);
+		const __m128 mask = _mm_andnot_ps(_mm_castsi128_ps(_mm_cmplt_epi32(diff, _mm_setzero_si128())),
+			_mm_cmplt_ps(left, fadeOutTime));
+		if (!_mm_movemask_ps(mask))
+			continue;
+
+		const __m128 d = _mm_div_ps(left, fadeOutTime);
+		const __m128 inv = _mm_sub_ps(one, d);
+
+		// interpolate each channel and round like SColor::getInterpolated
+		const __m128i start = _mm_load_si128((const __m128i*)(particles.StartColor+i));
+		const __m128i a = _mm_cvttps_epi32(_mm_add_ps(_mm_add_ps(_mm_mul_ps(ta, inv),
+			_mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(start, 24)), d)), half));
+		const __m128i r = _mm_cvttps_epi32(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tr, inv),
+			_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(start, 16), channel)), d)), half));
+		const __m128i g = _mm_cvttps_epi32(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tg, inv),
+			_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(start, 8), channel)), d)), half));
+		const __m128i b = _mm_cvttps_epi32(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tb, inv),
+			_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(start, channel)), d)), half));
+
+		const __m128i color = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(a, 24), _mm_slli_epi32(r, 16)),
+			_mm_or_si128(_mm_slli_epi32(g, 8), b));
+		const __m128i old = _mm_load_si128((const __m128i*)(particles.Color+i));
+		const __m128i m = _mm_castps_si128(mask);
+		_mm_store_si128((__m128i*)(particles.Color+i),
+			_mm_or_si128(_mm_and_si128(m, color), _mm_andnot_si128(m, old)));
+	}
+#endif
+
+	for (; i<particles.Count; ++i)
+	{
+		if (particles.EndTime[i] - now < FadeOutTime)
+		{
+			const f32 d = (particles.EndTime[i] - now) / FadeOutTime;
+			particles.Color[i] = particles.StartColor[i].getInterpolated(TargetColor, d);
+		}
+	}
+
+	return true;
+}
+
+
 //! Writes attributes of the object.
 //! Implement this to expose the attributes of your scene node animator for
 //! scripting languages, editors, debuggers or xml serialization purposes.
@@ -23,6 +23,12 @@ public:
 	//! Affects a particle.
 	virtual void affect(u32 now, SParticle* particlearray, u32 count);
 
+	//! Affects particles stored in arrays, 4 at once.
+	virtual bool affectArrays(u32 now, SParticleArrays& particles);
+
+	//! Returns true, the particles can be affected in parts
+	virtual bool prepareAffectArrays(u32 now) { return true; }
+
 	//! Sets the targetColor, i.e. the color the particles will interpolate
 	//! to over time.
 	virtual void setTargetColor( const video::SColor& targetColor ) { TargetColor = targetColor; }
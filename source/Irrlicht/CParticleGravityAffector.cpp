@@ -6,6 +6,10 @@
 #include "os.h"
 #include "IAttributes.h"
 
+#ifdef _IRR_COMPILE_WITH_SSE2_
+#include <emmintrin.h>
+#endif
+
 namespace irr
 {
 namespace scene
@@ -42,6 +46,52 @@ void CParticleGravityAffector::affect(u32 now, SParticle* particlearray, u32 cou
 	}
 }
 
+
+//! Affects particles stored in arrays, 4 at once.
+bool CParticleGravityAffector::affectArrays(u32 now, SParticleArrays& particles)
+{
+	if (!Enabled)
+		return true;
+
+	u32 i=0;
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+	const __m128i n = _mm_set1_epi32(now);
+	const __m128 timeForceLost = _mm_set1_ps(TimeForceLost);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.f);
+	const __m128 gx = _mm_set1_ps(Gravity.X);
+	const __m128 gy = _mm_set1_ps(Gravity.Y);
+	const __m128 gz = _mm_set1_ps(Gravity.Z);
+
+	for (; i<particles.Count; i+=4)
+	{
+		// the time is unsigned in affect(), so negative differences count as very large
+		const __m128i diff = _mm_sub_epi32(n, _mm_load_si128((const __m128i*)(particles.StartTime+i)));
+		const __m128 wrapped = _mm_castsi128_ps(_mm_cmplt_epi32(diff, _mm_setzero_si128()));
+		__m128 d = _mm_div_ps(_mm_cvtepi32_ps(diff), timeForceLost);
+		d = _mm_max_ps(_mm_min_ps(d, one), zero);
+		d = _mm_or_ps(_mm_and_ps(wrapped, one), _mm_andnot_ps(wrapped, d));
+
+		// d is the part of the gravity
+		const __m128 s = _mm_sub_ps(one, d);
+		_mm_store_ps(particles.VectorX+i, _mm_add_ps(_mm_mul_ps(_mm_load_ps(particles.StartVectorX+i), s), _mm_mul_ps(gx, d)));
+		_mm_store_ps(particles.VectorY+i, _mm_add_ps(_mm_mul_ps(_mm_load_ps(particles.StartVectorY+i), s), _mm_mul_ps(gy, d)));
+		_mm_store_ps(particles.VectorZ+i, _mm_add_ps(_mm_mul_ps(_mm_load_ps(particles.StartVectorZ+i), s), _mm_mul_ps(gz, d)));
+	}
+#endif
+
+	for (; i<particles.Count; ++i)
+	{
+		const f32 d = core::clamp((now - particles.StartTime[i]) / TimeForceLost, 0.f, 1.f);
+		particles.VectorX[i] = particles.StartVectorX[i] * (1.f-d) + Gravity.X * d;
+		particles.VectorY[i] = particles.StartVectorY[i] * (1.f-d) + Gravity.Y * d;
+		particles.VectorZ[i] = particles.StartVectorZ[i] * (1.f-d) + Gravity.Z * d;
+	}
+
+	return true;
+}
+
 //! Writes attributes of the object.
 void CParticleGravityAffector::serializeAttributes(io::IAttributes* out, io::SAttributeReadWriteOptions* options) const
 {
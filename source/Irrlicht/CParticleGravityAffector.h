@@ -25,6 +25,12 @@ public:
 	//! Affects a particle.
 	virtual void affect(u32 now, SParticle* particlearray, u32 count);
 
+	//! Affects particles stored in arrays, 4 at once.
+	virtual bool affectArrays(u32 now, SParticleArrays& particles);
+
+	//! Returns true, the particles can be affected in parts
+	virtual bool prepareAffectArrays(u32 now) { return true; }
+
 	//! Set the time in milliseconds when the gravity force is totally
 	//! lost and the particle does not move any more.
 	virtual void setTimeForceLost( f32 timeForceLost ) { TimeForceLost = timeForceLost; }
@@ -5,6 +5,10 @@
 #include "CParticleRotationAffector.h"
 #include "IAttributes.h"
 
+#ifdef _IRR_COMPILE_WITH_SSE2_
+#include <emmintrin.h>
+#endif
+
 namespace irr
 {
 namespace scene
@@ -12,7 +16,7 @@ namespace scene
 
 //! constructor
 CParticleRotationAffector::CParticleRotationAffector( const core::vector3df& speed, const core::vector3df& pivotPoint )
-		: PivotPoint(pivotPoint), Speed(speed), LastTime(0)
+		: PivotPoint(pivotPoint), Speed(speed), LastTime(0), TimeDelta(0.0f)
 {
 	#ifdef _DEBUG
 	setDebugName("CParticleRotationAffector");
@@ -48,6 +52,115 @@ void CParticleRotationAffector::affect(u32 now, SParticle* particlearray, u32 co
 	}
 }
 
+
+//! Advances the time of the last update for affectArrays()
+bool CParticleRotationAffector::prepareAffectArrays(u32 now)
+{
+	if( LastTime == 0 )
+		TimeDelta = 0.0f;
+	else
+		TimeDelta = ( now - LastTime ) / 1000.0f;
+	LastTime = now;
+
+	return true;
+}
+
+
+//! Affects particles stored in arrays, 4 at once.
+bool CParticleRotationAffector::affectArrays(u32 now, SParticleArrays& particles)
+{
+	const f32 timeDelta = TimeDelta;
+	if( !Enabled || timeDelta == 0.0f )
+		return true;
+
+	// rotations around the x, y and z axis, in the order of affect()
+	const f64 ax = timeDelta * Speed.X * core::DEGTORAD64;
+	const f64 ay = timeDelta * Speed.Y * core::DEGTORAD64;
+	const f64 az = timeDelta * Speed.Z * core::DEGTORAD64;
+	const f32 csx = (f32)cos(ax), snx = (f32)sin(ax);
+	const f32 csy = (f32)cos(ay), sny = (f32)sin(ay);
+	const f32 csz = (f32)cos(az), snz = (f32)sin(az);
+
+	u32 i=0;
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+	const __m128 cx = _mm_set1_ps(PivotPoint.X);
+	const __m128 cy = _mm_set1_ps(PivotPoint.Y);
+	const __m128 cz = _mm_set1_ps(PivotPoint.Z);
+
+	for (; i<particles.Count; i+=4)
+	{
+		__m128 x = _mm_sub_ps(_mm_load_ps(particles.PosX+i), cx);
+		__m128 y = _mm_sub_ps(_mm_load_ps(particles.PosY+i), cy);
+		__m128 z = _mm_sub_ps(_mm_load_ps(particles.PosZ+i), cz);
+		__m128 t;
+
+		if( Speed.X != 0.0f )
+		{
+			const __m128 cs = _mm_set1_ps(csx), sn = _mm_set1_ps(snx);
+			t = _mm_sub_ps(_mm_mul_ps(y, cs), _mm_mul_ps(z, sn));
+			z = _mm_add_ps(_mm_mul_ps(y, sn), _mm_mul_ps(z, cs));
+			y = t;
+		}
+
+		if( Speed.Y != 0.0f )
+		{
+			const __m128 cs = _mm_set1_ps(csy), sn = _mm_set1_ps(sny);
+			t = _mm_sub_ps(_mm_mul_ps(x, cs), _mm_mul_ps(z, sn));
+			z = _mm_add_ps(_mm_mul_ps(x, sn), _mm_mul_ps(z, cs));
+			x = t;
+		}
+
+		if( Speed.Z != 0.0f )
+		{
+			const __m128 cs = _mm_set1_ps(csz), sn = _mm_set1_ps(snz);
+			t = _mm_sub_ps(_mm_mul_ps(x, cs), _mm_mul_ps(y, sn));
+			y = _mm_add_ps(_mm_mul_ps(x, sn), _mm_mul_ps(y, cs));
+			x = t;
+		}
+
+		_mm_store_ps(particles.PosX+i, _mm_add_ps(x, cx));
+		_mm_store_ps(particles.PosY+i, _mm_add_ps(y, cy));
+		_mm_store_ps(particles.PosZ+i, _mm_add_ps(z, cz));
+	}
+#endif
+
+	for (; i<particles.Count; ++i)
+	{
+		f32 x = particles.PosX[i] - PivotPoint.X;
+		f32 y = particles.PosY[i] - PivotPoint.Y;
+		f32 z = particles.PosZ[i] - PivotPoint.Z;
+		f32 t;
+
+		if( Speed.X != 0.0f )
+		{
+			t = y*csx - z*snx;
+			z = y*snx + z*csx;
+			y = t;
+		}
+
+		if( Speed.Y != 0.0f )
+		{
+			t = x*csy - z*sny;
+			z = x*sny + z*csy;
+			x = t;
+		}
+
+		if( Speed.Z != 0.0f )
+		{
+			t = x*csz - y*snz;
+			y = x*snz + y*csz;
+			x = t;
+		}
+
+		particles.PosX[i] = x + PivotPoint.X;
+		particles.PosY[i] = y + PivotPoint.Y;
+		particles.PosZ[i] = z + PivotPoint.Z;
+	}
+
+	return true;
+}
+
 //! Writes attributes of the object.
 void CParticleRotationAffector::serializeAttributes(io::IAttributes* out, io::SAttributeReadWriteOptions* options) const
 {
@@ -23,6 +23,12 @@ public:
 	//! Affects a particle.
 	virtual void affect(u32 now, SParticle* particlearray, u32 count);
 
+	//! Affects particles stored in arrays, 4 at once.
+	virtual bool affectArrays(u32 now, SParticleArrays& particles);
+
+	//! Advances the time of the last update for affectArrays()
+	virtual bool prepareAffectArrays(u32 now);
+
 	//! Set the point that particles will attract to
 	virtual void setPivotPoint( const core::vector3df& point ) { PivotPoint = point; }
 
@@ -46,6 +52,9 @@ private:
 	core::vector3df PivotPoint;
 	core::vector3df Speed;
 	u32 LastTime;
+
+	//! seconds since the last update, set by prepareAffectArrays()
+	f32 TimeDelta;
 };
 
 } // end namespace scene
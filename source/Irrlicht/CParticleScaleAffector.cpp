@@ -5,6 +5,10 @@
 #include "CParticleScaleAffector.h"
 #include "IAttributes.h"
 
+#ifdef _IRR_COMPILE_WITH_SSE2_
+#include <emmintrin.h>
+#endif
+
 namespace irr
 {
 	namespace scene
@@ -30,6 +34,40 @@ namespace irr
 		}
 
 
+		//! Affects particles stored in arrays, 4 at once.
+		bool CParticleScaleAffector::affectArrays(u32 now, SParticleArrays& particles)
+		{
+			u32 i=0;
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+			const __m128i n = _mm_set1_epi32(now);
+			const __m128 scaleW = _mm_set1_ps(ScaleTo.Width);
+			const __m128 scaleH = _mm_set1_ps(ScaleTo.Height);
+
+			for (; i<particles.Count; i+=4)
+			{
+				const __m128i start = _mm_load_si128((const __m128i*)(particles.StartTime+i));
+				const __m128i maxdiff = _mm_sub_epi32(_mm_load_si128((const __m128i*)(particles.EndTime+i)), start);
+				const __m128i curdiff = _mm_sub_epi32(n, start);
+				const __m128 newscale = _mm_div_ps(_mm_cvtepi32_ps(curdiff), _mm_cvtepi32_ps(maxdiff));
+				_mm_store_ps(particles.Width+i, _mm_add_ps(_mm_load_ps(particles.StartWidth+i), _mm_mul_ps(scaleW, newscale)));
+				_mm_store_ps(particles.Height+i, _mm_add_ps(_mm_load_ps(particles.StartHeight+i), _mm_mul_ps(scaleH, newscale)));
+			}
+#endif
+
+			for (; i<particles.Count; ++i)
+			{
+				const u32 maxdiff = particles.EndTime[i] - particles.StartTime[i];
+				const u32 curdiff = now - particles.StartTime[i];
+				const f32 newscale = (f32)curdiff/maxdiff;
+				particles.Width[i] = particles.StartWidth[i] + ScaleTo.Width*newscale;
+				particles.Height[i] = particles.StartHeight[i] + ScaleTo.Height*newscale;
+			}
+
+			return true;
+		}
+
+
 		void CParticleScaleAffector::serializeAttributes(io::IAttributes* out, io::SAttributeReadWriteOptions* options) const
 		{
 			out->addFloat("ScaleToWidth", ScaleTo.Width);
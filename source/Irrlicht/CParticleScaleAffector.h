@@ -18,6 +18,12 @@ namespace irr
 
 			virtual void affect(u32 now, SParticle *particlearray, u32 count);
 
+			//! Affects particles stored in arrays, 4 at once.
+			virtual bool affectArrays(u32 now, SParticleArrays& particles);
+
+			//! Returns true, the particles can be affected in parts
+			virtual bool prepareAffectArrays(u32 now) { return true; }
+
 			//! Writes attributes of the object.
 			//! Implement this to expose the attributes of your scene node animator for
 			//! scripting languages, editors, debuggers or xml serialization purposes.
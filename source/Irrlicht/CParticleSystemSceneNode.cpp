@@ -22,11 +22,80 @@
 #include "CParticleScaleAffector.h"
 #include "SViewFrustum.h"
 
+#ifdef _IRR_COMPILE_WITH_SSE2_
+#include <emmintrin.h>
+#endif
+
 namespace irr
 {
 namespace scene
 {
 
+namespace
+{
+	//! particles drawn with one call, the indices of 4 vertices per particle must fit into 16 bit
+	const u32 PARTICLES_PER_DRAW = 16250;
+
+	//! number of arrays in SParticleArrays, all of them have 4 byte elements
+	const u32 PARTICLE_ARRAY_COUNT = 17;
+
+	//! particles handled by one work item with parallel updates, a multiple of 4 to keep the arrays aligned
+	const u32 PARTICLE_BLOCK_SIZE = 2048;
+
+	//! points the arrays of a SParticleArrays to consecutive parts of memory
+	void setParticleArrayPointers(SParticleArrays& arrays, u8* memory, u32 capacity)
+	{
+		f32* p = (f32*)memory;
+		arrays.PosX = p; p += capacity;
+		arrays.PosY = p; p += capacity;
+		arrays.PosZ = p; p += capacity;
+		arrays.VectorX = p; p += capacity;
+		arrays.VectorY = p; p += capacity;
+		arrays.VectorZ = p; p += capacity;
+		arrays.StartVectorX = p; p += capacity;
+		arrays.StartVectorY = p; p += capacity;
+		arrays.StartVectorZ = p; p += capacity;
+		arrays.Width = p; p += capacity;
+		arrays.Height = p; p += capacity;
+		arrays.StartWidth = p; p += capacity;
+		arrays.StartHeight = p; p += capacity;
+		arrays.StartTime = (u32*)p; p += capacity;
+		arrays.EndTime = (u32*)p; p += capacity;
+		arrays.Color = (video::SColor*)p; p += capacity;
+		arrays.StartColor = (video::SColor*)p;
+	}
+
+	//! returns arrays which point to the particles first to first+count-1 of arrays
+	SParticleArrays getParticleArrayRange(const SParticleArrays& arrays, u32 first, u32 count)
+	{
+		SParticleArrays range;
+		range.PosX = arrays.PosX + first;
+		range.PosY = arrays.PosY + first;
+		range.PosZ = arrays.PosZ + first;
+		range.VectorX = arrays.VectorX + first;
+		range.VectorY = arrays.VectorY + first;
+		range.VectorZ = arrays.VectorZ + first;
+		range.StartVectorX = arrays.StartVectorX + first;
+		range.StartVectorY = arrays.StartVectorY + first;
+		range.StartVectorZ = arrays.StartVectorZ + first;
+		range.StartTime = arrays.StartTime + first;
+		range.EndTime = arrays.EndTime + first;
+		range.Color = arrays.Color + first;
+		range.StartColor = arrays.StartColor + first;
+		range.Width = arrays.Width + first;
+		range.Height = arrays.Height + first;
+		range.StartWidth = arrays.StartWidth + first;
+		range.StartHeight = arrays.StartHeight + first;
+		range.Count = count;
+		return range;
+	}
+}
+
+#ifdef _IRR_COMPILE_WITH_THREADS_
+//! worker threads shared by all particle systems with parallel updates
+static CWorkerPool* ParticlePool = 0;
+#endif
+
 //! constructor
 CParticleSystemSceneNode::CParticleSystemSceneNode(bool createDefaultEmitter,
 	ISceneNode* parent, ISceneManager* mgr, s32 id,
@@ -34,13 +103,21 @@ CParticleSystemSceneNode::CParticleSystemSceneNode(bool createDefaultEmitter,
 	const core::vector3df& scale)
 	: IParticleSystemSceneNode(parent, mgr, id, position, rotation, scale),
 	Emitter(0), ParticleSize(core::dimension2d<f32>(5.0f, 5.0f)), LastEmitTime(0),
-	MaxParticles(0xffff), Buffer(0), ParticlesAreGlobal(true)
+	MaxParticles(16250), ParticleStorage(EPS_STRUCTS), ParticleArrayMemory(0),
+	ParticleArrayCapacity(0), ParallelUpdate(false), Buffer(0), ParticlesAreGlobal(true)
 {
 	#ifdef _DEBUG
 	setDebugName("CParticleSystemSceneNode");
 	#endif
 
+	AffectJob.Node = this;
+	MoveJob.Node = this;
+	BillboardJob.Node = this;
+
 	Buffer = new SMeshBuffer();
+	// the indices stay the same, only the vertices are streamed each frame
+	Buffer->setHardwareMappingHint(EHM_STATIC, EBT_INDEX);
+	Buffer->setHardwareMappingHint(EHM_STREAM, EBT_VERTEX);
 	if (createDefaultEmitter)
 	{
 		IParticleEmitter* e = createBoxEmitter();
@@ -57,6 +134,8 @@ CParticleSystemSceneNode::~CParticleSystemSceneNode()
 		Emitter->drop();
 	if (Buffer)
 		Buffer->drop();
+	delete [] ParticleArrayMemory;
+	setParallelUpdate(false);
 
 	removeAllAffectors();
 }
@@ -295,7 +374,7 @@ void CParticleSystemSceneNode::OnRegisterSceneNode()
 {
 	doParticleSystem(os::Timer::getTime());
 
-	if (IsVisible && (Particles.size() != 0))
+	if (IsVisible && (getParticleCount() != 0))
 	{
 		SceneManager->registerNodeForRendering(this);
 		ISceneNode::OnRegisterSceneNode();
@@ -313,67 +392,23 @@ void CParticleSystemSceneNode::render()
 		return;
 
 
-#if 0
-	// calculate vectors for letting particles look to camera
-	core::vector3df view(camera->getTarget() - camera->getAbsolutePosition());
-	view.normalize();
-
-	view *= -1.0f;
-
-#else
-
+	// the billboards face the camera
 	const core::matrix4 &m = camera->getViewFrustum()->getTransform( video::ETS_VIEW );
 
-	const core::vector3df view ( -m[2], -m[6] , -m[10] );
-
-#endif
-
 	// reallocate arrays, if they are too small
 	reallocateBuffers();
 
 	// create particle vertex data
-	s32 idx = 0;
-	for (u32 i=0; i<Particles.size(); ++i)
+	const u32 particleCount = getParticleCount();
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	if (ParallelUpdate)
 	{
-		const SParticle& particle = Particles[i];
-
-		#if 0
-			core::vector3df horizontal = camera->getUpVector().crossProduct(view);
-			horizontal.normalize();
-			horizontal *= 0.5f * particle.size.Width;
-
-			core::vector3df vertical = horizontal.crossProduct(view);
-			vertical.normalize();
-			vertical *= 0.5f * particle.size.Height;
-
-		#else
-			f32 f;
-
-			f = 0.5f * particle.size.Width;
-			const core::vector3df horizontal ( m[0] * f, m[4] * f, m[8] * f );
-
-			f = -0.5f * particle.size.Height;
-			const core::vector3df vertical ( m[1] * f, m[5] * f, m[9] * f );
-		#endif
-
-		Buffer->Vertices[0+idx].Pos = particle.pos + horizontal + vertical;
-		Buffer->Vertices[0+idx].Color = particle.color;
-		Buffer->Vertices[0+idx].Normal = view;
-
-		Buffer->Vertices[1+idx].Pos = particle.pos + horizontal - vertical;
-		Buffer->Vertices[1+idx].Color = particle.color;
-		Buffer->Vertices[1+idx].Normal = view;
-
-		Buffer->Vertices[2+idx].Pos = particle.pos - horizontal - vertical;
-		Buffer->Vertices[2+idx].Color = particle.color;
-		Buffer->Vertices[2+idx].Normal = view;
-
-		Buffer->Vertices[3+idx].Pos = particle.pos - horizontal + vertical;
-		Buffer->Vertices[3+idx].Color = particle.color;
-		Buffer->Vertices[3+idx].Normal = view;
-
-		idx +=4;
+		BillboardJob.View = m;
+		ParticlePool->run(&BillboardJob, getBlockCount());
 	}
+	else
+#endif
+		createBillboards(0, particleCount, m);
 
 	// render all
 	core::matrix4 mat;
@@ -383,8 +418,20 @@ void CParticleSystemSceneNode::render()
 
 	driver->setMaterial(Buffer->Material);
 
-	driver->drawVertexPrimitiveList(Buffer->getVertices(), Particles.size()*4,
-		Buffer->getIndices(), Particles.size()*2, video::EVT_STANDARD, EPT_TRIANGLES,Buffer->getIndexType());
+	Buffer->setDirty(EBT_VERTEX);
+
+	if (particleCount <= PARTICLES_PER_DRAW)
+		driver->drawMeshBuffer(Buffer, particleCount*2);
+	else
+	{
+		// the indices are 16 bit, so large systems are drawn in parts
+		for (u32 first=0; first<particleCount; first+=PARTICLES_PER_DRAW)
+		{
+			const u32 count = core::min_(particleCount-first, PARTICLES_PER_DRAW);
+			driver->drawVertexPrimitiveList(&Buffer->Vertices[first*4], count*4,
+				Buffer->getIndices(), count*2, video::EVT_STANDARD, EPT_TRIANGLES,Buffer->getIndexType());
+		}
+	}
 
 	// for debug purposes only:
 	if ( DebugDataVisible & scene::EDS_BBOX )
@@ -424,11 +471,25 @@ void CParticleSystemSceneNode::doParticleSystem(u32 time)
 		SParticle* array = 0;
 		s32 newParticles = Emitter->emitt(now, timediff, array);
 
-		if (newParticles && array)
+		s32 j=getParticleCount();
+		if (newParticles > (s32)MaxParticles-j)
+			newParticles=core::max_((s32)MaxParticles-j, 0);
+
+		if (newParticles && array && ParticleStorage == EPS_ARRAYS)
+		{
+			reallocateParticleArrays(j+newParticles);
+			for (s32 i=j; i<j+newParticles; ++i)
+			{
+				SParticle particle = array[i-j];
+				AbsoluteTransformation.rotateVect(particle.startVector);
+				if (ParticlesAreGlobal)
+					AbsoluteTransformation.transformVect(particle.pos);
+				ParticleArrays.setParticle(i, particle);
+			}
+			ParticleArrays.Count = j+newParticles;
+		}
+		else if (newParticles && array)
 		{
-			s32 j=Particles.size();
-			if (newParticles > 16250-j)
-				newParticles=16250-j;
 			Particles.set_used(j+newParticles);
 			for (s32 i=j; i<j+newParticles; ++i)
 			{
@@ -441,9 +502,14 @@ void CParticleSystemSceneNode::doParticleSystem(u32 time)
 	}
 
 	// run affectors
-	core::list<IParticleAffector*>::Iterator ait = AffectorList.begin();
-	for (; ait != AffectorList.end(); ++ait)
-		(*ait)->affect(now, Particles.pointer(), Particles.size());
+	if (ParticleStorage == EPS_ARRAYS)
+		affectParticleArrays(now);
+	else
+	{
+		core::list<IParticleAffector*>::Iterator ait = AffectorList.begin();
+		for (; ait != AffectorList.end(); ++ait)
+			(*ait)->affect(now, Particles.pointer(), Particles.size());
+	}
 
 	if (ParticlesAreGlobal)
 		Buffer->BoundingBox.reset(AbsoluteTransformation.getTranslation());
@@ -453,6 +519,9 @@ void CParticleSystemSceneNode::doParticleSystem(u32 time)
 	// animate all particles
 	f32 scale = (f32)timediff;
 
+	if (ParticleStorage == EPS_ARRAYS)
+		animateParticleArrays(now, scale);
+
 	for (u32 i=0; i<Particles.size();)
 	{
 		// erase is pretty expensive!
@@ -502,6 +571,334 @@ void CParticleSystemSceneNode::setParticlesAreGlobal(bool global)
 void CParticleSystemSceneNode::clearParticles()
 {
 	Particles.set_used(0);
+	ParticleArrays.Count = 0;
+}
+
+
+//! Sets how the particles are stored.
+void CParticleSystemSceneNode::setParticleStorage(E_PARTICLE_STORAGE storage)
+{
+	if (storage == ParticleStorage)
+		return;
+
+	// move the existing particles to the new storage
+	if (storage == EPS_ARRAYS)
+	{
+		reallocateParticleArrays(Particles.size());
+		for (u32 i=0; i<Particles.size(); ++i)
+			ParticleArrays.setParticle(i, Particles[i]);
+		ParticleArrays.Count = Particles.size();
+		Particles.clear();
+	}
+	else
+	{
+		Particles.set_used(ParticleArrays.Count);
+		for (u32 i=0; i<ParticleArrays.Count; ++i)
+			ParticleArrays.getParticle(i, Particles[i]);
+		ParticleArrays.Count = 0;
+		ConvertedParticles.clear();
+	}
+
+	ParticleStorage = storage;
+}
+
+
+u32 CParticleSystemSceneNode::getParticleCount() const
+{
+	return ParticleStorage == EPS_ARRAYS ? ParticleArrays.Count : Particles.size();
+}
+
+
+void CParticleSystemSceneNode::reallocateParticleArrays(u32 capacity)
+{
+	if (capacity <= ParticleArrayCapacity)
+		return;
+
+	// grow by doubling, keep a multiple of 4 particles for SIMD
+	capacity = core::max_(capacity, ParticleArrayCapacity*2);
+	capacity = (capacity + 3) & ~3;
+
+	u8* memory = new u8[capacity*PARTICLE_ARRAY_COUNT*4 + 15];
+	u8* aligned = (u8*)(((size_t)memory + 15) & ~(size_t)15);
+
+	if (ParticleArrayMemory)
+	{
+		const u8* oldAligned = (const u8*)ParticleArrays.PosX;
+		for (u32 i=0; i<PARTICLE_ARRAY_COUNT; ++i)
+			memcpy(aligned + i*capacity*4, oldAligned + i*ParticleArrayCapacity*4,
+				ParticleArrays.Count*4);
+		delete [] ParticleArrayMemory;
+	}
+
+	ParticleArrayMemory = memory;
+	ParticleArrayCapacity = capacity;
+	setParticleArrayPointers(ParticleArrays, aligned, capacity);
+}
+
+
+void CParticleSystemSceneNode::affectParticleArrays(u32 now)
+{
+	AffectJob.Now = now;
+	AffectJob.Affectors.set_used(0);
+
+	core::list<IParticleAffector*>::Iterator ait = AffectorList.begin();
+	for (; ait != AffectorList.end(); ++ait)
+	{
+		if ((*ait)->prepareAffectArrays(now))
+		{
+#ifdef _IRR_COMPILE_WITH_THREADS_
+			// collect affectors which can run on blocks
+			if (ParallelUpdate)
+			{
+				AffectJob.Affectors.push_back(*ait);
+				continue;
+			}
+#endif
+			(*ait)->affectArrays(now, ParticleArrays);
+			continue;
+		}
+
+#ifdef _IRR_COMPILE_WITH_THREADS_
+		// the collected affectors have to finish before this one
+		if (AffectJob.Affectors.size())
+		{
+			ParticlePool->run(&AffectJob, getBlockCount());
+			AffectJob.Affectors.set_used(0);
+		}
+#endif
+
+		if ((*ait)->affectArrays(now, ParticleArrays))
+			continue;
+
+		// affector works only on structs, copy the particles there and back
+		const u32 count = ParticleArrays.Count;
+		ConvertedParticles.set_used(count);
+		for (u32 i=0; i<count; ++i)
+			ParticleArrays.getParticle(i, ConvertedParticles[i]);
+
+		(*ait)->affect(now, ConvertedParticles.pointer(), count);
+
+		for (u32 i=0; i<count; ++i)
+			ParticleArrays.setParticle(i, ConvertedParticles[i]);
+	}
+
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	if (AffectJob.Affectors.size())
+		ParticlePool->run(&AffectJob, getBlockCount());
+#endif
+}
+
+
+void CParticleSystemSceneNode::animateParticleArrays(u32 now, f32 timediff)
+{
+	SParticleArrays& p = ParticleArrays;
+
+	// remove dead particles by moving the last particle into their place
+	for (u32 i=0; i<p.Count;)
+	{
+		if (now > p.EndTime[i])
+		{
+			const u32 last = --p.Count;
+			p.PosX[i] = p.PosX[last];
+			p.PosY[i] = p.PosY[last];
+			p.PosZ[i] = p.PosZ[last];
+			p.VectorX[i] = p.VectorX[last];
+			p.VectorY[i] = p.VectorY[last];
+			p.VectorZ[i] = p.VectorZ[last];
+			p.StartVectorX[i] = p.StartVectorX[last];
+			p.StartVectorY[i] = p.StartVectorY[last];
+			p.StartVectorZ[i] = p.StartVectorZ[last];
+			p.StartTime[i] = p.StartTime[last];
+			p.EndTime[i] = p.EndTime[last];
+			p.Color[i] = p.Color[last];
+			p.StartColor[i] = p.StartColor[last];
+			p.Width[i] = p.Width[last];
+			p.Height[i] = p.Height[last];
+			p.StartWidth[i] = p.StartWidth[last];
+			p.StartHeight[i] = p.StartHeight[last];
+		}
+		else
+			++i;
+	}
+
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	if (ParallelUpdate)
+	{
+		// each block has its own box, which are added in order
+		const u32 blocks = getBlockCount();
+		MoveJob.TimeDiff = timediff;
+		MoveJob.Boxes.set_used(blocks);
+		for (u32 b=0; b<blocks; ++b)
+			MoveJob.Boxes[b] = Buffer->BoundingBox;
+		ParticlePool->run(&MoveJob, blocks);
+		for (u32 b=0; b<blocks; ++b)
+			Buffer->BoundingBox.addInternalBox(MoveJob.Boxes[b]);
+		return;
+	}
+#endif
+
+	moveParticleArrays(0, p.Count, timediff, Buffer->BoundingBox);
+}
+
+
+void CParticleSystemSceneNode::moveParticleArrays(u32 first, u32 end, f32 timediff, core::aabbox3df& box)
+{
+	SParticleArrays& p = ParticleArrays;
+	u32 i = first;
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+	const __m128 t = _mm_set1_ps(timediff);
+	__m128 minX = _mm_set1_ps(box.MinEdge.X);
+	__m128 minY = _mm_set1_ps(box.MinEdge.Y);
+	__m128 minZ = _mm_set1_ps(box.MinEdge.Z);
+	__m128 maxX = _mm_set1_ps(box.MaxEdge.X);
+	__m128 maxY = _mm_set1_ps(box.MaxEdge.Y);
+	__m128 maxZ = _mm_set1_ps(box.MaxEdge.Z);
+
+	for (; i+4<=end; i+=4)
+	{
+		const __m128 x = _mm_add_ps(_mm_load_ps(p.PosX+i), _mm_mul_ps(_mm_load_ps(p.VectorX+i), t));
+		const __m128 y = _mm_add_ps(_mm_load_ps(p.PosY+i), _mm_mul_ps(_mm_load_ps(p.VectorY+i), t));
+		const __m128 z = _mm_add_ps(_mm_load_ps(p.PosZ+i), _mm_mul_ps(_mm_load_ps(p.VectorZ+i), t));
+		_mm_store_ps(p.PosX+i, x);
+		_mm_store_ps(p.PosY+i, y);
+		_mm_store_ps(p.PosZ+i, z);
+		minX = _mm_min_ps(minX, x);
+		minY = _mm_min_ps(minY, y);
+		minZ = _mm_min_ps(minZ, z);
+		maxX = _mm_max_ps(maxX, x);
+		maxY = _mm_max_ps(maxY, y);
+		maxZ = _mm_max_ps(maxZ, z);
+	}
+
+	f32 lanes[6][4];
+	_mm_storeu_ps(lanes[0], minX);
+	_mm_storeu_ps(lanes[1], minY);
+	_mm_storeu_ps(lanes[2], minZ);
+	_mm_storeu_ps(lanes[3], maxX);
+	_mm_storeu_ps(lanes[4], maxY);
+	_mm_storeu_ps(lanes[5], maxZ);
+	for (u32 l=0; l<4; ++l)
+	{
+		box.addInternalPoint(lanes[0][l], lanes[1][l], lanes[2][l]);
+		box.addInternalPoint(lanes[3][l], lanes[4][l], lanes[5][l]);
+	}
+#endif
+
+	for (; i<end; ++i)
+	{
+		p.PosX[i] += p.VectorX[i] * timediff;
+		p.PosY[i] += p.VectorY[i] * timediff;
+		p.PosZ[i] += p.VectorZ[i] * timediff;
+		box.addInternalPoint(p.PosX[i], p.PosY[i], p.PosZ[i]);
+	}
+}
+
+
+void CParticleSystemSceneNode::createBillboards(u32 first, u32 end, const core::matrix4& m)
+{
+	const core::vector3df view ( -m[2], -m[6] , -m[10] );
+
+	SParticle particle;
+	u32 idx = first*4;
+	for (u32 i=first; i<end; ++i)
+	{
+		if (ParticleStorage == EPS_ARRAYS)
+		{
+			particle.pos.set(ParticleArrays.PosX[i], ParticleArrays.PosY[i], ParticleArrays.PosZ[i]);
+			particle.color = ParticleArrays.Color[i];
+			particle.size.set(ParticleArrays.Width[i], ParticleArrays.Height[i]);
+		}
+		else
+			particle = Particles[i];
+
+		f32 f;
+
+		f = 0.5f * particle.size.Width;
+		const core::vector3df horizontal ( m[0] * f, m[4] * f, m[8] * f );
+
+		f = -0.5f * particle.size.Height;
+		const core::vector3df vertical ( m[1] * f, m[5] * f, m[9] * f );
+
+		Buffer->Vertices[0+idx].Pos = particle.pos + horizontal + vertical;
+		Buffer->Vertices[0+idx].Color = particle.color;
+		Buffer->Vertices[0+idx].Normal = view;
+		Buffer->Vertices[0+idx].TCoords.set(0.0f, 0.0f);
+
+		Buffer->Vertices[1+idx].Pos = particle.pos + horizontal - vertical;
+		Buffer->Vertices[1+idx].Color = particle.color;
+		Buffer->Vertices[1+idx].Normal = view;
+		Buffer->Vertices[1+idx].TCoords.set(0.0f, 1.0f);
+
+		Buffer->Vertices[2+idx].Pos = particle.pos - horizontal - vertical;
+		Buffer->Vertices[2+idx].Color = particle.color;
+		Buffer->Vertices[2+idx].Normal = view;
+		Buffer->Vertices[2+idx].TCoords.set(1.0f, 1.0f);
+
+		Buffer->Vertices[3+idx].Pos = particle.pos - horizontal + vertical;
+		Buffer->Vertices[3+idx].Color = particle.color;
+		Buffer->Vertices[3+idx].Normal = view;
+		Buffer->Vertices[3+idx].TCoords.set(1.0f, 0.0f);
+
+		idx +=4;
+	}
+}
+
+
+//! Updates the particles and creates their billboards on several threads.
+void CParticleSystemSceneNode::setParallelUpdate(bool on)
+{
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	if (ParallelUpdate == on)
+		return;
+
+	ParallelUpdate = on;
+	if (on)
+	{
+		if (ParticlePool)
+			ParticlePool->grab();
+		else
+			ParticlePool = new CWorkerPool();
+	}
+	else if (ParticlePool->drop())
+		ParticlePool = 0;
+#endif
+}
+
+
+u32 CParticleSystemSceneNode::getBlockCount() const
+{
+	return (getParticleCount() + PARTICLE_BLOCK_SIZE - 1) / PARTICLE_BLOCK_SIZE;
+}
+
+
+//! runs the collected affectors on a block of particles, called from the worker threads
+void CParticleSystemSceneNode::SAffectJob::execute(u32 block, u32 thread)
+{
+	const u32 first = block * PARTICLE_BLOCK_SIZE;
+	const u32 count = core::min_(Node->ParticleArrays.Count - first, PARTICLE_BLOCK_SIZE);
+	SParticleArrays range = getParticleArrayRange(Node->ParticleArrays, first, count);
+
+	for (u32 i=0; i<Affectors.size(); ++i)
+		Affectors[i]->affectArrays(Now, range);
+}
+
+
+//! moves a block of particles, called from the worker threads
+void CParticleSystemSceneNode::SMoveJob::execute(u32 block, u32 thread)
+{
+	const u32 first = block * PARTICLE_BLOCK_SIZE;
+	const u32 end = core::min_(Node->ParticleArrays.Count, first + PARTICLE_BLOCK_SIZE);
+	Node->moveParticleArrays(first, end, TimeDiff, Boxes[block]);
+}
+
+
+//! creates the billboards of a block of particles, called from the worker threads
+void CParticleSystemSceneNode::SBillboardJob::execute(u32 block, u32 thread)
+{
+	const u32 first = block * PARTICLE_BLOCK_SIZE;
+	const u32 end = core::min_(Node->getParticleCount(), first + PARTICLE_BLOCK_SIZE);
+	Node->createBillboards(first, end, View);
 }
 
 //! Sets the size of all particles.
@@ -520,29 +917,24 @@ void CParticleSystemSceneNode::setParticleSize(const core::dimension2d<f32> &siz
 
 void CParticleSystemSceneNode::reallocateBuffers()
 {
-	if (Particles.size() * 4 > Buffer->getVertexCount() ||
-			Particles.size() * 6 > Buffer->getIndexCount())
+	// only the vertices of the living particles are used and uploaded,
+	// the array grows by doubling to avoid a reallocation in each frame
+	const u32 particleCount = getParticleCount();
+	const u32 vertexCount = particleCount * 4;
+	if (vertexCount > Buffer->Vertices.allocated_size())
+		Buffer->Vertices.reallocate(core::max_(vertexCount, Buffer->Vertices.allocated_size() * 2));
+	Buffer->Vertices.set_used(vertexCount);
+
+	// the indices of all quads which can be drawn at once are created
+	// once, they are shared by all parts drawn in render()
+	const u32 indexedParticles = core::min_(core::max_(MaxParticles, particleCount), PARTICLES_PER_DRAW);
+	if (indexedParticles * 6 > Buffer->getIndexCount())
 	{
-		u32 oldSize = Buffer->getVertexCount();
-		Buffer->Vertices.set_used(Particles.size() * 4);
-
-		u32 i;
-
-		// fill remaining vertices
-		for (i=oldSize; i<Buffer->Vertices.size(); i+=4)
-		{
-			Buffer->Vertices[0+i].TCoords.set(0.0f, 0.0f);
-			Buffer->Vertices[1+i].TCoords.set(0.0f, 1.0f);
-			Buffer->Vertices[2+i].TCoords.set(1.0f, 1.0f);
-			Buffer->Vertices[3+i].TCoords.set(1.0f, 0.0f);
-		}
-
-		// fill remaining indices
 		u32 oldIdxSize = Buffer->getIndexCount();
-		u32 oldvertices = oldSize;
-		Buffer->Indices.set_used(Particles.size() * 6);
+		u32 oldvertices = oldIdxSize / 6 * 4;
+		Buffer->Indices.set_used(indexedParticles * 6);
 
-		for (i=oldIdxSize; i<Buffer->Indices.size(); i+=6)
+		for (u32 i=oldIdxSize; i<Buffer->Indices.size(); i+=6)
 		{
 			Buffer->Indices[0+i] = (u16)0+oldvertices;
 			Buffer->Indices[1+i] = (u16)2+oldvertices;
@@ -552,6 +944,7 @@ void CParticleSystemSceneNode::reallocateBuffers()
 			Buffer->Indices[5+i] = (u16)2+oldvertices;
 			oldvertices += 4;
 		}
+		Buffer->setDirty(EBT_INDEX);
 	}
 }
 
@@ -564,6 +957,7 @@ void CParticleSystemSceneNode::serializeAttributes(io::IAttributes* out, io::SAt
 	out->addBool("GlobalParticles", ParticlesAreGlobal);
 	out->addFloat("ParticleWidth", ParticleSize.Width);
 	out->addFloat("ParticleHeight", ParticleSize.Height);
+	out->addInt("MaxParticles", MaxParticles);
 
 	// write emitter
 
@@ -605,6 +999,8 @@ void CParticleSystemSceneNode::deserializeAttributes(io::IAttributes* in, io::SA
 	ParticlesAreGlobal = in->getAttributeAsBool("GlobalParticles");
 	ParticleSize.Width = in->getAttributeAsFloat("ParticleWidth");
 	ParticleSize.Height = in->getAttributeAsFloat("ParticleHeight");
+	if (in->existsAttribute("MaxParticles"))
+		MaxParticles = in->getAttributeAsInt("MaxParticles");
 
 	// read emitter
 
@@ -9,6 +9,7 @@
 #include "irrArray.h"
 #include "irrList.h"
 #include "SMeshBuffer.h"
+#include "CWorkerPool.h"
 
 namespace irr
 {
@@ -193,6 +194,24 @@ public:
 	//! Remove all currently visible particles
 	virtual void clearParticles();
 
+	//! Sets how the particles are stored.
+	virtual void setParticleStorage(E_PARTICLE_STORAGE storage);
+
+	//! Gets how the particles are stored.
+	virtual E_PARTICLE_STORAGE getParticleStorage() const { return ParticleStorage; }
+
+	//! Sets the maximal number of particles in the system.
+	virtual void setMaxParticles(u32 maxParticles) { MaxParticles = maxParticles; }
+
+	//! Gets the maximal number of particles in the system.
+	virtual u32 getMaxParticles() const { return MaxParticles; }
+
+	//! Updates the particles and creates their billboards on several threads.
+	virtual void setParallelUpdate(bool on);
+
+	//! Gets if the particles are updated on several threads.
+	virtual bool getParallelUpdate() const { return ParallelUpdate; }
+
 	//! Do manually update the particles.
 	//! This should only be called when you want to render the node outside the scenegraph,
 	//! as the node will care about this otherwise automatically.
@@ -211,12 +230,81 @@ private:
 
 	void reallocateBuffers();
 
+	//! number of particles in the used storage
+	u32 getParticleCount() const;
+
+	//! makes room for at least capacity particles in ParticleArrays
+	void reallocateParticleArrays(u32 capacity);
+
+	//! runs the affectors on ParticleArrays
+	void affectParticleArrays(u32 now);
+
+	//! removes dead particles from ParticleArrays, moves the others and updates the bounding box
+	void animateParticleArrays(u32 now, f32 timediff);
+
+	//! moves the particles first to end-1 of ParticleArrays and adds them to box
+	void moveParticleArrays(u32 first, u32 end, f32 timediff, core::aabbox3df& box);
+
+	//! writes the billboards of the particles first to end-1 into Buffer
+	void createBillboards(u32 first, u32 end, const core::matrix4& m);
+
+	//! number of blocks of particles handled by one work item
+	u32 getBlockCount() const;
+
+	//! runs the affectors of AffectJob on blocks of ParticleArrays
+	struct SAffectJob : public IWorkerJob
+	{
+		SAffectJob() : Node(0), Now(0) {}
+
+		virtual void execute(u32 block, u32 thread);
+
+		CParticleSystemSceneNode* Node;
+		u32 Now;
+		core::array<IParticleAffector*> Affectors;
+	};
+
+	//! moves blocks of ParticleArrays, each block with its own bounding box
+	struct SMoveJob : public IWorkerJob
+	{
+		SMoveJob() : Node(0), TimeDiff(0.f) {}
+
+		virtual void execute(u32 block, u32 thread);
+
+		CParticleSystemSceneNode* Node;
+		f32 TimeDiff;
+		core::array<core::aabbox3df> Boxes;
+	};
+
+	//! creates the billboards of blocks of particles
+	struct SBillboardJob : public IWorkerJob
+	{
+		SBillboardJob() : Node(0) {}
+
+		virtual void execute(u32 block, u32 thread);
+
+		CParticleSystemSceneNode* Node;
+		core::matrix4 View;
+	};
+
 	core::list<IParticleAffector*> AffectorList;
 	IParticleEmitter* Emitter;
 	core::array<SParticle> Particles;
 	core::dimension2d<f32> ParticleSize;
 	u32 LastEmitTime;
-	s32 MaxParticles;
+	u32 MaxParticles;
+
+	E_PARTICLE_STORAGE ParticleStorage;
+	SParticleArrays ParticleArrays;
+	u8* ParticleArrayMemory;
+	u32 ParticleArrayCapacity;
+
+	//! particles copied for affectors without affectArrays()
+	core::array<SParticle> ConvertedParticles;
+
+	SAffectJob AffectJob;
+	SMoveJob MoveJob;
+	SBillboardJob BillboardJob;
+	bool ParallelUpdate;
 
 	SMeshBuffer* Buffer;
 
@@ -0,0 +1,98 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CQueuedLogger.h"
+#include "os.h"
+
+namespace irr
+{
+
+//! Returns the current set log level.
+ELOG_LEVEL CQueuedLogger::getLogLevel() const
+{
+	return os::Printer::Logger ? os::Printer::Logger->getLogLevel() : ELL_INFORMATION;
+}
+
+
+//! Sets a new log level.
+void CQueuedLogger::setLogLevel(ELOG_LEVEL ll)
+{
+	// the level of the main logger is only changed on the main thread
+}
+
+
+//! Prints out a text into the log
+void CQueuedLogger::log(const c8* text, ELOG_LEVEL ll)
+{
+	queue(text, 0, ll);
+}
+
+
+//! Prints out a text into the log
+void CQueuedLogger::log(const wchar_t* text, ELOG_LEVEL ll)
+{
+	const core::stringc s(text);
+	queue(s.c_str(), 0, ll);
+}
+
+
+//! Prints out a text into the log
+void CQueuedLogger::log(const c8* text, const c8* hint, ELOG_LEVEL ll)
+{
+	queue(text, hint, ll);
+}
+
+
+//! Prints out a text into the log
+void CQueuedLogger::log(const c8* text, const wchar_t* hint, ELOG_LEVEL ll)
+{
+	const core::stringc s(hint);
+	queue(text, s.c_str(), ll);
+}
+
+
+//! Prints out a text into the log
+void CQueuedLogger::log(const wchar_t* text, const wchar_t* hint, ELOG_LEVEL ll)
+{
+	const core::stringc s1(text);
+	const core::stringc s2(hint);
+	queue(s1.c_str(), s2.c_str(), ll);
+}
+
+
+//! Logs the queued messages with os::Printer, on the main thread
+void CQueuedLogger::flush()
+{
+	core::array<SMessage> messages;
+	Lock.lock();
+	messages.swap(Messages);
+	Lock.unlock();
+
+	for (u32 i=0; i<messages.size(); ++i)
+	{
+		if (messages[i].HasHint)
+			os::Printer::log(messages[i].Text.c_str(), messages[i].Hint.c_str(), messages[i].Level);
+		else
+			os::Printer::log(messages[i].Text.c_str(), messages[i].Level);
+	}
+}
+
+
+void CQueuedLogger::queue(const c8* text, const c8* hint, ELOG_LEVEL ll)
+{
+	SMessage message;
+	message.Text = text;
+	message.HasHint = (hint != 0);
+	if (hint)
+		message.Hint = hint;
+	message.Level = ll;
+
+	Lock.lock();
+	Messages.push_back(message);
+	Lock.unlock();
+}
+
+
+} // end namespace irr
+
@@ -0,0 +1,67 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_QUEUED_LOGGER_H_INCLUDED__
+#define __C_QUEUED_LOGGER_H_INCLUDED__
+
+#include "ILogger.h"
+#include "irrString.h"
+#include "irrArray.h"
+#include "CWorkerPool.h"
+
+namespace irr
+{
+
+//! Class for collecting the log messages of worker threads
+/** Set it with os::Printer::setThreadLogger() on the worker threads. The
+messages are queued until flush() logs them on the main thread, because
+the logger of the device calls the event receiver. */
+class CQueuedLogger : public ILogger
+{
+public:
+
+	//! Returns the current set log level.
+	virtual ELOG_LEVEL getLogLevel() const;
+
+	//! Sets a new log level.
+	virtual void setLogLevel(ELOG_LEVEL ll);
+
+	//! Prints out a text into the log
+	virtual void log(const c8* text, ELOG_LEVEL ll=ELL_INFORMATION);
+
+	//! Prints out a text into the log
+	virtual void log(const wchar_t* text, ELOG_LEVEL ll=ELL_INFORMATION);
+
+	//! Prints out a text into the log
+	virtual void log(const c8* text, const c8* hint, ELOG_LEVEL ll=ELL_INFORMATION);
+
+	//! Prints out a text into the log
+	virtual void log(const c8* text, const wchar_t* hint, ELOG_LEVEL ll=ELL_INFORMATION);
+
+	//! Prints out a text into the log
+	virtual void log(const wchar_t* text, const wchar_t* hint, ELOG_LEVEL ll=ELL_INFORMATION);
+
+	//! Logs the queued messages with os::Printer, on the main thread
+	void flush();
+
+private:
+
+	struct SMessage
+	{
+		core::stringc Text;
+		core::stringc Hint;
+		ELOG_LEVEL Level;
+		bool HasHint;
+	};
+
+	void queue(const c8* text, const c8* hint, ELOG_LEVEL ll);
+
+	CWorkerLock Lock;
+	core::array<SMessage> Messages;
+};
+
+} // end namespace
+
+#endif
+
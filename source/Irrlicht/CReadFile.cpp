@@ -3,12 +3,18 @@
 // For conditions of distribution and use, see copyright notice in irrlicht.h
 
 #include "CReadFile.h"
+#include "CMappedReadFile.h"
 
 namespace irr
 {
 namespace io
 {
 
+#ifdef _IRR_COMPILE_WITH_MAPPED_FILES_
+//! files of at least this size are mapped into memory
+static const long MAPPED_FILE_MIN_SIZE = 64*1024;
+#endif
+
 
 CReadFile::CReadFile(const io::path& fileName)
 : File(0), FileSize(0), Filename(fileName)
@@ -99,6 +105,12 @@ const io::path& CReadFile::getFileName() const
 
 IReadFile* CReadFile::createReadFile(const io::path& fileName)
 {
+#ifdef _IRR_COMPILE_WITH_MAPPED_FILES_
+	IReadFile* mapped = CMappedReadFile::createMappedFile(fileName, MAPPED_FILE_MIN_SIZE);
+	if (mapped)
+		return mapped;
+#endif
+
 	CReadFile* file = new CReadFile(fileName);
 	if (file->isOpen())
 		return file;
@@ -0,0 +1,160 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CRenderQueue.h"
+#include "ISceneNode.h"
+#include "irrMath.h"
+
+namespace irr
+{
+namespace scene
+{
+
+//! removes all nodes, keeps the memory
+void CRenderQueue::clear()
+{
+	Entries.set_used(0);
+}
+
+
+void CRenderQueue::push(u64 key, ISceneNode* node)
+{
+	SEntry e;
+	e.Key = key;
+	e.Node = node;
+	Entries.push_back(e);
+}
+
+
+//! adds a node which is not sorted within its pass
+void CRenderQueue::add(ISceneNode* node, E_QUEUE_PASS pass)
+{
+	push((u64)pass << PASS_SHIFT, node);
+}
+
+
+//! adds a solid node, sorted by its first material
+void CRenderQueue::addSolid(ISceneNode* node, f32 distanceSQ)
+{
+	u64 key = (u64)EQP_SOLID << PASS_SHIFT;
+
+	if (node->getMaterialCount())
+	{
+		const video::SMaterial& material = node->getMaterial(0);
+
+		key |= (u64)core::min_((u32)material.MaterialType, 0xFFFFu) << MATERIAL_SHIFT;
+
+		// only equal textures have to end up next to each other
+		key |= (u64)(u32)((size_t)material.getTexture(0) >> 4) << TEXTURE_SHIFT;
+	}
+
+	// positive floats sort like their bit patterns, keep the 8 exponent bits and
+	// 5 bits of mantissa, distances are never negative so the sign is dropped
+	key |= (IR(distanceSQ) >> 18) & 0x1FFF;
+
+	push(key, node);
+}
+
+
+//! adds a transparent node, sorted back to front
+void CRenderQueue::addTransparent(ISceneNode* node, E_QUEUE_PASS pass, f32 distanceSQ)
+{
+	push(((u64)pass << PASS_SHIFT) | ((u64)(~IR(distanceSQ)) << TRANSPARENT_DEPTH_SHIFT), node);
+}
+
+
+//! sorts the queue and updates the statistics
+void CRenderQueue::sort()
+{
+	const u32 count = Entries.size();
+	u32 i;
+	u32 b;
+
+	Statistics.reset();
+	Statistics.Nodes = count;
+
+	if (count > 1)
+	{
+		// histograms of all key bytes in one run over the queue
+		u32 histogram[8][256];
+		for (b=0; b<8; ++b)
+			for (i=0; i<256; ++i)
+				histogram[b][i] = 0;
+
+		for (i=0; i<count; ++i)
+		{
+			u64 key = Entries[i].Key;
+			for (b=0; b<8; ++b)
+			{
+				++histogram[b][key & 0xFF];
+				key >>= 8;
+			}
+		}
+
+		// least significant byte first, each pass is stable
+		Temp.set_used(count);
+		for (b=0; b<8; ++b)
+		{
+			const u32 shift = b * 8;
+			u32* h = histogram[b];
+
+			// all keys are equal in this byte
+			if (h[(Entries[0].Key >> shift) & 0xFF] == count)
+				continue;
+
+			u32 sum = 0;
+			for (i=0; i<256; ++i)
+			{
+				const u32 n = h[i];
+				h[i] = sum;
+				sum += n;
+			}
+
+			const SEntry* src = Entries.const_pointer();
+			SEntry* dst = Temp.pointer();
+			for (i=0; i<count; ++i)
+				dst[h[(src[i].Key >> shift) & 0xFF]++] = src[i];
+
+			Entries.swap(Temp);
+			++Statistics.SortPasses;
+		}
+	}
+
+	// what the sort order left for the drivers
+	u64 lastSolid = 0;
+	for (i=0; i<count; ++i)
+	{
+		const u64 key = Entries[i].Key;
+		switch (key >> PASS_SHIFT)
+		{
+		case EQP_SKY_BOX:
+			++Statistics.SkyBoxNodes;
+			break;
+		case EQP_SOLID:
+			if (Statistics.SolidNodes)
+			{
+				if ((key ^ lastSolid) >> MATERIAL_SHIFT)
+					++Statistics.MaterialTypeChanges;
+				if (((key ^ lastSolid) >> TEXTURE_SHIFT) & 0xFFFFFFFF)
+					++Statistics.TextureChanges;
+			}
+			lastSolid = key;
+			++Statistics.SolidNodes;
+			break;
+		case EQP_SHADOW:
+			++Statistics.ShadowNodes;
+			break;
+		case EQP_TRANSPARENT:
+			++Statistics.TransparentNodes;
+			break;
+		case EQP_TRANSPARENT_EFFECT:
+			++Statistics.TransparentEffectNodes;
+			break;
+		}
+	}
+}
+
+} // end namespace scene
+} // end namespace irr
+
@@ -0,0 +1,94 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_RENDER_QUEUE_H_INCLUDED__
+#define __C_RENDER_QUEUE_H_INCLUDED__
+
+#include "irrArray.h"
+#include "SRenderStatistics.h"
+
+namespace irr
+{
+namespace scene
+{
+	class ISceneNode;
+
+	//! Sorted list of the scene nodes drawn in the sorted render passes.
+	/** Each entry has a 64 bit key, the queue is sorted with a stable
+	radix sort. The most significant bits hold the pass, so each pass is a
+	continuous range of the sorted queue. The remaining bits depend on the pass:
+	solid:			16 bit material type | 32 bit texture | 13 bit depth, front to back
+	transparent:	32 bit depth, back to front
+	other passes:	not sorted, registration order */
+	class CRenderQueue
+	{
+	public:
+
+		//! Sorted passes in render order
+		enum E_QUEUE_PASS
+		{
+			EQP_SKY_BOX = 0,
+			EQP_SOLID,
+			EQP_SHADOW,
+			EQP_TRANSPARENT,
+			EQP_TRANSPARENT_EFFECT,
+
+			EQP_COUNT
+		};
+
+		//! removes all nodes, keeps the memory
+		void clear();
+
+		//! adds a node which is not sorted within its pass
+		void add(ISceneNode* node, E_QUEUE_PASS pass);
+
+		//! adds a solid node, sorted by its first material
+		void addSolid(ISceneNode* node, f32 distanceSQ);
+
+		//! adds a transparent node, sorted back to front
+		void addTransparent(ISceneNode* node, E_QUEUE_PASS pass, f32 distanceSQ);
+
+		//! sorts the queue and updates the statistics
+		void sort();
+
+		//! returns the number of queued nodes
+		u32 size() const { return Entries.size(); }
+
+		//! returns the node of a sorted entry
+		ISceneNode* getNode(u32 index) const { return Entries[index].Node; }
+
+		//! returns the pass of a sorted entry
+		E_QUEUE_PASS getPass(u32 index) const { return (E_QUEUE_PASS) (Entries[index].Key >> PASS_SHIFT); }
+
+		//! returns the statistics of the last sort
+		const SRenderQueueStatistics& getStatistics() const { return Statistics; }
+
+	private:
+
+		struct SEntry
+		{
+			u64 Key;
+			ISceneNode* Node;
+		};
+
+		enum
+		{
+			PASS_SHIFT = 61,
+			MATERIAL_SHIFT = 45,
+			TEXTURE_SHIFT = 13,
+			TRANSPARENT_DEPTH_SHIFT = 29
+		};
+
+		void push(u64 key, ISceneNode* node);
+
+		core::array<SEntry> Entries;
+		core::array<SEntry> Temp;
+		SRenderQueueStatistics Statistics;
+	};
+
+} // end namespace scene
+} // end namespace irr
+
+#endif
+
@@ -31,6 +31,9 @@ public:
 
 	//! Creates/loads an animated mesh from the file.
 	virtual IAnimatedMesh* createMesh(io::IReadFile* file);
+
+	//! Returns true if createMesh() may be called on a background thread.
+	virtual bool canLoadInBackground() const { return true; }
 private:
 
 	void loadLimb(io::IReadFile* file, scene::SMesh* mesh, const core::matrix4 &parentTransformation);
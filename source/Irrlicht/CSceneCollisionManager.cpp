@@ -11,6 +11,10 @@
 #include "os.h"
 #include "irrMath.h"
 
+#ifdef _IRR_COMPILE_WITH_SSE2_
+#include <emmintrin.h>
+#endif
+
 namespace irr
 {
 namespace scene
@@ -18,7 +22,7 @@ namespace scene
 
 //! constructor
 CSceneCollisionManager::CSceneCollisionManager(ISceneManager* smanager, video::IVideoDriver* driver)
-: SceneManager(smanager), Driver(driver)
+: SceneManager(smanager), Driver(driver), RayBatchPool(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CSceneCollisionManager");
@@ -34,6 +38,9 @@ CSceneCollisionManager::~CSceneCollisionManager()
 {
 	if (Driver)
 		Driver->drop();
+
+	if (RayBatchPool)
+		RayBatchPool->drop();
 }
 
 
@@ -357,9 +364,58 @@ bool CSceneCollisionManager::getCollisionPoint(const core::line3d<f32>& ray,
 		return false;
 	}
 
+	f32 nearest = FLT_MAX;
+	getCollisionPointFromSelector(ray, selector, nearest,
+		outIntersection, outTriangle, outNode);
+
+	_IRR_IMPLEMENT_MANAGED_MARSHALLING_BUGFIX;
+	return nearest != FLT_MAX;
+}
+
+
+//! finds the nearest hit of the ray with the selector and all selectors in it
+void CSceneCollisionManager::getCollisionPointFromSelector(const core::line3d<f32>& ray,
+		ITriangleSelector* selector, f32& nearest,
+		core::vector3df& outIntersection, core::triangle3df& outTriangle,
+		ISceneNode*& outNode)
+{
+	// meta selectors are searched per selector, so that selectors
+	// with their own collision point query don't copy triangles
+	const u32 selectorCount = selector->getSelectorCount();
+	if (selectorCount != 1 || (selector->getSelector(0) && selector->getSelector(0) != selector))
+	{
+		for (u32 i=0; i<selectorCount; ++i)
+		{
+			ITriangleSelector* s = selector->getSelector(i);
+			if (s)
+				getCollisionPointFromSelector(ray, s, nearest,
+					outIntersection, outTriangle, outNode);
+		}
+		return;
+	}
+
+	if (selector->hasCollisionPointQuery())
+	{
+		core::vector3df intersection;
+		core::triangle3df triangle;
+		ISceneNode* node = 0;
+		if (selector->getCollisionPoint(ray, intersection, triangle, node))
+		{
+			const f32 tmp = intersection.getDistanceFromSQ(ray.start);
+			if (tmp < nearest)
+			{
+				nearest = tmp;
+				outTriangle = triangle;
+				outIntersection = intersection;
+				outNode = node;
+			}
+		}
+		return;
+	}
+
 	s32 totalcnt = selector->getTriangleCount();
 	if ( totalcnt <= 0 )
-		return false;
+		return;
 
 	Triangles.set_used(totalcnt);
 
@@ -368,8 +424,6 @@ bool CSceneCollisionManager::getCollisionPoint(const core::line3d<f32>& ray,
 
 	const core::vector3df linevect = ray.getVector().normalize();
 	core::vector3df intersection;
-	f32 nearest = FLT_MAX;
-	bool found = false;
 	const f32 raylength = ray.getLengthSQ();
 
 	const f32 minX = core::min_(ray.start.X, ray.end.X);
@@ -407,13 +461,311 @@ bool CSceneCollisionManager::getCollisionPoint(const core::line3d<f32>& ray,
 				outTriangle = triangle;
 				outIntersection = intersection;
 				outNode = selector->getSceneNodeForTriangle(i);
-				found = true;
 			}
 		}
 	}
+}
 
-	_IRR_IMPLEMENT_MANAGED_MARSHALLING_BUGFIX;
-	return found;
+
+//! number of rays searched by one work item of the ray batch job
+static const u32 RAY_BATCH_BLOCK_SIZE = 64;
+
+namespace
+{
+	//! four rays as start + dir*t with t in [0,1), as structure of arrays
+	struct SRayPacket
+	{
+		f32 StartX[4], StartY[4], StartZ[4];
+		f32 DirX[4], DirY[4], DirZ[4];
+	};
+
+	//! intersects the four rays of a packet with both sides of a triangle
+	/** Moeller-Trumbore, like the test of the BVH selector.
+	\return Bit mask of the rays which hit the triangle, outT is only
+	set for them. Like getCollisionPoint(), hits at the end of a ray
+	are ignored. */
+	inline u32 intersectRayPacket(const SRayPacket& packet,
+		const core::triangle3df& tri, f32* outT)
+	{
+		const core::vector3df e1 = tri.pointB - tri.pointA;
+		const core::vector3df e2 = tri.pointC - tri.pointA;
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+		const __m128 e1x = _mm_set1_ps(e1.X), e1y = _mm_set1_ps(e1.Y), e1z = _mm_set1_ps(e1.Z);
+		const __m128 e2x = _mm_set1_ps(e2.X), e2y = _mm_set1_ps(e2.Y), e2z = _mm_set1_ps(e2.Z);
+		const __m128 dx = _mm_loadu_ps(packet.DirX);
+		const __m128 dy = _mm_loadu_ps(packet.DirY);
+		const __m128 dz = _mm_loadu_ps(packet.DirZ);
+
+		const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+		const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+		const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+		const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+
+		// a determinant of 0 gives infinite or NaN values, which fail all compares below
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 invDet = _mm_div_ps(one, det);
+
+		const __m128 sx = _mm_sub_ps(_mm_loadu_ps(packet.StartX), _mm_set1_ps(tri.pointA.X));
+		const __m128 sy = _mm_sub_ps(_mm_loadu_ps(packet.StartY), _mm_set1_ps(tri.pointA.Y));
+		const __m128 sz = _mm_sub_ps(_mm_loadu_ps(packet.StartZ), _mm_set1_ps(tri.pointA.Z));
+		const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+
+		const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+		const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+		const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+		const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+		const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+		__m128 hit = _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero));
+		hit = _mm_and_ps(hit, _mm_cmple_ps(_mm_add_ps(u, v), one));
+		hit = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmplt_ps(t, one)));
+
+		const u32 mask = (u32)_mm_movemask_ps(hit);
+		if (mask)
+			_mm_storeu_ps(outT, t);
+		return mask;
+#else
+		u32 mask = 0;
+		for (u32 r=0; r<4; ++r)
+		{
+			const core::vector3df dir(packet.DirX[r], packet.DirY[r], packet.DirZ[r]);
+			const core::vector3df p = dir.crossProduct(e2);
+			const f32 det = e1.dotProduct(p);
+			if (det == 0.f)
+				continue;
+
+			const f32 invDet = 1.f / det;
+			const core::vector3df s = core::vector3df(packet.StartX[r], packet.StartY[r], packet.StartZ[r]) - tri.pointA;
+			const f32 u = s.dotProduct(p) * invDet;
+			if (u < 0.f || u > 1.f)
+				continue;
+
+			const core::vector3df q = s.crossProduct(e1);
+			const f32 v = dir.dotProduct(q) * invDet;
+			if (v < 0.f || u + v > 1.f)
+				continue;
+
+			const f32 t = e2.dotProduct(q) * invDet;
+			if (t >= 0.f && t < 1.f)
+			{
+				outT[r] = t;
+				mask |= 1 << r;
+			}
+		}
+		return mask;
+#endif
+	}
+}
+
+
+//! Finds the nearest collision points of many lines with lots of triangles.
+u32 CSceneCollisionManager::getCollisionPoints(const core::line3d<f32>* rays, u32 rayCount,
+		ITriangleSelector* selector, SCollisionHit* outHits, bool parallel)
+{
+	for (u32 i=0; i<rayCount; ++i)
+		outHits[i].Hit = false;
+
+	if (!selector || !rayCount)
+		return 0;
+
+	core::aabbox3df box(rays[0].start);
+	for (u32 i=0; i<rayCount; ++i)
+	{
+		box.addInternalPoint(rays[i].start);
+		box.addInternalPoint(rays[i].end);
+	}
+
+	RayBatchSelectors.set_used(0);
+	u32 triangleCount = 0;
+	collectRayBatchSelectors(selector, box, triangleCount);
+	if (RayBatchSelectors.empty())
+		return 0;
+
+	// the first packet lets selectors of animated nodes update to the
+	// current frame, after that the selectors are only read, which
+	// allows to search the other rays on several threads
+	const u32 firstCount = core::min_(rayCount, 4u);
+	getCollisionPointsOfPacket(rays, firstCount, outHits);
+
+	RayBatchJob.Manager = this;
+	RayBatchJob.Rays = rays + firstCount;
+	RayBatchJob.Hits = outHits + firstCount;
+	RayBatchJob.Count = rayCount - firstCount;
+
+	const u32 blockCount = (RayBatchJob.Count + RAY_BATCH_BLOCK_SIZE - 1) / RAY_BATCH_BLOCK_SIZE;
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	if (parallel && blockCount > 1)
+	{
+		if (!RayBatchPool)
+			RayBatchPool = new CWorkerPool();
+		RayBatchPool->run(&RayBatchJob, blockCount);
+	}
+	else
+#endif
+	{
+		for (u32 i=0; i<blockCount; ++i)
+			RayBatchJob.execute(i, 0);
+	}
+
+	u32 hitCount = 0;
+	for (u32 i=0; i<rayCount; ++i)
+	{
+		if (outHits[i].Hit)
+			++hitCount;
+	}
+	return hitCount;
+}
+
+
+//! collects the selectors in selector and fetches their triangles inside box
+void CSceneCollisionManager::collectRayBatchSelectors(ITriangleSelector* selector,
+		const core::aabbox3df& box, u32& triangleCount)
+{
+	const u32 selectorCount = selector->getSelectorCount();
+	if (selectorCount != 1 || (selector->getSelector(0) && selector->getSelector(0) != selector))
+	{
+		for (u32 i=0; i<selectorCount; ++i)
+		{
+			ITriangleSelector* s = selector->getSelector(i);
+			if (s)
+				collectRayBatchSelectors(s, box, triangleCount);
+		}
+		return;
+	}
+
+	SRayBatchSelector entry;
+	entry.Selector = selector;
+	entry.First = triangleCount;
+	entry.Count = 0;
+
+	if (!selector->hasCollisionPointQuery())
+	{
+		const s32 totalcnt = selector->getTriangleCount();
+		if (totalcnt <= 0)
+			return;
+
+		if (Triangles.size() < triangleCount + totalcnt)
+			Triangles.set_used(core::max_(triangleCount + totalcnt, Triangles.size() * 2));
+
+		s32 cnt = 0;
+		selector->getTriangles(Triangles.pointer() + triangleCount, totalcnt, cnt, box);
+		if (cnt <= 0)
+			return;
+
+		entry.Count = cnt;
+		triangleCount += cnt;
+	}
+
+	RayBatchSelectors.push_back(entry);
+}
+
+
+//! finds the nearest hits of up to four rays with the collected selectors
+void CSceneCollisionManager::getCollisionPointsOfPacket(const core::line3d<f32>* rays,
+		u32 count, SCollisionHit* outHits) const
+{
+	// unused lanes repeat the first ray, their hits are ignored
+	SRayPacket packet;
+	f32 lengthSQ[4];
+	f32 nearest[4];
+	core::aabbox3df box(rays[0].start);
+	for (u32 r=0; r<4; ++r)
+	{
+		const core::line3d<f32>& ray = rays[r < count ? r : 0];
+		const core::vector3df dir = ray.getVector();
+		packet.StartX[r] = ray.start.X;
+		packet.StartY[r] = ray.start.Y;
+		packet.StartZ[r] = ray.start.Z;
+		packet.DirX[r] = dir.X;
+		packet.DirY[r] = dir.Y;
+		packet.DirZ[r] = dir.Z;
+		lengthSQ[r] = dir.getLengthSQ();
+		nearest[r] = FLT_MAX;
+		box.addInternalPoint(ray.start);
+		box.addInternalPoint(ray.end);
+	}
+	const u32 laneMask = (1 << count) - 1;
+
+	for (u32 s=0; s<RayBatchSelectors.size(); ++s)
+	{
+		const SRayBatchSelector& entry = RayBatchSelectors[s];
+
+		if (!entry.Count)
+		{
+			// the selector finds the collision points by itself
+			for (u32 r=0; r<count; ++r)
+			{
+				core::vector3df intersection;
+				core::triangle3df triangle;
+				ISceneNode* node = 0;
+				if (entry.Selector->getCollisionPoint(rays[r], intersection, triangle, node))
+				{
+					const f32 tmp = intersection.getDistanceFromSQ(rays[r].start);
+					if (tmp < nearest[r])
+					{
+						nearest[r] = tmp;
+						outHits[r].Point = intersection;
+						outHits[r].Triangle = triangle;
+						outHits[r].Node = node;
+						outHits[r].Hit = true;
+					}
+				}
+			}
+			continue;
+		}
+
+		for (u32 i=entry.First; i<entry.First+entry.Count; ++i)
+		{
+			const core::triangle3df & triangle = Triangles[i];
+
+			// triangles outside the box of the packet miss all of its rays
+			if(box.MinEdge.X > triangle.pointA.X && box.MinEdge.X > triangle.pointB.X && box.MinEdge.X > triangle.pointC.X)
+				continue;
+			if(box.MaxEdge.X < triangle.pointA.X && box.MaxEdge.X < triangle.pointB.X && box.MaxEdge.X < triangle.pointC.X)
+				continue;
+			if(box.MinEdge.Y > triangle.pointA.Y && box.MinEdge.Y > triangle.pointB.Y && box.MinEdge.Y > triangle.pointC.Y)
+				continue;
+			if(box.MaxEdge.Y < triangle.pointA.Y && box.MaxEdge.Y < triangle.pointB.Y && box.MaxEdge.Y < triangle.pointC.Y)
+				continue;
+			if(box.MinEdge.Z > triangle.pointA.Z && box.MinEdge.Z > triangle.pointB.Z && box.MinEdge.Z > triangle.pointC.Z)
+				continue;
+			if(box.MaxEdge.Z < triangle.pointA.Z && box.MaxEdge.Z < triangle.pointB.Z && box.MaxEdge.Z < triangle.pointC.Z)
+				continue;
+
+			f32 t[4];
+			const u32 mask = intersectRayPacket(packet, triangle, t) & laneMask;
+			if (!mask)
+				continue;
+
+			for (u32 r=0; r<count; ++r)
+			{
+				if (!(mask & (1 << r)))
+					continue;
+
+				const f32 tmp = t[r] * t[r] * lengthSQ[r];
+				if (tmp < nearest[r])
+				{
+					nearest[r] = tmp;
+					outHits[r].Point = rays[r].start + rays[r].getVector() * t[r];
+					outHits[r].Triangle = triangle;
+					outHits[r].Node = entry.Selector->getSceneNodeForTriangle(i - entry.First);
+					outHits[r].Hit = true;
+				}
+			}
+		}
+	}
+}
+
+
+//! searches a block of rays of the batch
+void CSceneCollisionManager::SRayBatchJob::execute(u32 block, u32 thread)
+{
+	const u32 begin = block * RAY_BATCH_BLOCK_SIZE;
+	const u32 end = core::min_(begin + RAY_BATCH_BLOCK_SIZE, Count);
+	for (u32 i=begin; i<end; i+=4)
+		Manager->getCollisionPointsOfPacket(Rays + i, core::min_(end - i, 4u), Hits + i);
 }
 
 
@@ -776,17 +1128,24 @@ core::vector3df CSceneCollisionManager::collideWithWorld(s32 recursionDepth,
 	box.MinEdge -= colData.eRadius;
 	box.MaxEdge += colData.eRadius;
 
-	s32 totalTriangleCnt = colData.selector->getTriangleCount();
-	Triangles.set_used(totalTriangleCnt);
-
 	core::matrix4 scaleMatrix;
 	scaleMatrix.setScale(
 			core::vector3df(1.0f / colData.eRadius.X,
 					1.0f / colData.eRadius.Y,
 					1.0f / colData.eRadius.Z));
 
+	// the buffer only grows to the number of triangles in the box, not
+	// to all triangles of the selector
+	const s32 totalTriangleCnt = colData.selector->getTriangleCount();
 	s32 triangleCnt = 0;
-	colData.selector->getTriangles(Triangles.pointer(), totalTriangleCnt, triangleCnt, box, &scaleMatrix);
+	Triangles.set_used(core::min_(core::max_((s32)Triangles.allocated_size(), 64), core::max_(totalTriangleCnt, 1)));
+	for (;;)
+	{
+		colData.selector->getTriangles(Triangles.pointer(), Triangles.size(), triangleCnt, box, &scaleMatrix);
+		if (triangleCnt < (s32)Triangles.size() || (s32)Triangles.size() >= totalTriangleCnt)
+			break;
+		Triangles.set_used(core::min_((s32)Triangles.size() * 2, totalTriangleCnt));
+	}
 
 	for (s32 i=0; i<triangleCnt; ++i)
 		if(testTriangleIntersection(&colData, Triangles[i]))
@@ -8,6 +8,7 @@
 #include "ISceneCollisionManager.h"
 #include "ISceneManager.h"
 #include "IVideoDriver.h"
+#include "CWorkerPool.h"
 
 namespace irr
 {
@@ -47,6 +48,11 @@ namespace scene
 			core::triangle3df& outTriangle,
 			ISceneNode* & outNode);
 
+		//! Finds the nearest collision points of many lines with lots of triangles.
+		virtual u32 getCollisionPoints(const core::line3d<f32>* rays, u32 rayCount,
+			ITriangleSelector* selector, SCollisionHit* outHits,
+			bool parallel=false);
+
 		//! Collides a moving ellipsoid with a 3d world with gravity and returns
 		//! the resulting new position of the ellipsoid.
 		virtual core::vector3df getCollisionResultPosition(
@@ -143,11 +149,51 @@ namespace scene
 		core::vector3df collideWithWorld(s32 recursionDepth, SCollisionData &colData,
 			core::vector3df pos, core::vector3df vel);
 
+		//! finds the nearest hit of the ray with the selector and all selectors in it
+		void getCollisionPointFromSelector(const core::line3d<f32>& ray,
+			ITriangleSelector* selector, f32& nearest,
+			core::vector3df& outIntersection, core::triangle3df& outTriangle,
+			ISceneNode*& outNode);
+
+		//! a selector searched by getCollisionPoints
+		/** Selectors without their own collision point query have their
+		triangles at Triangles[First] to Triangles[First+Count-1]. */
+		struct SRayBatchSelector
+		{
+			ITriangleSelector* Selector;
+			u32 First;
+			u32 Count;
+		};
+
+		//! collects the selectors in selector and fetches their triangles inside box
+		void collectRayBatchSelectors(ITriangleSelector* selector,
+			const core::aabbox3df& box, u32& triangleCount);
+
+		//! finds the nearest hits of up to four rays with the collected selectors
+		void getCollisionPointsOfPacket(const core::line3d<f32>* rays, u32 count,
+			SCollisionHit* outHits) const;
+
+		//! searches blocks of rays of a batch on the worker threads
+		struct SRayBatchJob : public IWorkerJob
+		{
+			SRayBatchJob() : Manager(0), Rays(0), Hits(0), Count(0) {}
+
+			virtual void execute(u32 block, u32 thread);
+
+			const CSceneCollisionManager* Manager;
+			const core::line3d<f32>* Rays;
+			SCollisionHit* Hits;
+			u32 Count;
+		};
+
 		inline bool getLowestRoot(f32 a, f32 b, f32 c, f32 maxR, f32* root);
 
 		ISceneManager* SceneManager;
 		video::IVideoDriver* Driver;
 		core::array<core::triangle3df> Triangles; // triangle buffer
+		core::array<SRayBatchSelector> RayBatchSelectors;
+		SRayBatchJob RayBatchJob;
+		CWorkerPool* RayBatchPool;
 	};
 
 
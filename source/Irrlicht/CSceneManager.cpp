@@ -8,6 +8,7 @@
 #include "IFileSystem.h"
 #include "SAnimatedMesh.h"
 #include "CMeshCache.h"
+#include "CAsyncLoader.h"
 #include "IXMLWriter.h"
 #include "ISceneUserDataSerializer.h"
 #include "IGUIEnvironment.h"
@@ -146,6 +147,7 @@
 #include "CDummyTransformationSceneNode.h"
 #include "CWaterSurfaceSceneNode.h"
 #include "CTerrainSceneNode.h"
+#include "CPagedTerrainSceneNode.h"
 #include "CEmptySceneNode.h"
 #include "CTextSceneNode.h"
 #include "CQuake3ShaderSceneNode.h"
@@ -156,6 +158,7 @@
 #include "CSceneCollisionManager.h"
 #include "CTriangleSelector.h"
 #include "COctreeTriangleSelector.h"
+#include "CBVHTriangleSelector.h"
 #include "CTriangleBBSelector.h"
 #include "CMetaTriangleSelector.h"
 #include "CTerrainTriangleSelector.h"
@@ -173,8 +176,7 @@
 
 #include "CGeometryCreator.h"
 
-//! Enable debug features
-#define SCENEMANAGER_DEBUG
+#include <limits.h>
 
 namespace irr
 {
@@ -188,8 +190,9 @@ CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 : ISceneNode(0, 0), Driver(driver), FileSystem(fs), GUIEnvironment(gui),
 	CursorControl(cursorControl), CollisionManager(0),
 	ActiveCamera(0), ShadowColor(150,0,0,0), AmbientLight(0,0,0,0), Parameters(0),
-	MeshCache(cache), CurrentRendertime(ESNRP_NONE), LightManager(0),
-	IRR_XML_FORMAT_SCENE(L"irr_scene"), IRR_XML_FORMAT_NODE(L"node"), IRR_XML_FORMAT_NODE_ATTR_TYPE(L"type")
+	MeshCache(cache), AsyncLoader(0), CurrentRendertime(ESNRP_NONE), LightManager(0),
+	IRR_XML_FORMAT_SCENE(L"irr_scene"), IRR_XML_FORMAT_NODE(L"node"), IRR_XML_FORMAT_NODE_ATTR_TYPE(L"type"),
+	DeferCulling(false), CullPool(0), FrameNumber(0), StatisticsNext(0), StatisticsCount(0)
 {
 	#ifdef _DEBUG
 	ISceneManager::setDebugName("CSceneManager ISceneManager");
@@ -222,6 +225,8 @@ CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 	Parameters->setAttribute(DEBUG_NORMAL_LENGTH, 1.f);
 	Parameters->setAttribute(DEBUG_NORMAL_COLOR, video::SColor(255, 34, 221, 221));
 
+	setRenderStatisticsHistorySize(64);
+
 	// create collision manager
 	CollisionManager = new CSceneCollisionManager(this, Driver);
 
@@ -317,6 +322,10 @@ CSceneManager::CSceneManager(video::IVideoDriver* driver, io::IFileSystem* fs,
 //! destructor
 CSceneManager::~CSceneManager()
 {
+	// pending loads use the mesh loaders and the driver
+	if (AsyncLoader)
+		AsyncLoader->drop();
+
 	clearDeletionList();
 
 	//! force to remove hardwareTextures from the driver
@@ -363,6 +372,9 @@ CSceneManager::~CSceneManager()
 	for (i=0; i<SceneNodeAnimatorFactoryList.size(); ++i)
 		SceneNodeAnimatorFactoryList[i]->drop();
 
+	if (CullPool)
+		CullPool->drop();
+
 	if (LightManager)
 		LightManager->drop();
 
@@ -391,6 +403,9 @@ IAnimatedMesh* CSceneManager::getMesh(const io::path& filename)
 		return 0;
 	}
 
+	if (AsyncLoader)
+		AsyncLoader->lockMeshLoaders();
+
 	// iterate the list in reverse order so user-added loaders can override the built-in ones
 	s32 count = MeshLoaderList.size();
 	for (s32 i=count-1; i>=0; --i)
@@ -409,6 +424,9 @@ IAnimatedMesh* CSceneManager::getMesh(const io::path& filename)
 		}
 	}
 
+	if (AsyncLoader)
+		AsyncLoader->unlockMeshLoaders();
+
 	file->drop();
 
 	if (!msh)
@@ -431,6 +449,9 @@ IAnimatedMesh* CSceneManager::getMesh(io::IReadFile* file)
 	if (msh)
 		return msh;
 
+	if (AsyncLoader)
+		AsyncLoader->lockMeshLoaders();
+
 	// iterate the list in reverse order so user-added loaders can override the built-in ones
 	s32 count = MeshLoaderList.size();
 	for (s32 i=count-1; i>=0; --i)
@@ -449,6 +470,9 @@ IAnimatedMesh* CSceneManager::getMesh(io::IReadFile* file)
 		}
 	}
 
+	if (AsyncLoader)
+		AsyncLoader->unlockMeshLoaders();
+
 	if (!msh)
 		os::Printer::log("Could not load mesh, file format seems to be unsupported", file->getFileName(), ELL_ERROR);
 	else
@@ -813,6 +837,66 @@ ISceneNode* CSceneManager::addSkyBoxSceneNode(video::ITexture* top, video::IText
 }
 
 
+//! Adds a terrain which is streamed from a tiled heightmap file.
+IPagedTerrainSceneNode* CSceneManager::addPagedTerrainSceneNode(
+	const io::path& tiledHeightMapFileName,
+	s32 tileSize, s32 tileCountX, s32 tileCountZ,
+	s32 bitsPerPixel, bool signedData, bool floatVals,
+	ISceneNode* parent, s32 id,
+	const core::vector3df& position,
+	const core::vector3df& scale,
+	video::SColor vertexColor,
+	s32 maxLOD, E_TERRAIN_PATCH_SIZE patchSize)
+{
+	if (!parent)
+		parent = this;
+
+	if (tileSize < 2 || tileCountX < 1 || tileCountZ < 1 ||
+		(bitsPerPixel != 8 && bitsPerPixel != 16 && bitsPerPixel != 32) ||
+		(floatVals && bitsPerPixel != 32))
+	{
+		os::Printer::log("Could not load paged terrain, invalid tile format.", ELL_ERROR);
+		return 0;
+	}
+
+	io::IReadFile* file = FileSystem->createAndOpenFile(tiledHeightMapFileName);
+	if (!file)
+	{
+		os::Printer::log("Could not load paged terrain, because file could not be opened.",
+		tiledHeightMapFileName, ELL_ERROR);
+		return 0;
+	}
+
+	const f64 tileBytes = (f64)tileSize * tileSize * (bitsPerPixel / 8);
+	const f64 fileBytes = tileBytes * tileCountX * tileCountZ;
+
+	// the tiles are read with the long positions of IReadFile
+	if (fileBytes > (f64)LONG_MAX)
+	{
+		os::Printer::log("Could not load paged terrain, the file is too large for the long positions of IReadFile.",
+		tiledHeightMapFileName, ELL_ERROR);
+		file->drop();
+		return 0;
+	}
+
+	if ((f64)file->getSize() < fileBytes)
+	{
+		os::Printer::log("Could not load paged terrain, file is too small.",
+		tiledHeightMapFileName, ELL_ERROR);
+		file->drop();
+		return 0;
+	}
+
+	CPagedTerrainSceneNode* node = new CPagedTerrainSceneNode(parent, this, FileSystem,
+		file, id, tileSize, tileCountX, tileCountZ, bitsPerPixel, signedData, floatVals,
+		position, scale, vertexColor, maxLOD, patchSize);
+
+	file->drop();
+	node->drop();
+	return node;
+}
+
+
 //! Adds a skydome scene node. A skydome is a large (half-) sphere with a
 //! panoramic texture on it and is drawn around the camera position.
 ISceneNode* CSceneManager::addSkyDomeSceneNode(video::ITexture* texture,
@@ -1162,36 +1246,43 @@ const core::aabbox3d<f32>& CSceneManager::getBoundingBox() const
 
 //! returns if node is culled
 bool CSceneManager::isCulled(const ISceneNode* node) const
+{
+	const bool result = (cullingTest(node) != EAC_OFF);
+	_IRR_IMPLEMENT_MANAGED_MARSHALLING_BUGFIX;
+	return result;
+}
+
+
+//! returns the culling test which culled the node, EAC_OFF if it is visible
+E_CULLING_TYPE CSceneManager::cullingTest(const ISceneNode* node) const
 {
 	const ICameraSceneNode* cam = getActiveCamera();
 	if (!cam)
-	{
-		_IRR_IMPLEMENT_MANAGED_MARSHALLING_BUGFIX;
-		return false;
-	}
-	bool result = false;
+		return EAC_OFF;
 
 	// has occlusion query information
 	if (node->getAutomaticCulling() & scene::EAC_OCC_QUERY)
 	{
-		result = (Driver->getOcclusionQueryResult(const_cast<ISceneNode*>(node))==0);
+		if (Driver->getOcclusionQueryResult(const_cast<ISceneNode*>(node))==0)
+			return EAC_OCC_QUERY;
 	}
 
 	// can be seen by a bounding box ?
-	if (!result && (node->getAutomaticCulling() & scene::EAC_BOX))
+	if (node->getAutomaticCulling() & scene::EAC_BOX)
 	{
 		core::aabbox3d<f32> tbox = node->getBoundingBox();
 		node->getAbsoluteTransformation().transformBoxEx(tbox);
-		result = !(tbox.intersectsWithBox(cam->getViewFrustum()->getBoundingBox() ));
+		if (!tbox.intersectsWithBox(cam->getViewFrustum()->getBoundingBox()))
+			return EAC_BOX;
 	}
 
 	// can be seen by a bounding sphere
-	if (!result && (node->getAutomaticCulling() & scene::EAC_FRUSTUM_SPHERE))
+	if (node->getAutomaticCulling() & scene::EAC_FRUSTUM_SPHERE)
 	{ // requires bbox diameter
 	}
 
 	// can be seen by cam pyramid planes ?
-	if (!result && (node->getAutomaticCulling() & scene::EAC_FRUSTUM_BOX))
+	if (node->getAutomaticCulling() & scene::EAC_FRUSTUM_BOX)
 	{
 		SViewFrustum frust = *cam->getViewFrustum();
 
@@ -1216,21 +1307,50 @@ bool CSceneManager::isCulled(const ISceneNode* node) const
 			}
 
 			if (!boxInFrustum)
-			{
-				result = true;
-				break;
-			}
+				return EAC_FRUSTUM_BOX;
 		}
 	}
 
-	_IRR_IMPLEMENT_MANAGED_MARSHALLING_BUGFIX;
-	return result;
+	return EAC_OFF;
 }
 
 
 //! registers a node for rendering it at a specific time.
 u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDER_PASS pass)
 {
+	switch(pass)
+	{
+	case ESNRP_CAMERA:
+	case ESNRP_LIGHT:
+	case ESNRP_SKY_BOX:
+	case ESNRP_NONE:
+		return addToRenderList(node, pass, EAC_OFF);
+	default:
+		break;
+	}
+
+	// cull later together with all other nodes
+	if (DeferCulling)
+	{
+		DeferredNodeList.push_back(SDeferredNode(node, pass));
+		return 1;
+	}
+
+	return addToRenderList(node, pass, cullingTest(node));
+}
+
+
+//! squared distance of the node's position to the camera, used for sorting
+static inline f32 getCameraDistanceSQ(const ISceneNode* node, const core::vector3df& camera)
+{
+	return node->getAbsoluteTransformation().getTranslation().getDistanceFromSQ(camera);
+}
+
+
+//! adds a node to the render list of a pass, unless it is culled
+u32 CSceneManager::addToRenderList(ISceneNode* node, E_SCENE_NODE_RENDER_PASS pass, E_CULLING_TYPE culledBy)
+{
+	const bool culled = (culledBy != EAC_OFF);
 	u32 taken = 0;
 
 	switch(pass)
@@ -1265,32 +1385,32 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 		break;
 
 	case ESNRP_SKY_BOX:
-		SkyBoxList.push_back(node);
+		RenderQueue.add(node, CRenderQueue::EQP_SKY_BOX);
 		taken = 1;
 		break;
 	case ESNRP_SOLID:
-		if (!isCulled(node))
+		if (!culled)
 		{
-			SolidNodeList.push_back(node);
+			RenderQueue.addSolid(node, getCameraDistanceSQ(node, camWorldPos));
 			taken = 1;
 		}
 		break;
 	case ESNRP_TRANSPARENT:
-		if (!isCulled(node))
+		if (!culled)
 		{
-			TransparentNodeList.push_back(TransparentNodeEntry(node, camWorldPos));
+			RenderQueue.addTransparent(node, CRenderQueue::EQP_TRANSPARENT, getCameraDistanceSQ(node, camWorldPos));
 			taken = 1;
 		}
 		break;
 	case ESNRP_TRANSPARENT_EFFECT:
-		if (!isCulled(node))
+		if (!culled)
 		{
-			TransparentEffectNodeList.push_back(TransparentNodeEntry(node, camWorldPos));
+			RenderQueue.addTransparent(node, CRenderQueue::EQP_TRANSPARENT_EFFECT, getCameraDistanceSQ(node, camWorldPos));
 			taken = 1;
 		}
 		break;
 	case ESNRP_AUTOMATIC:
-		if (!isCulled(node))
+		if (!culled)
 		{
 			const u32 count = node->getMaterialCount();
 
@@ -1302,8 +1422,7 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 				if (rnd && rnd->isTransparent())
 				{
 					// register as transparent node
-					TransparentNodeEntry e(node, camWorldPos);
-					TransparentNodeList.push_back(e);
+					RenderQueue.addTransparent(node, CRenderQueue::EQP_TRANSPARENT, getCameraDistanceSQ(node, camWorldPos));
 					taken = 1;
 					break;
 				}
@@ -1312,15 +1431,15 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 			// not transparent, register as solid
 			if (!taken)
 			{
-				SolidNodeList.push_back(node);
+				RenderQueue.addSolid(node, getCameraDistanceSQ(node, camWorldPos));
 				taken = 1;
 			}
 		}
 		break;
 	case ESNRP_SHADOW:
-		if (!isCulled(node))
+		if (!culled)
 		{
-			ShadowNodeList.push_back(node);
+			RenderQueue.add(node, CRenderQueue::EQP_SHADOW);
 			taken = 1;
 		}
 		break;
@@ -1329,21 +1448,140 @@ u32 CSceneManager::registerNodeForRendering(ISceneNode* node, E_SCENE_NODE_RENDE
 		break;
 	}
 
-#ifdef SCENEMANAGER_DEBUG
-	s32 index = Parameters->findAttribute("calls");
-	Parameters->setAttribute(index, Parameters->getAttributeAsInt(index)+1);
-
+	++Statistics.RegisteredNodes;
 	if (!taken)
 	{
-		index = Parameters->findAttribute("culled");
-		Parameters->setAttribute(index, Parameters->getAttributeAsInt(index)+1);
+		++Statistics.CulledNodes;
+		switch (culledBy)
+		{
+		case EAC_OCC_QUERY:
+			++Statistics.CulledByOcclusionQuery;
+			break;
+		case EAC_BOX:
+			++Statistics.CulledByBox;
+			break;
+		case EAC_FRUSTUM_BOX:
+			++Statistics.CulledByFrustumBox;
+			break;
+		default:
+			break;
+		}
 	}
-#endif
 
 	return taken;
 }
 
 
+//! number of nodes culled by one work item of the culling job
+static const u32 CULL_BLOCK_SIZE = 64;
+
+//! culls the nodes collected during registration and adds them to the render lists
+void CSceneManager::cullDeferredNodes()
+{
+	const u32 count = DeferredNodeList.size();
+	if (!count)
+		return;
+
+	if (!CullPool)
+		CullPool = new CWorkerPool();
+
+	CullJob.SceneManager = this;
+	CullJob.Nodes = DeferredNodeList.pointer();
+	CullJob.Count = count;
+	CullPool->run(&CullJob, (count + CULL_BLOCK_SIZE - 1) / CULL_BLOCK_SIZE);
+
+	// in registration order, so the lists look like registered one by one
+	for (u32 i=0; i<count; ++i)
+		addToRenderList(DeferredNodeList[i].Node, DeferredNodeList[i].Pass, DeferredNodeList[i].CulledBy);
+
+	DeferredNodeList.set_used(0);
+}
+
+
+//! culls a block of deferred nodes, called from the worker threads
+void CSceneManager::SCullJob::execute(u32 block, u32 thread)
+{
+	const u32 end = core::min_(Count, (block + 1) * CULL_BLOCK_SIZE);
+	for (u32 i=block * CULL_BLOCK_SIZE; i<end; ++i)
+		Nodes[i].CulledBy = SceneManager->cullingTest(Nodes[i].Node);
+}
+
+
+//! renders the nodes of one pass of the sorted render queue, returns the number of nodes
+u32 CSceneManager::renderQueuePass(u32& entry, CRenderQueue::E_QUEUE_PASS pass)
+{
+	const u32 start = entry;
+
+	if (LightManager)
+	{
+		for (; entry<RenderQueue.size() && RenderQueue.getPass(entry) == pass; ++entry)
+		{
+			ISceneNode* node = RenderQueue.getNode(entry);
+			LightManager->OnNodePreRender(node);
+			node->render();
+			LightManager->OnNodePostRender(node);
+		}
+	}
+	else
+	{
+		for (; entry<RenderQueue.size() && RenderQueue.getPass(entry) == pass; ++entry)
+			RenderQueue.getNode(entry)->render();
+	}
+
+	return entry - start;
+}
+
+
+//! Get statistics about the render queue of the last drawAll() call.
+const SRenderQueueStatistics& CSceneManager::getRenderQueueStatistics() const
+{
+	return RenderQueue.getStatistics();
+}
+
+
+//! Get statistics about one of the last frames drawn by drawAll().
+const SRenderStatistics* CSceneManager::getRenderStatistics(u32 framesAgo) const
+{
+	if (framesAgo >= StatisticsCount)
+		return 0;
+
+	const u32 size = StatisticsHistory.size();
+	return &StatisticsHistory[(StatisticsNext + size - 1 - framesAgo) % size];
+}
+
+
+//! Set how many frames are kept in the render statistics history.
+void CSceneManager::setRenderStatisticsHistorySize(u32 frames)
+{
+	frames = core::max_(frames, 1u);
+
+	StatisticsHistory.clear();
+	StatisticsHistory.reallocate(frames);
+	for (u32 i=0; i<frames; ++i)
+		StatisticsHistory.push_back(SRenderStatistics());
+
+	StatisticsNext = 0;
+	StatisticsCount = 0;
+}
+
+
+//! Get how many frames are kept in the render statistics history.
+u32 CSceneManager::getRenderStatisticsHistorySize() const
+{
+	return StatisticsHistory.size();
+}
+
+
+//! returns the microseconds since time and sets time to now
+static inline u32 lapTime(u64& time)
+{
+	const u64 now = os::Timer::getRealTimeMicro();
+	const u32 elapsed = (u32)(now - time);
+	time = now;
+	return elapsed;
+}
+
+
 //! This method is called just before the rendering process of the whole scene.
 //! draws all scene nodes
 void CSceneManager::drawAll()
@@ -1351,12 +1589,16 @@ void CSceneManager::drawAll()
 	if (!Driver)
 		return;
 
-	// reset attributes
-	Parameters->setAttribute("culled", 0);
-	Parameters->setAttribute("calls", 0);
-	Parameters->setAttribute("drawn_solid", 0);
-	Parameters->setAttribute("drawn_transparent", 0);
-	Parameters->setAttribute("drawn_transparent_effect", 0);
+	const u64 startTime = os::Timer::getRealTimeMicro();
+	u64 time = startTime;
+
+	// the statistics of a frame are counted from here until the end of drawAll()
+	Statistics.reset();
+	Statistics.Frame = ++FrameNumber;
+
+	// finish the loads of the last frame
+	if (AsyncLoader)
+		AsyncLoader->update();
 
 	u32 i; // new ISO for scoping problem in some compilers
 
@@ -1371,6 +1613,7 @@ void CSceneManager::drawAll()
 
 	// do animations and other stuff.
 	OnAnimate(os::Timer::getTime());
+	Statistics.AnimateTime = lapTime(time);
 
 	/*!
 		First Scene Node for prerendering should be the active camera
@@ -1384,10 +1627,25 @@ void CSceneManager::drawAll()
 	}
 
 	// let all nodes register themselves
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	DeferCulling = Parameters->getAttributeAsBool(PARALLEL_CULLING);
+#endif
 	OnRegisterSceneNode();
 
+	if (DeferCulling)
+	{
+		DeferCulling = false;
+		cullDeferredNodes();
+	}
+
 	if (LightManager)
 		LightManager->OnPreRender(LightList);
+	Statistics.RegisterTime = lapTime(time);
+
+	// sort all passes at once, and render them in key order
+	RenderQueue.sort();
+	u32 entry = 0;
+	Statistics.SortTime = lapTime(time);
 
 	//render camera scenes
 	{
@@ -1400,10 +1658,12 @@ void CSceneManager::drawAll()
 		for (i=0; i<CameraList.size(); ++i)
 			CameraList[i]->render();
 
+		Statistics.Cameras = CameraList.size();
 		CameraList.set_used(0);
 
 		if (LightManager)
 			LightManager->OnRenderPassPostRender(CurrentRendertime);
+		Statistics.CameraPassTime = lapTime(time);
 	}
 
 	//render lights scenes
@@ -1446,8 +1706,11 @@ void CSceneManager::drawAll()
 		for (i=0; i< maxLights; ++i)
 			LightList[i]->render();
 
+		Statistics.Lights = LightList.size();
+
 		if (LightManager)
 			LightManager->OnRenderPassPostRender(CurrentRendertime);
+		Statistics.LightPassTime = lapTime(time);
 	}
 
 	// render skyboxes
@@ -1456,26 +1719,13 @@ void CSceneManager::drawAll()
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRendertime) != 0);
 
 		if (LightManager)
-		{
 			LightManager->OnRenderPassPreRender(CurrentRendertime);
-			for (i=0; i<SkyBoxList.size(); ++i)
-			{
-				ISceneNode* node = SkyBoxList[i];
-				LightManager->OnNodePreRender(node);
-				node->render();
-				LightManager->OnNodePostRender(node);
-			}
-		}
-		else
-		{
-			for (i=0; i<SkyBoxList.size(); ++i)
-				SkyBoxList[i]->render();
-		}
 
-		SkyBoxList.set_used(0);
+		Statistics.DrawnSkyBoxNodes = renderQueuePass(entry, CRenderQueue::EQP_SKY_BOX);
 
 		if (LightManager)
 			LightManager->OnRenderPassPostRender(CurrentRendertime);
+		Statistics.SkyBoxPassTime = lapTime(time);
 	}
 
 
@@ -1484,30 +1734,14 @@ void CSceneManager::drawAll()
 		CurrentRendertime = ESNRP_SOLID;
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRendertime) != 0);
 
-		SolidNodeList.sort(); // sort by textures
-
 		if (LightManager)
-		{
 			LightManager->OnRenderPassPreRender(CurrentRendertime);
-			for (i=0; i<SolidNodeList.size(); ++i)
-			{
-				ISceneNode* node = SolidNodeList[i].Node;
-				LightManager->OnNodePreRender(node);
-				node->render();
-				LightManager->OnNodePostRender(node);
-			}
-		}
-		else
-		{
-			for (i=0; i<SolidNodeList.size(); ++i)
-				SolidNodeList[i].Node->render();
-		}
 
-		Parameters->setAttribute("drawn_solid", (s32) SolidNodeList.size());
-		SolidNodeList.set_used(0);
+		Statistics.DrawnSolidNodes = renderQueuePass(entry, CRenderQueue::EQP_SOLID);
 
 		if (LightManager)
 			LightManager->OnRenderPassPostRender(CurrentRendertime);
+		Statistics.SolidPassTime = lapTime(time);
 	}
 
 	// render shadows
@@ -1516,30 +1750,16 @@ void CSceneManager::drawAll()
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRendertime) != 0);
 
 		if (LightManager)
-		{
 			LightManager->OnRenderPassPreRender(CurrentRendertime);
-			for (i=0; i<ShadowNodeList.size(); ++i)
-			{
-				ISceneNode* node = ShadowNodeList[i];
-				LightManager->OnNodePreRender(node);
-				node->render();
-				LightManager->OnNodePostRender(node);
-			}
-		}
-		else
-		{
-			for (i=0; i<ShadowNodeList.size(); ++i)
-				ShadowNodeList[i]->render();
-		}
 
-		if (!ShadowNodeList.empty())
+		Statistics.DrawnShadowNodes = renderQueuePass(entry, CRenderQueue::EQP_SHADOW);
+		if (Statistics.DrawnShadowNodes)
 			Driver->drawStencilShadow(true,ShadowColor, ShadowColor,
 				ShadowColor, ShadowColor);
 
-		ShadowNodeList.set_used(0);
-
 		if (LightManager)
 			LightManager->OnRenderPassPostRender(CurrentRendertime);
+		Statistics.ShadowPassTime = lapTime(time);
 	}
 
 	// render transparent objects.
@@ -1547,30 +1767,14 @@ void CSceneManager::drawAll()
 		CurrentRendertime = ESNRP_TRANSPARENT;
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRendertime) != 0);
 
-		TransparentNodeList.sort(); // sort by distance from camera
 		if (LightManager)
-		{
 			LightManager->OnRenderPassPreRender(CurrentRendertime);
 
-			for (i=0; i<TransparentNodeList.size(); ++i)
-			{
-				ISceneNode* node = TransparentNodeList[i].Node;
-				LightManager->OnNodePreRender(node);
-				node->render();
-				LightManager->OnNodePostRender(node);
-			}
-		}
-		else
-		{
-			for (i=0; i<TransparentNodeList.size(); ++i)
-				TransparentNodeList[i].Node->render();
-		}
-
-		Parameters->setAttribute("drawn_transparent", (s32) TransparentNodeList.size());
-		TransparentNodeList.set_used(0);
+		Statistics.DrawnTransparentNodes = renderQueuePass(entry, CRenderQueue::EQP_TRANSPARENT);
 
 		if (LightManager)
 			LightManager->OnRenderPassPostRender(CurrentRendertime);
+		Statistics.TransparentPassTime = lapTime(time);
 	}
 
 	// render transparent effect objects.
@@ -1578,30 +1782,15 @@ void CSceneManager::drawAll()
 		CurrentRendertime = ESNRP_TRANSPARENT_EFFECT;
 		Driver->getOverrideMaterial().Enabled = ((Driver->getOverrideMaterial().EnablePasses & CurrentRendertime) != 0);
 
-		TransparentEffectNodeList.sort(); // sort by distance from camera
-
 		if (LightManager)
-		{
 			LightManager->OnRenderPassPreRender(CurrentRendertime);
 
-			for (i=0; i<TransparentEffectNodeList.size(); ++i)
-			{
-				ISceneNode* node = TransparentEffectNodeList[i].Node;
-				LightManager->OnNodePreRender(node);
-				node->render();
-				LightManager->OnNodePostRender(node);
-			}
-		}
-		else
-		{
-			for (i=0; i<TransparentEffectNodeList.size(); ++i)
-				TransparentEffectNodeList[i].Node->render();
-		}
-
-		Parameters->setAttribute("drawn_transparent_effect", (s32) TransparentEffectNodeList.size());
-		TransparentEffectNodeList.set_used(0);
+		Statistics.DrawnTransparentEffectNodes = renderQueuePass(entry, CRenderQueue::EQP_TRANSPARENT_EFFECT);
+		Statistics.TransparentEffectPassTime = lapTime(time);
 	}
 
+	RenderQueue.clear();
+
 	if (LightManager)
 		LightManager->OnPostRender();
 
@@ -1609,6 +1798,15 @@ void CSceneManager::drawAll()
 	clearDeletionList();
 
 	CurrentRendertime = ESNRP_NONE;
+
+	// keep the statistics in the history
+	Statistics.RenderQueue = RenderQueue.getStatistics();
+	Statistics.TotalTime = (u32)(os::Timer::getRealTimeMicro() - startTime);
+
+	StatisticsHistory[StatisticsNext] = Statistics;
+	StatisticsNext = (StatisticsNext + 1) % StatisticsHistory.size();
+	if (StatisticsCount < StatisticsHistory.size())
+		++StatisticsCount;
 }
 
 void CSceneManager::setLightManager(ILightManager* lightManager)
@@ -1834,6 +2032,29 @@ ITriangleSelector* CSceneManager::createOctreeTriangleSelector(IMesh* mesh,
 }
 
 
+//! Creates a ITriangleSelector with a bounding volume hierarchy, based on a mesh.
+ITriangleSelector* CSceneManager::createBVHTriangleSelector(IMesh* mesh,
+							ISceneNode* node, s32 maximalPolysPerLeaf)
+{
+	if (!mesh)
+		return 0;
+
+	return new CBVHTriangleSelector(mesh, node, maximalPolysPerLeaf);
+}
+
+
+//! Creates a ITriangleSelector with a bounding volume hierarchy, which is
+//! refitted to the frames of an animated scene node.
+ITriangleSelector* CSceneManager::createBVHTriangleSelector(IAnimatedMeshSceneNode* node,
+							s32 maximalPolysPerLeaf)
+{
+	if (!node || !node->getMesh())
+		return 0;
+
+	return new CBVHTriangleSelector(node, maximalPolysPerLeaf);
+}
+
+
 //! Creates a meta triangle selector.
 IMetaTriangleSelector* CSceneManager::createMetaTriangleSelector()
 {
@@ -2021,6 +2242,16 @@ IMeshCache* CSceneManager::getMeshCache()
 }
 
 
+//! Get the loader which loads meshes and textures in the background.
+IAsyncLoader* CSceneManager::getAsyncLoader()
+{
+	if (!AsyncLoader)
+		AsyncLoader = new CAsyncLoader(this, Driver, FileSystem);
+
+	return AsyncLoader;
+}
+
+
 //! Creates a new scene manager.
 ISceneManager* CSceneManager::createNewSceneManager(bool cloneContent)
 {
@@ -13,6 +13,8 @@
 #include "IMeshLoader.h"
 #include "CAttributes.h"
 #include "ILightManager.h"
+#include "CWorkerPool.h"
+#include "CRenderQueue.h"
 
 namespace irr
 {
@@ -25,6 +27,7 @@ namespace scene
 {
 	class IMeshCache;
 	class IGeometryCreator;
+	class CAsyncLoader;
 
 	/*!
 		The Scene Manager manages scene nodes, mesh recources, cameras and all the other stuff.
@@ -50,6 +53,9 @@ namespace scene
 		//! Returns an interface to the mesh cache which is shared beween all existing scene managers.
 		virtual IMeshCache* getMeshCache();
 
+		//! Get the loader which loads meshes and textures in the background.
+		virtual IAsyncLoader* getAsyncLoader();
+
 		//! returns the video driver
 		virtual video::IVideoDriver* getVideoDriver();
 
@@ -266,6 +272,17 @@ namespace scene
 			s32 maxLOD=4, E_TERRAIN_PATCH_SIZE patchSize=ETPS_17,s32 smoothFactor=0,
 			bool addAlsoIfHeightmapEmpty=false);
 
+		//! Adds a terrain which is streamed from a tiled heightmap file.
+		virtual IPagedTerrainSceneNode* addPagedTerrainSceneNode(
+			const io::path& tiledHeightMapFileName,
+			s32 tileSize, s32 tileCountX, s32 tileCountZ,
+			s32 bitsPerPixel=16, bool signedData=true, bool floatVals=false,
+			ISceneNode* parent=0, s32 id=-1,
+			const core::vector3df& position = core::vector3df(0.0f,0.0f,0.0f),
+			const core::vector3df& scale = core::vector3df(1.0f,1.0f,1.0f),
+			video::SColor vertexColor = video::SColor(255,255,255,255),
+			s32 maxLOD=4, E_TERRAIN_PATCH_SIZE patchSize=ETPS_17);
+
 		//! Adds a dummy transformation scene node to the scene graph.
 		virtual IDummyTransformationSceneNode* addDummyTransformationSceneNode(
 			ISceneNode* parent=0, s32 id=-1);
@@ -355,6 +372,15 @@ namespace scene
 		virtual ITriangleSelector* createOctreeTriangleSelector(IMesh* mesh,
 			ISceneNode* node, s32 minimalPolysPerNode);
 
+		//! Creates a ITriangleSelector with a bounding volume hierarchy, based on a mesh.
+		virtual ITriangleSelector* createBVHTriangleSelector(IMesh* mesh,
+			ISceneNode* node, s32 maximalPolysPerLeaf);
+
+		//! Creates a ITriangleSelector with a bounding volume hierarchy, which is
+		//! refitted to the frames of an animated scene node.
+		virtual ITriangleSelector* createBVHTriangleSelector(IAnimatedMeshSceneNode* node,
+			s32 maximalPolysPerLeaf);
+
 		//! Creates a simple dynamic ITriangleSelector, based on a axis aligned bounding box.
 		virtual ITriangleSelector* createTriangleSelectorFromBoundingBox(
 			ISceneNode* node);
@@ -521,6 +547,18 @@ namespace scene
 		//! returns if node is culled
 		virtual bool isCulled(const ISceneNode* node) const;
 
+		//! Get statistics about the render queue of the last drawAll() call.
+		virtual const SRenderQueueStatistics& getRenderQueueStatistics() const;
+
+		//! Get statistics about one of the last frames drawn by drawAll().
+		virtual const SRenderStatistics* getRenderStatistics(u32 framesAgo=0) const;
+
+		//! Set how many frames are kept in the render statistics history.
+		virtual void setRenderStatisticsHistorySize(u32 frames);
+
+		//! Get how many frames are kept in the render statistics history.
+		virtual u32 getRenderStatisticsHistorySize() const;
+
 	private:
 
 		//! clears the deletion list
@@ -529,42 +567,40 @@ namespace scene
 		//! writes a scene node
 		void writeSceneNode(io::IXMLWriter* writer, ISceneNode* node, ISceneUserDataSerializer* userDataSerializer, const fschar_t* currentPath=0, bool init=false);
 
-		struct DefaultNodeEntry
-		{
-			DefaultNodeEntry(ISceneNode* n) :
-				Node(n), TextureValue(0)
-			{
-				if (n->getMaterialCount())
-					TextureValue = (n->getMaterial(0).getTexture(0));
-			}
+		//! adds a node to the render list of a pass, unless it is culled
+		u32 addToRenderList(ISceneNode* node, E_SCENE_NODE_RENDER_PASS pass, E_CULLING_TYPE culledBy);
 
-			bool operator < (const DefaultNodeEntry& other) const
-			{
-				return (TextureValue < other.TextureValue);
-			}
+		//! returns the culling test which culled the node, EAC_OFF if it is visible
+		E_CULLING_TYPE cullingTest(const ISceneNode* node) const;
+
+		//! culls the nodes collected during registration and adds them to the render lists
+		void cullDeferredNodes();
+
+		//! renders the nodes of one pass of the sorted render queue, returns the number of nodes
+		u32 renderQueuePass(u32& entry, CRenderQueue::E_QUEUE_PASS pass);
+
+		//! registration of a node which waits for culling, see PARALLEL_CULLING
+		struct SDeferredNode
+		{
+			SDeferredNode() : Node(0), Pass(ESNRP_NONE), CulledBy(EAC_OFF) {}
+			SDeferredNode(ISceneNode* node, E_SCENE_NODE_RENDER_PASS pass)
+				: Node(node), Pass(pass), CulledBy(EAC_OFF) {}
 
 			ISceneNode* Node;
-			private:
-			void* TextureValue;
+			E_SCENE_NODE_RENDER_PASS Pass;
+			E_CULLING_TYPE CulledBy;
 		};
 
-		//! sort on distance (center) to camera
-		struct TransparentNodeEntry
+		//! culls blocks of deferred nodes on the worker threads
+		struct SCullJob : public IWorkerJob
 		{
-			TransparentNodeEntry(ISceneNode* n, const core::vector3df& camera)
-				: Node(n)
-			{
-				Distance = Node->getAbsoluteTransformation().getTranslation().getDistanceFromSQ(camera);
-			}
+			SCullJob() : SceneManager(0), Nodes(0), Count(0) {}
 
-			bool operator < (const TransparentNodeEntry& other) const
-			{
-				return Distance > other.Distance;
-			}
+			virtual void execute(u32 block, u32 thread);
 
-			ISceneNode* Node;
-			private:
-				f64 Distance;
+			const CSceneManager* SceneManager;
+			SDeferredNode* Nodes;
+			u32 Count;
 		};
 
 		//! sort on distance (sphere) to camera
@@ -611,11 +647,9 @@ namespace scene
 		//! render pass lists
 		core::array<ISceneNode*> CameraList;
 		core::array<ISceneNode*> LightList;
-		core::array<ISceneNode*> ShadowNodeList;
-		core::array<ISceneNode*> SkyBoxList;
-		core::array<DefaultNodeEntry> SolidNodeList;
-		core::array<TransparentNodeEntry> TransparentNodeList;
-		core::array<TransparentNodeEntry> TransparentEffectNodeList;
+
+		//! sky box, solid, shadow, transparent and transparent effect nodes
+		CRenderQueue RenderQueue;
 
 		core::array<IMeshLoader*> MeshLoaderList;
 		core::array<ISceneLoader*> SceneLoaderList;
@@ -636,6 +670,9 @@ namespace scene
 		//! Mesh cache
 		IMeshCache* MeshCache;
 
+		//! loads meshes and textures in the background, created on demand
+		CAsyncLoader* AsyncLoader;
+
 		E_SCENE_NODE_RENDER_PASS CurrentRendertime;
 
 		//! An optional callbacks manager to allow the user app finer control
@@ -649,6 +686,21 @@ namespace scene
 		const core::stringw IRR_XML_FORMAT_NODE_ATTR_TYPE;
 
 		IGeometryCreator* GeometryCreator;
+
+		//! nodes waiting for culling while PARALLEL_CULLING is enabled
+		core::array<SDeferredNode> DeferredNodeList;
+		bool DeferCulling;
+		SCullJob CullJob;
+		CWorkerPool* CullPool;
+
+		//! statistics of the current frame
+		SRenderStatistics Statistics;
+		u32 FrameNumber;
+
+		//! ring buffer with the statistics of the last frames
+		core::array<SRenderStatistics> StatisticsHistory;
+		u32 StatisticsNext;
+		u32 StatisticsCount;
 	};
 
 } // end namespace video
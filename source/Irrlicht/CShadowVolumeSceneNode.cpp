@@ -9,6 +9,7 @@
 #include "ICameraSceneNode.h"
 #include "SViewFrustum.h"
 #include "SLight.h"
+#include "SceneParameters.h"
 #include "os.h"
 
 namespace irr
@@ -16,12 +17,14 @@ namespace irr
 namespace scene
 {
 
+core::array<CShadowVolumeSceneNode::SAdjacency*> CShadowVolumeSceneNode::SharedAdjacencies;
+
 
 //! constructor
 CShadowVolumeSceneNode::CShadowVolumeSceneNode(const IMesh* shadowMesh, ISceneNode* parent,
 		ISceneManager* mgr, s32 id, bool zfailmethod, f32 infinity)
 : IShadowVolumeSceneNode(parent, mgr, id),
-	ShadowMesh(0), IndexCount(0), VertexCount(0), ShadowVolumesUsed(0),
+	Adjacency(0), ShadowMesh(0), IndexCount(0), VertexCount(0), ShadowVolumesUsed(0),
 	Infinity(infinity), UseZFailMethod(zfailmethod)
 {
 	#ifdef _DEBUG
@@ -35,6 +38,7 @@ CShadowVolumeSceneNode::CShadowVolumeSceneNode(const IMesh* shadowMesh, ISceneNo
 //! destructor
 CShadowVolumeSceneNode::~CShadowVolumeSceneNode()
 {
+	releaseAdjacency();
 	if (ShadowMesh)
 		ShadowMesh->drop();
 }
@@ -105,6 +109,7 @@ u32 CShadowVolumeSceneNode::createEdgesAndCaps(const core::vector3df& light,
 {
 	u32 numEdges=0;
 	const u32 faceCount = IndexCount / 3;
+	const core::array<u16>& adjacency = Adjacency->Faces;
 
 	if(faceCount >= 1)
 		bb->reset(Vertices[Indices[0]]);
@@ -160,9 +165,9 @@ u32 CShadowVolumeSceneNode::createEdgesAndCaps(const core::vector3df& light,
 			const u16 wFace1 = Indices[3*i+1];
 			const u16 wFace2 = Indices[3*i+2];
 
-			const u16 adj0 = Adjacency[3*i+0];
-			const u16 adj1 = Adjacency[3*i+1];
-			const u16 adj2 = Adjacency[3*i+2];
+			const u16 adj0 = adjacency[3*i+0];
+			const u16 adj1 = adjacency[3*i+1];
+			const u16 adj2 = adjacency[3*i+2];
 
 			// add edges if face is adjacent to back-facing face
 			// or if no adjacent face was found
@@ -205,6 +210,7 @@ void CShadowVolumeSceneNode::setShadowMesh(const IMesh* mesh)
 {
 	if (ShadowMesh == mesh)
 		return;
+	releaseAdjacency();
 	if (ShadowMesh)
 		ShadowMesh->drop();
 	ShadowMesh = mesh;
@@ -271,8 +277,8 @@ void CShadowVolumeSceneNode::updateShadowVolumes()
 	}
 
 	// recalculate adjacency if necessary
-	if (oldVertexCount != VertexCount || oldIndexCount != IndexCount)
-		calculateAdjacency();
+	if (!Adjacency || oldVertexCount != VertexCount || oldIndexCount != IndexCount)
+		updateAdjacency();
 
 	core::matrix4 mat = Parent->getAbsoluteTransformation();
 	mat.makeInverse();
@@ -366,52 +372,216 @@ const core::aabbox3d<f32>& CShadowVolumeSceneNode::getBoundingBox() const
 }
 
 
+//! gets the adjacency for the current shadow mesh, shared or calculated
+void CShadowVolumeSceneNode::updateAdjacency()
+{
+	releaseAdjacency();
+
+	const bool share = SceneManager->getParameters()->getAttributeAsBool(SHADOW_ADJACENCY_CACHE);
+	if (share)
+	{
+		for (u32 i=0; i<SharedAdjacencies.size(); ++i)
+		{
+			SAdjacency* adjacency = SharedAdjacencies[i];
+			if (adjacency->Mesh == ShadowMesh && adjacency->IndexCount == IndexCount &&
+				adjacency->VertexCount == VertexCount)
+			{
+				adjacency->grab();
+				Adjacency = adjacency;
+				return;
+			}
+		}
+	}
+
+	Adjacency = new SAdjacency(ShadowMesh, IndexCount, VertexCount);
+	calculateAdjacency();
+
+	if (share)
+	{
+		Adjacency->grab();
+		SharedAdjacencies.push_back(Adjacency);
+	}
+}
+
+
+//! releases the adjacency, removes it from the shared ones when unused
+void CShadowVolumeSceneNode::releaseAdjacency()
+{
+	if (!Adjacency)
+		return;
+
+	// only referenced by this node and the shared list
+	if (Adjacency->getReferenceCount() == 2)
+	{
+		const s32 i = SharedAdjacencies.linear_search(Adjacency);
+		if (i != -1)
+		{
+			SharedAdjacencies.erase(i);
+			Adjacency->drop();
+		}
+	}
+
+	Adjacency->drop();
+	Adjacency = 0;
+}
+
+
+//! hash bucket of a position cell for calculateAdjacency
+static inline u32 adjacencyCellBucket(const core::vector3df& p, f32 invCellSize, u32 mask)
+{
+	const s32 x = (s32)floorf(core::clamp(p.X * invCellSize, -1.0e9f, 1.0e9f));
+	const s32 y = (s32)floorf(core::clamp(p.Y * invCellSize, -1.0e9f, 1.0e9f));
+	const s32 z = (s32)floorf(core::clamp(p.Z * invCellSize, -1.0e9f, 1.0e9f));
+	return (((u32)x * 73856093u) ^ ((u32)y * 19349663u) ^ ((u32)z * 83492791u)) & mask;
+}
+
+
+//! edge of the hash table in calculateAdjacency
+struct SAdjacencyEdge
+{
+	//! welded vertices of the edge, A < B, A is 0xffffffff for empty slots
+	u32 A;
+	u32 B;
+	//! the first two faces with this edge, 0xffffffff if there is none
+	u32 First;
+	u32 Second;
+};
+
+
 //! Generates adjacency information based on mesh indices.
+/** Vertices at equal positions are welded first. All face edges are then
+put into a hash table keyed on their welded vertices, which keeps the
+first two faces of each edge. An edge is adjacent to the first other face
+with the same edge, or to its own face if there is none. */
 void CShadowVolumeSceneNode::calculateAdjacency()
 {
-	Adjacency.set_used(IndexCount);
+	core::array<u16>& adjacency = Adjacency->Faces;
+	adjacency.set_used(IndexCount);
+	if (!IndexCount)
+		return;
+
+	u32 i;
+	const u32 none = 0xffffffff;
 
-	// go through all faces and fetch their three neighbours
-	for (u32 f=0; f<IndexCount; f+=3)
+	// weld: the first vertex with an equal position, found in a hashed grid
+	core::array<u32> welded;
+	welded.set_used(VertexCount);
+	if (VertexCount)
 	{
-		for (u32 edge = 0; edge<3; ++edge)
+		core::aabbox3df box(Vertices[0]);
+		for (i=1; i<VertexCount; ++i)
+			box.addInternalPoint(Vertices[i]);
+		const core::vector3df extent = box.getExtent();
+		const f32 cellSize = core::max_(core::max_(extent.X, extent.Y, extent.Z) * (1.f / 1024.f),
+			core::ROUNDING_ERROR_f32 * 2.f);
+		const f32 invCellSize = 1.f / cellSize;
+
+		u32 bucketCount = 16;
+		while (bucketCount < VertexCount * 2)
+			bucketCount <<= 1;
+		const u32 mask = bucketCount - 1;
+
+		// first vertex of each bucket and next vertex in the same bucket
+		core::array<u32> head;
+		core::array<u32> next;
+		head.set_used(bucketCount);
+		next.set_used(VertexCount);
+		for (i=0; i<bucketCount; ++i)
+			head[i] = none;
+
+		for (i=0; i<VertexCount; ++i)
 		{
-			const core::vector3df& v1 = Vertices[Indices[f+edge]];
-			const core::vector3df& v2 = Vertices[Indices[f+((edge+1)%3)]];
-
-			// now we search an_O_ther _F_ace with these two
-			// vertices, which is not the current face.
-			u32 of;
+			const core::vector3df& p = Vertices[i];
+			welded[i] = i;
+
+			// equal positions can be in all cells touched by the tolerance box
+			const core::vector3df tolerance(core::ROUNDING_ERROR_f32);
+			const core::vector3df corners[2] = { p - tolerance, p + tolerance };
+			u32 buckets[8];
+			u32 bucketsUsed = 0;
+			for (u32 c=0; c<8; ++c)
+			{
+				const u32 bucket = adjacencyCellBucket(core::vector3df(corners[c&1].X,
+					corners[(c>>1)&1].Y, corners[c>>2].Z), invCellSize, mask);
+				u32 k = 0;
+				while (k<bucketsUsed && buckets[k] != bucket)
+					++k;
+				if (k == bucketsUsed)
+					buckets[bucketsUsed++] = bucket;
+			}
 
-			for (of=0; of<IndexCount; of+=3)
+			// buckets are chained from the highest vertex index down
+			for (u32 k=0; k<bucketsUsed; ++k)
 			{
-				// only other faces
-				if (of != f)
+				for (u32 j=head[buckets[k]]; j != none; j=next[j])
 				{
-					bool cnt1 = false;
-					bool cnt2 = false;
-
-					for (s32 e=0; e<3; ++e)
-					{
-						if (v1.equals(Vertices[Indices[of+e]]))
-							cnt1=true;
-
-						if (v2.equals(Vertices[Indices[of+e]]))
-							cnt2=true;
-					}
-					// one match for each vertex, i.e. edge is the same
-					if (cnt1 && cnt2)
-						break;
+					if (p.equals(Vertices[j]) && welded[j] < welded[i])
+						welded[i] = welded[j];
 				}
 			}
 
-			// no adjacent edges -> store face number, else store adjacent face
-			if (of >= IndexCount)
-				Adjacency[f + edge] = f/3;
-			else
-				Adjacency[f + edge] = of/3;
+			const u32 bucket = adjacencyCellBucket(p, invCellSize, mask);
+			next[i] = head[bucket];
+			head[bucket] = i;
+		}
+	}
+
+	// hash table of all edges, at most half full
+	u32 edgeSlots = 16;
+	while (edgeSlots < IndexCount * 2)
+		edgeSlots <<= 1;
+	const u32 edgeMask = edgeSlots - 1;
+
+	SAdjacencyEdge empty;
+	empty.A = none;
+	empty.B = none;
+	empty.First = none;
+	empty.Second = none;
+	core::array<SAdjacencyEdge> edges;
+	edges.set_used(edgeSlots);
+	for (i=0; i<edgeSlots; ++i)
+		edges[i] = empty;
+
+	// slot of each face edge
+	core::array<u32> edgeOfIndex;
+	edgeOfIndex.set_used(IndexCount);
+
+	const u32 faceIndexCount = IndexCount - IndexCount % 3;
+	for (i=0; i<faceIndexCount; ++i)
+	{
+		const u32 face = i / 3;
+		const u32 v1 = welded[Indices[i]];
+		const u32 v2 = welded[Indices[i - i%3 + (i+1)%3]];
+		const u32 a = core::min_(v1, v2);
+		const u32 b = core::max_(v1, v2);
+
+		u32 slot = ((a * 73856093u) ^ (b * 19349663u)) & edgeMask;
+		while (edges[slot].A != none && (edges[slot].A != a || edges[slot].B != b))
+			slot = (slot + 1) & edgeMask;
+
+		SAdjacencyEdge& edge = edges[slot];
+		if (edge.A == none)
+		{
+			edge.A = a;
+			edge.B = b;
+			edge.First = face;
 		}
+		else if (edge.Second == none && edge.First != face)
+			edge.Second = face;
+
+		edgeOfIndex[i] = slot;
+	}
+
+	// no adjacent edges -> store face number, else store adjacent face
+	for (i=0; i<faceIndexCount; ++i)
+	{
+		const u32 face = i / 3;
+		const SAdjacencyEdge& edge = edges[edgeOfIndex[i]];
+		const u32 other = (edge.First != face) ? edge.First : edge.Second;
+		adjacency[i] = (u16)((other != none) ? other : face);
 	}
+	for (; i<IndexCount; ++i)
+		adjacency[i] = (u16)(i / 3);
 }
 
 
@@ -55,6 +55,27 @@ namespace scene
 		//! Generates adjacency information based on mesh indices.
 		void calculateAdjacency();
 
+		//! gets the adjacency for the current shadow mesh, shared or calculated
+		void updateAdjacency();
+
+		//! releases the adjacency, removes it from the shared ones when unused
+		void releaseAdjacency();
+
+		//! adjacent face for each edge of each face, the face itself for open edges
+		struct SAdjacency : public IReferenceCounted
+		{
+			SAdjacency(const IMesh* mesh, u32 indexCount, u32 vertexCount)
+				: Mesh(mesh), IndexCount(indexCount), VertexCount(vertexCount) {}
+
+			const IMesh* Mesh;
+			u32 IndexCount;
+			u32 VertexCount;
+			core::array<u16> Faces;
+		};
+
+		//! adjacencies shared by shadow volumes when SHADOW_ADJACENCY_CACHE is set
+		static core::array<SAdjacency*> SharedAdjacencies;
+
 		core::aabbox3d<f32> Box;
 
 		// a shadow volume for every light
@@ -65,7 +86,7 @@ namespace scene
 
 		core::array<core::vector3df> Vertices;
 		core::array<u16> Indices;
-		core::array<u16> Adjacency;
+		SAdjacency* Adjacency;
 		core::array<u16> Edges;
 		// tells if face is front facing
 		core::array<bool> FaceData;
@@ -10,31 +10,50 @@
 #include "IAnimatedMeshSceneNode.h"
 #include "os.h"
 
+#ifdef _IRR_COMPILE_WITH_SSE2_
+#include <emmintrin.h>
+#endif
+
 namespace irr
 {
 namespace scene
 {
 
+#ifdef _IRR_COMPILE_WITH_THREADS_
+//! worker threads shared by all skinned meshes with parallel skinning
+static CWorkerPool* SkinningPool = 0;
+#endif
+
+//! number of vertices skinned by one work item of the skinning job
+static const u32 SKIN_BLOCK_SIZE = 1024;
+
 
 //! constructor
 CSkinnedMesh::CSkinnedMesh()
-: SkinningBuffers(0), AnimationFrames(0.f), FramesPerSecond(25.f),
+: SkinningBuffers(0), PoseCacheBudget(0), PoseCacheSize(0), PoseCacheClock(0),
+	PoseFrameQuantum(0.f), PoseFrame(-1.f),
+	AnimationFrames(0.f), FramesPerSecond(25.f),
 	LastAnimatedFrame(-1), SkinnedLastFrame(false),
 	InterpolationMode(EIM_LINEAR),
 	HasAnimation(false), PreparedForSkinning(false),
-	AnimateNormals(true), HardwareSkinning(false)
+	AnimateNormals(true), HardwareSkinning(false), SkinInfluencesDirty(true),
+	ParallelSkinning(false)
 {
 	#ifdef _DEBUG
 	setDebugName("CSkinnedMesh");
 	#endif
 
 	SkinningBuffers=&LocalBuffers;
+	SkinJob.Mesh=this;
 }
 
 
 //! destructor
 CSkinnedMesh::~CSkinnedMesh()
 {
+	setParallelSkinning(false);
+	clearPoseCache();
+
 	for (u32 i=0; i<AllJoints.size(); ++i)
 		delete AllJoints[i];
 
@@ -93,15 +112,31 @@ IMesh* CSkinnedMesh::getMesh(s32 frame, s32 detailLevel, s32 startFrameLoop, s32
 //! blend: {0-old position, 1-New position}
 void CSkinnedMesh::animateMesh(f32 frame, f32 blend)
 {
+	const bool cachePose = PoseCacheBudget && !HardwareSkinning && blend==1.0f;
+	if (cachePose && PoseFrameQuantum>0.f)
+		frame = core::round_(frame / PoseFrameQuantum) * PoseFrameQuantum;
+
 	if (!HasAnimation || LastAnimatedFrame==frame)
 		return;
 
 	LastAnimatedFrame=frame;
 	SkinnedLastFrame=false;
+	PoseFrame=-1.f;
 
 	if (blend<=0.f)
 		return; //No need to animate
 
+	if (cachePose)
+	{
+		core::map<f32, u32>::Node* node = PoseOfFrame.find(frame);
+		if (node)
+		{
+			restorePose(node->getValue());
+			return;
+		}
+		PoseFrame=frame;
+	}
+
 	for (u32 i=0; i<AllJoints.size(); ++i)
 	{
 		//The joints can be animated here with no input from their
@@ -471,73 +506,451 @@ void CSkinnedMesh::skinMesh()
 			}
 		}
 
-		//clear skinning helper array
-		for (i=0; i<Vertices_Moved.size(); ++i)
-			for (u32 j=0; j<Vertices_Moved[i].size(); ++j)
-				Vertices_Moved[i][j]=false;
+		if (SkinInfluencesDirty)
+			buildSkinInfluences();
 
-		//skin starting with the root joints
-		for (i=0; i<RootJoints.size(); ++i)
-			skinJoint(RootJoints[i], 0);
+		const SSkinInfluences& t = SkinInfluences;
+
+		//Find each joints pull on vertices...
+		SkinMatrices.set_used(t.Joints.size());
+		for (i=0; i<t.Joints.size(); ++i)
+			SkinMatrices[i].setbyproduct(t.Joints[i]->GlobalAnimatedMatrix, t.Joints[i]->GlobalInversedMatrix);
+
+		updateSkinVertices();
+
+		//Skin Vertices Positions and Normals...
+		const u32 rows = t.Buffer.size();
+#ifdef _IRR_COMPILE_WITH_THREADS_
+		if (ParallelSkinning && rows > SKIN_BLOCK_SIZE)
+			SkinningPool->run(&SkinJob, (rows + SKIN_BLOCK_SIZE - 1) / SKIN_BLOCK_SIZE);
+		else
+#endif
+			skinRows(0, rows);
+
+		//Vertices with more than four joints
+		for (i=0; i<t.Extra.size(); ++i)
+		{
+			const SExtraInfluence& extra = t.Extra[i];
+			const u32 r = extra.Row;
+			video::S3DVertex* vertex = (video::S3DVertex*)(SkinVertices[t.Buffer[r]] + SkinVertexPitch[t.Buffer[r]] * t.Vertex[r]);
+
+			core::vector3df move;
+			SkinMatrices[extra.Joint].transformVect(move, t.StaticPos[r]);
+			vertex->Pos += move * extra.Weight;
+
+			if (AnimateNormals)
+			{
+				SkinMatrices[extra.Joint].rotateVect(move, t.StaticNormal[r]);
+				vertex->Normal += move * extra.Weight;
+			}
+		}
+
+		for (i=0; i<t.Buffers.size(); ++i)
+			(*SkinningBuffers)[t.Buffers[i]]->boundingBoxNeedsRecalculated();
 
 		for (i=0; i<SkinningBuffers->size(); ++i)
 			(*SkinningBuffers)[i]->setDirty(EBT_VERTEX);
 	}
 	updateBoundingBox();
+
+	if (PoseFrame>=0.f && !HardwareSkinning)
+		storePose(PoseFrame);
 }
 
 
-void CSkinnedMesh::skinJoint(SJoint *joint, SJoint *parentJoint)
+//! updates the vertex pointers and pitches of the skinning buffers
+void CSkinnedMesh::updateSkinVertices()
 {
-	if (joint->Weights.size())
+	SkinVertices.set_used(SkinningBuffers->size());
+	SkinVertexPitch.set_used(SkinningBuffers->size());
+	for (u32 i=0; i<SkinningBuffers->size(); ++i)
 	{
-		//Find this joints pull on vertices...
-		core::matrix4 jointVertexPull(core::matrix4::EM4CONST_NOTHING);
-		jointVertexPull.setbyproduct(joint->GlobalAnimatedMatrix, joint->GlobalInversedMatrix);
+		SSkinMeshBuffer* buffer = (*SkinningBuffers)[i];
+		SkinVertices[i] = (u8*)buffer->getVertices();
+		SkinVertexPitch[i] = video::getVertexPitchFromType(buffer->getVertexType());
+	}
+}
 
-		core::vector3df thisVertexMove, thisNormalMove;
 
-		core::array<scene::SSkinMeshBuffer*> &buffersUsed=*SkinningBuffers;
+//! skins the rows [begin, end) of the influence table
+void CSkinnedMesh::skinRows(u32 begin, u32 end)
+{
+	const SSkinInfluences& t = SkinInfluences;
+	const core::matrix4* matrices = SkinMatrices.const_pointer();
 
-		//Skin Vertices Positions and Normals...
-		for (u32 i=0; i<joint->Weights.size(); ++i)
+	for (u32 r=begin; r<end; ++r)
+	{
+		video::S3DVertex* vertex = (video::S3DVertex*)(SkinVertices[t.Buffer[r]] + SkinVertexPitch[t.Buffer[r]] * t.Vertex[r]);
+		const u16* joint = &t.Joint[r*4];
+		const f32* weight = &t.Weight[r*4];
+		const u32 count = t.Count[r];
+		const core::vector3df& pos = t.StaticPos[r];
+		const core::vector3df& normal = t.StaticNormal[r];
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+		// the columns of the matrices are the x, y, z and translation axes
+		const __m128 px = _mm_set1_ps(pos.X);
+		const __m128 py = _mm_set1_ps(pos.Y);
+		const __m128 pz = _mm_set1_ps(pos.Z);
+		const __m128 nx = _mm_set1_ps(normal.X);
+		const __m128 ny = _mm_set1_ps(normal.Y);
+		const __m128 nz = _mm_set1_ps(normal.Z);
+		__m128 sumPos = _mm_setzero_ps();
+		__m128 sumNormal = _mm_setzero_ps();
+
+		for (u32 k=0; k<count; ++k)
 		{
-			SWeight& weight = joint->Weights[i];
+			const f32* m = matrices[joint[k]].pointer();
+			const __m128 c0 = _mm_loadu_ps(m);
+			const __m128 c1 = _mm_loadu_ps(m+4);
+			const __m128 c2 = _mm_loadu_ps(m+8);
+			const __m128 w = _mm_set1_ps(weight[k]);
 
-			// Pull this vertex...
-			jointVertexPull.transformVect(thisVertexMove, weight.StaticPos);
+			__m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, px), _mm_mul_ps(c1, py)), _mm_mul_ps(c2, pz));
+			v = _mm_add_ps(v, _mm_loadu_ps(m+12));
+			sumPos = _mm_add_ps(sumPos, _mm_mul_ps(v, w));
 
 			if (AnimateNormals)
-				jointVertexPull.rotateVect(thisNormalMove, weight.StaticNormal);
+			{
+				v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, nx), _mm_mul_ps(c1, ny)), _mm_mul_ps(c2, nz));
+				sumNormal = _mm_add_ps(sumNormal, _mm_mul_ps(v, w));
+			}
+		}
+
+		f32 out[4];
+		_mm_storeu_ps(out, sumPos);
+		vertex->Pos.set(out[0], out[1], out[2]);
+
+		if (AnimateNormals)
+		{
+			_mm_storeu_ps(out, sumNormal);
+			vertex->Normal.set(out[0], out[1], out[2]);
+		}
+#else
+		core::vector3df sumPos(0,0,0);
+		core::vector3df sumNormal(0,0,0);
+		core::vector3df move;
+
+		for (u32 k=0; k<count; ++k)
+		{
+			matrices[joint[k]].transformVect(move, pos);
+			sumPos += move * weight[k];
 
-			if (! (*(weight.Moved)) )
+			if (AnimateNormals)
 			{
-				*(weight.Moved) = true;
+				matrices[joint[k]].rotateVect(move, normal);
+				sumNormal += move * weight[k];
+			}
+		}
+
+		vertex->Pos = sumPos;
+		if (AnimateNormals)
+			vertex->Normal = sumNormal;
+#endif
+	}
+}
+
+
+//! skins a block of rows, called from the worker threads
+void CSkinnedMesh::SSkinJob::execute(u32 block, u32 thread)
+{
+	const u32 begin = block * SKIN_BLOCK_SIZE;
+	Mesh->skinRows(begin, core::min_(begin + SKIN_BLOCK_SIZE, Mesh->SkinInfluences.Buffer.size()));
+}
+
+
+//! adds the joints with weights to the influence table, in skinning order
+void CSkinnedMesh::collectSkinJoints(SJoint *joint)
+{
+	if (joint->Weights.size())
+		SkinInfluences.Joints.push_back(joint);
 
-				buffersUsed[weight.buffer_id]->getVertex(weight.vertex_id)->Pos = thisVertexMove * weight.strength;
+	for (u32 j=0; j<joint->Children.size(); ++j)
+		collectSkinJoints(joint->Children[j]);
+}
+
+
+//! gathers the vertex weights into the influence table
+/** The influences of a vertex are in the order the joints were skinned
+before, starting with the root joints, so the sums are the same. */
+void CSkinnedMesh::buildSkinInfluences()
+{
+	SkinInfluencesDirty = false;
+	clearPoseCache();
+
+	SSkinInfluences& t = SkinInfluences;
+	t.Buffer.set_used(0);
+	t.Vertex.set_used(0);
+	t.Count.set_used(0);
+	t.Joint.set_used(0);
+	t.Weight.set_used(0);
+	t.StaticPos.set_used(0);
+	t.StaticNormal.set_used(0);
+	t.Extra.set_used(0);
+	t.Joints.set_used(0);
+	t.Buffers.set_used(0);
+
+	u32 i, j;
+	for (i=0; i<RootJoints.size(); ++i)
+		collectSkinJoints(RootJoints[i]);
+
+	// mark the skinned vertices
+	const u32 bufferCount = SkinningBuffers->size();
+	core::array< core::array<s32> > rowOfVertex;
+	rowOfVertex.reallocate(bufferCount);
+	for (i=0; i<bufferCount; ++i)
+	{
+		rowOfVertex.push_back(core::array<s32>());
+		rowOfVertex[i].set_used((*SkinningBuffers)[i]->getVertexCount());
+		for (j=0; j<rowOfVertex[i].size(); ++j)
+			rowOfVertex[i][j] = -1;
+	}
+
+	for (i=0; i<t.Joints.size(); ++i)
+	{
+		const SJoint* joint = t.Joints[i];
+		for (j=0; j<joint->Weights.size(); ++j)
+			rowOfVertex[joint->Weights[j].buffer_id][joint->Weights[j].vertex_id] = 0;
+	}
+
+	// one row per skinned vertex, in buffer and vertex order
+	u32 rows = 0;
+	for (i=0; i<bufferCount; ++i)
+	{
+		const u32 first = rows;
+		for (j=0; j<rowOfVertex[i].size(); ++j)
+		{
+			if (rowOfVertex[i][j] == -1)
+				continue;
+
+			rowOfVertex[i][j] = rows++;
+			t.Buffer.push_back(i);
+			t.Vertex.push_back(j);
+			t.Count.push_back(0);
+		}
+		if (rows != first)
+			t.Buffers.push_back(i);
+	}
+
+	t.Joint.set_used(rows*4);
+	t.Weight.set_used(rows*4);
+	t.StaticPos.set_used(rows);
+	t.StaticNormal.set_used(rows);
+	for (i=0; i<rows*4; ++i)
+	{
+		t.Joint[i] = 0;
+		t.Weight[i] = 0.f;
+	}
+
+	for (i=0; i<t.Joints.size(); ++i)
+	{
+		const SJoint* joint = t.Joints[i];
+		for (j=0; j<joint->Weights.size(); ++j)
+		{
+			const SWeight& weight = joint->Weights[j];
+			const u32 r = rowOfVertex[weight.buffer_id][weight.vertex_id];
 
-				if (AnimateNormals)
-					buffersUsed[weight.buffer_id]->getVertex(weight.vertex_id)->Normal = thisNormalMove * weight.strength;
+			if (t.Count[r] == 0)
+			{
+				t.StaticPos[r] = weight.StaticPos;
+				t.StaticNormal[r] = weight.StaticNormal;
+			}
 
-				//*(weight._Pos) = thisVertexMove * weight.strength;
+			if (t.Count[r] < 4)
+			{
+				const u32 slot = r*4 + t.Count[r];
+				t.Joint[slot] = (u16)i;
+				t.Weight[slot] = weight.strength;
+				++t.Count[r];
 			}
 			else
 			{
-				buffersUsed[weight.buffer_id]->getVertex(weight.vertex_id)->Pos += thisVertexMove * weight.strength;
+				SExtraInfluence extra;
+				extra.Row = r;
+				extra.Joint = (u16)i;
+				extra.Weight = weight.strength;
+				t.Extra.push_back(extra);
+			}
+		}
+	}
+}
 
-				if (AnimateNormals)
-					buffersUsed[weight.buffer_id]->getVertex(weight.vertex_id)->Normal += thisNormalMove * weight.strength;
 
-				//*(weight._Pos) += thisVertexMove * weight.strength;
-			}
+//--------------------------------------------------------------------------
+//				Pose Cache
+//--------------------------------------------------------------------------
+
+//! Keeps the skinned poses of animated frames for reuse
+void CSkinnedMesh::setPoseCache(u32 budget, f32 frameQuantum)
+{
+	PoseCacheBudget = budget;
+	PoseFrameQuantum = core::max_(frameQuantum, 0.f);
+	clearPoseCache();
+}
+
+
+//! Removes all poses from the pose cache
+void CSkinnedMesh::clearPoseCache()
+{
+	for (u32 i=0; i<Poses.size(); ++i)
+		delete Poses[i];
+
+	Poses.clear();
+	PoseOfFrame.clear();
+	PoseCacheSize = 0;
+}
+
+
+//! restores a cached pose into the joints and skinning buffers
+void CSkinnedMesh::restorePose(u32 index)
+{
+	SPose& pose = *Poses[index];
+	pose.LastUsed = ++PoseCacheClock;
+
+	u32 i;
+	for (i=0; i<AllJoints.size(); ++i)
+	{
+		SJoint *joint = AllJoints[i];
+		joint->Animatedposition = pose.Position[i];
+		joint->Animatedscale = pose.Scale[i];
+		joint->Animatedrotation = pose.Rotation[i];
+		joint->LocalAnimatedMatrix = pose.LocalMatrix[i];
+		joint->GlobalAnimatedMatrix = pose.GlobalMatrix[i];
+
+		for (u32 j=0; j<joint->AttachedMeshes.size(); ++j)
+			(*SkinningBuffers)[joint->AttachedMeshes[j]]->Transformation = joint->GlobalAnimatedMatrix;
+	}
+
+	updateSkinVertices();
+
+	const SSkinInfluences& t = SkinInfluences;
+	for (i=0; i<t.Buffer.size(); ++i)
+	{
+		video::S3DVertex* vertex = (video::S3DVertex*)(SkinVertices[t.Buffer[i]] + SkinVertexPitch[t.Buffer[i]] * t.Vertex[i]);
+		vertex->Pos = pose.Pos[i];
+		if (AnimateNormals)
+			vertex->Normal = pose.Normal[i];
+	}
+
+	for (i=0; i<t.Buffers.size(); ++i)
+	{
+		SSkinMeshBuffer* buffer = (*SkinningBuffers)[t.Buffers[i]];
+		buffer->BoundingBox = pose.BufferBox[i];
+		buffer->BoundingBoxNeedsRecalculated = false;
+	}
+
+	for (i=0; i<SkinningBuffers->size(); ++i)
+		(*SkinningBuffers)[i]->setDirty(EBT_VERTEX);
+
+	BoundingBox = pose.BoundingBox;
+	SkinnedLastFrame = true;
+}
+
+
+//! puts the current pose of the joints and buffers into the cache
+void CSkinnedMesh::storePose(f32 frame)
+{
+	PoseFrame = -1.f;
+
+	const SSkinInfluences& t = SkinInfluences;
+	const u32 jointSize = sizeof(core::vector3df)*2 + sizeof(core::quaternion) + sizeof(core::matrix4)*2;
+	const u32 rowSize = sizeof(core::vector3df) * (AnimateNormals ? 2 : 1);
+	const u32 size = sizeof(SPose) + AllJoints.size() * jointSize +
+		t.Buffer.size() * rowSize + t.Buffers.size() * sizeof(core::aabbox3df);
+
+	if (size > PoseCacheBudget || PoseOfFrame.find(frame))
+		return;
+
+	// remove the least recently used poses, the last one is reused
+	SPose* pose = 0;
+	while (PoseCacheSize + size > PoseCacheBudget)
+	{
+		u32 oldest = 0;
+		for (u32 i=1; i<Poses.size(); ++i)
+		{
+			if (Poses[i]->LastUsed < Poses[oldest]->LastUsed)
+				oldest = i;
+		}
 
-			buffersUsed[weight.buffer_id]->boundingBoxNeedsRecalculated();
+		delete pose;
+		pose = Poses[oldest];
+		PoseCacheSize -= pose->Size;
+		PoseOfFrame.remove(pose->Frame);
+
+		const u32 last = Poses.size()-1;
+		if (oldest != last)
+		{
+			Poses[oldest] = Poses[last];
+			PoseOfFrame[Poses[oldest]->Frame] = oldest;
 		}
+		Poses.erase(last);
 	}
 
-	//Skin all children
-	for (u32 j=0; j<joint->Children.size(); ++j)
-		skinJoint(joint->Children[j], joint);
+	if (!pose)
+		pose = new SPose();
+
+	pose->Frame = frame;
+	pose->LastUsed = ++PoseCacheClock;
+	pose->Size = size;
+
+	u32 i;
+	const u32 jointCount = AllJoints.size();
+	pose->Position.set_used(jointCount);
+	pose->Scale.set_used(jointCount);
+	pose->Rotation.set_used(jointCount);
+	pose->LocalMatrix.set_used(jointCount);
+	pose->GlobalMatrix.set_used(jointCount);
+	for (i=0; i<jointCount; ++i)
+	{
+		const SJoint *joint = AllJoints[i];
+		pose->Position[i] = joint->Animatedposition;
+		pose->Scale[i] = joint->Animatedscale;
+		pose->Rotation[i] = joint->Animatedrotation;
+		pose->LocalMatrix[i] = joint->LocalAnimatedMatrix;
+		pose->GlobalMatrix[i] = joint->GlobalAnimatedMatrix;
+	}
+
+	const u32 rows = t.Buffer.size();
+	pose->Pos.set_used(rows);
+	pose->Normal.set_used(AnimateNormals ? rows : 0);
+	for (i=0; i<rows; ++i)
+	{
+		const video::S3DVertex* vertex = (video::S3DVertex*)(SkinVertices[t.Buffer[i]] + SkinVertexPitch[t.Buffer[i]] * t.Vertex[i]);
+		pose->Pos[i] = vertex->Pos;
+		if (AnimateNormals)
+			pose->Normal[i] = vertex->Normal;
+	}
+
+	pose->BufferBox.set_used(t.Buffers.size());
+	for (i=0; i<t.Buffers.size(); ++i)
+		pose->BufferBox[i] = (*SkinningBuffers)[t.Buffers[i]]->BoundingBox;
+
+	pose->BoundingBox = BoundingBox;
+
+	PoseOfFrame[frame] = Poses.size();
+	Poses.push_back(pose);
+	PoseCacheSize += size;
+}
+
+
+//! Skins the vertices on several threads
+void CSkinnedMesh::setParallelSkinning(bool on)
+{
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	if (ParallelSkinning == on)
+		return;
+
+	ParallelSkinning = on;
+	if (on)
+	{
+		if (SkinningPool)
+			SkinningPool->grab();
+		else
+			SkinningPool = new CWorkerPool();
+	}
+	else if (SkinningPool->drop())
+		SkinningPool = 0;
+#endif
 }
 
 
@@ -672,6 +1085,7 @@ bool CSkinnedMesh::useAnimationFrom(const ISkinnedMesh *mesh)
 	}
 
 	checkForAnimation();
+	clearPoseCache();
 
 	return !unmatched;
 }
@@ -682,6 +1096,8 @@ bool CSkinnedMesh::useAnimationFrom(const ISkinnedMesh *mesh)
 //!True= Update normals (default)
 void CSkinnedMesh::updateNormalsWhenAnimating(bool on)
 {
+	if (AnimateNormals != on)
+		clearPoseCache();
 	AnimateNormals = on;
 }
 
@@ -689,6 +1105,8 @@ void CSkinnedMesh::updateNormalsWhenAnimating(bool on)
 //!Sets Interpolation Mode
 void CSkinnedMesh::setInterpolationMode(E_INTERPOLATION_MODE mode)
 {
+	if (InterpolationMode != mode)
+		clearPoseCache();
 	InterpolationMode = mode;
 }
 
@@ -735,6 +1153,7 @@ bool CSkinnedMesh::setHardwareSkinning(bool on)
 		}
 
 		HardwareSkinning=on;
+		clearPoseCache();
 	}
 	return HardwareSkinning;
 }
@@ -851,12 +1270,6 @@ void CSkinnedMesh::checkForAnimation()
 			}
 		}
 
-		//An array used in skinning
-
-		for (i=0; i<Vertices_Moved.size(); ++i)
-			for (j=0; j<Vertices_Moved[i].size(); ++j)
-				Vertices_Moved[i][j] = false;
-
 		// For skinning: cache weight values for speed
 
 		for (i=0; i<AllJoints.size(); ++i)
@@ -867,7 +1280,6 @@ void CSkinnedMesh::checkForAnimation()
 				const u16 buffer_id=joint->Weights[j].buffer_id;
 				const u32 vertex_id=joint->Weights[j].vertex_id;
 
-				joint->Weights[j].Moved = &Vertices_Moved[buffer_id] [vertex_id];
 				joint->Weights[j].StaticPos = LocalBuffers[buffer_id]->getVertex(vertex_id)->Pos;
 				joint->Weights[j].StaticNormal = LocalBuffers[buffer_id]->getVertex(vertex_id)->Normal;
 
@@ -877,6 +1289,8 @@ void CSkinnedMesh::checkForAnimation()
 
 		// normalize weights
 		normalizeWeights();
+
+		SkinInfluencesDirty=true;
 	}
 	SkinnedLastFrame=false;
 }
@@ -890,6 +1304,7 @@ void CSkinnedMesh::finalize()
 	// Make sure we recalc the next frame
 	LastAnimatedFrame=-1;
 	SkinnedLastFrame=false;
+	clearPoseCache();
 
 	//calculate bounding box
 	for (i=0; i<LocalBuffers.size(); ++i)
@@ -931,14 +1346,6 @@ void CSkinnedMesh::finalize()
 		AllJoints[i]->UseAnimationFrom=AllJoints[i];
 	}
 
-	//Set array sizes...
-
-	for (i=0; i<LocalBuffers.size(); ++i)
-	{
-		Vertices_Moved.push_back( core::array<bool>() );
-		Vertices_Moved[i].set_used(LocalBuffers[i]->getVertexCount());
-	}
-
 	//Todo: optimise keys here...
 
 	checkForAnimation();
@@ -1310,6 +1717,7 @@ void CSkinnedMesh::transferJointsToMesh(const core::array<IBoneSceneNode*> &join
 	// Make sure we recalc the next frame
 	LastAnimatedFrame=-1;
 	SkinnedLastFrame=false;
+	PoseFrame=-1.f;
 }
 
 
@@ -13,6 +13,8 @@
 #include "irrString.h"
 #include "matrix4.h"
 #include "quaternion.h"
+#include "irrMap.h"
+#include "CWorkerPool.h"
 
 namespace irr
 {
@@ -155,6 +157,15 @@ namespace scene
 		//! Tranfers the joint hints to the mesh
 		void transferOnlyJointsHintsToMesh(const core::array<IBoneSceneNode*> &jointChildSceneNodes);
 
+		//! Skins the vertices on several threads
+		virtual void setParallelSkinning(bool on);
+
+		//! Keeps the skinned poses of animated frames for reuse
+		virtual void setPoseCache(u32 budget, f32 frameQuantum=0.f);
+
+		//! Removes all poses from the pose cache
+		virtual void clearPoseCache();
+
 		//! Creates an array of joints from this mesh as children of node
 		void addJoints(core::array<IBoneSceneNode*> &jointChildSceneNodes,
 				IAnimatedMeshSceneNode* node,
@@ -176,7 +187,64 @@ private:
 
 		void calculateGlobalMatrices(SJoint *Joint,SJoint *ParentJoint);
 
-		void skinJoint(SJoint *Joint, SJoint *ParentJoint);
+		//! gathers the vertex weights into the influence table
+		void buildSkinInfluences();
+
+		//! adds the joints with weights to the influence table, in skinning order
+		void collectSkinJoints(SJoint *joint);
+
+		//! skins the rows [begin, end) of the influence table
+		void skinRows(u32 begin, u32 end);
+
+		//! updates the vertex pointers and pitches of the skinning buffers
+		void updateSkinVertices();
+
+		//! restores a cached pose into the joints and skinning buffers
+		void restorePose(u32 index);
+
+		//! puts the current pose of the joints and buffers into the cache
+		void storePose(f32 frame);
+
+		//! influence of a joint beyond the first four of a vertex
+		struct SExtraInfluence
+		{
+			u32 Row;
+			u16 Joint;
+			f32 Weight;
+		};
+
+		//! Influences of the joints on the vertices, one row per skinned vertex.
+		/** Each field is a separate array, rows are sorted by buffer and vertex. */
+		struct SSkinInfluences
+		{
+			//! mesh buffer and vertex of each row
+			core::array<u16> Buffer;
+			core::array<u32> Vertex;
+			//! number of used influences of each row, at most 4
+			core::array<u8> Count;
+			//! four joints and weights for each row
+			core::array<u16> Joint;
+			core::array<f32> Weight;
+			//! position and normal in the static pose
+			core::array<core::vector3df> StaticPos;
+			core::array<core::vector3df> StaticNormal;
+			//! influences beyond the first four of a row
+			core::array<SExtraInfluence> Extra;
+			//! joints with weights, the index is used in the Joint array
+			core::array<SJoint*> Joints;
+			//! mesh buffers with skinned vertices
+			core::array<u16> Buffers;
+		};
+
+		//! skins blocks of rows of the influence table on the worker threads
+		struct SSkinJob : public IWorkerJob
+		{
+			SSkinJob() : Mesh(0) {}
+
+			virtual void execute(u32 block, u32 thread);
+
+			CSkinnedMesh* Mesh;
+		};
 
 		void calculateTangents(core::vector3df& normal,
 			core::vector3df& tangent, core::vector3df& binormal,
@@ -190,7 +258,44 @@ private:
 		core::array<SJoint*> AllJoints;
 		core::array<SJoint*> RootJoints;
 
-		core::array< core::array<bool> > Vertices_Moved;
+		SSkinInfluences SkinInfluences;
+
+		//! joint matrices and vertex data of the skinned buffers, updated each skin
+		core::array<core::matrix4> SkinMatrices;
+		core::array<u8*> SkinVertices;
+		core::array<u32> SkinVertexPitch;
+
+		SSkinJob SkinJob;
+
+		//! animated joints and skinned vertices of one frame
+		struct SPose
+		{
+			f32 Frame;
+			u32 LastUsed;
+			u32 Size;
+			//! animated state of each joint
+			core::array<core::vector3df> Position;
+			core::array<core::vector3df> Scale;
+			core::array<core::quaternion> Rotation;
+			core::array<core::matrix4> LocalMatrix;
+			core::array<core::matrix4> GlobalMatrix;
+			//! skinned vertices, one per row of the influence table
+			core::array<core::vector3df> Pos;
+			core::array<core::vector3df> Normal;
+			//! bounding boxes of the buffers with skinned vertices
+			core::array<core::aabbox3df> BufferBox;
+			core::aabbox3df BoundingBox;
+		};
+
+		//! cached poses and the index of the pose of each frame
+		core::array<SPose*> Poses;
+		core::map<f32, u32> PoseOfFrame;
+		u32 PoseCacheBudget;
+		u32 PoseCacheSize;
+		u32 PoseCacheClock;
+		f32 PoseFrameQuantum;
+		//! frame of the joints when they are animated only by animateMesh, else -1
+		f32 PoseFrame;
 
 		core::aabbox3d<f32> BoundingBox;
 
@@ -206,6 +311,8 @@ private:
 		bool PreparedForSkinning;
 		bool AnimateNormals;
 		bool HardwareSkinning;
+		bool SkinInfluencesDirty;
+		bool ParallelSkinning;
 	};
 
 } // end namespace scene
@@ -14,6 +14,10 @@
 #include "S4DVertex.h"
 #include "CBlit.h"
 
+#if defined ( SOFTWARE_DRIVER_2_USE_SSE2 )
+	#include <emmintrin.h>
+#endif
+
 
 #define MAT_TEXTURE(tex) ( (video::CSoftwareTexture2*) Material.org.getTexture ( tex ) )
 
@@ -336,8 +340,8 @@ CBurningVideoDriver::CBurningVideoDriver(const irr::SIrrlichtCreationParameters&
 : CNullDriver(io, params.WindowSize), BackBuffer(0), Presenter(presenter),
 	WindowId(0), SceneSourceRect(0),
 	RenderTargetTexture(0), RenderTargetSurface(0), CurrentShader(0),
-	 DepthBuffer(0), StencilBuffer ( 0 ),
-	 CurrentOut ( 12 * 2, 128 ), Temp ( 12 * 2, 128 )
+	CurrentShaderType(ETR_INVALID), DepthBuffer(0), StencilBuffer ( 0 ),
+	 CurrentOut ( 12 * 2, 128 ), Temp ( 12 * 2, 128 ), RasterPool(0)
 {
 	#ifdef _DEBUG
 	setDebugName("CBurningVideoDriver");
@@ -367,37 +371,30 @@ CBurningVideoDriver::CBurningVideoDriver(const irr::SIrrlichtCreationParameters&
 
 	// create triangle renderers
 
-	irr::memset32 ( BurningShader, 0, sizeof ( BurningShader ) );
-	//BurningShader[ETR_FLAT] = createTRFlat2(DepthBuffer);
-	//BurningShader[ETR_FLAT_WIRE] = createTRFlatWire2(DepthBuffer);
-	BurningShader[ETR_GOURAUD] = createTriangleRendererGouraud2(this);
-	BurningShader[ETR_GOURAUD_ALPHA] = createTriangleRendererGouraudAlpha2(this );
-	BurningShader[ETR_GOURAUD_ALPHA_NOZ] = createTRGouraudAlphaNoZ2(this );
-	//BurningShader[ETR_GOURAUD_WIRE] = createTriangleRendererGouraudWire2(DepthBuffer);
-	//BurningShader[ETR_TEXTURE_FLAT] = createTriangleRendererTextureFlat2(DepthBuffer);
-	//BurningShader[ETR_TEXTURE_FLAT_WIRE] = createTriangleRendererTextureFlatWire2(DepthBuffer);
-	BurningShader[ETR_TEXTURE_GOURAUD] = createTriangleRendererTextureGouraud2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M1] = createTriangleRendererTextureLightMap2_M1(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M2] = createTriangleRendererTextureLightMap2_M2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M4] = createTriangleRendererGTextureLightMap2_M4(this);
-	BurningShader[ETR_TEXTURE_LIGHTMAP_M4] = createTriangleRendererTextureLightMap2_M4(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_LIGHTMAP_ADD] = createTriangleRendererTextureLightMap2_Add(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_DETAIL_MAP] = createTriangleRendererTextureDetailMap2(this);
-
-	BurningShader[ETR_TEXTURE_GOURAUD_WIRE] = createTriangleRendererTextureGouraudWire2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_NOZ] = createTRTextureGouraudNoZ2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_ADD] = createTRTextureGouraudAdd2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_ADD_NO_Z] = createTRTextureGouraudAddNoZ2(this);
-	BurningShader[ETR_TEXTURE_GOURAUD_VERTEX_ALPHA] = createTriangleRendererTextureVertexAlpha2 ( this );
-
-	BurningShader[ETR_TEXTURE_GOURAUD_ALPHA] = createTRTextureGouraudAlpha(this );
-	BurningShader[ETR_TEXTURE_GOURAUD_ALPHA_NOZ] = createTRTextureGouraudAlphaNoZ( this );
-
-	BurningShader[ETR_NORMAL_MAP_SOLID] = createTRNormalMap ( this );
-	BurningShader[ETR_STENCIL_SHADOW] = createTRStencilShadow ( this );
-	BurningShader[ETR_TEXTURE_BLEND] = createTRTextureBlend( this );
-
-	BurningShader[ETR_REFERENCE] = createTriangleRendererReference ( this );
+	createTriangleRenderers ( BurningShader );
+
+	// tile binned rasterizer
+	if ( params.DriverMultithreaded )
+	{
+		RasterPool = new CWorkerPool();
+		const u32 threads = RasterPool->getThreadCount();
+		if ( threads > 1 )
+		{
+			ThreadShader.set_used ( threads * ETR2_COUNT );
+			RasterJob.Shader.set_used ( threads );
+			for ( u32 t = 0; t != threads; ++t )
+				createTriangleRenderers ( ThreadShader.pointer() + t * ETR2_COUNT );
+
+			char buf[64];
+			snprintf ( buf, 64, "Burning's Video rasterizing with %u threads", threads );
+			os::Printer::log ( buf, ELL_INFORMATION );
+		}
+		else
+		{
+			RasterPool->drop();
+			RasterPool = 0;
+		}
+	}
 
 
 	// add the same renderer for all solid types
@@ -461,6 +458,15 @@ CBurningVideoDriver::~CBurningVideoDriver()
 			BurningShader[i]->drop();
 	}
 
+	for (u32 i=0; i<ThreadShader.size(); ++i)
+	{
+		if (ThreadShader[i])
+			ThreadShader[i]->drop();
+	}
+
+	if (RasterPool)
+		RasterPool->drop();
+
 	// delete Additional buffer
 	if (StencilBuffer)
 		StencilBuffer->drop();
@@ -476,6 +482,43 @@ CBurningVideoDriver::~CBurningVideoDriver()
 }
 
 
+//! creates one triangle renderer for each EBurningFFShader
+void CBurningVideoDriver::createTriangleRenderers ( IBurningShader** shader )
+{
+	irr::memset32 ( shader, 0, sizeof ( IBurningShader* ) * ETR2_COUNT );
+	//shader[ETR_FLAT] = createTRFlat2(DepthBuffer);
+	//shader[ETR_FLAT_WIRE] = createTRFlatWire2(DepthBuffer);
+	shader[ETR_GOURAUD] = createTriangleRendererGouraud2(this);
+	shader[ETR_GOURAUD_ALPHA] = createTriangleRendererGouraudAlpha2(this );
+	shader[ETR_GOURAUD_ALPHA_NOZ] = createTRGouraudAlphaNoZ2(this );
+	//shader[ETR_GOURAUD_WIRE] = createTriangleRendererGouraudWire2(DepthBuffer);
+	//shader[ETR_TEXTURE_FLAT] = createTriangleRendererTextureFlat2(DepthBuffer);
+	//shader[ETR_TEXTURE_FLAT_WIRE] = createTriangleRendererTextureFlatWire2(DepthBuffer);
+	shader[ETR_TEXTURE_GOURAUD] = createTriangleRendererTextureGouraud2(this);
+	shader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M1] = createTriangleRendererTextureLightMap2_M1(this);
+	shader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M2] = createTriangleRendererTextureLightMap2_M2(this);
+	shader[ETR_TEXTURE_GOURAUD_LIGHTMAP_M4] = createTriangleRendererGTextureLightMap2_M4(this);
+	shader[ETR_TEXTURE_LIGHTMAP_M4] = createTriangleRendererTextureLightMap2_M4(this);
+	shader[ETR_TEXTURE_GOURAUD_LIGHTMAP_ADD] = createTriangleRendererTextureLightMap2_Add(this);
+	shader[ETR_TEXTURE_GOURAUD_DETAIL_MAP] = createTriangleRendererTextureDetailMap2(this);
+
+	shader[ETR_TEXTURE_GOURAUD_WIRE] = createTriangleRendererTextureGouraudWire2(this);
+	shader[ETR_TEXTURE_GOURAUD_NOZ] = createTRTextureGouraudNoZ2(this);
+	shader[ETR_TEXTURE_GOURAUD_ADD] = createTRTextureGouraudAdd2(this);
+	shader[ETR_TEXTURE_GOURAUD_ADD_NO_Z] = createTRTextureGouraudAddNoZ2(this);
+	shader[ETR_TEXTURE_GOURAUD_VERTEX_ALPHA] = createTriangleRendererTextureVertexAlpha2 ( this );
+
+	shader[ETR_TEXTURE_GOURAUD_ALPHA] = createTRTextureGouraudAlpha(this );
+	shader[ETR_TEXTURE_GOURAUD_ALPHA_NOZ] = createTRTextureGouraudAlphaNoZ( this );
+
+	shader[ETR_NORMAL_MAP_SOLID] = createTRNormalMap ( this );
+	shader[ETR_STENCIL_SHADOW] = createTRStencilShadow ( this );
+	shader[ETR_TEXTURE_BLEND] = createTRTextureBlend( this );
+
+	shader[ETR_REFERENCE] = createTriangleRendererReference ( this );
+}
+
+
 /*!
 	selects the right triangle renderer based on the render states.
 */
@@ -582,25 +625,31 @@ void CBurningVideoDriver::setCurrentShader()
 	//shader = ETR_REFERENCE;
 
 	// switchToTriangleRenderer
+	CurrentShaderType = shader;
 	CurrentShader = BurningShader[shader];
 	if ( CurrentShader )
-	{
-		CurrentShader->setZCompareFunc ( Material.org.ZBuffer );
-		CurrentShader->setRenderTarget(RenderTargetSurface, ViewPort);
-		CurrentShader->setMaterial ( Material );
+		setShaderRenderStates ( CurrentShader, shader );
 
-		switch ( shader )
-		{
-			case ETR_TEXTURE_GOURAUD_ALPHA:
-			case ETR_TEXTURE_GOURAUD_ALPHA_NOZ:
-			case ETR_TEXTURE_BLEND:
-				CurrentShader->setParam ( 0, Material.org.MaterialTypeParam );
-				break;
-			default:
+}
+
+
+//! passes the current render states to a triangle renderer
+void CBurningVideoDriver::setShaderRenderStates ( IBurningShader* shader, EBurningFFShader type )
+{
+	shader->setZCompareFunc ( Material.org.ZBuffer );
+	shader->setRenderTarget(RenderTargetSurface, ViewPort);
+	shader->setMaterial ( Material );
+
+	switch ( type )
+	{
+		case ETR_TEXTURE_GOURAUD_ALPHA:
+		case ETR_TEXTURE_GOURAUD_ALPHA_NOZ:
+		case ETR_TEXTURE_BLEND:
+			shader->setParam ( 0, Material.org.MaterialTypeParam );
 			break;
-		}
+		default:
+		break;
 	}
-
 }
 
 
@@ -1174,11 +1223,6 @@ const SVSize CBurningVideoDriver::vSize[] =
 */
 void CBurningVideoDriver::VertexCache_fill(const u32 sourceIndex, const u32 destIndex)
 {
-	u8 * source;
-	s4DVertex *dest;
-
-	source = (u8*) VertexCache.vertices + ( sourceIndex * vSize[VertexCache.vType].Pitch );
-
 	// it's a look ahead so we never hit it..
 	// but give priority...
 	//VertexCache.info[ destIndex ].hit = hitCount;
@@ -1187,15 +1231,176 @@ void CBurningVideoDriver::VertexCache_fill(const u32 sourceIndex, const u32 dest
 	VertexCache.info[ destIndex ].index = sourceIndex;
 	VertexCache.info[ destIndex ].hit = 0;
 
+	VertexCache_fillBlock ( &sourceIndex, &destIndex, 1 );
+}
+
+
+/*!
+	fill several cache lines at once. the positions of the whole block are
+	transformed and clip tested first, then each vertex gets its attributes.
+*/
+void CBurningVideoDriver::VertexCache_fillBlock ( const u32 *sourceIndex, const u32 *destIndex, const u32 count )
+{
+	s4DVertex *dest[VERTEXCACHE_ELEMENT];
+	u32 i;
+
 	// destination Vertex
-	dest = (s4DVertex *) ( (u8*) VertexCache.mem.data + ( destIndex << ( SIZEOF_SVERTEX_LOG2 + 1  ) ) );
+	for ( i = 0; i != count; ++i )
+		dest[i] = (s4DVertex *) ( (u8*) VertexCache.mem.data + ( destIndex[i] << ( SIZEOF_SVERTEX_LOG2 + 1  ) ) );
+
+	VertexCache_transform ( dest, sourceIndex, count );
+
+	for ( i = 0; i != count; ++i )
+		VertexCache_attributes ( dest[i], sourceIndex[i] );
+}
+
+
+#if defined ( SOFTWARE_DRIVER_2_USE_SSE2 )
+
+//! one row of matrix4::transformVect for four vertices, same operation order
+static REALINLINE __m128 transformRow_sse2 ( const __m128 &x, const __m128 &y, const __m128 &z, const f32 *m, const u32 row )
+{
+	return _mm_add_ps ( _mm_add_ps ( _mm_add_ps (
+				_mm_mul_ps ( x, _mm_set1_ps ( m[row] ) ),
+				_mm_mul_ps ( y, _mm_set1_ps ( m[row + 4] ) ) ),
+				_mm_mul_ps ( z, _mm_set1_ps ( m[row + 8] ) ) ),
+				_mm_set1_ps ( m[row + 12] ) );
+}
+
+#endif
+
+/*!
+	transform a block of vertices by the Model * World * Camera * Projection * NDCSpace matrix,
+	set the clip flags and project the position of the vertices inside the frustum.
+	SSE2 works on four vertices at a time in structure of arrays layout, the
+	remaining vertices take the scalar path. Both give the same results.
+*/
+void CBurningVideoDriver::VertexCache_transform ( s4DVertex **dest, const u32 *sourceIndex, const u32 count ) const
+{
+	const u8 *vertices = (const u8*) VertexCache.vertices;
+	const u32 pitch = vSize[VertexCache.vType].Pitch;
+	const u32 format = vSize[VertexCache.vType].Format;
+	const f32 *c = Transformation [ ETS_CLIPSCALE ].pointer();
+
+	u32 g = 0;
+
+#if defined ( SOFTWARE_DRIVER_2_USE_SSE2 )
+	const f32 *m = Transformation [ ETS_CURRENT ].pointer();
+	const __m128 sign = _mm_set1_ps ( -0.f );
+
+	f32 clip[4][4];
+	f32 proj[4][4];
+	s32 mask[6];
+	u32 i;
+	u32 k;
+
+	for ( ; g + 4 <= count; g += 4 )
+	{
+		// gather the positions, one vertex per lane
+		const f32 *p0 = (const f32*) ( vertices + sourceIndex[g + 0] * pitch );
+		const f32 *p1 = (const f32*) ( vertices + sourceIndex[g + 1] * pitch );
+		const f32 *p2 = (const f32*) ( vertices + sourceIndex[g + 2] * pitch );
+		const f32 *p3 = (const f32*) ( vertices + sourceIndex[g + 3] * pitch );
+
+		const __m128 x = _mm_setr_ps ( p0[0], p1[0], p2[0], p3[0] );
+		const __m128 y = _mm_setr_ps ( p0[1], p1[1], p2[1], p3[1] );
+		const __m128 z = _mm_setr_ps ( p0[2], p1[2], p2[2], p3[2] );
+
+		const __m128 cx = transformRow_sse2 ( x, y, z, m, 0 );
+		const __m128 cy = transformRow_sse2 ( x, y, z, m, 1 );
+		const __m128 cz = transformRow_sse2 ( x, y, z, m, 2 );
+		const __m128 cw = transformRow_sse2 ( x, y, z, m, 3 );
+
+		// clip test, see clipToFrustumTest
+		mask[0] = _mm_movemask_ps ( _mm_cmple_ps ( cz, cw ) );
+		mask[1] = _mm_movemask_ps ( _mm_cmple_ps ( _mm_xor_ps ( cz, sign ), cw ) );
+		mask[2] = _mm_movemask_ps ( _mm_cmple_ps ( cx, cw ) );
+		mask[3] = _mm_movemask_ps ( _mm_cmple_ps ( _mm_xor_ps ( cx, sign ), cw ) );
+		mask[4] = _mm_movemask_ps ( _mm_cmple_ps ( cy, cw ) );
+		mask[5] = _mm_movemask_ps ( _mm_cmple_ps ( _mm_xor_ps ( cy, sign ), cw ) );
+
+		// to device coordinates, store 1/w. see ndc_2_dc_and_project2
+		const __m128 iw = _mm_div_ps ( _mm_set1_ps ( 1.f ), cw );
+
+		_mm_storeu_ps ( clip[0], cx );
+		_mm_storeu_ps ( clip[1], cy );
+		_mm_storeu_ps ( clip[2], cz );
+		_mm_storeu_ps ( clip[3], cw );
+
+		_mm_storeu_ps ( proj[0], _mm_mul_ps ( iw, _mm_add_ps ( _mm_mul_ps ( cx, _mm_set1_ps ( c[0] ) ), _mm_mul_ps ( cw, _mm_set1_ps ( c[12] ) ) ) ) );
+		_mm_storeu_ps ( proj[1], _mm_mul_ps ( iw, _mm_add_ps ( _mm_mul_ps ( cy, _mm_set1_ps ( c[5] ) ), _mm_mul_ps ( cw, _mm_set1_ps ( c[13] ) ) ) ) );
+		_mm_storeu_ps ( proj[2], _mm_mul_ps ( cz, iw ) );
+		_mm_storeu_ps ( proj[3], iw );
+
+		// back to one vertex per cache line
+		for ( k = 0; k != 4; ++k )
+		{
+			s4DVertex *v = dest[g + k];
+
+			v[0].Pos.x = clip[0][k];
+			v[0].Pos.y = clip[1][k];
+			v[0].Pos.z = clip[2][k];
+			v[0].Pos.w = clip[3][k];
+
+			v[0].flag = v[1].flag = format;
+			for ( i = 0; i != 6; ++i )
+				v[0].flag |= ( ( mask[i] >> k ) & 1 ) << i;
+
+			if ( (v[0].flag & VERTEX4D_CLIPMASK ) == VERTEX4D_INSIDE )
+			{
+				v[1].Pos.x = proj[0][k];
+				v[1].Pos.y = proj[1][k];
+#ifndef SOFTWARE_DRIVER_2_USE_WBUFFER
+				v[1].Pos.z = proj[2][k];
+#endif
+				v[1].Pos.w = proj[3][k];
+			}
+		}
+	}
+#endif
+
+	for ( ; g != count; ++g )
+	{
+		s4DVertex *v = dest[g];
+
+		const core::vector3df *pos = (const core::vector3df*) ( vertices + sourceIndex[g] * pitch );
+		Transformation [ ETS_CURRENT].transformVect ( &v->Pos.x, *pos );
 
-	// transform Model * World * Camera * Projection * NDCSpace matrix
+		v[0].flag = v[1].flag = format;
+
+		// test vertex
+		v[0].flag |= clipToFrustumTest ( v );
+
+		if ( (v[0].flag & VERTEX4D_CLIPMASK ) == VERTEX4D_INSIDE )
+		{
+			// project homogenous vertex, store 1/w
+			const f32 w = v->Pos.w;
+			const f32 iw = core::reciprocal ( w );
+
+			// to device coordinates
+			v[1].Pos.x = iw * ( v->Pos.x * c[ 0] + w * c[12] );
+			v[1].Pos.y = iw * ( v->Pos.y * c[ 5] + w * c[13] );
+
+#ifndef SOFTWARE_DRIVER_2_USE_WBUFFER
+			v[1].Pos.z = v->Pos.z * iw;
+#endif
+			v[1].Pos.w = iw;
+		}
+	}
+}
+
+
+/*!
+	light and texture a vertex whose position was set by VertexCache_transform,
+	then project the attributes if the vertex is inside the frustum
+*/
+void CBurningVideoDriver::VertexCache_attributes ( s4DVertex *dest, const u32 sourceIndex )
+{
+	const u8 * source = (u8*) VertexCache.vertices + ( sourceIndex * vSize[VertexCache.vType].Pitch );
 	const S3DVertex *base = ((S3DVertex*) source );
-	Transformation [ ETS_CURRENT].transformVect ( &dest->Pos.x, base->Pos );
 
 	//mhm ;-) maybe no goto
-	if ( VertexCache.vType == 4 ) goto clipandproject;
+	if ( VertexCache.vType == 4 ) goto project;
 
 
 #if defined (SOFTWARE_DRIVER_2_LIGHTING) || defined ( SOFTWARE_DRIVER_2_TEXTURE_TRANSFORM )
@@ -1455,19 +1660,24 @@ void CBurningVideoDriver::VertexCache_fill(const u32 sourceIndex, const u32 dest
 
 #endif
 
-clipandproject:
-	dest[0].flag = dest[1].flag = vSize[VertexCache.vType].Format;
-
-	// test vertex
-	dest[0].flag |= clipToFrustumTest ( dest);
-
-	// to DC Space, project homogenous vertex
+project:
+	// to DC Space, position and 1/w are already projected
 	if ( (dest[0].flag & VERTEX4D_CLIPMASK ) == VERTEX4D_INSIDE )
 	{
-		ndc_2_dc_and_project2 ( (const s4DVertex**) &dest, 1 );
-	}
+		const f32 iw = dest[1].Pos.w;
 
-	//return dest;
+		dest[1].flag = dest[0].flag | VERTEX4D_PROJECTED;
+
+	#ifdef SOFTWARE_DRIVER_2_USE_VERTEX_COLOR
+		#ifdef SOFTWARE_DRIVER_2_PERSPECTIVE_CORRECT
+			dest[1].Color[0] = dest[0].Color[0] * iw;
+		#else
+			dest[1].Color[0] = dest[0].Color[0];
+		#endif
+	#endif
+
+		dest[1].LightTangent[0] = dest[0].LightTangent[0] * iw;
+	}
 }
 
 //
@@ -1567,6 +1777,10 @@ REALINLINE void CBurningVideoDriver::VertexCache_get(const s4DVertex ** face)
 		}
 
 		// fill new
+		u32 fillSource[VERTEXCACHE_ELEMENT];
+		u32 fillDest[VERTEXCACHE_ELEMENT];
+		u32 fillCount = 0;
+
 		for ( i = 0; i!= fillIndex; ++i )
 		{
 			if ( info[i].hit != VERTEXCACHE_MISS )
@@ -1576,13 +1790,19 @@ REALINLINE void CBurningVideoDriver::VertexCache_get(const s4DVertex ** face)
 			{
 				if ( 0 == VertexCache.info[dIndex].hit )
 				{
-					VertexCache_fill ( info[i].index, dIndex );
-					VertexCache.info[dIndex].hit += 1;
+					VertexCache.info[dIndex].index = info[i].index;
+					VertexCache.info[dIndex].hit = 1;
+					fillSource[fillCount] = info[i].index;
+					fillDest[fillCount] = dIndex;
+					fillCount += 1;
 					info[i].hit = dIndex;
 					break;
 				}
 			}
 		}
+
+		// transform and clip test the new vertices as one block
+		VertexCache_fillBlock ( fillSource, fillDest, fillCount );
 	}
 
 	const u32 i0 = core::if_c_a_else_0 ( VertexCache.pType != scene::EPT_TRIANGLE_FAN, VertexCache.indicesRun );
@@ -1755,6 +1975,8 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 
 	VertexCache_reset ( vertices, vertexCount, indexList, primitiveCount, vType, pType, iType );
 
+	const bool binned = beginBinning ();
+
 	const s4DVertex * face[3];
 
 	f32 dc_area;
@@ -1800,7 +2022,10 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 			}
 
 			// rasterize
-			CurrentShader->drawTriangle ( face[0] + 1, face[1] + 1, face[2] + 1 );
+			if ( binned )
+				binTriangle ( face[0] + 1, face[1] + 1, face[2] + 1 );
+			else
+				CurrentShader->drawTriangle ( face[0] + 1, face[1] + 1, face[2] + 1 );
 			continue;
 		}
 
@@ -1879,13 +2104,21 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 		for ( g = 0; g <= vOut - 6; g += 2 )
 		{
 			// rasterize
-			CurrentShader->drawTriangle ( CurrentOut.data + 0 + 1,
+			if ( binned )
+				binTriangle ( CurrentOut.data + 0 + 1,
+							CurrentOut.data + g + 3,
+							CurrentOut.data + g + 5);
+			else
+				CurrentShader->drawTriangle ( CurrentOut.data + 0 + 1,
 							CurrentOut.data + g + 3,
 							CurrentOut.data + g + 5);
 		}
 
 	}
 
+	if ( binned )
+		flushBins ();
+
 	// dump statistics
 /*
 	char buf [64];
@@ -1899,6 +2132,113 @@ void CBurningVideoDriver::drawVertexPrimitiveList(const void* vertices, u32 vert
 }
 
 
+/*!
+	starts collecting the triangles of a draw call for the worker threads.
+	returns false if the current triangle renderer has to run single threaded.
+*/
+bool CBurningVideoDriver::beginBinning ()
+{
+	if ( 0 == RasterPool || 0 == RenderTargetSurface )
+		return false;
+
+	// wireframe draws lines, stencil shadow has render states set outside setCurrentShader
+	if ( CurrentShaderType == ETR_TEXTURE_GOURAUD_WIRE ||
+		CurrentShaderType == ETR_INVALID ||
+		CurrentShader != BurningShader[CurrentShaderType]
+		)
+		return false;
+
+	const s32 threads = (s32) RasterPool->getThreadCount();
+	const s32 height = (s32) RenderTargetSurface->getDimension().Height;
+
+	// some more bands than threads, keeps all threads busy if triangles are unevenly spread
+	RasterJob.BandHeight = core::s32_max ( 8, ( height + threads * 4 - 1 ) / ( threads * 4 ) );
+	const u32 bands = ( height + RasterJob.BandHeight - 1 ) / RasterJob.BandHeight;
+
+	RasterJob.Triangles.set_used ( 0 );
+
+	// set_used does not construct new elements
+	if ( RasterJob.Bins.size() > bands )
+		RasterJob.Bins.erase ( bands, RasterJob.Bins.size() - bands );
+	while ( RasterJob.Bins.size() < bands )
+		RasterJob.Bins.push_back ( core::array<u32> () );
+	for ( u32 i = 0; i != bands; ++i )
+		RasterJob.Bins[i].set_used ( 0 );
+
+	return true;
+}
+
+
+//! adds a projected triangle to all bands it covers
+void CBurningVideoDriver::binTriangle ( const s4DVertex *a, const s4DVertex *b, const s4DVertex *c )
+{
+	const f32 minY = core::min_ ( a->Pos.y, b->Pos.y, c->Pos.y );
+	const f32 maxY = core::max_ ( a->Pos.y, b->Pos.y, c->Pos.y );
+
+	const s32 last = (s32) RasterJob.Bins.size() - 1;
+	const s32 b0 = core::s32_clamp ( core::floor32 ( minY ) / RasterJob.BandHeight, 0, last );
+	const s32 b1 = core::s32_clamp ( core::ceil32 ( maxY ) / RasterJob.BandHeight, 0, last );
+
+	const u32 index = RasterJob.Triangles.size();
+	RasterJob.Triangles.set_used ( index + 1 );
+
+	SBinnedTriangle &t = RasterJob.Triangles[index];
+	t.v[0] = *a;
+	t.v[1] = *b;
+	t.v[2] = *c;
+
+	const sInternalTexture* sampler = CurrentShader->getTextureSamplers ();
+	for ( u32 i = 0; i != BURNING_MATERIAL_MAX_TEXTURES; ++i )
+		t.Sampler[i] = sampler[i];
+
+	for ( s32 i = b0; i <= b1; ++i )
+		RasterJob.Bins[i].push_back ( index );
+}
+
+
+//! rasterizes all binned triangles on the worker threads
+void CBurningVideoDriver::flushBins ()
+{
+	if ( RasterJob.Triangles.empty () )
+		return;
+
+	u32 t;
+	for ( t = 0; t != RasterJob.Shader.size(); ++t )
+	{
+		IBurningShader* shader = ThreadShader [ t * ETR2_COUNT + CurrentShaderType ];
+		setShaderRenderStates ( shader, CurrentShaderType );
+		RasterJob.Shader[t] = shader;
+	}
+
+	RasterPool->run ( &RasterJob, RasterJob.Bins.size() );
+
+	for ( t = 0; t != RasterJob.Shader.size(); ++t )
+	{
+		RasterJob.Shader[t]->setTextureSamplers ( 0 );
+		RasterJob.Shader[t]->setScanlineBand ( 0, 0x7FFFFFFF );
+	}
+}
+
+
+//! rasterizes the triangles of one band, called from the worker threads
+void CBurningVideoDriver::SRasterJob::execute ( u32 band, u32 thread )
+{
+	const core::array<u32> &bin = Bins[band];
+	if ( bin.empty () )
+		return;
+
+	IBurningShader* shader = Shader[thread];
+	shader->setScanlineBand ( band * BandHeight, ( band + 1 ) * BandHeight - 1 );
+
+	for ( u32 i = 0; i != bin.size(); ++i )
+	{
+		const SBinnedTriangle &t = Triangles [ bin[i] ];
+		shader->setTextureSamplers ( t.Sampler );
+		shader->drawTriangle ( t.v + 0, t.v + 1, t.v + 2 );
+	}
+}
+
+
 //! Sets the dynamic ambient light color. The default color is
 //! (0,0,0,0) which means it is dark.
 //! \param color: New color of the ambient light.
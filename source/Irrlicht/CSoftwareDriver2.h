@@ -12,6 +12,7 @@
 #include "os.h"
 #include "irrString.h"
 #include "SIrrCreationParameters.h"
+#include "CWorkerPool.h"
 
 namespace irr
 {
@@ -192,7 +193,14 @@ namespace video
 		//! selects the right triangle renderer based on the render states.
 		void setCurrentShader();
 
+		//! passes the current render states to a triangle renderer
+		void setShaderRenderStates ( IBurningShader* shader, EBurningFFShader type );
+
+		//! creates one triangle renderer for each EBurningFFShader
+		void createTriangleRenderers ( IBurningShader** shader );
+
 		IBurningShader* CurrentShader;
+		EBurningFFShader CurrentShaderType;
 		IBurningShader* BurningShader[ETR2_COUNT];
 
 		IDepthBuffer* DepthBuffer;
@@ -242,6 +250,9 @@ namespace video
 		void VertexCache_getbypass ( s4DVertex ** face );
 
 		void VertexCache_fill ( const u32 sourceIndex,const u32 destIndex );
+		void VertexCache_fillBlock ( const u32 *sourceIndex, const u32 *destIndex, const u32 count );
+		void VertexCache_transform ( s4DVertex **dest, const u32 *sourceIndex, const u32 count ) const;
+		void VertexCache_attributes ( s4DVertex *dest, const u32 sourceIndex );
 		s4DVertex * VertexCache_getVertex ( const u32 sourceIndex );
 
 
@@ -280,6 +291,39 @@ namespace video
 		SBurningShaderMaterial Material;
 
 		static const sVec4 NDCPlane[6];
+
+
+		/*
+			tile binned rasterizer, enabled by SIrrlichtCreationParameters::DriverMultithreaded.
+			Projected triangles of a draw call are binned into full width bands of
+			scanlines, each band is rasterized by one worker thread in submission
+			order, so the result is identical to the single threaded path.
+		*/
+		struct SBinnedTriangle
+		{
+			s4DVertex v[3];
+			sInternalTexture Sampler[BURNING_MATERIAL_MAX_TEXTURES];
+		};
+
+		struct SRasterJob : public IWorkerJob
+		{
+			virtual void execute ( u32 band, u32 thread );
+
+			core::array<SBinnedTriangle> Triangles;
+			core::array< core::array<u32> > Bins;
+			core::array<IBurningShader*> Shader;
+			s32 BandHeight;
+		};
+
+		bool beginBinning ();
+		void binTriangle ( const s4DVertex *a, const s4DVertex *b, const s4DVertex *c );
+		void flushBins ();
+
+		CWorkerPool* RasterPool;
+		SRasterJob RasterJob;
+
+		// one set of triangle renderers per worker thread
+		core::array<IBurningShader*> ThreadShader;
 	};
 
 } // end namespace video
@@ -550,7 +550,8 @@ void CTRTextureLightMap2_M4::drawTriangle_Min ( const s4DVertex *a,const s4DVert
 #endif
 
 			// render a scanline
-			scanline_bilinear2_min ();
+			if ( isScanlineInBand ( line.y ) )
+				scanline_bilinear2_min ();
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
@@ -711,7 +712,8 @@ void CTRTextureLightMap2_M4::drawTriangle_Min ( const s4DVertex *a,const s4DVert
 #endif
 
 			// render a scanline
-			scanline_bilinear2_min ();
+			if ( isScanlineInBand ( line.y ) )
+				scanline_bilinear2_min ();
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
@@ -924,7 +926,8 @@ void CTRTextureLightMap2_M4::drawTriangle ( const s4DVertex *a,const s4DVertex *
 #endif
 
 			// render a scanline
-			scanline_bilinear2_mag ();
+			if ( isScanlineInBand ( line.y ) )
+				scanline_bilinear2_mag ();
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
@@ -1085,7 +1088,8 @@ void CTRTextureLightMap2_M4::drawTriangle ( const s4DVertex *a,const s4DVertex *
 #endif
 
 			// render a scanline
-			scanline_bilinear2_mag ();
+			if ( isScanlineInBand ( line.y ) )
+				scanline_bilinear2_mag ();
 
 			scan.x[0] += scan.slopeX[0];
 			scan.x[1] += scan.slopeX[1];
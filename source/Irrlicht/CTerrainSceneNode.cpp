@@ -22,12 +22,22 @@
 #include "IAnimatedMesh.h"
 #include "SMesh.h"
 #include "CDynamicMeshBuffer.h"
+#include "CWorkerPool.h"
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+#include <emmintrin.h>
+#endif
 
 namespace irr
 {
 namespace scene
 {
 
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	//! worker threads shared by the terrain nodes for the normals of large terrains
+	static CWorkerPool* TerrainPool = 0;
+#endif
+
 	//! constructor
 	CTerrainSceneNode::CTerrainSceneNode(ISceneNode* parent, ISceneManager* mgr,
 			io::IFileSystem* fs, s32 id, s32 maxLOD, E_TERRAIN_PATCH_SIZE patchSize,
@@ -38,7 +48,7 @@ namespace scene
 	TerrainData(patchSize, maxLOD, position, rotation, scale), RenderBuffer(0),
 	VerticesToRender(0), IndicesToRender(0), DynamicSelectorUpdate(false),
 	OverrideDistanceThreshold(false), UseDefaultRotationPivot(true), ForceRecalculation(true),
-	CameraMovementDelta(10.0f), CameraRotationDelta(1.0f),CameraFOVDelta(0.1f),
+	UsesNormalsPool(false), CameraMovementDelta(10.0f), CameraRotationDelta(1.0f),CameraFOVDelta(0.1f),
 	TCoordScale1(1.0f), TCoordScale2(1.0f), SmoothFactor(0), FileSystem(fs)
 	{
 		#ifdef _DEBUG
@@ -70,6 +80,11 @@ namespace scene
 
 		if (RenderBuffer)
 			RenderBuffer->drop();
+
+#ifdef _IRR_COMPILE_WITH_THREADS_
+		if (UsesNormalsPool && TerrainPool->drop())
+			TerrainPool = 0;
+#endif
 	}
 
 
@@ -624,91 +639,163 @@ namespace scene
 	{
 		scene::ICameraSceneNode * camera = SceneManager->getActiveCamera();
 
-		if (!camera)
+		if (!camera || PatchTree.empty())
 			return;
 
 		const core::vector3df cameraPosition = camera->getAbsolutePosition();
 
 		const SViewFrustum* frustum = camera->getViewFrustum();
 
+		// Whole subtrees can only get the LOD of their nearest and farthest
+		// point if the LOD grows with the distance.
+		bool uniformLOD = true;
+		for (s32 i = 2; i < TerrainData.MaxLOD; ++i)
+		{
+			if (TerrainData.LODDistanceThreshold[i] < TerrainData.LODDistanceThreshold[i-1])
+				uniformLOD = false;
+		}
+
 		// Determine each patches LOD based on distance from camera (and whether or not they are in
 		// the view frustum).
-		const s32 count = TerrainData.PatchCount * TerrainData.PatchCount;
-		for (s32 j = 0; j < count; ++j)
+		calculateLODOfPatchTree(0, frustum->getBoundingBox(), cameraPosition, false, uniformLOD);
+	}
+
+
+	//! calculates the LODs of the patches below a quadtree node
+	void CTerrainSceneNode::calculateLODOfPatchTree(u32 n, const core::aabbox3df& frustumBox,
+			const core::vector3df& cameraPosition, bool inside, bool uniformLOD)
+	{
+		const SPatchTreeNode& node = PatchTree[n];
+
+		if (!inside)
 		{
-			if (frustum->getBoundingBox().intersectsWithBox(TerrainData.Patches[j].BoundingBox))
+			if (!frustumBox.intersectsWithBox(node.BoundingBox))
 			{
-				const f32 distance = cameraPosition.getDistanceFromSQ(TerrainData.Patches[j].Center);
-
-				TerrainData.Patches[j].CurrentLOD = 0;
-				for (s32 i = TerrainData.MaxLOD - 1; i>0; --i)
-				{
-					if (distance >= TerrainData.LODDistanceThreshold[i])
-					{
-						TerrainData.Patches[j].CurrentLOD = i;
-						break;
-					}
-				}
+				setLODOfPatchTree(node, -1);
+				return;
 			}
-			else
+
+			// all boxes below are inside as well
+			inside = node.BoundingBox.isFullInside(frustumBox);
+		}
+
+		if (!node.ChildCount)
+		{
+			SPatch& patch = TerrainData.Patches[node.X0 * TerrainData.PatchCount + node.Z0];
+			patch.CurrentLOD = getLODForDistance(cameraPosition.getDistanceFromSQ(patch.Center));
+			return;
+		}
+
+		if (inside && uniformLOD)
+		{
+			// the centers of the patches lie between the nearest and the farthest point of the box
+			const core::vector3df& minEdge = node.BoundingBox.MinEdge;
+			const core::vector3df& maxEdge = node.BoundingBox.MaxEdge;
+			const core::vector3df nearest(core::clamp(cameraPosition.X, minEdge.X, maxEdge.X),
+				core::clamp(cameraPosition.Y, minEdge.Y, maxEdge.Y),
+				core::clamp(cameraPosition.Z, minEdge.Z, maxEdge.Z));
+			const core::vector3df farthest(
+				fabsf(cameraPosition.X - minEdge.X) > fabsf(cameraPosition.X - maxEdge.X) ? minEdge.X : maxEdge.X,
+				fabsf(cameraPosition.Y - minEdge.Y) > fabsf(cameraPosition.Y - maxEdge.Y) ? minEdge.Y : maxEdge.Y,
+				fabsf(cameraPosition.Z - minEdge.Z) > fabsf(cameraPosition.Z - maxEdge.Z) ? minEdge.Z : maxEdge.Z);
+
+			const s32 LOD = getLODForDistance(cameraPosition.getDistanceFromSQ(nearest));
+			if (LOD == getLODForDistance(cameraPosition.getDistanceFromSQ(farthest)))
 			{
-				TerrainData.Patches[j].CurrentLOD = -1;
+				setLODOfPatchTree(node, LOD);
+				return;
 			}
 		}
+
+		const u32 end = node.FirstChild + node.ChildCount;
+		for (u32 i = node.FirstChild; i < end; ++i)
+			calculateLODOfPatchTree(i, frustumBox, cameraPosition, inside, uniformLOD);
+	}
+
+
+	//! sets the CurrentLOD of all patches below a quadtree node
+	void CTerrainSceneNode::setLODOfPatchTree(const SPatchTreeNode& node, s32 LOD)
+	{
+		for (s32 x = node.X0; x < node.X1; ++x)
+		{
+			SPatch* patch = &TerrainData.Patches[x * TerrainData.PatchCount];
+			for (s32 z = node.Z0; z < node.Z1; ++z)
+				patch[z].CurrentLOD = LOD;
+		}
+	}
+
+
+	//! get the LOD for a squared distance to the camera
+	s32 CTerrainSceneNode::getLODForDistance(f32 distanceSQ) const
+	{
+		for (s32 i = TerrainData.MaxLOD - 1; i>0; --i)
+		{
+			if (distanceSQ >= TerrainData.LODDistanceThreshold[i])
+				return i;
+		}
+		return 0;
 	}
 
 
 	void CTerrainSceneNode::preRenderIndicesCalculations()
 	{
 		scene::IIndexBuffer& indexBuffer = RenderBuffer->getIndexBuffer();
+		const bool indices16Bit = (indexBuffer.getType() == video::EIT_16BIT);
+		const u32 oldIndicesToRender = IndicesToRender;
+		bool changed = false;
+
 		IndicesToRender = 0;
-		indexBuffer.set_used(0);
 
+		// Then copy the indices of all patches that are visible. The
+		// indices of a patch only change with its LOD and the LODs of its
+		// neighbours, so patches which keep them and their place in the
+		// buffer are skipped.
 		s32 index = 0;
-		// Then generate the indices for all patches that are visible.
 		for (s32 i = 0; i < TerrainData.PatchCount; ++i)
 		{
 			for (s32 j = 0; j < TerrainData.PatchCount; ++j)
 			{
-				if (TerrainData.Patches[index].CurrentLOD >= 0)
+				SPatch& patch = TerrainData.Patches[index++];
+				if (patch.CurrentLOD < 0)
 				{
-					s32 x = 0;
-					s32 z = 0;
+					patch.RenderedKey = -1;
+					continue;
+				}
+
+				const s32 key = getPatchIndexKey(patch);
+				u32 count;
+				const u32* indices = getPatchIndices(key, count);
 
-					// calculate the step we take this patch, based on the patches current LOD
-					const s32 step = 1 << TerrainData.Patches[index].CurrentLOD;
+				if (key != patch.RenderedKey || IndicesToRender != patch.IndexStart)
+				{
+					const u32 first = (TerrainData.CalcPatchSize * i) * TerrainData.Size +
+						TerrainData.CalcPatchSize * j;
 
-					// Loop through patch and generate indices
-					while (z < TerrainData.CalcPatchSize)
+					if (indices16Bit)
 					{
-						const s32 index11 = getIndex(j, i, index, x, z);
-						const s32 index21 = getIndex(j, i, index, x + step, z);
-						const s32 index12 = getIndex(j, i, index, x, z + step);
-						const s32 index22 = getIndex(j, i, index, x + step, z + step);
-
-						indexBuffer.push_back(index12);
-						indexBuffer.push_back(index11);
-						indexBuffer.push_back(index22);
-						indexBuffer.push_back(index22);
-						indexBuffer.push_back(index11);
-						indexBuffer.push_back(index21);
-						IndicesToRender+=6;
-
-						// increment index position horizontally
-						x += step;
-
-						// we've hit an edge
-						if (x >= TerrainData.CalcPatchSize)
-						{
-							x = 0;
-							z += step;
-						}
+						u16* dst = (u16*)indexBuffer.pointer() + IndicesToRender;
+						for (u32 k = 0; k < count; ++k)
+							dst[k] = (u16)(first + indices[k]);
+					}
+					else
+					{
+						u32* dst = (u32*)indexBuffer.pointer() + IndicesToRender;
+						for (u32 k = 0; k < count; ++k)
+							dst[k] = first + indices[k];
 					}
+
+					patch.RenderedKey = key;
+					patch.IndexStart = IndicesToRender;
+					changed = true;
 				}
-				++index;
+
+				IndicesToRender += count;
 			}
 		}
 
+		if (!changed && IndicesToRender == oldIndicesToRender)
+			return;
+
 		RenderBuffer->setDirty(EBT_INDEX);
 
 		if (DynamicSelectorUpdate && TriangleSelector)
@@ -719,6 +806,90 @@ namespace scene
 	}
 
 
+	//! get the key of the index list of a patch, based on its LOD and the LODs of its neighbours
+	s32 CTerrainSceneNode::getPatchIndexKey(const SPatch& patch) const
+	{
+		const SPatch* neighbours[4] = { patch.Top, patch.Bottom, patch.Left, patch.Right };
+
+		const s32 LOD = core::clamp(patch.CurrentLOD, 0, TerrainData.MaxLOD - 1);
+		s32 key = LOD;
+		for (u32 i = 0; i < 4; ++i)
+		{
+			// only coarser neighbours change the indices
+			s32 neighbourLOD = neighbours[i] ? neighbours[i]->CurrentLOD : -1;
+			neighbourLOD = core::clamp(neighbourLOD, LOD, TerrainData.MaxLOD - 1);
+			key = key * TerrainData.MaxLOD + neighbourLOD;
+		}
+		return key;
+	}
+
+
+	//! get the index list for a key, relative to the first vertex of a patch. Created on first use.
+	const u32* CTerrainSceneNode::getPatchIndices(s32 key, u32& count)
+	{
+		if (PatchIndicesStart.empty())
+		{
+			s32 keyCount = TerrainData.MaxLOD;
+			for (u32 i = 0; i < 4; ++i)
+				keyCount *= TerrainData.MaxLOD;
+
+			PatchIndicesStart.set_used(keyCount);
+			for (s32 i = 0; i < keyCount; ++i)
+				PatchIndicesStart[i] = -1;
+		}
+
+		s32 neighbourLOD[4];
+		s32 rest = key;
+		for (s32 i = 3; i >= 0; --i)
+		{
+			neighbourLOD[i] = rest % TerrainData.MaxLOD;
+			rest /= TerrainData.MaxLOD;
+		}
+		const s32 LOD = rest;
+
+		// calculate the step we take this patch, based on the patches LOD
+		const s32 step = 1 << LOD;
+		const s32 quads = (TerrainData.CalcPatchSize + step - 1) / step;
+		count = quads * quads * 6;
+
+		if (PatchIndicesStart[key] < 0)
+		{
+			PatchIndicesStart[key] = PatchIndices.size();
+
+			s32 x = 0;
+			s32 z = 0;
+
+			// Loop through patch and generate indices
+			while (z < TerrainData.CalcPatchSize)
+			{
+				const u32 index11 = getStitchedIndex(LOD, neighbourLOD, x, z);
+				const u32 index21 = getStitchedIndex(LOD, neighbourLOD, x + step, z);
+				const u32 index12 = getStitchedIndex(LOD, neighbourLOD, x, z + step);
+				const u32 index22 = getStitchedIndex(LOD, neighbourLOD, x + step, z + step);
+
+				PatchIndices.push_back(index12);
+				PatchIndices.push_back(index11);
+				PatchIndices.push_back(index22);
+				PatchIndices.push_back(index22);
+				PatchIndices.push_back(index11);
+				PatchIndices.push_back(index21);
+
+				// increment index position horizontally
+				x += step;
+
+				// we've hit an edge
+				if (x >= TerrainData.CalcPatchSize)
+				{
+					x = 0;
+					z += step;
+				}
+			}
+		}
+
+		return PatchIndices.const_pointer() + PatchIndicesStart[key];
+	}
+
+
 	//! Render the scene node
 	void CTerrainSceneNode::render()
 	{
@@ -1030,47 +1201,47 @@ namespace scene
 	//! used to get the indices when generating index data for patches at varying levels of detail.
 	u32 CTerrainSceneNode::getIndex(const s32 PatchX, const s32 PatchZ,
 					const s32 PatchIndex, u32 vX, u32 vZ) const
+	{
+		const SPatch& patch = TerrainData.Patches[PatchIndex];
+		const s32 neighbourLOD[4] = {
+			patch.Top ? patch.Top->CurrentLOD : -1,
+			patch.Bottom ? patch.Bottom->CurrentLOD : -1,
+			patch.Left ? patch.Left->CurrentLOD : -1,
+			patch.Right ? patch.Right->CurrentLOD : -1 };
+
+		return getStitchedIndex(patch.CurrentLOD, neighbourLOD, vX, vZ) +
+			((TerrainData.CalcPatchSize) * PatchZ) * TerrainData.Size +
+			((TerrainData.CalcPatchSize) * PatchX);
+	}
+
+
+	//! get the index of a vertex relative to the first vertex of a patch
+	u32 CTerrainSceneNode::getStitchedIndex(s32 LOD, const s32* neighbourLOD, u32 vX, u32 vZ) const
 	{
 		// top border
 		if (vZ == 0)
 		{
-			if (TerrainData.Patches[PatchIndex].Top &&
-				TerrainData.Patches[PatchIndex].CurrentLOD < TerrainData.Patches[PatchIndex].Top->CurrentLOD &&
-				(vX % (1 << TerrainData.Patches[PatchIndex].Top->CurrentLOD)) != 0 )
-			{
-				vX -= vX % (1 << TerrainData.Patches[PatchIndex].Top->CurrentLOD);
-			}
+			if (LOD < neighbourLOD[0] && (vX % (1 << neighbourLOD[0])) != 0 )
+				vX -= vX % (1 << neighbourLOD[0]);
 		}
 		else
 		if (vZ == (u32)TerrainData.CalcPatchSize) // bottom border
 		{
-			if (TerrainData.Patches[PatchIndex].Bottom &&
-				TerrainData.Patches[PatchIndex].CurrentLOD < TerrainData.Patches[PatchIndex].Bottom->CurrentLOD &&
-				(vX % (1 << TerrainData.Patches[PatchIndex].Bottom->CurrentLOD)) != 0)
-			{
-				vX -= vX % (1 << TerrainData.Patches[PatchIndex].Bottom->CurrentLOD);
-			}
+			if (LOD < neighbourLOD[1] && (vX % (1 << neighbourLOD[1])) != 0)
+				vX -= vX % (1 << neighbourLOD[1]);
 		}
 
 		// left border
 		if (vX == 0)
 		{
-			if (TerrainData.Patches[PatchIndex].Left &&
-				TerrainData.Patches[PatchIndex].CurrentLOD < TerrainData.Patches[PatchIndex].Left->CurrentLOD &&
-				(vZ % (1 << TerrainData.Patches[PatchIndex].Left->CurrentLOD)) != 0)
-			{
-				vZ -= vZ % (1 << TerrainData.Patches[PatchIndex].Left->CurrentLOD);
-			}
+			if (LOD < neighbourLOD[2] && (vZ % (1 << neighbourLOD[2])) != 0)
+				vZ -= vZ % (1 << neighbourLOD[2]);
 		}
 		else
 		if (vX == (u32)TerrainData.CalcPatchSize) // right border
 		{
-			if (TerrainData.Patches[PatchIndex].Right &&
-				TerrainData.Patches[PatchIndex].CurrentLOD < TerrainData.Patches[PatchIndex].Right->CurrentLOD &&
-				(vZ % (1 << TerrainData.Patches[PatchIndex].Right->CurrentLOD)) != 0)
-			{
-				vZ -= vZ % (1 << TerrainData.Patches[PatchIndex].Right->CurrentLOD);
-			}
+			if (LOD < neighbourLOD[3] && (vZ % (1 << neighbourLOD[3])) != 0)
+				vZ -= vZ % (1 << neighbourLOD[3]);
 		}
 
 		if (vZ >= (u32)TerrainData.PatchSize)
@@ -1079,8 +1250,7 @@ namespace scene
 		if (vX >= (u32)TerrainData.PatchSize)
 			vX = TerrainData.CalcPatchSize;
 
-		return (vZ + ((TerrainData.CalcPatchSize) * PatchZ)) * TerrainData.Size +
-			(vX + ((TerrainData.CalcPatchSize) * PatchX));
+		return vZ * TerrainData.Size + vX;
 	}
 
 
@@ -1106,127 +1276,346 @@ namespace scene
 	}
 
 
-	//! calculate smooth normals
-	void CTerrainSceneNode::calculateNormals(IDynamicMeshBuffer* mb)
+	namespace
 	{
-		s32 count;
-		core::vector3df a, b, c, t;
+		//! number of vertex rows handled by one work item of the normal job
+		const s32 NORMAL_BLOCK_ROWS = 32;
 
-		for (s32 x=0; x<TerrainData.Size; ++x)
+		//! terrains of at least this size calculate their normals on several threads
+		const s32 PARALLEL_NORMALS_SIZE = 513;
+
+		//! the distinct triangle normals of a quad, stored in the quad rows of the normal job
+		enum E_QUAD_NORMAL
 		{
-			for (s32 z=0; z<TerrainData.Size; ++z)
+			EQN_1_X = 0, EQN_1_Y, EQN_1_Z,
+			EQN_2_X, EQN_2_Y, EQN_2_Z,
+			EQN_5_X, EQN_5_Y, EQN_5_Z,
+			EQN_6_X, EQN_6_Y, EQN_6_Z,
+			EQN_COUNT
+		};
+
+		//! normalizes vectors stored in separate x, y and z arrays
+		/** Gives exactly the results of core::vector3df::normalize(). */
+		void normalizeArrays(f32* x, f32* y, f32* z, s32 count)
+		{
+			s32 i=0;
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+			const __m128d one = _mm_set1_pd(1.0);
+			const __m128d zero = _mm_setzero_pd();
+
+			for (; i+4<=count; i+=4)
 			{
-				count = 0;
-				core::vector3df normal;
+				const __m128 vx = _mm_loadu_ps(x+i);
+				const __m128 vy = _mm_loadu_ps(y+i);
+				const __m128 vz = _mm_loadu_ps(z+i);
+				const __m128 length = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+
+				// normalize() scales with doubles, zero vectors stay unchanged
+				const __m128d lengthLo = _mm_cvtps_pd(length);
+				const __m128d lengthHi = _mm_cvtps_pd(_mm_movehl_ps(length, length));
+				const __m128d zeroLo = _mm_cmpeq_pd(lengthLo, zero);
+				const __m128d zeroHi = _mm_cmpeq_pd(lengthHi, zero);
+				const __m128d scaleLo = _mm_or_pd(_mm_and_pd(zeroLo, one),
+					_mm_andnot_pd(zeroLo, _mm_div_pd(one, _mm_sqrt_pd(lengthLo))));
+				const __m128d scaleHi = _mm_or_pd(_mm_and_pd(zeroHi, one),
+					_mm_andnot_pd(zeroHi, _mm_div_pd(one, _mm_sqrt_pd(lengthHi))));
+
+				_mm_storeu_ps(x+i, _mm_movelh_ps(
+					_mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(vx), scaleLo)),
+					_mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(vx, vx)), scaleHi))));
+				_mm_storeu_ps(y+i, _mm_movelh_ps(
+					_mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(vy), scaleLo)),
+					_mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(vy, vy)), scaleHi))));
+				_mm_storeu_ps(z+i, _mm_movelh_ps(
+					_mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(vz), scaleLo)),
+					_mm_cvtpd_ps(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(vz, vz)), scaleHi))));
+			}
+#endif
 
-				// top left
-				if (x>0 && z>0)
-				{
-					a = mb->getVertexBuffer()[(x-1)*TerrainData.Size+z-1].Pos;
-					b = mb->getVertexBuffer()[(x-1)*TerrainData.Size+z].Pos;
-					c = mb->getVertexBuffer()[x*TerrainData.Size+z].Pos;
-					b -= a;
-					c -= a;
-					t = b.crossProduct(c);
-					t.normalize();
-					normal += t;
-
-					a = mb->getVertexBuffer()[(x-1)*TerrainData.Size+z-1].Pos;
-					b = mb->getVertexBuffer()[x*TerrainData.Size+z-1].Pos;
-					c = mb->getVertexBuffer()[x*TerrainData.Size+z].Pos;
-					b -= a;
-					c -= a;
-					t = b.crossProduct(c);
-					t.normalize();
-					normal += t;
-
-					count += 2;
-				}
+			for (; i<count; ++i)
+			{
+				core::vector3df v(x[i], y[i], z[i]);
+				v.normalize();
+				x[i] = v.X;
+				y[i] = v.Y;
+				z[i] = v.Z;
+			}
+		}
 
-				// top right
-				if (x>0 && z<TerrainData.Size-1)
-				{
-					a = mb->getVertexBuffer()[(x-1)*TerrainData.Size+z].Pos;
-					b = mb->getVertexBuffer()[(x-1)*TerrainData.Size+z+1].Pos;
-					c = mb->getVertexBuffer()[x*TerrainData.Size+z+1].Pos;
-					b -= a;
-					c -= a;
-					t = b.crossProduct(c);
-					t.normalize();
-					normal += t;
-
-					a = mb->getVertexBuffer()[(x-1)*TerrainData.Size+z].Pos;
-					b = mb->getVertexBuffer()[x*TerrainData.Size+z+1].Pos;
-					c = mb->getVertexBuffer()[x*TerrainData.Size+z].Pos;
-					b -= a;
-					c -= a;
-					t = b.crossProduct(c);
-					t.normalize();
-					normal += t;
-
-					count += 2;
-				}
+		//! copies the positions of a vertex row into separate x, y and z arrays
+		void loadVertexRow(const video::S3DVertex2TCoords* vertices, f32* row, s32 size)
+		{
+			for (s32 z=0; z<size; ++z)
+			{
+				row[z] = vertices[z].Pos.X;
+				row[z+size] = vertices[z].Pos.Y;
+				row[z+size*2] = vertices[z].Pos.Z;
+			}
+		}
 
-				// bottom right
-				if (x<TerrainData.Size-1 && z<TerrainData.Size-1)
-				{
-					a = mb->getVertexBuffer()[x*TerrainData.Size+z+1].Pos;
-					b = mb->getVertexBuffer()[x*TerrainData.Size+z].Pos;
-					c = mb->getVertexBuffer()[(x+1)*TerrainData.Size+z+1].Pos;
-					b -= a;
-					c -= a;
-					t = b.crossProduct(c);
-					t.normalize();
-					normal += t;
-
-					a = mb->getVertexBuffer()[x*TerrainData.Size+z+1].Pos;
-					b = mb->getVertexBuffer()[(x+1)*TerrainData.Size+z+1].Pos;
-					c = mb->getVertexBuffer()[(x+1)*TerrainData.Size+z].Pos;
-					b -= a;
-					c -= a;
-					t = b.crossProduct(c);
-					t.normalize();
-					normal += t;
-
-					count += 2;
-				}
+		//! normalized cross product of b-a and c-a, like in the old per vertex loop
+		inline void storeTriangleNormal(const core::vector3df& a, core::vector3df b, core::vector3df c,
+			f32* quads, s32 normal, s32 size, s32 z)
+		{
+			b -= a;
+			c -= a;
+			core::vector3df t = b.crossProduct(c);
+			t.normalize();
+			quads[normal*size+z] = t.X;
+			quads[(normal+1)*size+z] = t.Y;
+			quads[(normal+2)*size+z] = t.Z;
+		}
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+		//! cross product of b-a and c-a for 4 triangles
+		inline void storeCrossProduct4(__m128 ax, __m128 ay, __m128 az,
+			__m128 bx, __m128 by, __m128 bz, __m128 cx, __m128 cy, __m128 cz,
+			f32* quads, s32 normal, s32 size, s32 z)
+		{
+			bx = _mm_sub_ps(bx, ax);
+			by = _mm_sub_ps(by, ay);
+			bz = _mm_sub_ps(bz, az);
+			cx = _mm_sub_ps(cx, ax);
+			cy = _mm_sub_ps(cy, ay);
+			cz = _mm_sub_ps(cz, az);
+			_mm_storeu_ps(quads+normal*size+z, _mm_sub_ps(_mm_mul_ps(by, cz), _mm_mul_ps(bz, cy)));
+			_mm_storeu_ps(quads+(normal+1)*size+z, _mm_sub_ps(_mm_mul_ps(bz, cx), _mm_mul_ps(bx, cz)));
+			_mm_storeu_ps(quads+(normal+2)*size+z, _mm_sub_ps(_mm_mul_ps(bx, cy), _mm_mul_ps(by, cx)));
+		}
+#endif
+
+		//! calculates the triangle normals of the quads between two vertex rows
+		/** Each vertex sums up two triangles of each of its four quads. The
+		eight triangles around a vertex only use four distinct normals per
+		quad, up to the sign, which are calculated here once for all vertices
+		of the quad. */
+		void calculateQuadNormals(const f32* row0, const f32* row1, f32* quads, s32 size)
+		{
+			const s32 count = size-1;
+			s32 z=0;
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+			for (; z+4<=count; z+=4)
+			{
+				const __m128 x00 = _mm_loadu_ps(row0+z);
+				const __m128 y00 = _mm_loadu_ps(row0+size+z);
+				const __m128 z00 = _mm_loadu_ps(row0+size*2+z);
+				const __m128 x01 = _mm_loadu_ps(row0+z+1);
+				const __m128 y01 = _mm_loadu_ps(row0+size+z+1);
+				const __m128 z01 = _mm_loadu_ps(row0+size*2+z+1);
+				const __m128 x10 = _mm_loadu_ps(row1+z);
+				const __m128 y10 = _mm_loadu_ps(row1+size+z);
+				const __m128 z10 = _mm_loadu_ps(row1+size*2+z);
+				const __m128 x11 = _mm_loadu_ps(row1+z+1);
+				const __m128 y11 = _mm_loadu_ps(row1+size+z+1);
+				const __m128 z11 = _mm_loadu_ps(row1+size*2+z+1);
+
+				storeCrossProduct4(x00, y00, z00, x01, y01, z01, x11, y11, z11, quads, EQN_1_X, size, z);
+				storeCrossProduct4(x00, y00, z00, x10, y10, z10, x11, y11, z11, quads, EQN_2_X, size, z);
+				storeCrossProduct4(x01, y01, z01, x00, y00, z00, x11, y11, z11, quads, EQN_5_X, size, z);
+				storeCrossProduct4(x01, y01, z01, x11, y11, z11, x10, y10, z10, quads, EQN_6_X, size, z);
+			}
+
+			for (s32 n=EQN_1_X; n<EQN_COUNT; n+=3)
+				normalizeArrays(quads+n*size, quads+(n+1)*size, quads+(n+2)*size, z);
+#endif
 
-				// bottom left
-				if (x<TerrainData.Size-1 && z>0)
+			for (; z<count; ++z)
+			{
+				const core::vector3df q00(row0[z], row0[z+size], row0[z+size*2]);
+				const core::vector3df q01(row0[z+1], row0[z+1+size], row0[z+1+size*2]);
+				const core::vector3df q10(row1[z], row1[z+size], row1[z+size*2]);
+				const core::vector3df q11(row1[z+1], row1[z+1+size], row1[z+1+size*2]);
+
+				storeTriangleNormal(q00, q01, q11, quads, EQN_1_X, size, z);
+				storeTriangleNormal(q00, q10, q11, quads, EQN_2_X, size, z);
+				storeTriangleNormal(q01, q00, q11, quads, EQN_5_X, size, z);
+				storeTriangleNormal(q01, q11, q10, quads, EQN_6_X, size, z);
+			}
+		}
+
+		//! adds or subtracts a triangle normal of a quad
+		inline void addQuadNormal(core::vector3df& normal, const f32* quads, s32 n, s32 size, s32 z, bool negate)
+		{
+			const core::vector3df t(quads[n*size+z], quads[(n+1)*size+z], quads[(n+2)*size+z]);
+
+			// the flipped triangle has the negated normal, but exact zeros are always positive
+			if (negate)
+				normal += core::vector3df(0.f, 0.f, 0.f) - t;
+			else
+				normal += t;
+		}
+
+		//! sums up the triangle normals around a vertex in the order of the old per vertex loop
+		/** \param above Quads between the previous and this vertex row, 0 for the first row.
+		\param below Quads between this and the next vertex row, 0 for the last row. */
+		void sumVertexNormal(const f32* above, const f32* below, f32* normals, s32 size, s32 z)
+		{
+			core::vector3df normal;
+			bool found = false;
+
+			// top left
+			if (above && z>0)
+			{
+				addQuadNormal(normal, above, EQN_1_X, size, z-1, false);
+				addQuadNormal(normal, above, EQN_2_X, size, z-1, false);
+				found = true;
+			}
+
+			// top right
+			if (above && z<size-1)
+			{
+				addQuadNormal(normal, above, EQN_1_X, size, z, false);
+				addQuadNormal(normal, above, EQN_2_X, size, z, true);
+				found = true;
+			}
+
+			// bottom right
+			if (below && z<size-1)
+			{
+				addQuadNormal(normal, below, EQN_5_X, size, z, false);
+				addQuadNormal(normal, below, EQN_6_X, size, z, false);
+				found = true;
+			}
+
+			// bottom left
+			if (below && z>0)
+			{
+				addQuadNormal(normal, below, EQN_1_X, size, z-1, false);
+				addQuadNormal(normal, below, EQN_2_X, size, z-1, true);
+				found = true;
+			}
+
+			if (!found)
+				normal.set(0.0f, 1.0f, 0.0f);
+
+			normals[z] = normal.X;
+			normals[z+size] = normal.Y;
+			normals[z+size*2] = normal.Z;
+		}
+
+		//! sums up the triangle normals of all vertices of a row
+		void sumVertexNormals(const f32* above, const f32* below, f32* normals, s32 size)
+		{
+			s32 z=0;
+
+#ifdef _IRR_COMPILE_WITH_SSE2_
+			if (above && below && size>2)
+			{
+				sumVertexNormal(above, below, normals, size, 0);
+
+				// inner vertices have all eight triangles
+				for (z=1; z+4<=size-1; z+=4)
 				{
-					a = mb->getVertexBuffer()[x*TerrainData.Size+z-1].Pos;
-					b = mb->getVertexBuffer()[x*TerrainData.Size+z].Pos;
-					c = mb->getVertexBuffer()[(x+1)*TerrainData.Size+z].Pos;
-					b -= a;
-					c -= a;
-					t = b.crossProduct(c);
-					t.normalize();
-					normal += t;
-
-					a = mb->getVertexBuffer()[x*TerrainData.Size+z-1].Pos;
-					b = mb->getVertexBuffer()[(x+1)*TerrainData.Size+z].Pos;
-					c = mb->getVertexBuffer()[(x+1)*TerrainData.Size+z-1].Pos;
-					b -= a;
-					c -= a;
-					t = b.crossProduct(c);
-					t.normalize();
-					normal += t;
-
-					count += 2;
+					for (s32 i=0; i<3; ++i)
+					{
+						const s32 n1 = (EQN_1_X+i)*size;
+						const s32 n2 = (EQN_2_X+i)*size;
+						const __m128 zero = _mm_setzero_ps();
+						__m128 sum = zero;
+						sum = _mm_add_ps(sum, _mm_loadu_ps(above+n1+z-1));
+						sum = _mm_add_ps(sum, _mm_loadu_ps(above+n2+z-1));
+						sum = _mm_add_ps(sum, _mm_loadu_ps(above+n1+z));
+						sum = _mm_add_ps(sum, _mm_sub_ps(zero, _mm_loadu_ps(above+n2+z)));
+						sum = _mm_add_ps(sum, _mm_loadu_ps(below+(EQN_5_X+i)*size+z));
+						sum = _mm_add_ps(sum, _mm_loadu_ps(below+(EQN_6_X+i)*size+z));
+						sum = _mm_add_ps(sum, _mm_loadu_ps(below+n1+z-1));
+						sum = _mm_add_ps(sum, _mm_sub_ps(zero, _mm_loadu_ps(below+n2+z-1)));
+						_mm_storeu_ps(normals+i*size+z, sum);
+					}
 				}
+			}
+#endif
+
+			for (; z<size; ++z)
+				sumVertexNormal(above, below, normals, size, z);
+		}
 
-				if (count != 0)
+		//! calculates the normals of blocks of vertex rows on the worker threads
+		struct SNormalJob : public IWorkerJob
+		{
+			virtual void execute(u32 block, u32 thread)
+			{
+				const s32 first = block * NORMAL_BLOCK_ROWS;
+				const s32 last = core::min_(first + NORMAL_BLOCK_ROWS, Size);
+
+				// two vertex rows, two quad rows and the normals of a vertex row
+				core::array<f32>& buffer = Buffers[thread];
+				if (buffer.empty())
+					buffer.set_used(Size * (3*2 + EQN_COUNT*2 + 3));
+				f32* rows[2] = { buffer.pointer(), buffer.pointer() + Size*3 };
+				f32* quads[2] = { buffer.pointer() + Size*6, buffer.pointer() + Size*(6+EQN_COUNT) };
+				f32* normals = buffer.pointer() + Size*(6+EQN_COUNT*2);
+
+				// rows[x&1] holds vertex row x, quads[x&1] the quads between the vertex rows x and x+1
+				loadVertexRow(Vertices + first*Size, rows[first&1], Size);
+				if (first > 0)
 				{
-					normal.normalize();
+					loadVertexRow(Vertices + (first-1)*Size, rows[(first-1)&1], Size);
+					calculateQuadNormals(rows[(first-1)&1], rows[first&1], quads[(first-1)&1], Size);
 				}
-				else
+
+				for (s32 x=first; x<last; ++x)
 				{
-					normal.set(0.0f, 1.0f, 0.0f);
+					if (x < Size-1)
+					{
+						loadVertexRow(Vertices + (x+1)*Size, rows[(x+1)&1], Size);
+						calculateQuadNormals(rows[x&1], rows[(x+1)&1], quads[x&1], Size);
+					}
+
+					sumVertexNormals(x > 0 ? quads[(x-1)&1] : 0, x < Size-1 ? quads[x&1] : 0, normals, Size);
+					normalizeArrays(normals, normals+Size, normals+Size*2, Size);
+
+					video::S3DVertex2TCoords* v = Vertices + x*Size;
+					for (s32 z=0; z<Size; ++z)
+						v[z].Normal.set(normals[z], normals[z+Size], normals[z+Size*2]);
 				}
+			}
+
+			video::S3DVertex2TCoords* Vertices;
+			s32 Size;
+
+			//! rows of each thread, allocated on its first block
+			core::array<core::array<f32> > Buffers;
+		};
+	}
+
+
+	//! calculate smooth normals
+	/** Each vertex gets the mean of the normals of the eight triangles
+	around it. The rows of the grid are processed in blocks, on several
+	threads for large terrains. */
+	void CTerrainSceneNode::calculateNormals(IDynamicMeshBuffer* mb)
+	{
+		SNormalJob job;
+		job.Vertices = static_cast<video::S3DVertex2TCoords*>(mb->getVertexBuffer().pointer());
+		job.Size = TerrainData.Size;
+		const u32 blocks = (TerrainData.Size + NORMAL_BLOCK_ROWS - 1) / NORMAL_BLOCK_ROWS;
 
-				mb->getVertexBuffer()[x * TerrainData.Size + z].Normal = normal;
+#ifdef _IRR_COMPILE_WITH_THREADS_
+		if (TerrainData.Size >= PARALLEL_NORMALS_SIZE && CWorkerPool::getProcessorCount() > 1)
+		{
+			// the threads stay around for the next terrain or scaling
+			if (!UsesNormalsPool)
+			{
+				if (TerrainPool)
+					TerrainPool->grab();
+				else
+					TerrainPool = new CWorkerPool();
+				UsesNormalsPool = true;
 			}
+
+			for (u32 i=0; i<TerrainPool->getThreadCount(); ++i)
+				job.Buffers.push_back(core::array<f32>());
+			TerrainPool->run(&job, blocks);
+			return;
 		}
+#endif
+
+		job.Buffers.push_back(core::array<f32>());
+		for (u32 i=0; i<blocks; ++i)
+			job.execute(i, 0);
 	}
 
 
@@ -1239,6 +1628,53 @@ namespace scene
 			delete [] TerrainData.Patches;
 
 		TerrainData.Patches = new SPatch[TerrainData.PatchCount * TerrainData.PatchCount];
+
+		// the index lists depend on the size of the terrain
+		PatchIndices.clear();
+		PatchIndicesStart.clear();
+
+		PatchTree.clear();
+		if (TerrainData.PatchCount > 0)
+		{
+			SPatchTreeNode root;
+			root.X0 = 0;
+			root.Z0 = 0;
+			root.X1 = TerrainData.PatchCount;
+			root.Z1 = TerrainData.PatchCount;
+			PatchTree.push_back(root);
+			buildPatchTree(0);
+		}
+	}
+
+
+	//! builds the quadtree over the patches
+	void CTerrainSceneNode::buildPatchTree(u32 n)
+	{
+		SPatchTreeNode node = PatchTree[n];
+		node.FirstChild = PatchTree.size();
+		node.ChildCount = 0;
+
+		// split the patches in halves, leaves hold a single patch
+		const s32 xmid = (node.X0 + node.X1) / 2;
+		const s32 zmid = (node.Z0 + node.Z1) / 2;
+		for (u32 i = 0; i < 4; ++i)
+		{
+			SPatchTreeNode child;
+			child.X0 = (i & 1) ? xmid : node.X0;
+			child.X1 = (i & 1) ? node.X1 : xmid;
+			child.Z0 = (i & 2) ? zmid : node.Z0;
+			child.Z1 = (i & 2) ? node.Z1 : zmid;
+			if (child.X0 == child.X1 || child.Z0 == child.Z1 ||
+				(child.X1 - child.X0 == node.X1 - node.X0 && child.Z1 - child.Z0 == node.Z1 - node.Z0))
+				continue;
+
+			PatchTree.push_back(child);
+			++node.ChildCount;
+		}
+
+		PatchTree[n] = node;
+		for (u32 i = 0; i < node.ChildCount; ++i)
+			buildPatchTree(node.FirstChild + i);
 	}
 
 
@@ -1300,6 +1736,21 @@ namespace scene
 			}
 		}
 
+		// Boxes of the quadtree, children are always stored after their parents
+		for (s32 i = (s32)PatchTree.size() - 1; i >= 0; --i)
+		{
+			SPatchTreeNode& node = PatchTree[i];
+			if (!node.ChildCount)
+			{
+				node.BoundingBox = TerrainData.Patches[node.X0 * TerrainData.PatchCount + node.Z0].BoundingBox;
+				continue;
+			}
+
+			node.BoundingBox = PatchTree[node.FirstChild].BoundingBox;
+			for (u32 c = 1; c < node.ChildCount; ++c)
+				node.BoundingBox.addInternalBox(PatchTree[node.FirstChild + c].BoundingBox);
+		}
+
 		// get center of Terrain
 		TerrainData.Center = TerrainData.BoundingBox.getCenter();
 
@@ -222,7 +222,8 @@ namespace scene
 		struct SPatch
 		{
 			SPatch()
-			: Top(0), Bottom(0), Right(0), Left(0), CurrentLOD(-1)
+			: Top(0), Bottom(0), Right(0), Left(0), CurrentLOD(-1),
+				RenderedKey(-1), IndexStart(0)
 			{
 			}
 
@@ -231,10 +232,25 @@ namespace scene
 			SPatch* Right;
 			SPatch* Left;
 			s32 CurrentLOD;
+			//! index list key of the indices in the render buffer, -1 if none
+			s32 RenderedKey;
+			//! first index of this patch in the render buffer
+			u32 IndexStart;
 			core::aabbox3df BoundingBox;
 			core::vector3df Center;
 		};
 
+		//! Node of the quadtree over the patches
+		/** Covers the patches [X0,X1) x [Z0,Z1). The children of a
+		node are stored one after another, starting at FirstChild. */
+		struct SPatchTreeNode
+		{
+			core::aabbox3df BoundingBox;
+			s32 X0, Z0, X1, Z1;
+			u32 FirstChild;
+			u32 ChildCount;
+		};
+
 		struct STerrainData
 		{
 			STerrainData(s32 patchSize, s32 maxLOD, const core::vector3df& position, const core::vector3df& rotation, const core::vector3df& scale)
@@ -266,6 +282,29 @@ namespace scene
 		//! get indices when generating index data for patches at varying levels of detail.
 		u32 getIndex(const s32 PatchX, const s32 PatchZ, const s32 PatchIndex, u32 vX, u32 vZ) const;
 
+		//! get the index of a vertex relative to the first vertex of a patch
+		//! \param neighbourLOD: LODs of the top, bottom, left and right neighbours, -1 if there is none.
+		u32 getStitchedIndex(s32 LOD, const s32* neighbourLOD, u32 vX, u32 vZ) const;
+
+		//! get the key of the index list of a patch, based on its LOD and the LODs of its neighbours
+		s32 getPatchIndexKey(const SPatch& patch) const;
+
+		//! get the index list for a key, relative to the first vertex of a patch. Created on first use.
+		const u32* getPatchIndices(s32 key, u32& count);
+
+		//! get the LOD for a squared distance to the camera
+		s32 getLODForDistance(f32 distanceSQ) const;
+
+		//! builds the quadtree over the patches
+		void buildPatchTree(u32 node);
+
+		//! calculates the LODs of the patches below a quadtree node
+		void calculateLODOfPatchTree(u32 node, const core::aabbox3df& frustumBox,
+			const core::vector3df& cameraPosition, bool inside, bool uniformLOD);
+
+		//! sets the CurrentLOD of all patches below a quadtree node
+		void setLODOfPatchTree(const SPatchTreeNode& node, s32 LOD);
+
 		//! smooth the terrain
 		void smoothTerrain(IDynamicMeshBuffer* mb, s32 smoothFactor);
 
@@ -295,6 +334,13 @@ namespace scene
 
 		IDynamicMeshBuffer *RenderBuffer;
 
+		//! quadtree over the patches, the root is the first node
+		core::array<SPatchTreeNode> PatchTree;
+
+		//! index lists of patches for each combination of LODs, see getPatchIndices
+		core::array<u32> PatchIndices;
+		core::array<s32> PatchIndicesStart;
+
 		u32 VerticesToRender;
 		u32 IndicesToRender;
 
@@ -302,6 +348,8 @@ namespace scene
 		bool OverrideDistanceThreshold;
 		bool UseDefaultRotationPivot;
 		bool ForceRecalculation;
+		//! true if this node holds a reference to the worker threads for normals
+		bool UsesNormalsPool;
 
 		core::vector3df	OldCameraPosition;
 		core::vector3df	OldCameraRotation;
@@ -55,6 +55,10 @@ void CTerrainTriangleSelector::setTriangleData(ITerrainSceneNode* node, s32 LOD)
 		{
 			TrianglePatches.TrianglePatchArray[tIndex].NumTriangles = 0;
 			TrianglePatches.TrianglePatchArray[tIndex].Box = node->getBoundingBox( x, z );
+			if (tIndex)
+				TrianglePatches.Box.addInternalBox(TrianglePatches.TrianglePatchArray[tIndex].Box);
+			else
+				TrianglePatches.Box = TrianglePatches.TrianglePatchArray[tIndex].Box;
 			u32 indexCount = node->getIndicesForPatch( indices, x, z, LOD );
 
 			TrianglePatches.TrianglePatchArray[tIndex].Triangles.reallocate(indexCount/3);
@@ -190,6 +194,17 @@ s32 CTerrainTriangleSelector::getTriangleCount() const
 }
 
 
+//! Gets a box around all triangles, in world space.
+bool CTerrainTriangleSelector::getTransformedBoundingBox(core::aabbox3df& outBox) const
+{
+	if (!TrianglePatches.NumPatches)
+		return false;
+
+	outBox = TrianglePatches.Box;
+	return true;
+}
+
+
 ISceneNode* CTerrainTriangleSelector::getSceneNodeForTriangle(
 		u32 triangleIndex) const
 {
@@ -54,6 +54,9 @@ public:
 	//! Returns amount of all available triangles in this selector
 	virtual s32 getTriangleCount() const;
 
+	//! Gets a box around all triangles, in world space.
+	virtual bool getTransformedBoundingBox(core::aabbox3df& outBox) const;
+
 	//! Return the scene node associated with a given triangle.
 	virtual ISceneNode* getSceneNodeForTriangle(u32 triangleIndex) const;
 
@@ -87,6 +90,7 @@ private:
 		core::array<SGeoMipMapTrianglePatch> TrianglePatchArray;
 		s32 NumPatches;
 		u32 TotalTriangles;
+		core::aabbox3df Box;
 	};
 
 	ITerrainSceneNode* SceneNode;
@@ -75,6 +75,17 @@ void CTriangleBBSelector::getTriangles(core::triangle3df* triangles,
 }
 
 
+//! Gets a box around all triangles, in world space.
+bool CTriangleBBSelector::getTransformedBoundingBox(core::aabbox3df& outBox) const
+{
+	if (!SceneNode)
+		return false;
+
+	outBox = SceneNode->getTransformedBoundingBox();
+	return true;
+}
+
+
 } // end namespace scene
 } // end namespace irr
 
@@ -33,6 +33,8 @@ public:
 		s32& outTriangleCount, const core::line3d<f32>& line,
 		const core::matrix4* transform=0) const;
 
+	//! Gets a box around all triangles, in world space.
+	virtual bool getTransformedBoundingBox(core::aabbox3df& outBox) const;
 };
 
 } // end namespace scene
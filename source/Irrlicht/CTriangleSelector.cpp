@@ -261,6 +261,19 @@ s32 CTriangleSelector::getTriangleCount() const
 }
 
 
+//! Gets a box around all triangles, in world space.
+bool CTriangleSelector::getTransformedBoundingBox(core::aabbox3df& outBox) const
+{
+	// Update my triangles if necessary
+	update();
+
+	outBox = BoundingBox;
+	if (SceneNode)
+		SceneNode->getAbsoluteTransformation().transformBoxEx(outBox);
+	return true;
+}
+
+
 /* Get the number of TriangleSelectors that are part of this one.
 Only useful for MetaTriangleSelector others return 1
 */
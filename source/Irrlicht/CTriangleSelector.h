@@ -52,6 +52,9 @@ public:
 	//! Returns amount of all available triangles in this selector
 	virtual s32 getTriangleCount() const;
 
+	//! Gets a box around all triangles, in world space.
+	virtual bool getTransformedBoundingBox(core::aabbox3df& outBox) const;
+
 	//! Return the scene node associated with a given triangle.
 	virtual ISceneNode* getSceneNodeForTriangle(u32 triangleIndex) const { return SceneNode; }
 
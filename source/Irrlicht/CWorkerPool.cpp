@@ -0,0 +1,512 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#include "CWorkerPool.h"
+#include "os.h"
+#include "irrMath.h"
+
+#ifdef _IRR_COMPILE_WITH_THREADS_
+#if defined(_IRR_WINDOWS_API_)
+	#include <windows.h>
+#else
+	#include <pthread.h>
+	#include <unistd.h>
+#endif
+#endif
+
+namespace irr
+{
+
+#if defined(_IRR_COMPILE_WITH_THREADS_) && defined(_IRR_WINDOWS_API_)
+
+struct SWorkerSync
+{
+	SWorkerSync()
+	{
+		InitializeCriticalSection(&Mutex);
+		InitializeConditionVariable(&WorkAvailable);
+		InitializeConditionVariable(&WorkDone);
+	}
+	~SWorkerSync()
+	{
+		DeleteCriticalSection(&Mutex);
+	}
+	void lock() { EnterCriticalSection(&Mutex); }
+	void unlock() { LeaveCriticalSection(&Mutex); }
+	void waitForWork() { SleepConditionVariableCS(&WorkAvailable, &Mutex, INFINITE); }
+	void waitForDone() { SleepConditionVariableCS(&WorkDone, &Mutex, INFINITE); }
+	void signalWork() { WakeAllConditionVariable(&WorkAvailable); }
+	void signalDone() { WakeAllConditionVariable(&WorkDone); }
+
+	CRITICAL_SECTION Mutex;
+	CONDITION_VARIABLE WorkAvailable;
+	CONDITION_VARIABLE WorkDone;
+};
+
+#elif defined(_IRR_COMPILE_WITH_THREADS_)
+
+struct SWorkerSync
+{
+	SWorkerSync()
+	{
+		pthread_mutex_init(&Mutex, 0);
+		pthread_cond_init(&WorkAvailable, 0);
+		pthread_cond_init(&WorkDone, 0);
+	}
+	~SWorkerSync()
+	{
+		pthread_cond_destroy(&WorkDone);
+		pthread_cond_destroy(&WorkAvailable);
+		pthread_mutex_destroy(&Mutex);
+	}
+	void lock() { pthread_mutex_lock(&Mutex); }
+	void unlock() { pthread_mutex_unlock(&Mutex); }
+	void waitForWork() { pthread_cond_wait(&WorkAvailable, &Mutex); }
+	void waitForDone() { pthread_cond_wait(&WorkDone, &Mutex); }
+	void signalWork() { pthread_cond_broadcast(&WorkAvailable); }
+	void signalDone() { pthread_cond_broadcast(&WorkDone); }
+
+	pthread_mutex_t Mutex;
+	pthread_cond_t WorkAvailable;
+	pthread_cond_t WorkDone;
+};
+
+#else
+
+struct SWorkerSync
+{
+	void lock() {}
+	void unlock() {}
+	void waitForWork() {}
+	void waitForDone() {}
+	void signalWork() {}
+	void signalDone() {}
+};
+
+#endif
+
+
+//! a thread running the loop of a worker pool or queue
+struct SWorkerThread
+{
+	typedef void (*LoopFunction)(void* owner, u32 index);
+
+	SWorkerThread(LoopFunction loop, void* owner, u32 index)
+		: Loop(loop), Owner(owner), Index(index) {}
+
+#ifdef _IRR_COMPILE_WITH_THREADS_
+#if defined(_IRR_WINDOWS_API_)
+	static DWORD WINAPI entry(LPVOID param)
+	{
+		SWorkerThread* thread = (SWorkerThread*)param;
+		thread->Loop(thread->Owner, thread->Index);
+		return 0;
+	}
+
+	bool start()
+	{
+		Handle = CreateThread(0, 0, entry, this, 0, &Id);
+		return Handle != 0;
+	}
+
+	bool isCurrent() const
+	{
+		return GetCurrentThreadId() == Id;
+	}
+
+	void join()
+	{
+		WaitForSingleObject(Handle, INFINITE);
+		CloseHandle(Handle);
+	}
+
+	HANDLE Handle;
+	DWORD Id;
+#else
+	static void* entry(void* param)
+	{
+		SWorkerThread* thread = (SWorkerThread*)param;
+		thread->Loop(thread->Owner, thread->Index);
+		return 0;
+	}
+
+	bool start()
+	{
+		return pthread_create(&Handle, 0, entry, this) == 0;
+	}
+
+	bool isCurrent() const
+	{
+		return pthread_equal(Handle, pthread_self()) != 0;
+	}
+
+	void join()
+	{
+		pthread_join(Handle, 0);
+	}
+
+	pthread_t Handle;
+#endif
+#else
+	bool start() { return false; }
+	void join() {}
+	bool isCurrent() const { return false; }
+#endif
+
+	LoopFunction Loop;
+	void* Owner;
+	u32 Index;
+};
+
+
+//! constructor
+CWorkerPool::CWorkerPool(u32 threadCount)
+	: Job(0), ItemCount(0), NextItem(0), PendingItems(0), Generation(0),
+	Quit(false), Sync(new SWorkerSync())
+{
+	#ifdef _DEBUG
+	setDebugName("CWorkerPool");
+	#endif
+
+	if (!threadCount)
+		threadCount = getProcessorCount();
+
+	// the calling thread is worker 0
+	for (u32 i=1; i<threadCount; ++i)
+	{
+		SWorkerThread* thread = new SWorkerThread(threadLoop, this, i);
+		if (!thread->start())
+		{
+			delete thread;
+			os::Printer::log("Could not create worker thread.", ELL_WARNING);
+			break;
+		}
+		Threads.push_back(thread);
+	}
+}
+
+
+//! destructor
+CWorkerPool::~CWorkerPool()
+{
+	Sync->lock();
+	Quit = true;
+	Sync->signalWork();
+	Sync->unlock();
+
+	for (u32 i=0; i<Threads.size(); ++i)
+	{
+		Threads[i]->join();
+		delete Threads[i];
+	}
+
+	delete Sync;
+}
+
+
+//! Returns the number of threads working on a job, including the caller.
+u32 CWorkerPool::getThreadCount() const
+{
+	return Threads.size() + 1;
+}
+
+
+//! Executes all items of the job and returns when they are finished.
+void CWorkerPool::run(IWorkerJob* job, u32 itemCount)
+{
+	if (!job || !itemCount)
+		return;
+
+	if (Threads.empty() || itemCount == 1)
+	{
+		for (u32 i=0; i<itemCount; ++i)
+			job->execute(i, 0);
+		return;
+	}
+
+	Sync->lock();
+	Job = job;
+	ItemCount = itemCount;
+	NextItem = 0;
+	PendingItems = itemCount;
+	++Generation;
+	Sync->signalWork();
+	Sync->unlock();
+
+	work(0);
+
+	Sync->lock();
+	while (PendingItems)
+		Sync->waitForDone();
+	Job = 0;
+	Sync->unlock();
+}
+
+
+//! waits for new jobs until the pool shuts down
+void CWorkerPool::threadLoop(void* owner, u32 thread)
+{
+	CWorkerPool* pool = (CWorkerPool*)owner;
+	SWorkerSync* sync = pool->Sync;
+	u32 generation = 0;
+
+	sync->lock();
+	while (true)
+	{
+		while (!pool->Quit && pool->Generation == generation)
+			sync->waitForWork();
+
+		if (pool->Quit)
+			break;
+
+		generation = pool->Generation;
+		sync->unlock();
+		pool->work(thread);
+		sync->lock();
+	}
+	sync->unlock();
+}
+
+
+//! Processes items of the current job until none are left.
+void CWorkerPool::work(u32 thread)
+{
+	while (true)
+	{
+		Sync->lock();
+		if (!Job || NextItem >= ItemCount)
+		{
+			Sync->unlock();
+			return;
+		}
+		IWorkerJob* job = Job;
+		const u32 item = NextItem++;
+		Sync->unlock();
+
+		job->execute(item, thread);
+
+		Sync->lock();
+		if (--PendingItems == 0)
+			Sync->signalDone();
+		Sync->unlock();
+	}
+}
+
+
+//! Returns the number of processor cores available to the process.
+u32 CWorkerPool::getProcessorCount()
+{
+#if defined(_IRR_COMPILE_WITH_THREADS_) && defined(_IRR_WINDOWS_API_)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return core::max_((u32)info.dwNumberOfProcessors, 1u);
+#elif defined(_IRR_COMPILE_WITH_THREADS_) && defined(_SC_NPROCESSORS_ONLN)
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+	return count > 1 ? (u32)count : 1;
+#else
+	return 1;
+#endif
+}
+
+
+
+//! constructor
+CWorkerQueue::CWorkerQueue(u32 threadCount)
+	: Running(0), Quit(false), Sync(new SWorkerSync())
+{
+	#ifdef _DEBUG
+	setDebugName("CWorkerQueue");
+	#endif
+
+	if (!threadCount)
+		threadCount = CWorkerPool::getProcessorCount();
+
+	for (u32 i=0; i<threadCount; ++i)
+	{
+		SWorkerThread* thread = new SWorkerThread(threadLoop, this, i);
+		if (!thread->start())
+		{
+			delete thread;
+			os::Printer::log("Could not create worker thread.", ELL_WARNING);
+			break;
+		}
+		Threads.push_back(thread);
+	}
+}
+
+
+//! destructor
+CWorkerQueue::~CWorkerQueue()
+{
+	Sync->lock();
+	Quit = true;
+	Waiting.clear();
+	Sync->signalWork();
+	Sync->unlock();
+
+	for (u32 i=0; i<Threads.size(); ++i)
+	{
+		Threads[i]->join();
+		delete Threads[i];
+	}
+
+	delete Sync;
+}
+
+
+//! Returns the number of background threads.
+u32 CWorkerQueue::getThreadCount() const
+{
+	return Threads.size();
+}
+
+
+//! Adds an item of a job to the end of the queue.
+void CWorkerQueue::enqueue(IWorkerJob* job, u32 item)
+{
+	if (!job)
+		return;
+
+	SItem entry;
+	entry.Job = job;
+	entry.Item = item;
+
+	if (Threads.empty())
+	{
+		job->execute(item, 0);
+		Finished.push_back(entry);
+		return;
+	}
+
+	Sync->lock();
+	Waiting.push_back(entry);
+	Sync->signalWork();
+	Sync->unlock();
+}
+
+
+//! Gets an item which was executed since the last call.
+bool CWorkerQueue::popFinished(IWorkerJob*& job, u32& item)
+{
+	Sync->lock();
+	const bool found = !Finished.empty();
+	if (found)
+	{
+		core::list<SItem>::Iterator first = Finished.begin();
+		job = first->Job;
+		item = first->Item;
+		Finished.erase(first);
+	}
+	Sync->unlock();
+	return found;
+}
+
+
+//! Returns the number of items which are waiting or running.
+u32 CWorkerQueue::getPendingCount() const
+{
+	Sync->lock();
+	const u32 count = Waiting.size() + Running;
+	Sync->unlock();
+	return count;
+}
+
+
+//! Blocks until all waiting and running items are finished.
+void CWorkerQueue::waitForAll()
+{
+	Sync->lock();
+	while (!Waiting.empty() || Running)
+		Sync->waitForDone();
+	Sync->unlock();
+}
+
+
+//! Returns true if called from one of the background threads of the queue.
+bool CWorkerQueue::isWorkerThread() const
+{
+	for (u32 i=0; i<Threads.size(); ++i)
+	{
+		if (Threads[i]->isCurrent())
+			return true;
+	}
+	return false;
+}
+
+
+//! executes queued items until the queue shuts down
+void CWorkerQueue::threadLoop(void* owner, u32 thread)
+{
+	CWorkerQueue* queue = (CWorkerQueue*)owner;
+	SWorkerSync* sync = queue->Sync;
+
+	sync->lock();
+	while (true)
+	{
+		while (!queue->Quit && queue->Waiting.empty())
+			sync->waitForWork();
+
+		if (queue->Quit)
+			break;
+
+		core::list<SItem>::Iterator first = queue->Waiting.begin();
+		const SItem entry = *first;
+		queue->Waiting.erase(first);
+		++queue->Running;
+		sync->unlock();
+
+		entry.Job->execute(entry.Item, thread);
+
+		sync->lock();
+		--queue->Running;
+		queue->Finished.push_back(entry);
+		sync->signalDone();
+	}
+	sync->unlock();
+}
+
+
+
+
+//! constructor
+CWorkerLock::CWorkerLock()
+	: Sync(new SWorkerSync())
+{
+}
+
+
+//! destructor
+CWorkerLock::~CWorkerLock()
+{
+	delete Sync;
+}
+
+
+void CWorkerLock::lock()
+{
+	Sync->lock();
+}
+
+
+void CWorkerLock::unlock()
+{
+	Sync->unlock();
+}
+
+
+//! Unlocks, blocks until notify() is called, and locks again.
+void CWorkerLock::wait()
+{
+	Sync->waitForWork();
+}
+
+
+//! Wakes up all threads which wait.
+void CWorkerLock::notify()
+{
+	Sync->signalWork();
+}
+
+} // end namespace irr
+
@@ -0,0 +1,173 @@
+// Copyright (C) 2002-2012 Nikolaus Gebhardt
+// This file is part of the "Irrlicht Engine".
+// For conditions of distribution and use, see copyright notice in irrlicht.h
+
+#ifndef __C_WORKER_POOL_H_INCLUDED__
+#define __C_WORKER_POOL_H_INCLUDED__
+
+#include "IrrCompileConfig.h"
+#include "IReferenceCounted.h"
+#include "irrArray.h"
+#include "irrList.h"
+
+namespace irr
+{
+
+struct SWorkerSync;
+struct SWorkerThread;
+
+//! Interface for work which can be split up into independent items.
+class IWorkerJob
+{
+public:
+
+	virtual ~IWorkerJob() {}
+
+	//! Processes a single work item.
+	/** Called concurrently from several threads, but never twice for the same item.
+	\param item Index of the work item, smaller than the item count passed to CWorkerPool::run(),
+	or the item passed to CWorkerQueue::enqueue().
+	\param thread Index of the executing thread, smaller than getThreadCount() of the pool
+	or queue. Thread 0 of a pool is always the thread which called CWorkerPool::run(). */
+	virtual void execute(u32 item, u32 thread) = 0;
+};
+
+
+//! A set of worker threads which execute the items of a job in parallel.
+/** The engine is not thread safe, so jobs must only touch data which is
+not shared between their items. Without _IRR_COMPILE_WITH_THREADS_ all
+items are simply processed on the calling thread. */
+class CWorkerPool : public virtual IReferenceCounted
+{
+public:
+
+	//! Constructor
+	/** \param threadCount Number of threads working on a job, including the
+	thread calling run(). 0 uses one thread per processor core. */
+	CWorkerPool(u32 threadCount=0);
+
+	//! Destructor, stops all worker threads.
+	virtual ~CWorkerPool();
+
+	//! Returns the number of threads working on a job, including the caller.
+	u32 getThreadCount() const;
+
+	//! Executes all items of the job and returns when they are finished.
+	/** Must not be called from inside a job, and only from one thread at a time. */
+	void run(IWorkerJob* job, u32 itemCount);
+
+	//! Returns the number of processor cores available to the process.
+	static u32 getProcessorCount();
+
+private:
+
+	//! Processes items of the current job until none are left.
+	void work(u32 thread);
+
+	//! waits for new jobs until the pool shuts down
+	static void threadLoop(void* pool, u32 thread);
+
+	core::array<SWorkerThread*> Threads;
+
+	IWorkerJob* Job;
+	u32 ItemCount;
+	u32 NextItem;
+	u32 PendingItems;
+	u32 Generation;
+	bool Quit;
+
+	// opaque handle to the platform synchronisation objects
+	SWorkerSync* Sync;
+};
+
+
+//! Threads which execute single job items in the background.
+/** Items are started in the order in which they were enqueued. The caller
+continues while they run, and collects the finished items with
+popFinished(), e.g. once per frame. Without _IRR_COMPILE_WITH_THREADS_
+enqueue() executes the item at once. */
+class CWorkerQueue : public virtual IReferenceCounted
+{
+public:
+
+	//! Constructor
+	/** \param threadCount Number of background threads. 0 uses one thread
+	per processor core. */
+	CWorkerQueue(u32 threadCount=1);
+
+	//! Destructor, waits for running items. Items which were not started yet are not executed.
+	virtual ~CWorkerQueue();
+
+	//! Returns the number of background threads.
+	u32 getThreadCount() const;
+
+	//! Adds an item of a job to the end of the queue.
+	/** The job must stay valid until the item was returned by popFinished(). */
+	void enqueue(IWorkerJob* job, u32 item);
+
+	//! Gets an item which was executed since the last call.
+	/** \return False if no item finished. */
+	bool popFinished(IWorkerJob*& job, u32& item);
+
+	//! Returns the number of items which are waiting or running.
+	u32 getPendingCount() const;
+
+	//! Blocks until all waiting and running items are finished.
+	void waitForAll();
+
+	//! Returns true if called from one of the background threads of the queue.
+	bool isWorkerThread() const;
+
+private:
+
+	//! executes queued items until the queue shuts down
+	static void threadLoop(void* queue, u32 thread);
+
+	struct SItem
+	{
+		IWorkerJob* Job;
+		u32 Item;
+	};
+
+	core::array<SWorkerThread*> Threads;
+
+	core::list<SItem> Waiting;
+	core::list<SItem> Finished;
+	u32 Running;
+	bool Quit;
+
+	SWorkerSync* Sync;
+};
+
+
+//! A lock and a condition, for data which is shared with worker threads.
+/** Without _IRR_COMPILE_WITH_THREADS_ all calls do nothing. */
+class CWorkerLock
+{
+public:
+
+	//! Constructor
+	CWorkerLock();
+
+	//! Destructor
+	~CWorkerLock();
+
+	void lock();
+	void unlock();
+
+	//! Unlocks, blocks until notify() is called, and locks again.
+	/** May also return without notify(), so the condition has to be checked again. */
+	void wait();
+
+	//! Wakes up all threads which wait.
+	void notify();
+
+private:
+
+	SWorkerSync* Sync;
+};
+
+} // end namespace irr
+
+#endif
+
@@ -26,6 +26,13 @@ namespace irr
 namespace scene
 {
 
+//! checks if a byte can be part of a number in text files
+static inline bool isNumberCharacter(c8 c)
+{
+	return core::isdigit(c) || c=='.' || c=='-' || c=='+' || c=='e' || c=='E';
+}
+
+
 //! Constructor
 CXMeshFileLoader::CXMeshFileLoader(scene::ISceneManager* smgr, io::IFileSystem* fs)
 : SceneManager(smgr), FileSystem(fs), AllJoints(0), AnimatedMesh(0),
@@ -396,26 +403,38 @@ bool CXMeshFileLoader::load(io::IReadFile* file)
 bool CXMeshFileLoader::readFileIntoMemory(io::IReadFile* file)
 {
 	const long size = file->getSize();
-	if (size < 12)
+	if (size < 16)
 	{
 		os::Printer::log("X File is too small.", ELL_WARNING);
 		return false;
 	}
 
-	Buffer = new c8[size];
+	// Numbers in text files are parsed up to the first byte which doesn't
+	// belong to them. So files in memory are only parsed directly when they
+	// don't end with a number, the others are copied and terminated.
+	const c8* data = (const c8*)file->getBuffer();
+	if (data && isNumberCharacter(data[size-1]))
+		data = 0;
 
-	//! read all into memory
-	if (file->read(Buffer, size) != size)
+	if (!data)
 	{
-		os::Printer::log("Could not read from x file.", ELL_WARNING);
-		return false;
+		Buffer = new c8[size+1];
+
+		//! read all into memory
+		if (file->read(Buffer, size) != size)
+		{
+			os::Printer::log("Could not read from x file.", ELL_WARNING);
+			return false;
+		}
+		Buffer[size] = 0;
+		data = Buffer;
 	}
 
 	Line = 1;
-	End = Buffer + size;
+	End = data + size;
 
 	//! check header "xof "
-	if (strncmp(Buffer, "xof ", 4)!=0)
+	if (strncmp(data, "xof ", 4)!=0)
 	{
 		os::Printer::log("Not an x file, wrong header.", ELL_WARNING);
 		return false;
@@ -423,19 +442,19 @@ bool CXMeshFileLoader::readFileIntoMemory(io::IReadFile* file)
 
 	//! read minor and major version, e.g. 0302 or 0303
 	c8 tmp[3];
-	tmp[0] = Buffer[4];
-	tmp[1] = Buffer[5];
+	tmp[0] = data[4];
+	tmp[1] = data[5];
 	tmp[2] = 0x0;
 	MajorVersion = core::strtoul10(tmp);
 
-	tmp[0] = Buffer[6];
-	tmp[1] = Buffer[7];
+	tmp[0] = data[6];
+	tmp[1] = data[7];
 	MinorVersion = core::strtoul10(tmp);
 
 	//! read format
-	if (strncmp(&Buffer[8], "txt ", 4) ==0)
+	if (strncmp(&data[8], "txt ", 4) ==0)
 		BinaryFormat = false;
-	else if (strncmp(&Buffer[8], "bin ", 4) ==0)
+	else if (strncmp(&data[8], "bin ", 4) ==0)
 		BinaryFormat = true;
 	else
 	{
@@ -445,9 +464,9 @@ bool CXMeshFileLoader::readFileIntoMemory(io::IReadFile* file)
 	BinaryNumCount=0;
 
 	//! read float size
-	if (strncmp(&Buffer[12], "0032", 4) ==0)
+	if (strncmp(&data[12], "0032", 4) ==0)
 		FloatSize = 4;
-	else if (strncmp(&Buffer[12], "0064", 4) ==0)
+	else if (strncmp(&data[12], "0064", 4) ==0)
 		FloatSize = 8;
 	else
 	{
@@ -455,7 +474,7 @@ bool CXMeshFileLoader::readFileIntoMemory(io::IReadFile* file)
 		return false;
 	}
 
-	P = &Buffer[16];
+	P = &data[16];
 
 	readUntilEndOfLine();
 	FilePath = FileSystem->getFileDir(file->getFileName()) + "/";
@@ -1420,7 +1439,7 @@ bool CXMeshFileLoader::parseDataObjectMeshMaterialList(SXMesh &mesh)
 	// commented out version check, as version 03.03 exported from blender also has 2 semicolons
 	if (!BinaryFormat) // && MajorVersion == 3 && MinorVersion <= 2)
 	{
-		if (P[0] == ';')
+		if (P < End && P[0] == ';')
 			++P;
 	}
 
@@ -2064,13 +2083,13 @@ core::stringc CXMeshFileLoader::getNextToken()
 		switch (tok) {
 			case 1:
 				// name token
-				len = readBinDWord();
+				len = core::min_(readBinDWord(), (u32)(End-P));
 				s = core::stringc(P, len);
 				P += len;
 				return s;
 			case 2:
 				// string token
-				len = readBinDWord();
+				len = core::min_(readBinDWord(), (u32)(End-P));
 				s = core::stringc(P, len);
 				P += (len + 2);
 				return s;
@@ -2181,7 +2200,7 @@ void CXMeshFileLoader::findNextNoneWhiteSpaceNumber()
 		!( core::isdigit(P[0])))
 	{
 		// check if this is a comment
-		if ((P[0] == '/' && P[1] == '/') || P[0] == '#')
+		if ((P[0] == '/' && P+1 < End && P[1] == '/') || P[0] == '#')
 			readUntilEndOfLine();
 		else
 			++P;
@@ -2208,7 +2227,7 @@ void CXMeshFileLoader::findNextNoneWhiteSpace()
 			return;
 
 		// check if this is a comment
-		if ((P[0] == '/' && P[1] == '/') ||
+		if ((P[0] == '/' && P+1 < End && P[1] == '/') ||
 			P[0] == '#')
 			readUntilEndOfLine();
 		else
@@ -2240,7 +2259,7 @@ bool CXMeshFileLoader::getNextTokenAsString(core::stringc& out)
 		++P;
 	}
 
-	if ( P[1] != ';' || P[0] != '"')
+	if (P+1 >= End || P[0] != '"' || P[1] != ';')
 		return false;
 	P+=2;
 
@@ -2269,8 +2288,11 @@ void CXMeshFileLoader::readUntilEndOfLine()
 
 u16 CXMeshFileLoader::readBinWord()
 {
-	if (P>=End)
+	if (P+2>End)
+	{
+		P = End;
 		return 0;
+	}
 #ifdef __BIG_ENDIAN__
 	const u16 tmp = os::Byteswap::byteswap(*(u16 *)P);
 #else
@@ -2283,8 +2305,11 @@ u16 CXMeshFileLoader::readBinWord()
 
 u32 CXMeshFileLoader::readBinDWord()
 {
-	if (P>=End)
+	if (P+4>End)
+	{
+		P = End;
 		return 0;
+	}
 #ifdef __BIG_ENDIAN__
 	const u32 tmp = os::Byteswap::byteswap(*(u32 *)P);
 #else
@@ -2313,6 +2338,8 @@ u32 CXMeshFileLoader::readInt()
 	else
 	{
 		findNextNoneWhiteSpaceNumber();
+		if (P >= End)
+			return 0;
 		return core::strtoul10(P, &P);
 	}
 }
@@ -2331,6 +2358,11 @@ f32 CXMeshFileLoader::readFloat()
 				BinaryNumCount = 1; // single int
 		}
 		--BinaryNumCount;
+		if (P+FloatSize>End)
+		{
+			P = End;
+			return 0.f;
+		}
 		if (FloatSize == 8)
 		{
 #ifdef __BIG_ENDIAN__
@@ -2357,6 +2389,8 @@ f32 CXMeshFileLoader::readFloat()
 		}
 	}
 	findNextNoneWhiteSpaceNumber();
+	if (P >= End)
+		return 0.f;
 	f32 ftmp;
 	P = core::fast_atof_move(P, ftmp);
 	return ftmp;
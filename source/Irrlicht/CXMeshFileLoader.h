@@ -39,6 +39,9 @@ public:
 	//! See IReferenceCounted::drop() for more information.
 	virtual IAnimatedMesh* createMesh(io::IReadFile* file);
 
+	//! Returns true if createMesh() may be called on a background thread.
+	virtual bool canLoadInBackground() const { return true; }
+
 	struct SXTemplateMaterial
 	{
 		core::stringc Name; // template name from Xfile
@@ -174,7 +177,7 @@ private:
 
 	c8* Buffer;
 	const c8* P;
-	c8* End;
+	const c8* End;
 	// counter for number arrays in binary format
 	u32 BinaryNumCount;
 	u32 Line;
@@ -17,6 +17,7 @@ extern "C" void bz_internal_error(int errorCode)
 #include "CFileList.h"
 #include "CReadFile.h"
 #include "coreutil.h"
+#include "CWorkerPool.h"
 
 #include "IrrCompileConfig.h"
 #ifdef _IRR_COMPILE_WITH_ZLIB_
@@ -137,8 +138,17 @@ bool CArchiveLoaderZIP::isALoadableFileFormat(io::IReadFile* file) const
 // zip archive
 // -----------------------------------------------------------------------------
 
+#ifdef _IRR_COMPILE_WITH_THREADS_
+//! worker threads shared by the zip readers for createAndOpenFiles()
+static CWorkerPool* DecompressionPool = 0;
+
+//! archives can also be read on the thread of the async loader
+static CWorkerLock DecompressionPoolLock;
+#endif
+
 CZipReader::CZipReader(IFileSystem* fs, IReadFile* file, bool ignoreCase, bool ignorePaths, bool isGZip)
- : CFileList((file ? file->getFileName() : io::path("")), ignoreCase, ignorePaths), FileSystem(fs), File(file), IsGZip(isGZip)
+ : CFileList((file ? file->getFileName() : io::path("")), ignoreCase, ignorePaths), FileSystem(fs), File(file), CacheSize(0), CachedBytes(0), IsGZip(isGZip),
+	UsesDecompressionPool(false)
 {
 	#ifdef _DEBUG
 	setDebugName("CZipReader");
@@ -160,6 +170,18 @@ CZipReader::CZipReader(IFileSystem* fs, IReadFile* file, bool ignoreCase, bool i
 
 CZipReader::~CZipReader()
 {
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	if (UsesDecompressionPool)
+	{
+		DecompressionPoolLock.lock();
+		if (DecompressionPool->drop())
+			DecompressionPool = 0;
+		DecompressionPoolLock.unlock();
+	}
+#endif
+
+	shrinkCache(0);
+
 	if (File)
 		File->drop();
 }
@@ -488,16 +510,157 @@ IReadFile* CZipReader::createAndOpenFile(const io::path& filename)
 	return 0;
 }
 
-#ifdef _IRR_COMPILE_WITH_LZMA_
-//! Used for LZMA decompression. The lib has no default memory management
 namespace
 {
+#ifdef _IRR_COMPILE_WITH_LZMA_
+	//! Used for LZMA decompression. The lib has no default memory management
 	void *SzAlloc(void *p, size_t size) { p = p; return malloc(size); }
 	void SzFree(void *p, void *address) { p = p; free(address); }
 	ISzAlloc lzmaAlloc = { SzAlloc, SzFree };
-}
 #endif
 
+	//! checks if the compression method can be decompressed, logs if not
+	bool isDecompressionSupported(s16 method)
+	{
+		switch(method)
+		{
+		case 8:
+			#ifdef _IRR_COMPILE_WITH_ZLIB_
+			return true;
+			#else
+			return false; // zlib not compiled, we cannot decompress the data.
+			#endif
+		case 12:
+			#ifdef _IRR_COMPILE_WITH_BZIP2_
+			return true;
+			#else
+			os::Printer::log("bzip2 decompression not supported. File cannot be read.", ELL_ERROR);
+			return false;
+			#endif
+		case 14:
+			#ifdef _IRR_COMPILE_WITH_LZMA_
+			return true;
+			#else
+			os::Printer::log("lzma decompression not supported. File cannot be read.", ELL_ERROR);
+			return false;
+			#endif
+		default:
+			return false;
+		}
+	}
+
+	//! decompresses the data of a file, used by several threads at once
+	/** \param size Size of dest, receives the decompressed size. */
+	bool decompressData(s16 method, s16 generalBitFlag, u8* source, u32 sourceSize, c8* dest, u32& size)
+	{
+		switch(method)
+		{
+		#ifdef _IRR_COMPILE_WITH_ZLIB_
+		case 8:
+			{
+				// Setup the inflate stream.
+				z_stream stream;
+				memset(&stream, 0, sizeof(z_stream));
+				stream.next_in = (Bytef*)source;
+				stream.avail_in = (uInt)sourceSize;
+				stream.next_out = (Bytef*)dest;
+				stream.avail_out = size;
+
+				// Perform inflation. wbits < 0 indicates no zlib header inside the data.
+				if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+					return false;
+
+				// incomplete data is accepted
+				inflate(&stream, Z_FINISH);
+				inflateEnd(&stream);
+				return true;
+			}
+		#endif
+		#ifdef _IRR_COMPILE_WITH_BZIP2_
+		case 12:
+			{
+				bz_stream bz_ctx={0};
+				/* use BZIP2's default memory allocation
+				bz_ctx->bzalloc = NULL;
+				bz_ctx->bzfree  = NULL;
+				bz_ctx->opaque  = NULL;
+				*/
+				if (BZ2_bzDecompressInit(&bz_ctx, 0, 0) != BZ_OK) /* decompression */
+					return false;
+				bz_ctx.next_in = (char*)source;
+				bz_ctx.avail_in = sourceSize;
+				/* pass all input to decompressor */
+				bz_ctx.next_out = dest;
+				bz_ctx.avail_out = size;
+				BZ2_bzDecompress(&bz_ctx);
+				return BZ2_bzDecompressEnd(&bz_ctx) == BZ_OK;
+			}
+		#endif
+		#ifdef _IRR_COMPILE_WITH_LZMA_
+		case 14:
+			{
+				if (sourceSize < 4)
+					return false;
+
+				ELzmaStatus status;
+				SizeT tmpDstSize = size;
+				SizeT tmpSrcSize = sourceSize;
+
+				unsigned int propSize = (source[3]<<8)+source[2];
+				int err = LzmaDecode((Byte*)dest, &tmpDstSize,
+						source+4+propSize, &tmpSrcSize,
+						source+4, propSize,
+						generalBitFlag&0x1?LZMA_FINISH_END:LZMA_FINISH_ANY, &status,
+						&lzmaAlloc);
+				size = tmpDstSize; // may be different to expected value
+				return err == SZ_OK;
+			}
+		#endif
+		default:
+			return false;
+		}
+	}
+
+	//! a file of createAndOpenFiles()
+	struct SZipDecompression
+	{
+		u32 Slot;
+		u32 Index;
+		s16 Method;
+		s16 GeneralBitFlag;
+		u8* Source;
+		u32 SourceSize;
+		c8* Data;
+		u32 Size;
+		bool Success;
+	};
+
+	//! decompresses the files of createAndOpenFiles() on several threads
+	class CZipDecompressionJob : public IWorkerJob
+	{
+	public:
+		CZipDecompressionJob(core::array<SZipDecompression>& items) : Items(items) {}
+
+		virtual void execute(u32 item, u32 thread)
+		{
+			SZipDecompression& d = Items[item];
+			d.Success = decompressData(d.Method, d.GeneralBitFlag, d.Source, d.SourceSize, d.Data, d.Size);
+		}
+
+		core::array<SZipDecompression>& Items;
+	};
+
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+	// deflated files of this size and more are decompressed while they are read
+	const u32 ZIP_STREAM_MIN_SIZE = 65536;
+	// seeking backwards to this position restarts the decompression
+	const u32 ZIP_STREAM_RESTART_SIZE = 65536;
+	// compressed bytes which are read from the archive at once
+	const u32 ZIP_STREAM_INPUT_SIZE = 16384;
+#endif
+} // end anonymous namespace
+
+
 //! opens a file by index
 IReadFile* CZipReader::createAndOpenFile(u32 index)
 {
@@ -613,226 +776,419 @@ IReadFile* CZipReader::createAndOpenFile(u32 index)
 				return createLimitReadFile(Files[index].FullName, File, e.Offset, decryptedSize);
 		}
 	case 8:
+	case 12:
+	case 14:
 		{
-  			#ifdef _IRR_COMPILE_WITH_ZLIB_
+			// the cache only has files which are not encrypted
+			if (!decrypted)
+			{
+				IReadFile* cached = openCachedFile(index);
+				if (cached)
+					return cached;
+			}
 
-			const u32 uncompressedSize = e.header.DataDescriptor.UncompressedSize;
-			c8* pBuf = new c8[ uncompressedSize ];
-			if (!pBuf)
+			if (!isDecompressionSupported(actualCompressionMethod))
 			{
-				swprintf ( buf, 64, L"Not enough memory for decompressing %s", Files[index].FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
 				if (decrypted)
 					decrypted->drop();
 				return 0;
 			}
 
-			u8 *pcData = decryptedBuf;
-			if (!pcData)
-			{
-				pcData = new u8[decryptedSize];
-				if (!pcData)
-				{
-					swprintf ( buf, 64, L"Not enough memory for decompressing %s", Files[index].FullName.c_str() );
-					os::Printer::log( buf, ELL_ERROR);
-					delete [] pBuf;
-					return 0;
-				}
-
-				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
-			}
-
-			// Setup the inflate stream.
-			z_stream stream;
-			s32 err;
-
-			stream.next_in = (Bytef*)pcData;
-			stream.avail_in = (uInt)decryptedSize;
-			stream.next_out = (Bytef*)pBuf;
-			stream.avail_out = uncompressedSize;
-			stream.zalloc = (alloc_func)0;
-			stream.zfree = (free_func)0;
+			u32 uncompressedSize = e.header.DataDescriptor.UncompressedSize;
 
-			// Perform inflation. wbits < 0 indicates no zlib header inside the data.
-			err = inflateInit2(&stream, -MAX_WBITS);
-			if (err == Z_OK)
+			#ifdef _IRR_COMPILE_WITH_ZLIB_
+			if (actualCompressionMethod == 8 && !decrypted &&
+				uncompressedSize >= ZIP_STREAM_MIN_SIZE && uncompressedSize > CacheSize)
 			{
-				err = inflate(&stream, Z_FINISH);
-				inflateEnd(&stream);
-				if (err == Z_STREAM_END)
-					err = Z_OK;
-				err = Z_OK;
-				inflateEnd(&stream);
-			}
-
-			if (decrypted)
-				decrypted->drop();
-			else
-				delete[] pcData;
+				CZipStreamReadFile* stream = new CZipStreamReadFile(Files[index].FullName, File, e.Offset, decryptedSize, uncompressedSize);
+				if (stream->isValid())
+					return stream;
 
-			if (err != Z_OK)
-			{
-				swprintf ( buf, 64, L"Error decompressing %s", Files[index].FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
-				delete [] pBuf;
-				return 0;
+				// decompressed at once below, which reports the error
+				stream->drop();
 			}
-			else
-				return FileSystem->createMemoryReadFile(pBuf, uncompressedSize, Files[index].FullName, true);
-
-			#else
-			return 0; // zlib not compiled, we cannot decompress the data.
 			#endif
-		}
-	case 12:
-		{
-  			#ifdef _IRR_COMPILE_WITH_BZIP2_
 
-			const u32 uncompressedSize = e.header.DataDescriptor.UncompressedSize;
 			c8* pBuf = new c8[ uncompressedSize ];
-			if (!pBuf)
-			{
-				swprintf ( buf, 64, L"Not enough memory for decompressing %s", Files[index].FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
-				if (decrypted)
-					decrypted->drop();
-				return 0;
-			}
 
 			u8 *pcData = decryptedBuf;
 			if (!pcData)
 			{
 				pcData = new u8[decryptedSize];
-				if (!pcData)
-				{
-					swprintf ( buf, 64, L"Not enough memory for decompressing %s", Files[index].FullName.c_str() );
-					os::Printer::log( buf, ELL_ERROR);
-					delete [] pBuf;
-					return 0;
-				}
 
-				//memset(pcData, 0, decryptedSize);
 				File->seek(e.Offset);
 				File->read(pcData, decryptedSize);
 			}
 
-			bz_stream bz_ctx={0};
-			/* use BZIP2's default memory allocation
-			bz_ctx->bzalloc = NULL;
-			bz_ctx->bzfree  = NULL;
-			bz_ctx->opaque  = NULL;
-			*/
-			int err = BZ2_bzDecompressInit(&bz_ctx, 0, 0); /* decompression */
-			if(err != BZ_OK)
-			{
-				os::Printer::log("bzip2 decompression failed. File cannot be read.", ELL_ERROR);
-				return 0;
-			}
-			bz_ctx.next_in = (char*)pcData;
-			bz_ctx.avail_in = decryptedSize;
-			/* pass all input to decompressor */
-			bz_ctx.next_out = pBuf;
-			bz_ctx.avail_out = uncompressedSize;
-			err = BZ2_bzDecompress(&bz_ctx);
-			err = BZ2_bzDecompressEnd(&bz_ctx);
+			const bool success = decompressData(actualCompressionMethod, e.header.GeneralBitFlag,
+					pcData, decryptedSize, pBuf, uncompressedSize);
 
 			if (decrypted)
 				decrypted->drop();
 			else
 				delete[] pcData;
 
-			if (err != BZ_OK)
+			if (!success)
 			{
-				swprintf ( buf, 64, L"Error decompressing %s", Files[index].FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
+				os::Printer::log("Error decompressing", Files[index].FullName, ELL_ERROR);
 				delete [] pBuf;
 				return 0;
 			}
+
+			return createDecompressedFile(index, pBuf, uncompressedSize, !decrypted);
+		}
+	case 99:
+		// If we come here with an encrypted file, decryption support is missing
+		os::Printer::log("Decryption support not enabled. File cannot be read.", ELL_ERROR);
+		return 0;
+	default:
+		swprintf ( buf, 64, L"file has unsupported compression method. %s", Files[index].FullName.c_str() );
+		os::Printer::log( buf, ELL_ERROR);
+		return 0;
+	};
+
+}
+
+
+//! opens several files by index, decompresses them on several threads
+void CZipReader::createAndOpenFiles(const core::array<u32>& indices, core::array<IReadFile*>& files)
+{
+	files.set_used(indices.size());
+
+	// the compressed data is read first, as all files share the archive file
+	core::array<SZipDecompression> items;
+	for (u32 i=0; i<indices.size(); ++i)
+	{
+		const u32 index = indices[i];
+		const SZipFileEntry &e = FileInfo[Files[index].ID];
+		const s16 method = e.header.CompressionMethod;
+
+		files[i] = openCachedFile(index);
+		if (files[i])
+			continue;
+
+		if (method == 0 || (e.header.GeneralBitFlag & ZIP_FILE_ENCRYPTED) ||
+			(method != 8 && method != 12 && method != 14))
+		{
+			files[i] = createAndOpenFile(index);
+			continue;
+		}
+
+		if (!isDecompressionSupported(method))
+			continue;
+
+		SZipDecompression item;
+		item.Slot = i;
+		item.Index = index;
+		item.Method = method;
+		item.GeneralBitFlag = e.header.GeneralBitFlag;
+		item.SourceSize = e.header.DataDescriptor.CompressedSize;
+		item.Source = new u8[item.SourceSize];
+		item.Size = e.header.DataDescriptor.UncompressedSize;
+		item.Data = new c8[item.Size];
+		item.Success = false;
+
+		File->seek(e.Offset);
+		File->read(item.Source, item.SourceSize);
+		items.push_back(item);
+	}
+
+	CZipDecompressionJob job(items);
+#ifdef _IRR_COMPILE_WITH_THREADS_
+	if (items.size() > 1 && CWorkerPool::getProcessorCount() > 1)
+	{
+		// the threads stay around for the next batch of this or another archive
+		DecompressionPoolLock.lock();
+		if (!UsesDecompressionPool)
+		{
+			if (DecompressionPool)
+				DecompressionPool->grab();
 			else
-				return FileSystem->createMemoryReadFile(pBuf, uncompressedSize, Files[index].FullName, true);
+				DecompressionPool = new CWorkerPool();
+			UsesDecompressionPool = true;
+		}
 
-			#else
-			os::Printer::log("bzip2 decompression not supported. File cannot be read.", ELL_ERROR);
-			return 0;
-			#endif
+		DecompressionPool->run(&job, items.size());
+		DecompressionPoolLock.unlock();
+	}
+	else
+#endif
+	{
+		for (u32 i=0; i<items.size(); ++i)
+			job.execute(i, 0);
+	}
+
+	for (u32 i=0; i<items.size(); ++i)
+	{
+		delete [] items[i].Source;
+
+		if (items[i].Success)
+			files[items[i].Slot] = createDecompressedFile(items[i].Index, items[i].Data, items[i].Size, true);
+		else
+		{
+			os::Printer::log("Error decompressing", Files[items[i].Index].FullName, ELL_ERROR);
+			delete [] items[i].Data;
 		}
-	case 14:
+	}
+}
+
+
+//! sets the size of the cache for decompressed files
+void CZipReader::setCacheSize(u32 bytes)
+{
+	CacheSize = bytes;
+	shrinkCache(CacheSize);
+}
+
+
+//! opens a file of the cache, returns 0 if it's not cached
+IReadFile* CZipReader::openCachedFile(u32 index)
+{
+	for (u32 i=0; i<Cache.size(); ++i)
+	{
+		if (Cache[i].Index == index)
 		{
-  			#ifdef _IRR_COMPILE_WITH_LZMA_
+			const SCachedFile cached = Cache[i];
+			Cache.erase(i);
+			Cache.push_back(cached);
 
-			u32 uncompressedSize = e.header.DataDescriptor.UncompressedSize;
-			c8* pBuf = new c8[ uncompressedSize ];
-			if (!pBuf)
-			{
-				swprintf ( buf, 64, L"Not enough memory for decompressing %s", Files[index].FullName.c_str() );
-				os::Printer::log( buf, ELL_ERROR);
-				if (decrypted)
-					decrypted->drop();
-				return 0;
-			}
+			// the files share the memory, the cache may drop it before them
+			return createLimitReadFile(Files[index].FullName, cached.File, 0, cached.File->getSize());
+		}
+	}
 
-			u8 *pcData = decryptedBuf;
-			if (!pcData)
-			{
-				pcData = new u8[decryptedSize];
-				if (!pcData)
-				{
-					swprintf ( buf, 64, L"Not enough memory for decompressing %s", Files[index].FullName.c_str() );
-					os::Printer::log( buf, ELL_ERROR);
-					delete [] pBuf;
-					return 0;
-				}
+	return 0;
+}
 
-				//memset(pcData, 0, decryptedSize);
-				File->seek(e.Offset);
-				File->read(pcData, decryptedSize);
-			}
 
-			ELzmaStatus status;
-			SizeT tmpDstSize = uncompressedSize;
-			SizeT tmpSrcSize = decryptedSize;
+//! creates a file for decompressed data, and keeps it in the cache if allowed
+IReadFile* CZipReader::createDecompressedFile(u32 index, c8* data, u32 size, bool cache)
+{
+	if (!cache || size > CacheSize)
+		return FileSystem->createMemoryReadFile(data, size, Files[index].FullName, true);
+
+	// opened several times at once
+	IReadFile* file = openCachedFile(index);
+	if (file)
+	{
+		delete [] data;
+		return file;
+	}
 
-			unsigned int propSize = (pcData[3]<<8)+pcData[2];
-			int err = LzmaDecode((Byte*)pBuf, &tmpDstSize,
-					pcData+4+propSize, &tmpSrcSize,
-					pcData+4, propSize,
-					e.header.GeneralBitFlag&0x1?LZMA_FINISH_END:LZMA_FINISH_ANY, &status,
-					&lzmaAlloc);
-			uncompressedSize = tmpDstSize; // may be different to expected value
+	shrinkCache(CacheSize - size);
 
-			if (decrypted)
-				decrypted->drop();
-			else
-				delete[] pcData;
+	SCachedFile cached;
+	cached.Index = index;
+	cached.File = FileSystem->createMemoryReadFile(data, size, Files[index].FullName, true);
+	Cache.push_back(cached);
+	CachedBytes += size;
+
+	return createLimitReadFile(Files[index].FullName, cached.File, 0, size);
+}
+
+
+//! removes the files which were not opened for the longest time from the cache
+void CZipReader::shrinkCache(u32 bytes)
+{
+	u32 count = 0;
+	while (count < Cache.size() && CachedBytes > bytes)
+	{
+		CachedBytes -= Cache[count].File->getSize();
+		Cache[count].File->drop();
+		++count;
+	}
+
+	if (count)
+		Cache.erase(0, count);
+}
+
+
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+
+struct SInflateStream
+{
+	z_stream Stream;
+	u8 Input[ZIP_STREAM_INPUT_SIZE];
+};
+
+
+//! constructor
+CZipStreamReadFile::CZipStreamReadFile(const io::path& fileName, IReadFile* archive, long offset,
+		u32 compressedSize, u32 size)
+: File(archive), Filename(fileName), Offset(offset), CompressedSize(compressedSize),
+	CompressedPos(0), Size(size), Pos(0), Stream(new SInflateStream), Buffer(0)
+{
+	#ifdef _DEBUG
+	setDebugName("CZipStreamReadFile");
+	#endif
+
+	File->grab();
 
-			if (err != SZ_OK)
+	// wbits < 0 indicates no zlib header inside the data.
+	memset(&Stream->Stream, 0, sizeof(z_stream));
+	if (inflateInit2(&Stream->Stream, -MAX_WBITS) != Z_OK)
+	{
+		delete Stream;
+		Stream = 0;
+	}
+}
+
+
+//! destructor
+CZipStreamReadFile::~CZipStreamReadFile()
+{
+	if (Stream)
+	{
+		inflateEnd(&Stream->Stream);
+		delete Stream;
+	}
+
+	delete [] Buffer;
+	File->drop();
+}
+
+
+//! returns how much was read
+s32 CZipStreamReadFile::read(void* buffer, u32 sizeToRead)
+{
+	const u32 amount = core::min_(sizeToRead, Size - Pos);
+
+	if (Buffer)
+	{
+		memcpy(buffer, Buffer + Pos, amount);
+		Pos += amount;
+		return (s32)amount;
+	}
+
+	return (s32)decompress(buffer, amount);
+}
+
+
+//! changes position in file, returns true if successful
+bool CZipStreamReadFile::seek(long finalPos, bool relativeMovement)
+{
+	if (relativeMovement)
+		finalPos += Pos;
+
+	if (finalPos < 0 || finalPos > (long)Size)
+		return false;
+
+	if (!Buffer && (u32)finalPos < Pos)
+	{
+		restart();
+
+		// loaders which jump around get the whole file
+		if (finalPos > (long)ZIP_STREAM_RESTART_SIZE)
+		{
+			Buffer = new c8[Size];
+			const u32 done = decompress(Buffer, Size);
+			memset(Buffer + done, 0, Size - done);
+
+			if (Stream)
 			{
-				os::Printer::log( "Error decompressing", Files[index].FullName, ELL_ERROR);
-				delete [] pBuf;
-				return 0;
+				inflateEnd(&Stream->Stream);
+				delete Stream;
+				Stream = 0;
 			}
-			else
-				return FileSystem->createMemoryReadFile(pBuf, uncompressedSize, Files[index].FullName, true);
-
-			#else
-			os::Printer::log("lzma decompression not supported. File cannot be read.", ELL_ERROR);
-			return 0;
-			#endif
 		}
-	case 99:
-		// If we come here with an encrypted file, decryption support is missing
-		os::Printer::log("Decryption support not enabled. File cannot be read.", ELL_ERROR);
-		return 0;
-	default:
-		swprintf ( buf, 64, L"file has unsupported compression method. %s", Files[index].FullName.c_str() );
-		os::Printer::log( buf, ELL_ERROR);
+	}
+
+	if (Buffer)
+	{
+		Pos = finalPos;
+		return true;
+	}
+
+	c8 skipped[4096];
+	while (Pos < (u32)finalPos)
+	{
+		if (!decompress(skipped, core::min_((u32)sizeof(skipped), (u32)finalPos - Pos)))
+			return false;
+	}
+
+	return true;
+}
+
+
+//! returns size of file
+long CZipStreamReadFile::getSize() const
+{
+	return Size;
+}
+
+
+//! returns where in the file we are.
+long CZipStreamReadFile::getPos() const
+{
+	return Pos;
+}
+
+
+//! returns name of file
+const io::path& CZipStreamReadFile::getFileName() const
+{
+	return Filename;
+}
+
+
+//! returns the contents of the file, once they were decompressed into a buffer
+const void* CZipStreamReadFile::getBuffer() const
+{
+	return Buffer;
+}
+
+
+//! decompresses the next bytes, returns how many
+u32 CZipStreamReadFile::decompress(void* buffer, u32 size)
+{
+	if (!Stream || !size)
 		return 0;
-	};
 
+	z_stream& stream = Stream->Stream;
+	stream.next_out = (Bytef*)buffer;
+	stream.avail_out = size;
+
+	while (stream.avail_out)
+	{
+		if (!stream.avail_in && CompressedPos < CompressedSize)
+		{
+			// other files of the archive move the position of the archive
+			File->seek(Offset + CompressedPos);
+			const s32 r = File->read(Stream->Input, core::min_(ZIP_STREAM_INPUT_SIZE, CompressedSize - CompressedPos));
+			if (r <= 0)
+				break;
+
+			stream.next_in = Stream->Input;
+			stream.avail_in = r;
+			CompressedPos += r;
+		}
+
+		// stops at the end of the data, on errors and without progress
+		if (inflate(&stream, Z_NO_FLUSH) != Z_OK)
+			break;
+	}
+
+	const u32 done = size - stream.avail_out;
+	Pos += done;
+	return done;
 }
 
+
+//! starts the decompression at the beginning of the file again
+void CZipStreamReadFile::restart()
+{
+	if (Stream)
+	{
+		inflateReset(&Stream->Stream);
+		Stream->Stream.avail_in = 0;
+	}
+
+	CompressedPos = 0;
+	Pos = 0;
+}
+
+#endif // _IRR_COMPILE_WITH_ZLIB_
+
 } // end namespace io
 } // end namespace irr
 
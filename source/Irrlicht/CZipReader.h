@@ -135,6 +135,66 @@ namespace io
 		SZIPFileHeader header;
 	};
 
+#ifdef _IRR_COMPILE_WITH_ZLIB_
+	struct SInflateStream;
+
+	//! Reads a deflated file of a zip archive, decompressing it while it's read
+	/** Large files don't need a buffer for the whole decompressed file
+	this way. Seeking back near the beginning of the file restarts the
+	decompression, seeking back further decompresses the whole file into
+	a buffer. */
+	class CZipStreamReadFile : public IReadFile
+	{
+	public:
+
+		//! constructor
+		CZipStreamReadFile(const io::path& fileName, IReadFile* archive, long offset,
+				u32 compressedSize, u32 size);
+
+		//! destructor
+		virtual ~CZipStreamReadFile();
+
+		//! returns how much was read
+		virtual s32 read(void* buffer, u32 sizeToRead);
+
+		//! changes position in file, returns true if successful
+		virtual bool seek(long finalPos, bool relativeMovement = false);
+
+		//! returns size of file
+		virtual long getSize() const;
+
+		//! returns where in the file we are.
+		virtual long getPos() const;
+
+		//! returns name of file
+		virtual const io::path& getFileName() const;
+
+		//! returns the contents of the file, once they were decompressed into a buffer
+		virtual const void* getBuffer() const;
+
+		//! returns false if the decompression could not be started
+		bool isValid() const { return Stream != 0; }
+
+	private:
+
+		//! decompresses the next bytes, returns how many
+		u32 decompress(void* buffer, u32 size);
+
+		//! starts the decompression at the beginning of the file again
+		void restart();
+
+		IReadFile* File;
+		io::path Filename;
+		long Offset;
+		u32 CompressedSize;
+		u32 CompressedPos;
+		u32 Size;
+		u32 Pos;
+		SInflateStream* Stream;
+		c8* Buffer;
+	};
+#endif
+
 	//! Archiveloader capable of loading ZIP Archives
 	class CArchiveLoaderZIP : public IArchiveLoader
 	{
@@ -191,12 +251,21 @@ namespace io
 		//! opens a file by index
 		virtual IReadFile* createAndOpenFile(u32 index);
 
+		//! opens several files by index, decompresses them on several threads
+		virtual void createAndOpenFiles(const core::array<u32>& indices, core::array<IReadFile*>& files);
+
 		//! returns the list of files
 		virtual const IFileList* getFileList() const;
 
+		//! Check if files are opened by looking them up in the file list
+		virtual bool opensFilesByFileList() const { return true; }
+
 		//! get the archive type
 		virtual E_FILE_ARCHIVE_TYPE getType() const;
 
+		//! sets the size of the cache for decompressed files
+		virtual void setCacheSize(u32 bytes);
+
 	protected:
 
 		//! reads the next file header from a ZIP file, returns false if there are no more headers.
@@ -210,13 +279,36 @@ namespace io
 
 		bool scanCentralDirectoryHeader();
 
+		//! opens a file of the cache, returns 0 if it's not cached
+		IReadFile* openCachedFile(u32 index);
+
+		//! creates a file for decompressed data, and keeps it in the cache if allowed
+		IReadFile* createDecompressedFile(u32 index, c8* data, u32 size, bool cache);
+
+		//! removes the files which were not opened for the longest time from the cache
+		void shrinkCache(u32 bytes);
+
 		io::IFileSystem* FileSystem;
 		IReadFile* File;
 
 		// holds extended info about files
 		core::array<SZipFileEntry> FileInfo;
 
+		struct SCachedFile
+		{
+			u32 Index;
+			IReadFile* File;
+		};
+
+		// decompressed files, the most recently opened last
+		core::array<SCachedFile> Cache;
+		u32 CacheSize;
+		u32 CachedBytes;
+
 		bool IsGZip;
+
+		//! true if this reader holds a reference to the worker threads for decompression
+		bool UsesDecompressionPool;
 	};
 
 
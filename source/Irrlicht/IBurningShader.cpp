@@ -36,6 +36,8 @@ namespace video
 		Driver = driver;
 		RenderTarget = 0;
 		ColorMask = COLOR_BRIGHT_WHITE;
+		BandStart = 0;
+		BandEnd = 0x7FFFFFFF;
 		DepthBuffer = (CDepthBuffer*) driver->getDepthBuffer ();
 		if ( DepthBuffer )
 			DepthBuffer->grab();
@@ -113,6 +115,21 @@ namespace video
 		}
 	}
 
+	//! copies texture samplers prepared by another shader instance
+	void IBurningShader::setTextureSamplers( const sInternalTexture* samplers )
+	{
+		if ( samplers )
+		{
+			for ( u32 i = 0; i != BURNING_MATERIAL_MAX_TEXTURES; ++i )
+				IT[i] = samplers[i];
+		}
+		else
+		{
+			for ( u32 i = 0; i != BURNING_MATERIAL_MAX_TEXTURES; ++i )
+				IT[i].Texture = 0;
+		}
+	}
+
 
 } // end namespace video
 } // end namespace irr
@@ -144,8 +144,21 @@ namespace video
 
 		virtual void setMaterial ( const SBurningShaderMaterial &material ) {};
 
+		//! returns the texture samplers selected by setTextureParam
+		const sInternalTexture* getTextureSamplers () const { return IT; }
+
+		//! copies texture samplers prepared by another shader instance.
+		//! the textures are not grabbed, pass 0 to release them again.
+		void setTextureSamplers ( const sInternalTexture* samplers );
+
+		//! restricts rasterization to the scanlines y0..y1 (inclusive)
+		void setScanlineBand ( s32 y0, s32 y1 ) { BandStart = y0; BandEnd = y1; }
+
 	protected:
 
+		//! true if scanline y lies inside the current band
+		inline bool isScanlineInBand ( s32 y ) const { return y >= BandStart && y <= BandEnd; }
+
 		CBurningVideoDriver *Driver;
 
 		video::CImage* RenderTarget;
@@ -155,6 +168,9 @@ namespace video
 
 		sInternalTexture IT[ BURNING_MATERIAL_MAX_TEXTURES ];
 
+		s32 BandStart;
+		s32 BandEnd;
+
 		static const tFixPointu dithermask[ 4 * 4];
 	};
 
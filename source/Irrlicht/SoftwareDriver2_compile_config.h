@@ -93,6 +93,15 @@
 
 #define SOFTWARE_DRIVER_2_MIPMAPPING_SCALE (8/SOFTWARE_DRIVER_2_MIPMAPPING_MAX)
 
+// transform and clip test four vertices at a time with SSE2 intrinsics
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+	#define SOFTWARE_DRIVER_2_USE_SSE2
+#endif
+
+#ifdef NO_SOFTWARE_DRIVER_2_USE_SSE2
+	#undef SOFTWARE_DRIVER_2_USE_SSE2
+#endif
+
 #ifndef REALINLINE
 	#ifdef _MSC_VER
 		#define REALINLINE __forceinline
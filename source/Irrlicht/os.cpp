@@ -133,6 +133,34 @@ namespace os
 		return GetTickCount();
 	}
 
+	u64 Timer::getRealTimeMicro()
+	{
+		if (HighPerformanceTimerSupport)
+		{
+#if !defined(_WIN32_WCE) && !defined (_IRR_XBOX_PLATFORM_)
+			DWORD_PTR affinityMask=0;
+			if(MultiCore)
+				affinityMask = SetThreadAffinityMask(GetCurrentThread(), 1);
+#endif
+			LARGE_INTEGER nTime;
+			BOOL queriedOK = QueryPerformanceCounter(&nTime);
+
+#if !defined(_WIN32_WCE)  && !defined (_IRR_XBOX_PLATFORM_)
+			if(MultiCore)
+				(void)SetThreadAffinityMask(GetCurrentThread(), affinityMask);
+#endif
+			if(queriedOK)
+			{
+				// split to avoid the overflow of counter * 1000000
+				const u64 freq = HighPerformanceFreq.QuadPart;
+				const u64 count = nTime.QuadPart;
+				return (count / freq) * 1000000 + (count % freq) * 1000000 / freq;
+			}
+		}
+
+		return (u64)GetTickCount() * 1000;
+	}
+
 } // end namespace os
 
 
@@ -188,6 +216,13 @@ namespace os
 		gettimeofday(&tv, 0);
 		return (u32)(tv.tv_sec * 1000) + (tv.tv_usec / 1000);
 	}
+
+	u64 Timer::getRealTimeMicro()
+	{
+		timeval tv;
+		gettimeofday(&tv, 0);
+		return (u64)tv.tv_sec * 1000000 + tv.tv_usec;
+	}
 } // end namespace os
 
 #else
@@ -222,39 +257,71 @@ namespace os
 		gettimeofday(&tv, 0);
 		return (u32)(tv.tv_sec * 1000) + (tv.tv_usec / 1000);
 	}
+
+	u64 Timer::getRealTimeMicro()
+	{
+		timeval tv;
+		gettimeofday(&tv, 0);
+		return (u64)tv.tv_sec * 1000000 + tv.tv_usec;
+	}
 } // end namespace os
 
 #endif // end linux / android / windows
 
 #include <time.h>
 
+#if !defined(_IRR_COMPILE_WITH_THREADS_)
+	#define _IRR_THREAD_LOCAL_
+#elif defined(_MSC_VER)
+	#define _IRR_THREAD_LOCAL_ __declspec(thread)
+#else
+	#define _IRR_THREAD_LOCAL_ __thread
+#endif
+
 namespace os
 {
 	// The platform independent implementation of the printer
 	ILogger* Printer::Logger = 0;
 
+	// set by background threads for themselves
+	static _IRR_THREAD_LOCAL_ ILogger* ThreadLogger = 0;
+
+	void Printer::setThreadLogger(ILogger* logger)
+	{
+		ThreadLogger = logger;
+	}
+
+	ILogger* Printer::getLogger()
+	{
+		return ThreadLogger ? ThreadLogger : Logger;
+	}
+
 	void Printer::log(const c8* message, ELOG_LEVEL ll)
 	{
-		if (Logger)
-			Logger->log(message, ll);
+		ILogger* logger = getLogger();
+		if (logger)
+			logger->log(message, ll);
 	}
 
 	void Printer::log(const wchar_t* message, ELOG_LEVEL ll)
 	{
-		if (Logger)
-			Logger->log(message, ll);
+		ILogger* logger = getLogger();
+		if (logger)
+			logger->log(message, ll);
 	}
 
 	void Printer::log(const c8* message, const c8* hint, ELOG_LEVEL ll)
 	{
-		if (Logger)
-			Logger->log(message, hint, ll);
+		ILogger* logger = getLogger();
+		if (logger)
+			logger->log(message, hint, ll);
 	}
 
 	void Printer::log(const c8* message, const io::path& hint, ELOG_LEVEL ll)
 	{
-		if (Logger)
-			Logger->log(message, hint.c_str(), ll);
+		ILogger* logger = getLogger();
+		if (logger)
+			logger->log(message, hint.c_str(), ll);
 	}
 
 	// our Randomizer is not really os specific, so we
@@ -41,7 +41,17 @@ namespace os
 		static void log(const wchar_t* message, ELOG_LEVEL ll = ELL_INFORMATION);
 		static void log(const c8* message, const c8* hint, ELOG_LEVEL ll = ELL_INFORMATION);
 		static void log(const c8* message, const io::path& hint, ELOG_LEVEL ll = ELL_INFORMATION);
+
+		//! Sets a logger which gets the messages of the calling thread instead of Logger
+		/** Used by background threads which must not call the event receiver, 0 removes it. */
+		static void setThreadLogger(ILogger* logger);
+
 		static ILogger* Logger;
+
+	private:
+
+		//! returns the logger of the calling thread
+		static ILogger* getLogger();
 	};
 
 
@@ -114,6 +124,9 @@ namespace os
 		//! returns the current real time in milliseconds
 		static u32 getRealTime();
 
+		//! returns the current real time in microseconds, for measuring short intervals
+		static u64 getRealTimeMicro();
+
 	private:
 
 		static void initVirtualTimer();
@@ -423,6 +423,442 @@ bool testAddRemove(IFileSystem* fs, const io::path& archiveName)
 
 	return true;
 }
+
+//! opens a file of the archives, content 0 means that no archive has the file
+bool testFileContent(IFileSystem* fs, const char* filename, const char* content)
+{
+	const bool exists = fs->existFile(filename);
+	IReadFile* file = fs->createAndOpenFile(filename);
+
+	if (!content)
+	{
+		if (file)
+			file->drop();
+		if (exists || file)
+		{
+			logTestString("Found %s, which is in no archive\n", filename);
+			return false;
+		}
+		return true;
+	}
+
+	if (!exists || !file)
+	{
+		logTestString("Could not find %s\n", filename);
+		if (file)
+			file->drop();
+		return false;
+	}
+
+	char tmp[16] = {'\0'};
+	file->read(tmp, 15);
+	file->drop();
+	if (strcmp(tmp, content))
+	{
+		logTestString("Read %s instead of %s from %s\n", tmp, content, filename);
+		return false;
+	}
+
+	return true;
+}
+
+bool testArchiveOrder(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	if ( !fs->addFileArchive("media/archive_order1.zip", /*bool ignoreCase=*/true, /*bool ignorePaths=*/false) ||
+		!fs->addFileArchive("media/archive_order2.zip", /*bool ignoreCase=*/true, /*bool ignorePaths=*/false) )
+	{
+		logTestString("Mounting archives failed\n");
+		while (fs->getFileArchiveCount())
+			fs->removeFileArchive(fs->getFileArchiveCount()-1);
+		return false;
+	}
+
+	bool result = true;
+
+	// the archive which was added first is searched first
+	result &= testFileContent(fs, "a.txt", "order1 a");
+	result &= testFileContent(fs, "DIR/B.TXT", "order1 b");
+	result &= testFileContent(fs, "dir\\b.txt", "order1 b");
+	result &= testFileContent(fs, "d.txt", "order2 d");
+	result &= testFileContent(fs, "e.txt", 0);
+
+	// now the second archive is searched first
+	result &= fs->moveFileArchive(1, -1);
+	result &= testFileContent(fs, "a.txt", "order2 a");
+	result &= testFileContent(fs, "dir/b.txt", "order2 b");
+	result &= testFileContent(fs, "c.txt", "order1 c");
+
+	// its files are found in the remaining archive after removing it
+	result &= fs->removeFileArchive((u32)0);
+	result &= testFileContent(fs, "a.txt", "order1 a");
+	result &= testFileContent(fs, "dir/b.txt", "order1 b");
+	result &= testFileContent(fs, "d.txt", 0);
+
+	result &= fs->removeFileArchive((u32)0);
+
+	return result;
+}
+
+bool testArchiveIgnorePaths(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	// only the second archive ignores the paths
+	if ( !fs->addFileArchive("media/archive_order1.zip", /*bool ignoreCase=*/true, /*bool ignorePaths=*/false) ||
+		!fs->addFileArchive("media/archive_order2.zip", /*bool ignoreCase=*/true, /*bool ignorePaths=*/true) )
+	{
+		logTestString("Mounting archives failed\n");
+		while (fs->getFileArchiveCount())
+			fs->removeFileArchive(fs->getFileArchiveCount()-1);
+		return false;
+	}
+
+	bool result = true;
+
+	result &= testFileContent(fs, "a.txt", "order1 a");
+	result &= testFileContent(fs, "dir/b.txt", "order1 b");
+	result &= testFileContent(fs, "b.txt", "order2 b");
+	result &= testFileContent(fs, "other/b.txt", "order2 b");
+	result &= testFileContent(fs, "other/a.txt", "order2 a");
+	result &= testFileContent(fs, "dir/c.txt", "order1 C");
+	result &= testFileContent(fs, "other/c.txt", 0);
+
+	// the archive which ignores the paths is searched first
+	result &= fs->moveFileArchive(1, -1);
+	result &= testFileContent(fs, "a.txt", "order2 a");
+	result &= testFileContent(fs, "dir/b.txt", "order2 b");
+	result &= testFileContent(fs, "dir/c.txt", "order1 C");
+
+	while (fs->getFileArchiveCount())
+		result &= fs->removeFileArchive(fs->getFileArchiveCount()-1);
+
+	return result;
+}
+
+bool testArchiveCase(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	// only the second archive ignores the case
+	if ( !fs->addFileArchive("media/archive_order1.zip", /*bool ignoreCase=*/false, /*bool ignorePaths=*/false) ||
+		!fs->addFileArchive("media/archive_order2.zip", /*bool ignoreCase=*/true, /*bool ignorePaths=*/false) )
+	{
+		logTestString("Mounting archives failed\n");
+		while (fs->getFileArchiveCount())
+			fs->removeFileArchive(fs->getFileArchiveCount()-1);
+		return false;
+	}
+
+	bool result = true;
+
+	// the first archive keeps the names as they are, but finds them with any case
+	const IFileList* fileList = fs->getFileArchive(0)->getFileList();
+	if (fileList->findFile("dir/c.txt") == -1 || fileList->getFullFileName(fileList->findFile("dir/c.txt")) != "dir/C.txt")
+	{
+		logTestString("Case of file name not kept\n");
+		result = false;
+	}
+
+	result &= testFileContent(fs, "dir/C.txt", "order1 C");
+	result &= testFileContent(fs, "DIR/c.TXT", "order1 C");
+	result &= testFileContent(fs, "A.TXT", "order1 a");
+	result &= testFileContent(fs, "d.txt", "order2 d");
+
+	// the archive which keeps the case is searched second
+	result &= fs->moveFileArchive(1, -1);
+	result &= testFileContent(fs, "A.TXT", "order2 a");
+	result &= testFileContent(fs, "Dir/B.txt", "order2 b");
+	result &= testFileContent(fs, "dir/c.txt", "order1 C");
+
+	// and removed
+	result &= fs->removeFileArchive(1);
+	result &= testFileContent(fs, "a.txt", "order2 a");
+	result &= testFileContent(fs, "dir/C.txt", 0);
+	result &= testFileContent(fs, "c.txt", 0);
+
+	result &= fs->removeFileArchive((u32)0);
+
+	return result;
+}
+
+//! the text of the files lines.txt and lines2.txt in media/deflated.zip
+core::stringc makeLines(const char* format, u32 count)
+{
+	core::stringc text;
+	c8 line[16];
+	for (u32 i=0; i < count; ++i)
+	{
+		snprintf(line, 16, format, i);
+		text += line;
+	}
+	return text;
+}
+
+//! reads from the current position and compares with the text at the same position
+bool testReadLines(IReadFile* file, const core::stringc& text, u32 size)
+{
+	const long pos = file->getPos();
+	c8* buffer = new c8[size];
+	const s32 read = file->read(buffer, size);
+	const bool result = read == (s32)size && file->getPos() == pos + (long)size &&
+		!memcmp(buffer, text.c_str() + pos, size);
+	delete [] buffer;
+
+	if (!result)
+		logTestString("Read wrong data at %ld from %s\n", pos, file->getFileName().c_str());
+	return result;
+}
+
+//! compares the whole contents of two files
+bool testSameContent(IReadFile* file1, IReadFile* file2)
+{
+	if (!file1 || !file2 || file1->getSize() != file2->getSize())
+	{
+		logTestString("Files have different sizes\n");
+		return false;
+	}
+
+	const u32 size = (u32)file1->getSize();
+	c8* buffer1 = new c8[size];
+	c8* buffer2 = new c8[size];
+	file1->seek(0);
+	file2->seek(0);
+	const bool result = file1->read(buffer1, size) == (s32)size &&
+		file2->read(buffer2, size) == (s32)size && !memcmp(buffer1, buffer2, size);
+	delete [] buffer1;
+	delete [] buffer2;
+
+	if (!result)
+		logTestString("Files have different content: %s\n", file1->getFileName().c_str());
+	return result;
+}
+
+bool testStreamedZip(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	if ( !fs->addFileArchive("media/deflated.zip", /*bool ignoreCase=*/true, /*bool ignorePaths=*/false) )
+	{
+		logTestString("Mounting archive failed\n");
+		return false;
+	}
+
+	const core::stringc text = makeLines("line %05u\n", 20000);
+	IReadFile* file = fs->createAndOpenFile("lines.txt");
+	if (!file || file->getSize() != (long)text.size())
+	{
+		logTestString("Opening large deflated file failed\n");
+		if (file)
+			file->drop();
+		fs->removeFileArchive(fs->getFileArchiveCount()-1);
+		return false;
+	}
+
+	bool result = true;
+
+	// without cache, large files are decompressed while they are read
+	if (file->getBuffer())
+	{
+		logTestString("Large deflated file was not streamed\n");
+		result = false;
+	}
+
+	while (result && file->getPos() + 777 < file->getSize())
+		result &= testReadLines(file, text, 777);
+
+	// reading stops at the end of the file
+	c8 tmp[1000];
+	const s32 rest = (s32)(file->getSize() - file->getPos());
+	if (file->read(tmp, sizeof(tmp)) != rest || file->read(tmp, sizeof(tmp)) != 0)
+	{
+		logTestString("Reading at the end of the file failed\n");
+		result = false;
+	}
+
+	// seeking backwards to the start of the file decompresses it again
+	result &= file->seek(1000);
+	result &= testReadLines(file, text, 5000);
+	result &= file->seek(-3000, true);
+	result &= testReadLines(file, text, 70000);
+	if (file->getBuffer())
+	{
+		logTestString("Large deflated file was decompressed at once\n");
+		result = false;
+	}
+
+	// seeking backwards further into the file decompresses all of it
+	result &= file->seek(70000);
+	result &= testReadLines(file, text, 20000);
+	result &= !file->seek(text.size()+1);
+	result &= file->seek(text.size());
+	if (!file->getBuffer() || memcmp(file->getBuffer(), text.c_str(), text.size()))
+	{
+		logTestString("Large deflated file was not decompressed at once\n");
+		result = false;
+	}
+	result &= file->seek(150000);
+	result &= testReadLines(file, text, 70000);
+
+	file->drop();
+
+	result &= fs->removeFileArchive(fs->getFileArchiveCount()-1);
+
+	return result;
+}
+
+bool testZipCache(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	IFileArchive* archive = 0;
+	if ( !fs->addFileArchive("media/deflated.zip", /*bool ignoreCase=*/true, /*bool ignorePaths=*/false,
+		EFAT_UNKNOWN, "", &archive) )
+	{
+		logTestString("Mounting archive failed\n");
+		return false;
+	}
+
+	bool result = true;
+	const core::stringc text = makeLines("line %05u\n", 20000);
+
+	// room for lines.txt, but not for lines2.txt, too
+	archive->setCacheSize(300000);
+
+	IReadFile* file1 = fs->createAndOpenFile("lines.txt");
+	IReadFile* file2 = fs->createAndOpenFile("lines.txt");
+	if (!file1 || !file2 || !file1->getBuffer() || file1->getBuffer() != file2->getBuffer())
+	{
+		logTestString("Opening file twice didn't use the cache\n");
+		result = false;
+	}
+	else
+		result &= testReadLines(file2, text, text.size());
+	if (file2)
+		file2->drop();
+
+	// removes lines.txt from the cache, file1 keeps its data
+	IReadFile* other = fs->createAndOpenFile("lines2.txt");
+	if (other)
+	{
+		result &= testReadLines(other, makeLines("%05u enil\n", 10000), (u32)other->getSize());
+		other->drop();
+	}
+	else
+		result = false;
+
+	IReadFile* file3 = fs->createAndOpenFile("lines.txt");
+	if (!file1 || !file3 || !file3->getBuffer() || file1->getBuffer() == file3->getBuffer())
+	{
+		logTestString("File was not removed from the cache\n");
+		result = false;
+	}
+	else
+	{
+		result &= testReadLines(file1, text, text.size());
+		result &= testReadLines(file3, text, text.size());
+	}
+	if (file3)
+		file3->drop();
+	if (file1)
+		file1->drop();
+
+	// without cache the file is streamed again
+	archive->setCacheSize(0);
+	IReadFile* file4 = fs->createAndOpenFile("lines.txt");
+	if (!file4 || file4->getBuffer())
+	{
+		logTestString("File was not streamed without cache\n");
+		result = false;
+	}
+	if (file4)
+		file4->drop();
+
+	result &= fs->removeFileArchive(fs->getFileArchiveCount()-1);
+
+	return result;
+}
+
+bool testZipBatch(IFileSystem* fs)
+{
+	// make sure there is no archive mounted
+	if ( fs->getFileArchiveCount() )
+	{
+		logTestString("Already mounted archives found\n");
+		return false;
+	}
+
+	IFileArchive* archive = 0;
+	if ( !fs->addFileArchive("media/deflated.zip", /*bool ignoreCase=*/true, /*bool ignorePaths=*/false,
+		EFAT_UNKNOWN, "", &archive) )
+	{
+		logTestString("Mounting archive failed\n");
+		return false;
+	}
+
+	// all files, one of them twice
+	core::array<u32> indices;
+	const IFileList* fileList = archive->getFileList();
+	for (u32 i=0; i < fileList->getFileCount(); ++i)
+		indices.push_back(i);
+	indices.push_back(fileList->findFile("lines.txt"));
+
+	bool result = true;
+
+	// without and with cache
+	for (u32 cache=0; cache < 2; ++cache)
+	{
+		archive->setCacheSize(cache ? 1000000 : 0);
+
+		core::array<IReadFile*> files;
+		archive->createAndOpenFiles(indices, files);
+		if (files.size() != indices.size())
+		{
+			logTestString("createAndOpenFiles returned %u files instead of %u\n", files.size(), indices.size());
+			result = false;
+		}
+
+		for (u32 i=0; i < files.size(); ++i)
+		{
+			IReadFile* file = archive->createAndOpenFile(indices[i]);
+			result &= testSameContent(files[i], file);
+			if (file)
+				file->drop();
+			if (files[i])
+				files[i]->drop();
+		}
+	}
+
+	result &= fs->removeFileArchive(fs->getFileArchiveCount()-1);
+
+	return result;
+}
 }
 
 
@@ -459,6 +895,18 @@ bool archiveReader()
 //	ret &= testMountFile(fs);
 	logTestString("Testing add/remove with filenames.\n");
 	ret &= testAddRemove(fs, "media/file_with_path.zip");
+	logTestString("Testing the search order of archives.\n");
+	ret &= testArchiveOrder(fs);
+	logTestString("Testing archives which ignore paths.\n");
+	ret &= testArchiveIgnorePaths(fs);
+	logTestString("Testing archives which don't ignore the case.\n");
+	ret &= testArchiveCase(fs);
+	logTestString("Testing large deflated files.\n");
+	ret &= testStreamedZip(fs);
+	logTestString("Testing the cache of zip files.\n");
+	ret &= testZipCache(fs);
+	logTestString("Testing opening several zip files at once.\n");
+	ret &= testZipBatch(fs);
 
 	device->closeDevice();
 	device->run();
@@ -0,0 +1,178 @@
+// Copyright (C) 2008-2012 Colin MacDonald
+// No rights reserved: this software is in the public domain.
+
+#include "testUtils.h"
+
+using namespace irr;
+
+namespace
+{
+
+//! counts the finished loads
+class CFinishedCounter : public scene::IAsyncLoadFinishedCallBack
+{
+public:
+	CFinishedCounter() : Count(0) {}
+
+	virtual void OnLoadFinished(scene::IAsyncLoad* load)
+	{
+		if (load->getState() != scene::EALS_LOADING)
+			++Count;
+	}
+
+	u32 Count;
+};
+
+//! the console device doesn't need a window, so the loader runs with a real driver
+IrrlichtDevice* createConsoleDevice()
+{
+	SIrrlichtCreationParameters params;
+	params.DeviceType = EIDT_CONSOLE;
+	params.DriverType = video::EDT_BURNINGSVIDEO;
+	params.WindowSize = core::dimension2d<u32>(160,120);
+	return createDeviceEx(params);
+}
+
+//! true if the load has the expected state, and the result if it's loaded
+bool checkLoad(scene::IAsyncLoad* load, scene::E_ASYNC_LOAD_STATE state, bool isMesh)
+{
+	const bool loaded = isMesh ? load->getMesh() != 0 : load->getTexture() != 0;
+	if (load->getState() != state || loaded != (state == scene::EALS_LOADED))
+	{
+		logTestString("Load of %s has state %d instead of %d\n",
+			load->getFileName().c_str(), (s32)load->getState(), (s32)state);
+		return false;
+	}
+	return true;
+}
+
+//! loads meshes and textures, some of them on the main thread, and some which fail
+bool loadAndWait()
+{
+	IrrlichtDevice* device = createConsoleDevice();
+	if (!device)
+		return false;
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	scene::ISceneManager* smgr = device->getSceneManager();
+	scene::IAsyncLoader* loader = smgr->getAsyncLoader();
+
+	CFinishedCounter* counter = new CFinishedCounter();
+	loader->setLoadFinishedCallback(counter);
+
+	scene::IAsyncLoad* mesh = loader->loadMesh("../media/sydney.md2");
+	scene::IAsyncLoad* texture = loader->loadTexture("../media/sydney.bmp");
+	// the loader of .x files requests its textures on the loader thread
+	scene::IAsyncLoad* textured = loader->loadMesh("../media/dwarf.x");
+	// the loader of .b3d files is only run on the main thread
+	scene::IAsyncLoad* mainThread = loader->loadMesh("../media/ninja.b3d");
+	scene::IAsyncLoad* missingMesh = loader->loadMesh("../media/missing.md2");
+	scene::IAsyncLoad* missingTexture = loader->loadTexture("../media/missing.bmp");
+
+	bool result = true;
+
+	// the textures of the mesh are created while waiting for it
+	loader->wait(textured);
+	result &= checkLoad(textured, scene::EALS_LOADED, true);
+	io::IFileSystem* fs = device->getFileSystem();
+	if (!driver->findTexture(fs->getAbsolutePath("../media/dwarf.jpg")) ||
+		!driver->findTexture(fs->getAbsolutePath("../media/axe.jpg")))
+	{
+		logTestString("Textures of dwarf.x were not loaded\n");
+		result = false;
+	}
+
+	loader->wait();
+	if (loader->getPendingCount() != 0 || counter->Count != 6)
+	{
+		logTestString("%u loads pending, %u finished\n", loader->getPendingCount(), counter->Count);
+		result = false;
+	}
+
+	result &= checkLoad(mesh, scene::EALS_LOADED, true);
+	result &= checkLoad(texture, scene::EALS_LOADED, false);
+	result &= checkLoad(mainThread, scene::EALS_LOADED, true);
+	result &= checkLoad(missingMesh, scene::EALS_FAILED, true);
+	result &= checkLoad(missingTexture, scene::EALS_FAILED, false);
+
+	// the results are in the caches
+	if (mesh->getMesh() != smgr->getMesh("../media/sydney.md2") ||
+		mainThread->getMesh() != smgr->getMeshCache()->getMeshByName("../media/ninja.b3d") ||
+		texture->getTexture() != driver->getTexture("../media/sydney.bmp"))
+	{
+		logTestString("Loaded files are not in the caches\n");
+		result = false;
+	}
+
+	// loads of cached files finish with the next update
+	scene::IAsyncLoad* cached = loader->loadMesh("../media/sydney.md2");
+	loader->update();
+	result &= checkLoad(cached, scene::EALS_LOADED, true);
+	cached->drop();
+
+	mesh->drop();
+	texture->drop();
+	textured->drop();
+	mainThread->drop();
+	missingMesh->drop();
+	missingTexture->drop();
+
+	loader->setLoadFinishedCallback(0);
+	counter->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+//! drops the loader while loads are running or waiting for textures
+bool dropPending()
+{
+	IrrlichtDevice* device = createConsoleDevice();
+	if (!device)
+		return false;
+
+	scene::IAsyncLoader* loader = device->getSceneManager()->getAsyncLoader();
+
+	const char* const files[] = { "../media/dwarf.x", "../media/sydney.md2",
+		"../media/ninja.b3d", "../media/earth.x", "../media/faerie.md2" };
+	core::array<scene::IAsyncLoad*> loads;
+	for (u32 i=0; i < sizeof(files)/sizeof(files[0]); ++i)
+		loads.push_back(loader->loadMesh(files[i]));
+	loads.push_back(loader->loadTexture("../media/wall.bmp"));
+
+	// without update() the loader thread waits for the first texture of dwarf.x
+	device->sleep(200);
+
+	// the scene manager drops the loader
+	device->closeDevice();
+	device->drop();
+
+	bool result = true;
+	for (u32 i=0; i < loads.size(); ++i)
+	{
+		if (loads[i]->getState() == scene::EALS_LOADING)
+		{
+			logTestString("Load of %s is still running\n", loads[i]->getFileName().c_str());
+			result = false;
+		}
+		loads[i]->drop();
+	}
+
+	return result;
+}
+
+}
+
+//! Tests loading meshes and textures in the background
+bool asyncLoader(void)
+{
+	bool result = true;
+
+	result &= loadAndWait();
+	result &= dropPending();
+
+	return result;
+}
@@ -88,10 +88,87 @@ bool loadFromFileFolder(void)
 	return ((tex1 == tex2) && (tex1 == tex3) && (tex1 == tex4));
 }
 
+/** This tests loads a list of textures at once, in several batches, and
+	verifies that each texture is cached once and can be found afterwards. */
+bool preloadFromList(void)
+{
+	IrrlichtDevice *device =
+		createDevice( video::EDT_NULL, dimension2du(160, 120));
+
+	if (!device)
+	{
+		logTestString("Unable to create EDT_NULL device\n");
+		return false;
+	}
+
+	IVideoDriver * driver = device->getVideoDriver();
+	device->getFileSystem()->addFileArchive("../media/map-20kdm2.pk3");
+
+	ITexture * loaded = driver->getTexture("../media/tools.png");
+	const u32 numTexs = driver->getTextureCount();
+
+	core::array<io::path> files;
+	files.push_back("../media/fire.bmp");
+	files.push_back("../media/particle.bmp");
+	files.push_back("../media/tools.png");
+	files.push_back("../media/fire.bmp");
+	files.push_back("../media/missing.png");
+	files.push_back("textures/e7/e7beam02_red.jpg");
+	files.push_back("../media/portal1.bmp");
+	files.push_back("textures/e7/e7beam02_red.jpg");
+	files.push_back("../media/irrlichtlogo2.png");
+
+	// the limit is smaller than most files, so they are loaded in several batches
+	bool result = true;
+	if (driver->preloadTextures(files, 2, 4096))
+	{
+		logTestString("Missing texture was not reported %s:%d\n", __FILE__, __LINE__);
+		result = false;
+	}
+
+	// five new textures, the others are duplicates, loaded or missing
+	if (driver->getTextureCount() != numTexs+5)
+	{
+		logTestString("%u textures added instead of 5 %s:%d\n", driver->getTextureCount()-numTexs, __FILE__, __LINE__);
+		result = false;
+	}
+
+	// findTexture() needs the textures sorted by name
+	for (u32 i=1; i<driver->getTextureCount(); ++i)
+	{
+		if (!(driver->getTextureByIndex(i-1)->getName() < driver->getTextureByIndex(i)->getName()))
+		{
+			logTestString("Textures are not sorted at %u %s:%d\n", i, __FILE__, __LINE__);
+			result = false;
+		}
+	}
+
+	// so the textures are found instead of loaded again
+	for (u32 i=0; i<files.size(); ++i)
+	{
+		if (files[i] != "../media/missing.png" && !driver->getTexture(files[i]))
+		{
+			logTestString("Unable to get %s %s:%d\n", files[i].c_str(), __FILE__, __LINE__);
+			result = false;
+		}
+	}
+	if (driver->getTextureCount() != numTexs+5 || driver->getTexture("../media/tools.png") != loaded)
+	{
+		logTestString("Preloaded textures were loaded again %s:%d\n", __FILE__, __LINE__);
+		result = false;
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+	return result;
+}
+
 bool loadTextures()
 {
 	bool result = true;
 	result &= loadFromFileFolder();
+	result &= preloadFromList();
 	return result;
 }
 
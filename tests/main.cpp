@@ -128,6 +128,8 @@ int main(int argumentCount, char * arguments[])
 	TEST(terrainSceneNode);
 	TEST(lightMaps);
 	TEST(triangleSelector);
+	TEST(stencilShadowAdjacencyCache);
+	TEST(asyncLoader);
 
 	unsigned int numberOfTests = tests.size();
 	unsigned int testToRun = 0;
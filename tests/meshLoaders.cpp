@@ -5,6 +5,84 @@
 
 using namespace irr;
 
+namespace
+{
+
+//! writes a file of 64KB, which is mapped into memory, with the tail at its very end
+/** The size is a multiple of the page size, so a read past the end of the
+mapping would crash. */
+bool writeMappedFile(io::IFileSystem* fs, const io::path& name, const core::stringc& head, const core::stringc& tail)
+{
+	const u32 size = 65536;
+	core::stringc text(head);
+	while (text.size() + tail.size() < size)
+	{
+		const u32 line = core::min_(64u, size - tail.size() - text.size());
+		core::stringc padding("#");
+		while (padding.size() < line-1)
+			padding.append('-');
+		text += padding;
+		text.append('\n');
+	}
+	text += tail;
+
+	io::IWriteFile* file = fs->createAndWriteFile(name);
+	if (!file)
+		return false;
+	const bool result = (file->write(text.c_str(), text.size()) == (s32)size);
+	file->drop();
+	return result;
+}
+
+//! loads .x and .obj files which end in the middle of a token
+bool truncatedMappedFiles()
+{
+	IrrlichtDevice *device = createDevice(video::EDT_NULL, core::dimension2d<u32>(160, 120));
+	if (!device)
+		return false;
+
+	io::IFileSystem* fs = device->getFileSystem();
+	scene::ISceneManager* smgr = device->getSceneManager();
+	bool result = true;
+
+	const core::stringc xHead("xof 0303txt 0032\n"
+		"Mesh triangle {\n 3;\n 0.0;0.0;0.0;,\n 1.0;0.0;0.0;,\n 0.0;1.0;0.0;;\n 1;\n 3;0,1,2;;\n}\n");
+	const char* const xTails[] = {
+		"/",
+		"Mesh truncated {\n",
+		"Material truncated {\n 1.0;1.0;1.0;1.0;;\n 1.0;\n 0.0;0.0;0.0;;\n 0.0;0.0;0.0;;\n TextureFilename {\n \"texture"
+	};
+	for (u32 i=0; i < sizeof(xTails)/sizeof(xTails[0]); ++i)
+	{
+		const io::path name = io::path("results/truncated") + io::path(i) + ".x";
+		result &= writeMappedFile(fs, name, xHead, xTails[i]);
+		// broken files may be rejected, but must not crash
+		smgr->getMesh(name);
+	}
+
+	const core::stringc objHead("v 0 0 0\nv 1 0 0\nv 0 1 0\nvt 0 0\nf 1/1 2/1 3/1\n");
+	const char* const objTails[] = { "v", "f", "vt 0.5", "g" };
+	for (u32 i=0; i < sizeof(objTails)/sizeof(objTails[0]); ++i)
+	{
+		const io::path name = io::path("results/truncated") + io::path(i) + ".obj";
+		result &= writeMappedFile(fs, name, objHead, objTails[i]);
+		scene::IAnimatedMesh* mesh = smgr->getMesh(name);
+		if (!mesh || mesh->getMesh(0)->getMeshBuffer(0)->getIndexCount() != 3)
+		{
+			logTestString("Could not load the triangle of %s\n", name.c_str());
+			result = false;
+		}
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+} // end anonymous namespace
+
 // Tests mesh loading features and the mesh cache.
 /** This won't test render results. Currently, not all mesh loaders are tested. */
 bool meshLoaders(void)
@@ -33,5 +111,7 @@ bool meshLoaders(void)
 	device->run();
 	device->drop();
 
+	result &= truncatedMappedFiles();
+
 	return result;
 }
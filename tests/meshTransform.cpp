@@ -10,8 +10,178 @@ using namespace video;
 using namespace io;
 using namespace gui;
 
+namespace
+{
+
+//! vertex comparisons of the reference welding
+bool similarVertices(const S3DVertex& a, const S3DVertex& b, f32 tolerance)
+{
+	return a.Pos.equals(b.Pos, tolerance) && a.Normal.equals(b.Normal, tolerance) &&
+		a.TCoords.equals(b.TCoords) && (a.Color == b.Color);
+}
+
+bool similarVertices(const S3DVertexTangents& a, const S3DVertexTangents& b, f32 tolerance)
+{
+	return similarVertices((const S3DVertex&)a, (const S3DVertex&)b, tolerance) &&
+		a.Tangent.equals(b.Tangent, tolerance) && a.Binormal.equals(b.Binormal, tolerance);
+}
+
+//! compares a welded buffer with the brute force welding
+/** Each vertex is redirected to the first vertex before it which is
+similar, and triangles which lost a corner are removed. */
+template <class T>
+bool compareWelded(const IMeshBuffer* buffer, const IMeshBuffer* welded, f32 tolerance)
+{
+	const T* v = (const T*)buffer->getVertices();
+	array<T> vertices;
+	array<u16> redirects;
+	for (u32 i=0; i < buffer->getVertexCount(); ++i)
+	{
+		u32 j=0;
+		while (j < i && !similarVertices(v[i], v[j], tolerance))
+			++j;
+		if (j < i)
+			redirects.push_back(redirects[j]);
+		else
+		{
+			redirects.push_back(vertices.size());
+			vertices.push_back(v[i]);
+		}
+	}
+
+	array<u16> indices;
+	const u16* idx = buffer->getIndices();
+	for (u32 i=0; i < buffer->getIndexCount(); i+=3)
+	{
+		const u16 a = redirects[idx[i]];
+		const u16 b = redirects[idx[i+1]];
+		const u16 c = redirects[idx[i+2]];
+		if (a != b && b != c && a != c)
+		{
+			indices.push_back(a);
+			indices.push_back(b);
+			indices.push_back(c);
+		}
+	}
+
+	if (welded->getVertexType() != buffer->getVertexType() ||
+		welded->getVertexCount() != vertices.size() || welded->getIndexCount() != indices.size())
+	{
+		logTestString("Welded buffer with tolerance %f has %u vertices and %u indices instead of %u and %u\n",
+			tolerance, welded->getVertexCount(), welded->getIndexCount(), vertices.size(), indices.size());
+		return false;
+	}
+
+	const T* w = (const T*)welded->getVertices();
+	for (u32 i=0; i < vertices.size(); ++i)
+	{
+		if (w[i] != vertices[i])
+		{
+			logTestString("Welded vertex %u differs with tolerance %f\n", i, tolerance);
+			return false;
+		}
+	}
+	for (u32 i=0; i < indices.size(); ++i)
+	{
+		if (welded->getIndices()[i] != indices[i])
+		{
+			logTestString("Welded index %u differs with tolerance %f\n", i, tolerance);
+			return false;
+		}
+	}
+	return true;
+}
+
+//! welds a mesh and compares each buffer with the brute force welding
+bool checkWelded(IMeshManipulator* manipulator, IMesh* mesh, f32 tolerance)
+{
+	IMesh* welded = manipulator->createMeshWelded(mesh, tolerance);
+	bool result = (welded->getMeshBufferCount() == mesh->getMeshBufferCount());
+	for (u32 b=0; result && b < mesh->getMeshBufferCount(); ++b)
+	{
+		const IMeshBuffer* buffer = mesh->getMeshBuffer(b);
+		if (buffer->getVertexType() == EVT_TANGENTS)
+			result = compareWelded<S3DVertexTangents>(buffer, welded->getMeshBuffer(b), tolerance);
+		else
+			result = compareWelded<S3DVertex>(buffer, welded->getMeshBuffer(b), tolerance);
+	}
+	welded->drop();
+	return result;
+}
+
+//! random numbers which are the same on all platforms
+f32 nextRandom(u32& seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return (seed >> 8) / 16777216.f;
+}
+
+//! a buffer with clusters of close vertices, and far vertices if spread is set
+SMeshBuffer* createClusters(u32& seed, f32 spread)
+{
+	SMeshBuffer* buffer = new SMeshBuffer();
+	for (u32 i=0; i < 3000; ++i)
+	{
+		S3DVertex vertex;
+		vertex.Pos.set((f32)(i % 5) + nextRandom(seed)*0.4f - 0.2f,
+			(f32)((i / 5) % 5) + nextRandom(seed)*0.4f - 0.2f,
+			(f32)((i / 25) % 5) + nextRandom(seed)*0.4f - 0.2f);
+		if (nextRandom(seed) < 0.01f)
+			vertex.Pos *= spread;
+		vertex.Normal.set(0, (nextRandom(seed) < 0.5f) ? 1.f : -1.f, 0);
+		vertex.TCoords.set((nextRandom(seed) < 0.8f) ? 0.f : 1.f, 0);
+		vertex.Color = SColor(255,255,255,255);
+		buffer->Vertices.push_back(vertex);
+	}
+	for (u32 i=0; i < 6000; ++i)
+		buffer->Indices.push_back((u16)(nextRandom(seed) * 3000.f));
+	buffer->recalculateBoundingBox();
+	return buffer;
+}
+
+//! Tests the welding of vertices against a comparison with all previous vertices
+bool meshWelding()
+{
+	IrrlichtDevice *device = createDevice(EDT_NULL, dimension2d<u32>(160, 120));
+	if (!device)
+		return false;
+
+	IMeshManipulator* manipulator = device->getVideoDriver()->getMeshManipulator();
+
+	// a sphere where each triangle has its own vertices
+	IMesh* sphere = device->getSceneManager()->getGeometryCreator()->createSphereMesh(10.f, 16, 16);
+	IMesh* unique = manipulator->createMeshUniquePrimitives(sphere);
+	IMesh* tangents = manipulator->createMeshWithTangents(unique);
+	bool result = checkWelded(manipulator, unique, ROUNDING_ERROR_f32);
+	result &= checkWelded(manipulator, unique, 2.f);
+	result &= checkWelded(manipulator, tangents, ROUNDING_ERROR_f32);
+	sphere->drop();
+	unique->drop();
+	tangents->drop();
+
+	// clusters of close vertices, the far ones make the cells larger than the tolerance
+	SMesh* clusters = new SMesh();
+	u32 seed = 1;
+	for (u32 i=0; i < 2; ++i)
+	{
+		SMeshBuffer* buffer = createClusters(seed, i ? 2000.f : 1.f);
+		clusters->addMeshBuffer(buffer);
+		buffer->drop();
+	}
+	const f32 tolerances[] = { 0.f, 0.001f, 0.1f, 0.25f, 0.5f, 3.f };
+	for (u32 i=0; i < sizeof(tolerances)/sizeof(tolerances[0]); ++i)
+		result &= checkWelded(manipulator, clusters, tolerances[i]);
+	clusters->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
 // Tests mesh transformations via mesh manipulator.
-bool meshTransform(void)
+bool transformMeshes()
 {
 	// Use EDT_BURNINGSVIDEO since it is not dependent on (e.g.) OpenGL driver versions.
 	IrrlichtDevice *device = createDevice(EDT_BURNINGSVIDEO, dimension2d<u32>(160, 120), 32);
@@ -86,3 +256,13 @@ bool meshTransform(void)
 
 	return result;
 }
+
+} // end anonymous namespace
+
+// Tests the mesh manipulator.
+bool meshTransform(void)
+{
+	bool result = meshWelding();
+	result &= transformMeshes();
+	return result;
+}
@@ -297,6 +297,45 @@ bool XmlSerialization(io::IFileSystem * fs, video::IVideoDriver * driver )
 	return origMock == copyMock;
 }
 
+// Lookup by name in collections large enough for the name index
+bool NameLookup(io::IFileSystem * fs)
+{
+	io::IAttributes* attr = fs->createEmptyAttributes();
+
+	const s32 count = 100;
+	for (s32 i=0; i<count; ++i)
+	{
+		core::stringc name("attr");
+		name += i;
+		attr->addInt(name.c_str(), i);
+	}
+	// lookups return the first of several attributes with the same name
+	attr->addInt("attr10", -1);
+
+	bool result = true;
+	for (s32 i=0; i<count && result; ++i)
+	{
+		core::stringc name("attr");
+		name += i;
+		result &= (attr->findAttribute(name.c_str()) == i);
+		result &= (attr->getAttributeAsInt(name.c_str()) == i);
+	}
+	result &= (attr->findAttribute("attr100") == -1);
+
+	// removing moves the following attributes
+	attr->setAttribute("attr5", (const c8*)0);
+	result &= (attr->findAttribute("attr5") == -1);
+	result &= (attr->findAttribute("attr6") == 5);
+	result &= (attr->findAttribute("attr10") == 9);
+	result &= (attr->getAttributeAsInt("attr99") == 99);
+
+	attr->clear();
+	result &= (attr->findAttribute("attr0") == -1);
+
+	attr->drop();
+	return result;
+}
+
 bool serializeAttributes()
 {
 	bool result = true;
@@ -327,6 +366,12 @@ bool serializeAttributes()
 		logTestString("XmlSerialization failed in %s:%d\n", __FILE__, __LINE__ );
 	}
 
+	result &= NameLookup(fs);
+	if ( !result )
+	{
+		logTestString("NameLookup failed in %s:%d\n", __FILE__, __LINE__ );
+	}
+
 	device->closeDevice();
 	device->run();
 	device->drop();
@@ -5,12 +5,14 @@
 
 using namespace irr;
 
-static bool shadows(video::E_DRIVER_TYPE driverType)
+static bool shadows(video::E_DRIVER_TYPE driverType, bool adjacencyCache)
 {
 	IrrlichtDevice *device = createDevice (driverType, core::dimension2d<u32>(160,120), 16, false, true);
 	if (!device)
 		return true; // No error if device does not exist
 
+	logTestString("Testing shadows with%s adjacency cache\n", adjacencyCache ? "" : "out");
+	device->getSceneManager()->getParameters()->setAttribute(scene::SHADOW_ADJACENCY_CACHE, adjacencyCache);
 	stabilizeScreenBackground(device->getVideoDriver());
 
 	scene::ICameraSceneNode* cam = device->getSceneManager()->addCameraSceneNodeFPS();
@@ -65,12 +67,141 @@ bool stencilShadow(void)
 {
 	bool passed = true;
 
-	passed &= shadows(video::EDT_OPENGL);
-	// no shadows in these renderers
-//	passed &= shadows(video::EDT_SOFTWARE);
-//	passed &= shadows(video::EDT_BURNINGSVIDEO);
-	passed &= shadows(video::EDT_DIRECT3D9);
-	passed &= shadows(video::EDT_DIRECT3D8);
+	// the shared adjacency must not change the shadows
+	for (u32 i=0; i<2; ++i)
+	{
+		passed &= shadows(video::EDT_OPENGL, i==1);
+		// no shadows in these renderers
+//		passed &= shadows(video::EDT_SOFTWARE, i==1);
+//		passed &= shadows(video::EDT_BURNINGSVIDEO, i==1);
+		passed &= shadows(video::EDT_DIRECT3D9, i==1);
+		passed &= shadows(video::EDT_DIRECT3D8, i==1);
+	}
 
 	return passed;
 }
+
+//! number of pixels which differ in two images of the same size
+static u32 countDifferentPixels(video::IImage* image1, video::IImage* image2)
+{
+	const core::dimension2d<u32> dim = image1->getDimension();
+	u32 count = 0;
+	for (u32 y=0; y<dim.Height; ++y)
+		for (u32 x=0; x<dim.Width; ++x)
+			if (image1->getPixel(x,y) != image2->getPixel(x,y))
+				++count;
+	return count;
+}
+
+//! renders several shadows of the same meshes, without and with shadows
+/** The console device doesn't need a window, but would print each frame,
+so the screenshots are taken before endScene(). */
+static bool renderSharedShadows(bool adjacencyCache, core::array<video::IImage*>& screenshots)
+{
+	SIrrlichtCreationParameters params;
+	params.DeviceType = EIDT_CONSOLE;
+	params.DriverType = video::EDT_BURNINGSVIDEO;
+	params.WindowSize = core::dimension2d<u32>(160,120);
+	params.Stencilbuffer = true;
+
+	IrrlichtDevice *device = createDeviceEx(params);
+	if (!device)
+		return false;
+
+	video::IVideoDriver* driver = device->getVideoDriver();
+	scene::ISceneManager* smgr = device->getSceneManager();
+	smgr->getParameters()->setAttribute(scene::SHADOW_ADJACENCY_CACHE, adjacencyCache);
+
+	scene::ICameraSceneNode* cam = smgr->addCameraSceneNode();
+	cam->setPosition(core::vector3df(-15,55,10));
+	cam->setTarget(core::vector3df(5,-5,-15));
+
+	smgr->setAmbientLight(video::SColorf(.5f,.5f,.5f));
+	scene::IMeshSceneNode* cube = smgr->addCubeSceneNode(100, 0, -1, core::vector3df(0,50,0));
+	cube->setScale(core::vector3df(-1,-1,-1));
+
+	// three nodes share the mesh, and with it the adjacency
+	scene::IAnimatedMesh* mesh = smgr->getMesh("../media/ninja.b3d");
+	core::array<scene::IAnimatedMeshSceneNode*> nodes;
+	core::array<scene::IShadowVolumeSceneNode*> shadows;
+	for (u32 i=0; i<3; ++i)
+	{
+		scene::IAnimatedMeshSceneNode* node = smgr->addAnimatedMeshSceneNode(mesh, 0, -1,
+			core::vector3df((f32)i*12.f-5.f,2,(f32)i*-8.f), core::vector3df(0,(f32)i*60.f,0), core::vector3df(5,5,5));
+		node->setAnimationSpeed(0.f);
+		nodes.push_back(node);
+		shadows.push_back(node->addShadowVolumeSceneNode());
+		shadows.getLast()->setVisible(false);
+	}
+
+	scene::ILightSceneNode* light = smgr->addLightSceneNode(0, core::vector3df(10,10,10));
+	light->setLightType(video::ELT_POINT);
+	light->setRadius(500.f);
+
+	for (u32 i=0; i<3; ++i)
+	{
+		if (i==1)
+		{
+			for (u32 n=0; n<shadows.size(); ++n)
+				shadows[n]->setVisible(true);
+		}
+		else if (i==2)
+		{
+			// a shadow of another mesh, and a removed node which held the adjacency
+			scene::IMesh* sphere = smgr->getGeometryCreator()->createSphereMesh(2.f);
+			shadows[2]->setShadowMesh(sphere);
+			sphere->drop();
+			nodes[0]->remove();
+		}
+
+		driver->beginScene(true, true, 0);
+		smgr->drawAll();
+		video::IImage* screenshot = driver->createScreenShot();
+		if (!screenshot)
+			break;
+		screenshots.push_back(screenshot);
+	}
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return screenshots.size() == 3;
+}
+
+//! the shadows with shared adjacency have to be the same as without
+bool stencilShadowAdjacencyCache(void)
+{
+	core::array<video::IImage*> screenshots[2];
+	bool result = renderSharedShadows(false, screenshots[0]);
+	result &= renderSharedShadows(true, screenshots[1]);
+
+	if (result)
+	{
+		// make sure that the shadows were drawn
+		if (!countDifferentPixels(screenshots[0][0], screenshots[0][1]) ||
+			!countDifferentPixels(screenshots[0][1], screenshots[0][2]))
+		{
+			logTestString("No shadows were drawn\n");
+			result = false;
+		}
+
+		for (u32 i=0; i<3; ++i)
+		{
+			const u32 count = countDifferentPixels(screenshots[0][i], screenshots[1][i]);
+			if (count)
+			{
+				logTestString("Frame %u differs in %u pixels with adjacency cache\n", i, count);
+				result = false;
+			}
+		}
+	}
+	else
+		logTestString("Could not render shadows with the console device\n");
+
+	for (u32 c=0; c<2; ++c)
+		for (u32 i=0; i<screenshots[c].size(); ++i)
+			screenshots[c][i]->drop();
+
+	return result;
+}
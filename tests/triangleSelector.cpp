@@ -282,6 +282,632 @@ bool triangle()
 
 	return result;
 }
+
+//! random numbers which are the same on all platforms
+f32 nextRandom(u32& seed)
+{
+	seed = seed * 1664525u + 1013904223u;
+	return (seed >> 8) / 16777216.f;
+}
+
+core::vector3df randomPoint(u32& seed, const core::aabbox3df& area)
+{
+	const core::vector3df extent = area.getExtent();
+	return area.MinEdge + core::vector3df(extent.X * nextRandom(seed),
+		extent.Y * nextRandom(seed), extent.Z * nextRandom(seed));
+}
+
+//! sorts triangles by their points, so results of different selectors can be compared
+struct SSortedTriangle
+{
+	core::triangle3df Triangle;
+
+	bool operator<(const SSortedTriangle& other) const
+	{
+		const core::vector3df* points[3] = { &Triangle.pointA, &Triangle.pointB, &Triangle.pointC };
+		const core::vector3df* otherPoints[3] = { &other.Triangle.pointA, &other.Triangle.pointB, &other.Triangle.pointC };
+		for (u32 i=0; i<3; ++i)
+		{
+			if (points[i]->X != otherPoints[i]->X)
+				return points[i]->X < otherPoints[i]->X;
+			if (points[i]->Y != otherPoints[i]->Y)
+				return points[i]->Y < otherPoints[i]->Y;
+			if (points[i]->Z != otherPoints[i]->Z)
+				return points[i]->Z < otherPoints[i]->Z;
+		}
+		return false;
+	}
+};
+
+void sortTriangles(const core::array<core::triangle3df>& triangles, core::array<SSortedTriangle>& sorted)
+{
+	sorted.clear();
+	for (u32 i=0; i < triangles.size(); ++i)
+	{
+		sorted.push_back(SSortedTriangle());
+		sorted.getLast().Triangle = triangles[i];
+	}
+	sorted.sort();
+}
+
+//! true if each triangle of part is in triangles, at least as often as in part
+bool containsTriangles(const core::array<core::triangle3df>& triangles, const core::array<core::triangle3df>& part)
+{
+	core::array<SSortedTriangle> sorted, sortedPart;
+	sortTriangles(triangles, sorted);
+	sortTriangles(part, sortedPart);
+
+	u32 t = 0;
+	for (u32 p=0; p < sortedPart.size(); ++p)
+	{
+		while (t < sorted.size() && sorted[t] < sortedPart[p])
+			++t;
+		if (t == sorted.size() || sortedPart[p] < sorted[t])
+			return false;
+		++t;
+	}
+	return true;
+}
+
+//! the triangles of a box query, line queries only keep the triangles which are hit
+/** With boxCulling only the selectors whose box touches the query box are asked. */
+void getTriangles(const core::array<scene::ITriangleSelector*>& selectors, const core::aabbox3df* box,
+	const core::line3df* line, core::array<core::triangle3df>& triangles, bool boxCulling=false)
+{
+	triangles.clear();
+	for (u32 i=0; i < selectors.size(); ++i)
+	{
+		core::aabbox3df selectorBox;
+		if (box && boxCulling && selectors[i]->getTransformedBoundingBox(selectorBox) &&
+			!selectorBox.intersectsWithBox(*box))
+			continue;
+
+		core::array<core::triangle3df> buffer;
+		buffer.set_used(selectors[i]->getTriangleCount());
+		s32 count = 0;
+		if (box)
+			selectors[i]->getTriangles(buffer.pointer(), buffer.size(), count, *box);
+		else
+			selectors[i]->getTriangles(buffer.pointer(), buffer.size(), count, *line);
+
+		for (s32 t=0; t < count; ++t)
+		{
+			core::vector3df hit;
+			if (box || buffer[t].getIntersectionWithLimitedLine(*line, hit))
+				triangles.push_back(buffer[t]);
+		}
+	}
+}
+
+//! compares a selector with the triangle selectors of the same nodes
+/** The triangle selectors may return triangles outside of the box of a
+query. The meta selector doesn't ask selectors whose box is far from the
+query box, so with boxCulling it only has to return the triangles of the
+selectors whose box touches the query box. */
+bool compareSelectors(scene::ISceneCollisionManager* collMgr, scene::ITriangleSelector* selector,
+	const core::array<scene::ITriangleSelector*>& references, const core::aabbox3df& area, bool boxCulling)
+{
+	core::array<scene::ITriangleSelector*> selectors;
+	selectors.push_back(selector);
+
+	u32 boxTriangles = 0;
+	u32 lineHits = 0;
+	u32 seed = 1;
+	for (u32 i=0; i < 200; ++i)
+	{
+		const core::vector3df start = randomPoint(seed, area);
+		core::aabbox3df box(start);
+		box.addInternalPoint(start + area.getExtent() * 0.2f * nextRandom(seed));
+
+		core::array<core::triangle3df> triangles, referenceTriangles, nearTriangles;
+		getTriangles(selectors, &box, 0, triangles);
+		getTriangles(references, &box, 0, referenceTriangles);
+		getTriangles(references, &box, 0, nearTriangles, boxCulling);
+		if (!containsTriangles(referenceTriangles, triangles) || !containsTriangles(triangles, nearTriangles))
+		{
+			logTestString("Box query %u found %u triangles instead of %u\n", i, triangles.size(), nearTriangles.size());
+			return false;
+		}
+		boxTriangles += triangles.size();
+
+		const core::line3df line(start, randomPoint(seed, area));
+		getTriangles(selectors, 0, &line, triangles);
+		getTriangles(references, 0, &line, referenceTriangles);
+		if (!containsTriangles(referenceTriangles, triangles) || !containsTriangles(triangles, referenceTriangles))
+		{
+			logTestString("Line query %u hit %u triangles instead of %u\n", i, triangles.size(), referenceTriangles.size());
+			return false;
+		}
+
+		// the nearest hit of the references
+		bool referenceHit = false;
+		core::vector3df referencePoint;
+		scene::ISceneNode* referenceNode = 0;
+		for (u32 r=0; r < references.size(); ++r)
+		{
+			core::vector3df point;
+			core::triangle3df triangle;
+			scene::ISceneNode* node = 0;
+			if (collMgr->getCollisionPoint(line, references[r], point, triangle, node) &&
+				(!referenceHit || point.getDistanceFromSQ(line.start) < referencePoint.getDistanceFromSQ(line.start)))
+			{
+				referenceHit = true;
+				referencePoint = point;
+				referenceNode = node;
+			}
+		}
+
+		core::vector3df point;
+		core::triangle3df triangle;
+		scene::ISceneNode* node = 0;
+		const bool hit = collMgr->getCollisionPoint(line, selector, point, triangle, node);
+		if (hit != referenceHit || (hit && (!point.equals(referencePoint, 0.01f) || node != referenceNode)))
+		{
+			logTestString("Collision point %u differs\n", i);
+			return false;
+		}
+		if (hit)
+			++lineHits;
+	}
+
+	// make sure that the queries found something
+	if (!boxTriangles || !lineHits)
+	{
+		logTestString("Queries found no triangles\n");
+		return false;
+	}
+	return true;
+}
+
+//! Tests the bounding volume hierarchy against the triangle selector
+bool bvh()
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, core::dimension2d<u32>(160, 120));
+	if (!device)
+		return false;
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+
+	scene::IMesh* mesh = smgr->getGeometryCreator()->createSphereMesh(50.f, 64, 64);
+	scene::IMeshSceneNode* node = smgr->addMeshSceneNode(mesh);
+	node->setPosition(core::vector3df(10,20,30));
+	node->setRotation(core::vector3df(10,40,70));
+	node->setScale(core::vector3df(1,2,0.5f));
+	node->updateAbsolutePosition();
+
+	scene::ITriangleSelector* selector = smgr->createBVHTriangleSelector(mesh, node);
+	core::array<scene::ITriangleSelector*> references;
+	references.push_back(smgr->createTriangleSelector(mesh, node));
+	mesh->drop();
+
+	core::aabbox3df area(node->getTransformedBoundingBox());
+	area.MinEdge -= core::vector3df(20,20,20);
+	area.MaxEdge += core::vector3df(20,20,20);
+
+	bool result = compareSelectors(smgr->getSceneCollisionManager(), selector, references, area, false);
+
+	selector->drop();
+	references[0]->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+//! compares a selector of an animated node with a triangle selector of one frame of its mesh
+bool compareFrame(scene::ISceneManager* smgr, scene::ITriangleSelector* selector,
+	scene::IAnimatedMeshSceneNode* node, s32 frame, const core::aabbox3df& area)
+{
+	core::array<scene::ITriangleSelector*> references;
+	references.push_back(smgr->createTriangleSelector(node->getMesh()->getMesh(frame), node));
+
+	const bool result = compareSelectors(smgr->getSceneCollisionManager(), selector, references, area, false);
+	if (!result)
+		logTestString("Selector of frame %d of the node differs\n", frame);
+
+	references[0]->drop();
+	return result;
+}
+
+//! Tests the refitted hierarchy of an animated node against the triangle selector of each frame
+bool bvhAnimated()
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, core::dimension2d<u32>(160, 120));
+	if (!device)
+		return false;
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+
+	scene::IAnimatedMesh* mesh = smgr->getMesh("../media/sydney.md2");
+	if (!mesh)
+	{
+		device->closeDevice();
+		device->run();
+		device->drop();
+		return false;
+	}
+
+	scene::IAnimatedMeshSceneNode* node = smgr->addAnimatedMeshSceneNode(mesh);
+	node->setPosition(core::vector3df(10,20,30));
+	node->setRotation(core::vector3df(0,40,0));
+	node->updateAbsolutePosition();
+
+	scene::ITriangleSelector* selector = smgr->createBVHTriangleSelector(node);
+
+	core::aabbox3df area(node->getTransformedBoundingBox());
+	area.MinEdge -= core::vector3df(20,20,20);
+	area.MaxEdge += core::vector3df(20,20,20);
+
+	bool result = true;
+	const s32 endFrame = node->getEndFrame();
+	const s32 frames[] = { endFrame / 3, endFrame, 1, endFrame * 2 / 3 };
+	for (u32 i=0; i < sizeof(frames)/sizeof(frames[0]); ++i)
+	{
+		node->setCurrentFrame((f32)frames[i]);
+		result &= compareFrame(smgr, selector, node, frames[i], area);
+	}
+	selector->drop();
+
+	// spheres of different size, the last frame has more triangles
+	scene::SAnimatedMesh* spheres = new scene::SAnimatedMesh();
+	for (u32 i=0; i < 4; ++i)
+	{
+		const u32 segments = i < 3 ? 12 : 16;
+		scene::IMesh* sphere = smgr->getGeometryCreator()->createSphereMesh(6.f + (f32)i * 2.f, segments, segments);
+		spheres->addMesh(sphere);
+		sphere->drop();
+	}
+	spheres->recalculateBoundingBox();
+
+	node = smgr->addAnimatedMeshSceneNode(spheres);
+	spheres->drop();
+	node->setPosition(core::vector3df(-40,0,0));
+	node->setRotation(core::vector3df(30,0,10));
+	node->updateAbsolutePosition();
+	selector = smgr->createBVHTriangleSelector(node);
+	area = core::aabbox3df(core::vector3df(-60,-20,-20), core::vector3df(-20,20,20));
+
+	node->setCurrentFrame(2.f);
+	result &= compareFrame(smgr, selector, node, 2, area);
+
+	// the hierarchy keeps the triangles of the last frame which fits
+	node->setCurrentFrame(3.f);
+	result &= compareFrame(smgr, selector, node, 2, area);
+
+	node->setCurrentFrame(1.f);
+	result &= compareFrame(smgr, selector, node, 1, area);
+	selector->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+//! Tests the tree of the meta selector against the triangle selectors of its nodes
+bool metaTree()
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, core::dimension2d<u32>(160, 120));
+	if (!device)
+		return false;
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+	scene::IMetaTriangleSelector* meta = smgr->createMetaTriangleSelector();
+	core::array<scene::ITriangleSelector*> children;
+	core::array<scene::ITriangleSelector*> references;
+	core::array<scene::ISceneNode*> nodes;
+
+	// a grid of spheres and cubes, half of them in BVH selectors
+	for (u32 i=0; i < 12; ++i)
+	{
+		scene::IMesh* mesh = (i % 3) ? smgr->getGeometryCreator()->createSphereMesh(8.f, 12, 12) :
+			smgr->getGeometryCreator()->createCubeMesh(core::vector3df(10,10,10));
+		scene::IMeshSceneNode* node = smgr->addMeshSceneNode(mesh);
+		node->setPosition(core::vector3df((f32)(i % 4) * 30.f, (f32)(i / 4) * 30.f, (f32)(i % 2) * 15.f));
+		node->setRotation(core::vector3df((f32)i * 20.f, 0, 0));
+		node->updateAbsolutePosition();
+		nodes.push_back(node);
+
+		children.push_back((i % 2) ? smgr->createBVHTriangleSelector(mesh, node) :
+			smgr->createTriangleSelector(mesh, node));
+		meta->addTriangleSelector(children.getLast());
+		references.push_back(smgr->createTriangleSelector(mesh, node));
+		mesh->drop();
+	}
+
+	const core::aabbox3df area(core::vector3df(-30,-30,-30), core::vector3df(120,90,50));
+	scene::ISceneCollisionManager* collMgr = smgr->getSceneCollisionManager();
+	bool result = compareSelectors(collMgr, meta, references, area, true);
+
+	// nodes which move out of their place in the tree
+	nodes[1]->setPosition(core::vector3df(60,10,0));
+	nodes[1]->updateAbsolutePosition();
+	nodes[6]->setPosition(core::vector3df(-10,70,40));
+	nodes[6]->updateAbsolutePosition();
+	// the tree is updated in the next frame
+	device->getTimer()->setTime(device->getTimer()->getTime() + 10);
+	result &= compareSelectors(collMgr, meta, references, area, true);
+
+	// and a selector which is removed
+	meta->removeTriangleSelector(children[4]);
+	references[4]->drop();
+	references.erase(4);
+	result &= compareSelectors(collMgr, meta, references, area, true);
+
+	for (u32 i=0; i < children.size(); ++i)
+		children[i]->drop();
+	for (u32 i=0; i < references.size(); ++i)
+		references[i]->drop();
+	meta->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+//! forwards to a selector and counts how often its box is fetched
+class CCountingSelector : public scene::ITriangleSelector
+{
+public:
+	CCountingSelector(scene::ITriangleSelector* selector) : Selector(selector), BoxCount(0)
+	{
+		Selector->grab();
+	}
+
+	~CCountingSelector()
+	{
+		Selector->drop();
+	}
+
+	virtual s32 getTriangleCount() const
+	{
+		return Selector->getTriangleCount();
+	}
+
+	virtual void getTriangles(core::triangle3df* triangles, s32 arraySize,
+		s32& outTriangleCount, const core::matrix4* transform=0) const
+	{
+		Selector->getTriangles(triangles, arraySize, outTriangleCount, transform);
+	}
+
+	virtual void getTriangles(core::triangle3df* triangles, s32 arraySize,
+		s32& outTriangleCount, const core::aabbox3d<f32>& box,
+		const core::matrix4* transform=0) const
+	{
+		Selector->getTriangles(triangles, arraySize, outTriangleCount, box, transform);
+	}
+
+	virtual void getTriangles(core::triangle3df* triangles, s32 arraySize,
+		s32& outTriangleCount, const core::line3d<f32>& line,
+		const core::matrix4* transform=0) const
+	{
+		Selector->getTriangles(triangles, arraySize, outTriangleCount, line, transform);
+	}
+
+	virtual bool getTransformedBoundingBox(core::aabbox3df& outBox) const
+	{
+		++BoxCount;
+		return Selector->getTransformedBoundingBox(outBox);
+	}
+
+	virtual scene::ISceneNode* getSceneNodeForTriangle(u32 triangleIndex) const
+	{
+		return Selector->getSceneNodeForTriangle(triangleIndex);
+	}
+
+	virtual u32 getSelectorCount() const
+	{
+		return 1;
+	}
+
+	virtual scene::ITriangleSelector* getSelector(u32 index)
+	{
+		return index ? 0 : this;
+	}
+
+	virtual const scene::ITriangleSelector* getSelector(u32 index) const
+	{
+		return index ? 0 : this;
+	}
+
+	scene::ITriangleSelector* Selector;
+	mutable u32 BoxCount;
+};
+
+//! queries a meta selector and checks how many boxes of its selectors were fetched
+bool queryBoxCounts(scene::IMetaTriangleSelector* meta, const core::array<CCountingSelector*>& children,
+	const u32* expected, const char* step)
+{
+	for (u32 i=0; i < children.size(); ++i)
+		children[i]->BoxCount = 0;
+
+	core::array<core::triangle3df> triangles;
+	triangles.set_used(meta->getTriangleCount());
+	const core::aabbox3df box(core::vector3df(-20,-20,-20), core::vector3df(20,20,20));
+	const core::line3df line(core::vector3df(-50,0,0), core::vector3df(200,0,0));
+	for (u32 q=0; q < 3; ++q)
+	{
+		s32 count = 0;
+		meta->getTriangles(triangles.pointer(), triangles.size(), count, box);
+		meta->getTriangles(triangles.pointer(), triangles.size(), count, line);
+	}
+
+	bool result = true;
+	for (u32 i=0; i < children.size(); ++i)
+	{
+		if (children[i]->BoxCount != expected[i])
+		{
+			logTestString("%s: box of selector %u fetched %u times instead of %u\n", step, i, children[i]->BoxCount, expected[i]);
+			result = false;
+		}
+	}
+	return result;
+}
+
+//! Tests that the meta selector only fetches the boxes of changed selectors, once per frame
+bool metaBoxUpdates()
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, core::dimension2d<u32>(160, 120));
+	if (!device)
+		return false;
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+	ITimer* timer = device->getTimer();
+	scene::IMetaTriangleSelector* meta = smgr->createMetaTriangleSelector();
+	core::array<CCountingSelector*> children;
+	core::array<scene::ISceneNode*> nodes;
+
+	scene::IMesh* mesh = smgr->getGeometryCreator()->createCubeMesh(core::vector3df(10,10,10));
+	for (u32 i=0; i < 4; ++i)
+	{
+		scene::IMeshSceneNode* node = smgr->addMeshSceneNode(mesh);
+		node->setPosition(core::vector3df((f32)i * 40.f, 0, 0));
+		node->updateAbsolutePosition();
+		nodes.push_back(node);
+
+		scene::ITriangleSelector* selector = smgr->createTriangleSelector(mesh, node);
+		children.push_back(new CCountingSelector(selector));
+		selector->drop();
+		meta->addTriangleSelector(children.getLast());
+	}
+	mesh->drop();
+
+	// new selectors are fetched once, all queries of the frame only walk the tree
+	const u32 once[] = { 1, 1, 1, 1 };
+	const u32 never[] = { 0, 0, 0, 0 };
+	bool result = queryBoxCounts(meta, children, once, "New selectors");
+	result &= queryBoxCounts(meta, children, never, "Same frame");
+
+	// unchanged nodes are not fetched in the next frames
+	timer->setTime(timer->getTime() + 10);
+	result &= queryBoxCounts(meta, children, never, "Unchanged nodes");
+
+	// a moved node is fetched once in the next frame
+	nodes[2]->setPosition(core::vector3df(0,30,0));
+	nodes[2]->updateAbsolutePosition();
+	timer->setTime(timer->getTime() + 10);
+	const u32 moved[] = { 0, 0, 1, 0 };
+	result &= queryBoxCounts(meta, children, moved, "Moved node");
+
+	// a stopped timer checks the nodes on each query
+	timer->stop();
+	nodes[0]->setPosition(core::vector3df(0,-30,0));
+	nodes[0]->updateAbsolutePosition();
+	const u32 stopped[] = { 1, 0, 0, 0 };
+	result &= queryBoxCounts(meta, children, stopped, "Stopped timer");
+	timer->start();
+
+	for (u32 i=0; i < children.size(); ++i)
+		children[i]->drop();
+	meta->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
+
+//! compares the batch of getCollisionPoints() with getCollisionPoint() for each ray
+bool compareCollisionPoints(scene::ISceneCollisionManager* collMgr, scene::ITriangleSelector* selector,
+	const core::array<core::line3df>& rays, bool parallel)
+{
+	core::array<scene::SCollisionHit> hits;
+	hits.set_used(rays.size());
+	const u32 hitCount = collMgr->getCollisionPoints(rays.const_pointer(), rays.size(), selector, hits.pointer(), parallel);
+
+	u32 referenceCount = 0;
+	for (u32 i=0; i < rays.size(); ++i)
+	{
+		core::vector3df point;
+		core::triangle3df triangle;
+		scene::ISceneNode* node = 0;
+		const bool hit = collMgr->getCollisionPoint(rays[i], selector, point, triangle, node);
+		if (hit != hits[i].Hit || (hit && (!point.equals(hits[i].Point, 0.01f) || node != hits[i].Node)))
+		{
+			logTestString("Ray %u of the batch differs from its collision point\n", i);
+			return false;
+		}
+		if (hit)
+			++referenceCount;
+	}
+
+	if (hitCount != referenceCount || !hitCount)
+	{
+		logTestString("Batch hit %u rays instead of %u\n", hitCount, referenceCount);
+		return false;
+	}
+	return true;
+}
+
+//! Tests the batch of collision points against the collision point of each ray
+bool batchCollisionPoints()
+{
+	IrrlichtDevice* device = createDevice(video::EDT_NULL, core::dimension2d<u32>(160, 120));
+	if (!device)
+		return false;
+
+	scene::ISceneManager* smgr = device->getSceneManager();
+	scene::IMetaTriangleSelector* meta = smgr->createMetaTriangleSelector();
+	core::array<scene::ITriangleSelector*> children;
+
+	// a grid of spheres and cubes, half of them in BVH selectors
+	for (u32 i=0; i < 12; ++i)
+	{
+		scene::IMesh* mesh = (i % 3) ? smgr->getGeometryCreator()->createSphereMesh(8.f, 12, 12) :
+			smgr->getGeometryCreator()->createCubeMesh(core::vector3df(8,8,8));
+		scene::IMeshSceneNode* node = smgr->addMeshSceneNode(mesh);
+		node->setPosition(core::vector3df((f32)(i % 4) * 30.f, (f32)(i / 4) * 30.f, (f32)(i % 2) * 15.f));
+		if (i % 3)
+			node->setRotation(core::vector3df((f32)i * 20.f, 0, 0));
+		node->updateAbsolutePosition();
+
+		children.push_back((i % 2) ? smgr->createBVHTriangleSelector(mesh, node) :
+			smgr->createTriangleSelector(mesh, node));
+		meta->addTriangleSelector(children.getLast());
+		mesh->drop();
+	}
+
+	// more rays than one block of the batch, and not a multiple of a packet
+	const core::aabbox3df area(core::vector3df(-30,-30,-30), core::vector3df(120,90,50));
+	core::array<core::line3df> rays;
+	u32 seed = 1;
+	for (u32 i=0; i < 203; ++i)
+		rays.push_back(core::line3df(randomPoint(seed, area), randomPoint(seed, area)));
+
+	// rays which end exactly on a face of the cubes at 0,0,0 and 60,30,0
+	// don't hit them, in the first packet and in later blocks
+	for (u32 i=1; i < rays.size(); i+=50)
+	{
+		const f32 offset = (f32)(i % 3);
+		if (i % 2)
+			rays[i] = core::line3df(-20.f, 1.f+offset, 2.f, -4.f, 1.f+offset, 2.f);
+		else
+			rays[i] = core::line3df(40.f, 31.f, 1.f+offset, 56.f, 31.f, 1.f+offset);
+	}
+
+	scene::ISceneCollisionManager* collMgr = smgr->getSceneCollisionManager();
+	bool result = compareCollisionPoints(collMgr, meta, rays, false);
+	result &= compareCollisionPoints(collMgr, meta, rays, true);
+
+	// and a triangle selector without meta selector
+	result &= compareCollisionPoints(collMgr, children[0], rays, false);
+
+	for (u32 i=0; i < children.size(); ++i)
+		children[i]->drop();
+	meta->drop();
+
+	device->closeDevice();
+	device->run();
+	device->drop();
+
+	return result;
+}
 }
 
 // Tests need not be accurate, as we just need to include at least
@@ -293,6 +919,11 @@ bool triangleSelector(void)
 
 	result &= octree();
 	result &= triangle();
+	result &= bvh();
+	result &= bvhAnimated();
+	result &= metaTree();
+	result &= metaBoxUpdates();
+	result &= batchCollisionPoints();
 
 	return result;
 }